@@ -34,6 +34,9 @@ include $(dir)/Rules.mk
 dir := $(d)/painter_cells
 include $(dir)/Rules.mk
 
+dir := $(d)/path_tessellation_benchmark
+include $(dir)/Rules.mk
+
 
 
 # Begin standard footer
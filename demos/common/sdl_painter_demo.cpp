@@ -198,6 +198,12 @@ sdl_painter_demo(const std::string &about_text,
                                  "one for those item shaders that have discard and one for "
                                  "those that do not",
                                  *this),
+  m_painter_stencil_clipping(m_painter_base_params.stencil_clipping(),
+                             "painter_stencil_clipping",
+                             "if true, clipInPath and clipOutPath use the stencil buffer "
+                             "instead of depth occluders; requires a stencil buffer with "
+                             "at least 8 bits (see stencil_bits)",
+                             *this),
 
   m_painter_options_affected_by_context("PainterBackendGL Options that can be overridden "
                                         "by version and extension supported by GL/GLES context",
@@ -241,7 +247,14 @@ sdl_painter_demo(const std::string &about_text,
                          "If true, use a UBO instead of uniforms to hold uniform values common to all items",
                          *this),
   m_demo_options("Demo Options", *this),
-  m_print_painter_config(default_value_for_print_painter_config, "print_painter_config", "Print PainterBackendGL config", *this)
+  m_print_painter_config(default_value_for_print_painter_config, "print_painter_config", "Print PainterBackendGL config", *this),
+  m_painter_curve_flatness(0.25f, "painter_curve_flatness",
+                           "If positive, maximum distance in pixels allowed between the curves "
+                           "of a path and the line segments used to draw it, letting the Painter "
+                           "draw paths with coarser tessellations when zoomed out (see "
+                           "Painter::curve_flatness()); zero or less always uses the default "
+                           "tessellation of a path",
+                           *this)
 {}
 
 sdl_painter_demo::
@@ -318,7 +331,9 @@ init_gl(int w, int h)
   m_colorstop_atlas = FASTUIDRAWnew fastuidraw::gl::ColorStopAtlasGL(m_colorstop_atlas_params);
 
 
-  m_painter_base_params.alignment(m_painter_alignment.m_value);
+  m_painter_base_params
+    .alignment(m_painter_alignment.m_value)
+    .stencil_clipping(m_painter_stencil_clipping.m_value);
   m_painter_params
     .image_atlas(m_image_atlas)
     .glyph_atlas(m_glyph_atlas)
@@ -342,6 +357,7 @@ init_gl(int w, int h)
 
   m_backend = FASTUIDRAWnew fastuidraw::gl::PainterBackendGL(m_painter_params, m_painter_base_params);
   m_painter = FASTUIDRAWnew fastuidraw::Painter(m_backend);
+  m_painter->curve_flatness(m_painter_curve_flatness.m_value);
   m_glyph_cache = FASTUIDRAWnew fastuidraw::GlyphCache(m_painter->glyph_atlas());
   m_glyph_selector = FASTUIDRAWnew fastuidraw::GlyphSelector(m_glyph_cache);
   m_ft_lib = FASTUIDRAWnew fastuidraw::FreetypeLib();
@@ -399,6 +415,7 @@ init_gl(int w, int h)
       print_dashed_stroke_shader_ids(sh.pixel_width_dashed_stroke_shader());
 
       std::cout << "\tFill Shader:" << sh.fill_shader()->tag() << "\n";
+      std::cout << "\tAnalytic Fill Shader:" << sh.analytic_fill_shader()->tag() << "\n";
     }
 
   m_painter_params = m_backend->configuration_gl();
@@ -97,6 +97,7 @@ private:
   command_line_argument_value<bool> m_uber_blend_use_switch;
   command_line_argument_value<bool> m_unpack_header_and_brush_in_frag_shader;
   command_line_argument_value<bool> m_separate_program_for_discard;
+  command_line_argument_value<bool> m_painter_stencil_clipping;
 
   /* Painter params that can be overridden by properties of GL context
    */
@@ -112,4 +113,5 @@ private:
 
   command_separator m_demo_options;
   command_line_argument_value<bool> m_print_painter_config;
+  command_line_argument_value<float> m_painter_curve_flatness;
 };
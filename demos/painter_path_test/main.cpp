@@ -1035,7 +1035,7 @@ draw_frame(void)
   update_cts_params();
 
   glClearColor(1.0f, 0.0f, 0.0f, 0.0f);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
   enable_wire_frame(m_wire_frame);
 
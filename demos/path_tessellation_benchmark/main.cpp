@@ -0,0 +1,620 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <math.h>
+
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/filled_path.hpp>
+#include <fastuidraw/stroked_path.hpp>
+#include <fastuidraw/path_tessellation_pool.hpp>
+#include <fastuidraw/painter/painter_analytic_fill_params.hpp>
+
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "read_path.hpp"
+
+using namespace fastuidraw;
+
+/* Micro-benchmark of path tessellation: for each path file,
+   times tessellating the edges of the path (i.e. the calls to
+   PathContour::interpolator_base::produce_tessellation()),
+   times constructing the TessellatedPath of the path and
+   times constructing the FilledPath of the TessellatedPath
+   with each FilledPath::triangulation_t, checking each
+   triangulation against the winding number of the path
+   computed by counting crossings of its contours, at the
+   centroid of each triangle and at a grid of sample points
+   within the bounding box. Also times constructing the PainterAnalyticFillParams
+   of the TessellatedPath, checking that its winding_number()
+   and compute_coverage() at the centroid of each triangle of
+   the FilledPath agree with the winding number of the triangle.
+   Also times constructing the StrokedPath of the
+   TessellatedPath together with its edge segments, checking
+   on the CPU, with StrokedPath::point::offset_vector(), that
+   the edge segments give the same stroked quads as the edges
+   of StrokedPath::edge_point_set. When a number of
+   threads is given, the TessellatedPath is constructed with a
+   PathTessellationPool and checked to be identical to the
+   TessellatedPath constructed on the calling thread only. Does
+   not create a window or a GL context.
+ */
+
+class command_line_list:
+  public command_line_argument,
+  public std::vector<std::string>
+{
+public:
+  command_line_list(const std::string &nm,
+                    const std::string &desc,
+                    command_line_register &p):
+    command_line_argument(p),
+    m_name(nm)
+  {
+    std::ostringstream ostr;
+    ostr << "\n\t" << m_name << " value"
+         << format_description_string(m_name, desc);
+    m_description = tabs_to_spaces(ostr.str());
+  }
+
+  virtual
+  int
+  check_arg(const std::vector<std::string> &argv, int location)
+  {
+    int argc(argv.size());
+    if(location + 1 < argc && argv[location] == m_name)
+      {
+        push_back(argv[location+1]);
+        std::cout << "\n\t" << m_name << " \""
+                  << argv[location+1] << "\" ";
+        return 2;
+      }
+    return 0;
+  }
+
+  virtual
+  void
+  print_command_line_description(std::ostream &ostr) const
+  {
+    ostr << "[" << m_name << " value] ";
+  }
+
+  virtual
+  void
+  print_detailed_description(std::ostream &ostr) const
+  {
+    ostr << m_description;
+  }
+
+private:
+  std::string m_name, m_description;
+};
+
+class path_tessellation_benchmark:public command_line_register
+{
+public:
+  path_tessellation_benchmark(void);
+
+  int
+  main(int argc, char **argv);
+
+private:
+  void
+  benchmark_path(const std::string &filename);
+
+  static
+  bool
+  same_tessellation(const TessellatedPath &a, const TessellatedPath &b);
+
+  static
+  bool
+  same_stroked_edges(const StrokedPath &stroked);
+
+  static
+  int
+  path_winding_number(const TessellatedPath &tess, const vec2 &p, double tolerance);
+
+  static
+  unsigned int
+  coverage_mismatches(const FilledPath &filled, const TessellatedPath &tess);
+
+  static
+  unsigned int
+  analytic_mismatches(PainterAnalyticFillParams &params, const FilledPath &filled);
+
+  int64_t
+  benchmark_fill(const TessellatedPath &tess, enum FilledPath::triangulation_t tri,
+                 unsigned int &number_indices,
+                 reference_counted_ptr<FilledPath> &filled);
+
+  command_line_list m_path_files;
+  command_line_argument_value<int> m_count;
+  command_line_argument_value<int> m_max_segments_per_edge;
+  command_line_argument_value<int> m_points_per_circle;
+  command_line_argument_value<int> m_number_threads;
+
+  TessellatedPath::TessellationParams m_params;
+  reference_counted_ptr<PathTessellationPool> m_pool;
+};
+
+path_tessellation_benchmark::
+path_tessellation_benchmark(void):
+  m_path_files("path_file", "add a file from which to read a path, "
+               "can be specified multiple times", *this),
+  m_count(1000, "count", "number of times to tessellate each path", *this),
+  m_max_segments_per_edge(32, "max_segs", "Max number of segments per edge", *this),
+  m_points_per_circle(60, "tess", "number of points per 2*PI curvature to attempt", *this),
+  m_number_threads(0, "num_threads", "if positive, number of worker threads of the "
+                   "PathTessellationPool passed to the ctor of TessellatedPath", *this)
+{}
+
+void
+path_tessellation_benchmark::
+benchmark_path(const std::string &filename)
+{
+  std::ifstream path_file(filename.c_str());
+  if(!path_file)
+    {
+      std::cout << filename << ": unable to open\n";
+      return;
+    }
+
+  std::stringstream buffer;
+  Path path;
+
+  buffer << path_file.rdbuf();
+  read_path(path, buffer.str());
+
+  std::vector<TessellatedPath::point> work_room(m_params.m_max_segments + 1);
+  c_array<TessellatedPath::point> work_room_array(&work_room[0], work_room.size());
+  unsigned int number_edges(0), number_points(0), count(m_count.m_value);
+  unsigned int glu_indices, sweep_indices;
+  float edge_distance;
+  int64_t edge_us, path_us, stroke_us, glu_us, sweep_us, analytic_us;
+  unsigned int glu_bad, sweep_bad, analytic_bad;
+  PainterAnalyticFillParams analytic;
+  reference_counted_ptr<TessellatedPath> tess;
+  reference_counted_ptr<StrokedPath> stroked;
+  reference_counted_ptr<FilledPath> glu_filled, sweep_filled;
+  simple_time timer;
+
+  for(unsigned int i = 0; i < count; ++i)
+    {
+      for(unsigned int o = 0, endo = path.number_contours(); o < endo; ++o)
+        {
+          reference_counted_ptr<const PathContour> contour(path.contour(o));
+          for(unsigned int e = 0, ende = contour->number_points(); e < ende; ++e)
+            {
+              number_points += contour->interpolator(e)->produce_tessellation(m_params, work_room_array,
+                                                                              &edge_distance);
+              ++number_edges;
+            }
+        }
+    }
+  edge_us = timer.restart_us();
+
+  for(unsigned int i = 0; i < count; ++i)
+    {
+      tess = FASTUIDRAWnew TessellatedPath(path, m_params, m_pool.get());
+    }
+  path_us = timer.restart_us();
+
+  if(m_pool && !same_tessellation(*tess, TessellatedPath(path, m_params)))
+    {
+      std::cout << filename << ": TessellatedPath constructed with "
+                << m_pool->number_threads() << " threads differs from the "
+                << "one constructed on a single thread\n";
+    }
+
+  for(unsigned int i = 0; i < count; ++i)
+    {
+      stroked = FASTUIDRAWnew StrokedPath(*tess);
+      stroked->points(StrokedPath::edge_segment_point_set, true);
+    }
+  stroke_us = timer.restart_us();
+
+  if(!same_stroked_edges(*stroked))
+    {
+      std::cout << filename << ": StrokedPath edge segments differ from "
+                << "the edges of StrokedPath::edge_point_set\n";
+    }
+
+  glu_us = benchmark_fill(*tess, FilledPath::glu_triangulation, glu_indices, glu_filled);
+  sweep_us = benchmark_fill(*tess, FilledPath::sweep_line_triangulation, sweep_indices, sweep_filled);
+
+  /* the triangulations are allowed to differ, so each is
+     checked against the path itself rather than against the
+     other; the GLU triangulation is known to be wrong on some
+     degenerate paths.
+   */
+  glu_bad = coverage_mismatches(*glu_filled, *tess);
+  if(glu_bad > 0)
+    {
+      std::cout << filename << ": FilledPath glu disagrees with the winding "
+                << "number of the path at " << glu_bad << " points\n";
+    }
+
+  sweep_bad = coverage_mismatches(*sweep_filled, *tess);
+  if(sweep_bad > 0)
+    {
+      std::cout << filename << ": FilledPath sweep-line disagrees with the winding "
+                << "number of the path at " << sweep_bad << " points\n";
+    }
+
+  timer.restart();
+  for(unsigned int i = 0; i < count; ++i)
+    {
+      analytic.path(*tess);
+    }
+  analytic_us = timer.restart_us();
+
+  analytic_bad = analytic_mismatches(analytic, *sweep_filled);
+  if(analytic_bad > 0)
+    {
+      std::cout << filename << ": PainterAnalyticFillParams disagrees with the "
+                << "winding number of " << analytic_bad << " FilledPath triangles\n";
+    }
+
+  std::cout << filename << ": edges = " << number_edges / count
+            << ", points = " << number_points / count
+            << ", edges: " << static_cast<double>(edge_us) / static_cast<double>(count)
+            << " us/path, TessellatedPath: " << static_cast<double>(path_us) / static_cast<double>(count)
+            << " us/path, StrokedPath edge segments: "
+            << static_cast<double>(stroke_us) / static_cast<double>(count)
+            << " us/path\n\tFilledPath glu: " << static_cast<double>(glu_us) / static_cast<double>(count)
+            << " us/path (" << glu_indices << " indices), FilledPath sweep-line: "
+            << static_cast<double>(sweep_us) / static_cast<double>(count)
+            << " us/path (" << sweep_indices << " indices)\n\tPainterAnalyticFillParams: "
+            << static_cast<double>(analytic_us) / static_cast<double>(count)
+            << " us/path (" << analytic.number_segments() << " segments, "
+            << analytic.number_bands() << " bands)\n";
+}
+
+bool
+path_tessellation_benchmark::
+same_tessellation(const TessellatedPath &a, const TessellatedPath &b)
+{
+  const_c_array<TessellatedPath::point> pa(a.point_data()), pb(b.point_data());
+
+  if(pa.size() != pb.size() || a.number_contours() != b.number_contours())
+    {
+      return false;
+    }
+
+  for(unsigned int o = 0, endo = a.number_contours(); o < endo; ++o)
+    {
+      if(a.number_edges(o) != b.number_edges(o))
+        {
+          return false;
+        }
+      for(unsigned int e = 0, ende = a.number_edges(o); e < ende; ++e)
+        {
+          if(a.edge_range(o, e).m_begin != b.edge_range(o, e).m_begin
+             || a.edge_range(o, e).m_end != b.edge_range(o, e).m_end)
+            {
+              return false;
+            }
+        }
+    }
+
+  for(unsigned int i = 0; i < pa.size(); ++i)
+    {
+      if(pa[i].m_p != pb[i].m_p
+         || pa[i].m_p_t != pb[i].m_p_t
+         || pa[i].m_distance_from_edge_start != pb[i].m_distance_from_edge_start
+         || pa[i].m_distance_from_contour_start != pb[i].m_distance_from_contour_start
+         || pa[i].m_edge_length != pb[i].m_edge_length
+         || pa[i].m_open_contour_length != pb[i].m_open_contour_length
+         || pa[i].m_closed_contour_length != pb[i].m_closed_contour_length)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+path_tessellation_benchmark::
+same_stroked_edges(const StrokedPath &stroked)
+{
+  const_c_array<StrokedPath::point> edges(stroked.points(StrokedPath::edge_point_set, true));
+  const_c_array<StrokedPath::point> segs(stroked.points(StrokedPath::edge_segment_point_set, true));
+  unsigned int s(0);
+  /* the tolerance StrokedPath uses to drop sub-edges of zero length */
+  const float tol(0.000001f);
+  const float width(2.0f);
+
+  /* each sub-edge of non-zero length is 6 points in the edges,
+     (p, n), (p, -n), (p, 0), (q, n), (q, -n), (q, 0), and 4 points
+     in the edge segments, (p, n), (p, -n), (q, n), (q, -n), both
+     in the same order; the stroked positions and depths of the
+     points must match.
+   */
+  for(unsigned int e = 0; e + 5 < edges.size(); e += 6)
+    {
+      const unsigned int corners[4] = { 0, 1, 3, 4 };
+
+      if(edges[e].m_auxilary_offset.magnitudeSq() < tol * tol)
+        {
+          continue;
+        }
+
+      if(s + 3 >= segs.size())
+        {
+          return false;
+        }
+
+      for(unsigned int k = 0; k < 4; ++k)
+        {
+          const StrokedPath::point &a(edges[e + corners[k]]), &b(segs[s + k]);
+          vec2 pa, pb;
+
+          pa = a.m_position + 0.5f * width * a.offset_vector();
+          pb = b.m_position + 0.5f * width * b.offset_vector();
+          if((pa - pb).magnitude() > 1e-4f * std::max(1.0f, a.m_position.magnitude())
+             || a.depth() != b.depth())
+            {
+              return false;
+            }
+        }
+      s += 4;
+    }
+  return s == segs.size();
+}
+
+int
+path_tessellation_benchmark::
+path_winding_number(const TessellatedPath &tess, const vec2 &p, double tolerance)
+{
+  /* returns -1 if p is within tolerance of a contour, where
+     rounding of the triangulation decides the answer.
+   */
+  double px(p.x()), py(p.y());
+  int winding(0);
+
+  for(unsigned int o = 0, endo = tess.number_contours(); o < endo; ++o)
+    {
+      const_c_array<TessellatedPath::point> pts(tess.contour_point_data(o));
+      for(unsigned int i = 0, endi = pts.size(); i < endi; ++i)
+        {
+          const vec2 &fa(pts[i].m_p), &fb(pts[(i + 1 == endi) ? 0 : i + 1].m_p);
+          double ax(fa.x()), ay(fa.y()), bx(fb.x()), by(fb.y());
+          double dx(bx - ax), dy(by - ay), len_sq(dx * dx + dy * dy), t, cross;
+
+          t = (len_sq > 0.0) ? ((px - ax) * dx + (py - ay) * dy) / len_sq : 0.0;
+          t = std::max(0.0, std::min(1.0, t));
+          if(std::abs(ax + t * dx - px) <= tolerance && std::abs(ay + t * dy - py) <= tolerance)
+            {
+              return -1;
+            }
+
+          cross = dx * (py - ay) - dy * (px - ax);
+          if(ay <= py && by > py && cross > 0.0)
+            {
+              ++winding;
+            }
+          else if(ay > py && by <= py && cross < 0.0)
+            {
+              --winding;
+            }
+        }
+    }
+  return std::abs(winding);
+}
+
+unsigned int
+path_tessellation_benchmark::
+coverage_mismatches(const FilledPath &filled, const TessellatedPath &tess)
+{
+  /* the winding numbers are compared by absolute value, since
+     the sign depends on the orientation of the contours
+   */
+  const_c_array<vec2> pts(filled.points());
+  const_c_array<int> windings(filled.winding_numbers());
+  const unsigned int grid(32);
+  vec2 box_min(tess.bounding_box_min()), box_size(tess.bounding_box_size());
+  double tolerance;
+  std::vector<vec2> samples;
+  std::vector<int> found, count;
+  std::vector<bool> skip;
+  unsigned int return_value(0);
+
+  tolerance = 1e-5 * (t_abs(box_min.x()) + t_abs(box_min.y())
+                      + box_size.x() + box_size.y() + 1.0);
+
+  /* the grid is offset by irrational fractions of a cell so
+     that its points do not line up with the path
+   */
+  for(unsigned int y = 0; y < grid; ++y)
+    {
+      for(unsigned int x = 0; x < grid; ++x)
+        {
+          samples.push_back(box_min + box_size * vec2((x + 0.381966f) / grid, (y + 0.236068f) / grid));
+        }
+    }
+  found.resize(samples.size(), 0);
+  count.resize(samples.size(), 0);
+  skip.resize(samples.size(), false);
+
+  for(unsigned int w = 0; w < windings.size(); ++w)
+    {
+      const_c_array<unsigned int> indices(filled.indices(windings[w]));
+      if(windings[w] == 0)
+        {
+          continue;
+        }
+
+      for(unsigned int i = 0; i + 2 < indices.size(); i += 3)
+        {
+          vec2 p(pts[indices[i]]), q(pts[indices[i + 1]]), r(pts[indices[i + 2]]);
+          double area, perimeter, inradius, e0, e1, e2;
+          vec2 centroid;
+          int truth;
+
+          area = 0.5 * std::abs(static_cast<double>(q.x() - p.x()) * (r.y() - p.y())
+                                - static_cast<double>(q.y() - p.y()) * (r.x() - p.x()));
+          perimeter = (q - p).magnitude() + (r - q).magnitude() + (p - r).magnitude();
+          inradius = (perimeter > 0.0) ? 2.0 * area / perimeter : 0.0;
+          centroid = (p + q + r) / 3.0f;
+          e0 = tolerance * (q - p).magnitude();
+          e1 = tolerance * (r - q).magnitude();
+          e2 = tolerance * (p - r).magnitude();
+
+          /* the centroid of a sliver is too close to its sides
+             for the rounding of the triangulation to be ignored
+           */
+          truth = (inradius > tolerance) ? path_winding_number(tess, centroid, tolerance) : -1;
+          if(truth != -1 && truth != std::abs(windings[w]))
+            {
+              ++return_value;
+            }
+
+          for(unsigned int s = 0; s < samples.size(); ++s)
+            {
+              const vec2 &v(samples[s]);
+              double d0, d1, d2;
+
+              d0 = static_cast<double>(q.x() - p.x()) * (v.y() - p.y()) - static_cast<double>(q.y() - p.y()) * (v.x() - p.x());
+              d1 = static_cast<double>(r.x() - q.x()) * (v.y() - q.y()) - static_cast<double>(r.y() - q.y()) * (v.x() - q.x());
+              d2 = static_cast<double>(p.x() - r.x()) * (v.y() - r.y()) - static_cast<double>(p.y() - r.y()) * (v.x() - r.x());
+              if((d0 > e0 && d1 > e1 && d2 > e2) || (d0 < -e0 && d1 < -e1 && d2 < -e2))
+                {
+                  found[s] = std::abs(windings[w]);
+                  ++count[s];
+                }
+              else if((d0 > -e0 && d1 > -e1 && d2 > -e2) || (d0 < e0 && d1 < e1 && d2 < e2))
+                {
+                  skip[s] = true;
+                }
+            }
+        }
+    }
+
+  /* a sample point must be covered once by a triangle with the
+     winding number of the path there, or not at all if that
+     winding number is zero; points near the path or on the side
+     of a triangle are skipped.
+   */
+  for(unsigned int s = 0; s < samples.size(); ++s)
+    {
+      int truth;
+
+      if(skip[s])
+        {
+          continue;
+        }
+      truth = path_winding_number(tess, samples[s], tolerance);
+      if(truth != -1 && (count[s] > 1 || found[s] != truth))
+        {
+          ++return_value;
+        }
+    }
+  return return_value;
+}
+
+unsigned int
+path_tessellation_benchmark::
+analytic_mismatches(PainterAnalyticFillParams &params, const FilledPath &filled)
+{
+  const_c_array<vec2> pts(filled.points());
+  const_c_array<int> windings(filled.winding_numbers());
+  unsigned int return_value(0);
+
+  params.fill_rule(PainterEnums::nonzero_fill_rule);
+  for(unsigned int w = 0; w < windings.size(); ++w)
+    {
+      const_c_array<unsigned int> indices(filled.indices(windings[w]));
+      for(unsigned int i = 0; i + 2 < indices.size(); i += 3)
+        {
+          vec2 p(pts[indices[i]]), q(pts[indices[i + 1]]), r(pts[indices[i + 2]]);
+          float area, perimeter, inradius, coverage;
+          vec2 centroid;
+
+          area = 0.5f * t_abs((q.x() - p.x()) * (r.y() - p.y()) - (q.y() - p.y()) * (r.x() - p.x()));
+          perimeter = (q - p).magnitude() + (r - q).magnitude() + (p - r).magnitude();
+          centroid = (p + q + r) / 3.0f;
+
+          /* the centroid is further than 2/3 of the inradius
+             from each side of the triangle, so with a pixel of
+             the size of the inradius no segment of the path is
+             within half a pixel of it and the coverage is exact.
+             Slivers whose inradius is below the precision of
+             the coordinates are skipped since rounding decides
+             on which side of an edge their centroid lies.
+           */
+          inradius = (perimeter > 0.0f) ? 2.0f * area / perimeter : 0.0f;
+          if(inradius <= 1e-4f * (t_abs(centroid.x()) + t_abs(centroid.y()) + 1.0f))
+            {
+              continue;
+            }
+          coverage = params.compute_coverage(centroid, vec2(1.0f / inradius, 1.0f / inradius));
+          if(params.winding_number(centroid) != windings[w]
+             || t_abs(coverage - ((windings[w] != 0) ? 1.0f : 0.0f)) > 1e-3f)
+            {
+              ++return_value;
+            }
+        }
+    }
+  return return_value;
+}
+
+int64_t
+path_tessellation_benchmark::
+benchmark_fill(const TessellatedPath &tess, enum FilledPath::triangulation_t tri,
+               unsigned int &number_indices,
+               reference_counted_ptr<FilledPath> &filled)
+{
+  simple_time timer;
+
+  for(unsigned int i = 0, count = m_count.m_value; i < count; ++i)
+    {
+      filled = FASTUIDRAWnew FilledPath(tess, tri);
+    }
+  number_indices = filled->nonzero_winding_indices().size()
+    + filled->zero_winding_indices().size();
+  return timer.restart_us();
+}
+
+int
+path_tessellation_benchmark::
+main(int argc, char **argv)
+{
+  if(argc == 2 && (std::string(argv[1]) == "-help" || std::string(argv[1]) == "--help"))
+    {
+      std::cout << "\n\nUsage: " << argv[0];
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+
+  std::cout << "\n\nRunning: \"";
+  for(int i = 0; i < argc; ++i)
+    {
+      std::cout << argv[i] << " ";
+    }
+  parse_command_line(argc, argv);
+  std::cout << "\n\n" << std::flush;
+
+  m_count.m_value = std::max(m_count.m_value, 1);
+  m_params.m_max_segments = m_max_segments_per_edge.m_value;
+  m_params.m_curve_tessellation = 2.0f * float(M_PI) / static_cast<float>(m_points_per_circle.m_value);
+  if(m_number_threads.m_value > 0)
+    {
+      m_pool = FASTUIDRAWnew PathTessellationPool(m_number_threads.m_value);
+    }
+
+  for(unsigned int i = 0; i < m_path_files.size(); ++i)
+    {
+      benchmark_path(m_path_files[i]);
+    }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  path_tessellation_benchmark B;
+  return B.main(argc, argv);
+}
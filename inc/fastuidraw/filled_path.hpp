@@ -27,6 +27,7 @@
 namespace fastuidraw  {
 
 class PainterAttributeData;
+class PainterAttributeDataHierarchy;
 class TessellatedPath;
 class Path;
 
@@ -40,17 +41,53 @@ class Path;
   the fill rule.
  */
 class FilledPath:
-    public reference_counted<FilledPath>::non_concurrent
+    public reference_counted<FilledPath>::atomic
 {
 public:
+  /*!
+    Enumeration to specify how the regions of a
+    FilledPath are triangulated.
+   */
+  enum triangulation_t
+    {
+      /*!
+        Triangulate with the GLU tessellator, i.e. a
+        half-edge mesh that is traversed once to find
+        the regions with non-zero winding number and
+        once to find the region with zero winding
+        number.
+       */
+      glu_triangulation,
+
+      /*!
+        Triangulate with a sweep-line trapezoidation
+        that finds the regions of all winding numbers
+        in one pass, with all edges allocated in one
+        array. It is faster than glu_triangulation, but
+        it creates more points since each trapezoid has
+        its own corners.
+       */
+      sweep_line_triangulation,
+    };
+
   /*!
     Ctor. Construct a FilledPath from the data
-    of a TessellatedPath.
+    of a TessellatedPath, triangulated as specified
+    by TessellatedPath::TessellationParams::m_fill_triangulation
+    of P.tessellation_parameters().
     \param P source TessellatedPath
    */
   explicit
   FilledPath(const TessellatedPath &P);
 
+  /*!
+    Ctor. Construct a FilledPath from the data
+    of a TessellatedPath.
+    \param P source TessellatedPath
+    \param tri how to triangulate the regions of P
+   */
+  FilledPath(const TessellatedPath &P, enum triangulation_t tri);
+
   ~FilledPath();
 
   /*!
@@ -118,6 +155,36 @@ public:
   const PainterAttributeData&
   painter_data(void) const;
 
+  /*!
+    Returns a PainterAttributeDataHierarchy that spatially
+    partitions the triangles of painter_data(). A Painter uses
+    it to send only those portions of the path that are near
+    the visible region when the path is filled.
+   */
+  const PainterAttributeDataHierarchy&
+  painter_data_hierarchy(void) const;
+
+  /*!
+    Returns the initial value of
+    TessellatedPath::TessellationParams::m_fill_triangulation.
+    Default value is glu_triangulation.
+   */
+  static
+  enum triangulation_t
+  default_triangulation(void);
+
+  /*!
+    Set the value returned by default_triangulation(void).
+    Only affects TessellatedPath::TessellationParams values
+    constructed afterwards, so it should be set before any
+    Path is created. The value is atomic, so it is safe to
+    set while a PathTessellationPool is working.
+    \param tri new value
+   */
+  static
+  void
+  default_triangulation(enum triangulation_t tri);
+
 private:
   void *m_d;
 };
@@ -374,6 +374,148 @@ namespace fastuidraw
         ConfigurationGL&
         separate_program_for_discard(bool v);
 
+        /*!
+          If true and if the GL context supports base vertex
+          draws (GL 3.2, GLES 3.2, GL_ARB_draw_elements_base_vertex,
+          GL_OES_draw_elements_base_vertex or
+          GL_EXT_draw_elements_base_vertex), then index data
+          is copied to the index buffer unchanged and draws
+          are issued with glMultiDrawElementsBaseVertex (or its
+          GLES equivalent), i.e. PainterBackend::ConfigurationBase::supports_base_vertex()
+          is true for the constructed PainterBackendGL.
+          Default value is true.
+         */
+        bool
+        use_base_vertex(void) const;
+
+        /*!
+          Set the value for use_base_vertex(void) const
+        */
+        ConfigurationGL&
+        use_base_vertex(bool v);
+
+        /*!
+          If true and if the GL context supports base instance
+          draws (GL 4.2, GL_ARB_base_instance or GL_EXT_base_instance),
+          then the header location of each vertex is not
+          replicated into a per-vertex attribute. Instead
+          the header attribute has an attribute divisor of
+          one, the header buffer holds one entry per header
+          and each range of indices sharing a header is
+          drawn with its own glDrawElementsInstancedBaseVertexBaseInstance
+          call whose base instance selects the header entry,
+          i.e. PainterBackend::ConfigurationBase::per_draw_header()
+          is true for the constructed PainterBackendGL. This
+          reduces the attribute data sent to GL at the cost
+          of issuing a GL draw call per item instead of per
+          glMultiDrawElements entry. Default value is false.
+         */
+        bool
+        use_per_draw_header(void) const;
+
+        /*!
+          Set the value for use_per_draw_header(void) const
+        */
+        ConfigurationGL&
+        use_per_draw_header(bool v);
+
+        /*!
+          Specifies the number of blocks at the start of each
+          data store buffer that are reserved as a persistent
+          region, i.e. the value for
+          PainterBackend::ConfigurationBase::persistent_store_blocks()
+          of the constructed PainterBackendGL. The value is
+          clamped to half of data_blocks_per_store_buffer()
+          (after it is clamped against the GL implementation
+          limits). A non-zero value makes the data store buffers
+          be mapped without invalidating their contents so
+          that the persistent region survives across frames;
+          on some GL implementations mapping without invalidate
+          may introduce stalls if number_pools() is too small.
+          Default value is 0.
+         */
+        unsigned int
+        persistent_store_blocks(void) const;
+
+        /*!
+          Set the value for persistent_store_blocks(void) const
+        */
+        ConfigurationGL&
+        persistent_store_blocks(unsigned int v);
+
+        /*!
+          If true, the sizes of the buffers backing the
+          PainterDraw objects returned by map_draw() adapt
+          to the amount of data drawn. After each
+          on_post_draw(), the sizes grow to fit the data of
+          the frame (with some headroom) or, if the frame used
+          much less than the buffers hold, shrink. The values
+          of attributes_per_buffer(), indices_per_buffer() and
+          data_blocks_per_store_buffer() are then the upper
+          bounds (and the initial sizes) and the values of
+          min_attributes_per_buffer(), min_indices_per_buffer()
+          and min_data_blocks_per_store_buffer() are the lower
+          bounds. If data_store_backing() is \ref data_store_ubo,
+          the data store size does not adapt because it is
+          part of the shader source. The sizes never shrink
+          below the largest chunk passed to ensure_room(), and
+          grow at once to fit such a chunk. The sizes chosen are
+          given by the PainterPacker::Stats of the PainterPacker
+          using the PainterBackendGL. Default value is false.
+         */
+        bool
+        adaptive_buffer_sizing(void) const;
+
+        /*!
+          Set the value for adaptive_buffer_sizing(void) const
+        */
+        ConfigurationGL&
+        adaptive_buffer_sizing(bool v);
+
+        /*!
+          Lower bound for the number of attributes per buffer
+          when adaptive_buffer_sizing() is true.
+          Default value is 4 * 1024.
+         */
+        unsigned int
+        min_attributes_per_buffer(void) const;
+
+        /*!
+          Set the value for min_attributes_per_buffer(void) const
+        */
+        ConfigurationGL&
+        min_attributes_per_buffer(unsigned int v);
+
+        /*!
+          Lower bound for the number of indices per buffer
+          when adaptive_buffer_sizing() is true.
+          Default value is 1.5 times the default value
+          of min_attributes_per_buffer().
+         */
+        unsigned int
+        min_indices_per_buffer(void) const;
+
+        /*!
+          Set the value for min_indices_per_buffer(void) const
+        */
+        ConfigurationGL&
+        min_indices_per_buffer(unsigned int v);
+
+        /*!
+          Lower bound for the number of data store blocks per
+          buffer when adaptive_buffer_sizing() is true. The
+          bound is raised to twice persistent_store_blocks()
+          if that is larger. Default value is 1024.
+         */
+        unsigned int
+        min_data_blocks_per_store_buffer(void) const;
+
+        /*!
+          Set the value for min_data_blocks_per_store_buffer(void) const
+        */
+        ConfigurationGL&
+        min_data_blocks_per_store_buffer(unsigned int v);
+
       private:
         void *m_d;
       };
@@ -408,6 +550,10 @@ namespace fastuidraw
       reference_counted_ptr<const PainterDraw>
       map_draw(void);
 
+      virtual
+      void
+      ensure_room(unsigned int attributes, unsigned int indices);
+
       /*!
         Return the specified Program use to draw
         with this PainterBackendGL.
@@ -0,0 +1,423 @@
+/*!
+ * \file painter_backend_null.hpp
+ * \brief file painter_backend_null.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/glsl/painter_backend_glsl.hpp>
+
+namespace fastuidraw
+{
+  namespace glsl
+  {
+/*!\addtogroup GLSLShaderBuilder
+  @{
+ */
+    /*!
+      A PainterBackendNull is a PainterBackend that does not
+      use any 3D API. The PainterDraw objects returned by
+      map_draw() are backed by host memory and drawing them
+      only records how much data was written to them together
+      with the draw breaks (see PainterDraw::draw_break())
+      they received. The shaders are absorbed exactly as
+      PainterBackendGLSL does, so the packing of data by a
+      Painter is identical to that of a GLSL based backend.
+      The intended use is to measure (and regression check)
+      the CPU cost of Painter and PainterPacker without a
+      GPU or windowing system present. A PainterBackendNull
+      supports PainterBackend::ConfigurationBase::supports_base_vertex(),
+      PainterBackend::ConfigurationBase::per_draw_header() and
+      PainterBackend::ConfigurationBase::stencil_clipping()
+      being true and supports a non-zero value for
+      PainterBackend::ConfigurationBase::persistent_store_blocks().
+     */
+    class PainterBackendNull:public PainterBackendGLSL
+    {
+    public:
+      /*!
+        A ConfigurationNull gives parameters how to contruct
+        a PainterBackendNull.
+       */
+      class ConfigurationNull
+      {
+      public:
+        /*!
+          Ctor.
+         */
+        ConfigurationNull(void);
+
+        /*!
+          Copy ctor.
+          \param obj value from which to copy
+         */
+        ConfigurationNull(const ConfigurationNull &obj);
+
+        ~ConfigurationNull();
+
+        /*!
+          Assignment operator
+          \param rhs value from which to copy
+         */
+        ConfigurationNull&
+        operator=(const ConfigurationNull &rhs);
+
+        /*!
+          The GlyphAtlas to be used by the painter. If the
+          value is NULL, then the PainterBackendNull will
+          create a GlyphAtlas whose backing stores are
+          in host memory. Default value is NULL.
+         */
+        const reference_counted_ptr<GlyphAtlas>&
+        glyph_atlas(void) const;
+
+        /*!
+          Set the value returned by glyph_atlas(void) const.
+         */
+        ConfigurationNull&
+        glyph_atlas(const reference_counted_ptr<GlyphAtlas> &v);
+
+        /*!
+          The ImageAtlas to be used by the painter. If the
+          value is NULL, then the PainterBackendNull will
+          create an ImageAtlas whose backing stores are
+          in host memory. Default value is NULL.
+         */
+        const reference_counted_ptr<ImageAtlas>&
+        image_atlas(void) const;
+
+        /*!
+          Set the value returned by image_atlas(void) const.
+         */
+        ConfigurationNull&
+        image_atlas(const reference_counted_ptr<ImageAtlas> &v);
+
+        /*!
+          The ColorStopAtlas to be used by the painter. If the
+          value is NULL, then the PainterBackendNull will
+          create a ColorStopAtlas whose backing store is
+          in host memory. Default value is NULL.
+         */
+        const reference_counted_ptr<ColorStopAtlas>&
+        colorstop_atlas(void) const;
+
+        /*!
+          Set the value returned by colorstop_atlas(void) const.
+         */
+        ConfigurationNull&
+        colorstop_atlas(const reference_counted_ptr<ColorStopAtlas> &v);
+
+        /*!
+          Specifies the maximum number of attributes
+          a PainterDraw returned by map_draw() may
+          store, i.e. the size of PainterDraw::m_attributes.
+          Initial value is 512 * 512.
+         */
+        unsigned int
+        attributes_per_buffer(void) const;
+
+        /*!
+          Set the value for attributes_per_buffer(void) const
+        */
+        ConfigurationNull&
+        attributes_per_buffer(unsigned int v);
+
+        /*!
+          Specifies the maximum number of indices
+          a PainterDraw returned by map_draw() may
+          store, i.e. the size of PainterDraw::m_indices.
+          Initial value is 1.5 times the initial value
+          for attributes_per_buffer(void) const.
+         */
+        unsigned int
+        indices_per_buffer(void) const;
+
+        /*!
+          Set the value for indices_per_buffer(void) const
+        */
+        ConfigurationNull&
+        indices_per_buffer(unsigned int v);
+
+        /*!
+          Specifies the maximum number of blocks of
+          data a PainterDraw returned by map_draw()
+          may store. The size of PainterDraw::m_store
+          is given by data_blocks_per_store_buffer() *
+          PainterBackend::ConfigurationBase::alignment(),
+          Initial value is 1024 * 64.
+         */
+        unsigned int
+        data_blocks_per_store_buffer(void) const;
+
+        /*!
+          Set the value for data_blocks_per_store_buffer(void) const
+        */
+        ConfigurationNull&
+        data_blocks_per_store_buffer(unsigned int v);
+
+        /*!
+          If true, each call to PainterDraw::draw_break() on
+          a PainterDraw returned by map_draw() is recorded
+          as a DrawBreak value, see draw_breaks(). If false,
+          only the number of draw breaks is recorded.
+          Default value is false.
+         */
+        bool
+        record_draw_breaks(void) const;
+
+        /*!
+          Set the value for record_draw_breaks(void) const
+        */
+        ConfigurationNull&
+        record_draw_breaks(bool v);
+
+        /*!
+          If true, the item and blend shaders of each unique
+          PainterShader::ID() are placed into their own
+          shader group (see PainterShader::group()), thus
+          a change of shader triggers a draw break just
+          as PainterBackendGL does with
+          PainterBackendGL::ConfigurationGL::break_on_shader_change().
+          Default value is false.
+         */
+        bool
+        break_on_shader_change(void) const;
+
+        /*!
+          Set the value for break_on_shader_change(void) const
+        */
+        ConfigurationNull&
+        break_on_shader_change(bool v);
+
+      private:
+        void *m_d;
+      };
+
+      /*!
+        A DrawBreak records the values passed to
+        PainterDraw::draw_break() of a PainterDraw
+        returned by map_draw().
+       */
+      class DrawBreak
+      {
+      public:
+        /*!
+          Value of PainterShaderGroup::item_group() of
+          the old and new groups, [0] for the old
+          value and [1] for the new value.
+         */
+        uvec2 m_item_group;
+
+        /*!
+          Value of PainterShaderGroup::blend_group() of
+          the old and new groups, [0] for the old
+          value and [1] for the new value.
+         */
+        uvec2 m_blend_group;
+
+        /*!
+          Value of PainterShaderGroup::brush() of
+          the old and new groups, [0] for the old
+          value and [1] for the new value.
+         */
+        uvec2 m_brush;
+
+        /*!
+          Value of PainterShaderGroup::packed_blend_mode()
+          of the old and new groups, [0] for the old value
+          and [1] for the new value.
+         */
+        vecN<BlendMode::packed_value, 2> m_blend_mode;
+
+        /*!
+          Number of attributes written before the draw break.
+         */
+        unsigned int m_attributes_written;
+
+        /*!
+          Number of indices written before the draw break.
+         */
+        unsigned int m_indices_written;
+
+        /*!
+          Value of DrawStats::m_number_draws at the time
+          the PainterDraw that received the draw break
+          was drawn.
+         */
+        unsigned int m_draw;
+      };
+
+      /*!
+        A DrawStats gives the accumulated amount of data
+        that was drawn by the PainterDraw objects returned
+        by map_draw().
+       */
+      class DrawStats
+      {
+      public:
+        /*!
+          Ctor, initializes all counters as 0.
+         */
+        DrawStats(void):
+          m_number_flushes(0),
+          m_number_draws(0),
+          m_number_draw_breaks(0),
+          m_number_base_vertex_changes(0),
+          m_attributes_written(0),
+          m_indices_written(0),
+          m_data_store_written(0),
+          m_attribute_bytes(0),
+          m_header_attribute_bytes(0),
+          m_index_bytes(0),
+          m_data_store_bytes(0)
+        {}
+
+        /*!
+          Number of on_pre_draw()/on_post_draw() pairs.
+         */
+        uint64_t m_number_flushes;
+
+        /*!
+          Number of times PainterDraw::draw() was called.
+         */
+        uint64_t m_number_draws;
+
+        /*!
+          Number of times PainterDraw::draw_break() was
+          called on PainterDraw objects that were drawn.
+         */
+        uint64_t m_number_draw_breaks;
+
+        /*!
+          Number of times PainterDraw::base_vertex_change()
+          was called on PainterDraw objects that were drawn.
+         */
+        uint64_t m_number_base_vertex_changes;
+
+        /*!
+          Number of PainterAttribute values drawn.
+         */
+        uint64_t m_attributes_written;
+
+        /*!
+          Number of PainterIndex values drawn.
+         */
+        uint64_t m_indices_written;
+
+        /*!
+          Number of generic_data values written to
+          PainterDraw::m_store of the PainterDraw objects
+          drawn.
+         */
+        uint64_t m_data_store_written;
+
+        /*!
+          Number of bytes of PainterDraw::m_attributes drawn.
+         */
+        uint64_t m_attribute_bytes;
+
+        /*!
+          Number of bytes of PainterDraw::m_header_attributes drawn.
+         */
+        uint64_t m_header_attribute_bytes;
+
+        /*!
+          Number of bytes of PainterDraw::m_indices drawn.
+         */
+        uint64_t m_index_bytes;
+
+        /*!
+          Number of bytes of PainterDraw::m_store drawn.
+         */
+        uint64_t m_data_store_bytes;
+      };
+
+      /*!
+        Ctor.
+        \param config_null ConfigurationNull providing configuration parameters
+        \param config_glsl ConfigurationGLSL providing configuration parameters
+        \param config_base ConfigurationBase parameters inherited from PainterBackend
+       */
+      PainterBackendNull(const ConfigurationNull &config_null = ConfigurationNull(),
+                         const ConfigurationGLSL &config_glsl = ConfigurationGLSL(),
+                         const ConfigurationBase &config_base = ConfigurationBase());
+
+      ~PainterBackendNull();
+
+      /*!
+        Returns the ConfigurationNull passed in the ctor,
+        with the atlas values set to the atlases used.
+       */
+      const ConfigurationNull&
+      configuration_null(void) const;
+
+      /*!
+        Returns the data accumulated since construction
+        or the last call to reset_stats().
+       */
+      const DrawStats&
+      stats(void) const;
+
+      /*!
+        Returns the draw breaks recorded since construction
+        or the last call to reset_stats(). Draw breaks are
+        recorded only if ConfigurationNull::record_draw_breaks()
+        is true and are recorded when the PainterDraw that
+        received them is drawn.
+       */
+      const_c_array<DrawBreak>
+      draw_breaks(void) const;
+
+      /*!
+        Resets the values returned by stats() and draw_breaks().
+       */
+      void
+      reset_stats(void);
+
+      //////////////////////////////////////////////////////////////
+      // virtual methods from PainterBackend
+      virtual
+      void
+      on_pre_draw(void);
+
+      virtual
+      void
+      on_post_draw(void);
+
+      virtual
+      reference_counted_ptr<const PainterDraw>
+      map_draw(void);
+
+    protected:
+      //////////////////////////////////////////////////////////////
+      // virtual methods from PainterBackendGLSL
+      virtual
+      uint32_t
+      compute_item_shader_group(PainterShader::Tag tag,
+                                const reference_counted_ptr<PainterItemShader> &shader);
+
+      virtual
+      uint32_t
+      compute_blend_shader_group(PainterShader::Tag tag,
+                                 const reference_counted_ptr<PainterBlendShader> &shader);
+
+    private:
+      void *m_d;
+    };
+/*! @} */
+  }
+}
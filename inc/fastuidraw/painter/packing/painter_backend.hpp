@@ -99,6 +99,101 @@ namespace fastuidraw
       ConfigurationBase&
       alignment(int v);
 
+      /*!
+        If true, the PainterDraw objects returned by
+        PainterBackend::map_draw() implement
+        PainterDraw::base_vertex_change() and the
+        index data of PainterDraw::m_indices is
+        taken relative to the base vertex of the
+        draw. In this case, a PainterPacker copies
+        index data unchanged instead of adding the
+        offset of where the attribute data is
+        placed in PainterDraw::m_attributes.
+       */
+      bool
+      supports_base_vertex(void) const;
+
+      /*!
+        Specify the value returned by supports_base_vertex(void) const,
+        default value is false
+        \param v value
+       */
+      ConfigurationBase&
+      supports_base_vertex(bool v);
+
+      /*!
+        If true, the PainterDraw objects returned by
+        PainterBackend::map_draw() implement
+        PainterDraw::header_change() and the header location
+        of the vertices is given per sub-draw instead of
+        per vertex: a PainterPacker writes one element to
+        PainterDraw::m_header_attributes for each header
+        it packs (rather than one element per attribute)
+        and calls PainterDraw::header_change() to mark
+        which index range uses which header.
+       */
+      bool
+      per_draw_header(void) const;
+
+      /*!
+        Specify the value returned by per_draw_header(void) const,
+        default value is false
+        \param v value
+       */
+      ConfigurationBase&
+      per_draw_header(bool v);
+
+      /*!
+        If non-zero, the first persistent_store_blocks()
+        blocks (a block being alignment() generic_data
+        values) of PainterDraw::m_store of each PainterDraw
+        returned by map_draw() form a persistent region.
+        When the data of a PainterPackedValue is used by a
+        second PainterDraw, a PainterPacker allocates it into
+        the persistent region once and from then on references
+        it directly instead of copying the data into each
+        PainterDraw that uses it; values used by only one
+        PainterDraw (for example per-draw transformations) are
+        only copied into that PainterDraw. The backend is
+        responsible for retaining the contents of the
+        persistent region across PainterDraw objects, see
+        PainterDraw::persistent_store_version() and
+        PainterDraw::persistent_store_written().
+       */
+      unsigned int
+      persistent_store_blocks(void) const;
+
+      /*!
+        Specify the value returned by persistent_store_blocks(void) const,
+        default value is 0
+        \param v value
+       */
+      ConfigurationBase&
+      persistent_store_blocks(unsigned int v);
+
+      /*!
+        If true, Painter implements Painter::clipInPath() and
+        Painter::clipOutPath() with the stencil buffer instead
+        of with depth occluders: each level of path clipping
+        is a stencil value and the PainterDraw objects returned
+        by PainterBackend::map_draw() must honor the values of
+        PainterShaderGroup::stencil_ref() and
+        PainterShaderGroup::stencil_action() passed to
+        PainterDraw::draw_break(). The stencil buffer must have
+        at least 8 bits and be cleared to 0 before
+        Painter::begin(); it is 0 again after Painter::end().
+       */
+      bool
+      stencil_clipping(void) const;
+
+      /*!
+        Specify the value returned by stencil_clipping(void) const,
+        default value is false
+        \param v value
+       */
+      ConfigurationBase&
+      stencil_clipping(bool v);
+
     private:
       void *m_d;
     };
@@ -221,6 +316,22 @@ namespace fastuidraw
     reference_counted_ptr<const PainterDraw>
     map_draw(void) = 0;
 
+    /*!
+      Called by a PainterPacker just before map_draw() when
+      the new PainterDraw is needed to hold a chunk of
+      attribute and index data that did not fit into the
+      current one. A PainterBackend whose PainterDraw sizes
+      change over time should, when it can, return from
+      map_draw() a PainterDraw with at least this much room
+      from now on, so that the chunk is not dropped. Default
+      implementation does nothing.
+      \param attributes number of attributes of the chunk
+      \param indices number of indices of the chunk
+     */
+    virtual
+    void
+    ensure_room(unsigned int attributes, unsigned int indices);
+
     /*!
       Registers a vertex shader for use. Must not be called within a
       on_pre_draw()/on_post_draw() pair.
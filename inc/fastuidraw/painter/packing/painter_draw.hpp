@@ -95,6 +95,10 @@ namespace fastuidraw
       \ref m_header_attributes must be the same
       as the size of \ref m_attributes,
       the store is understood to be write only.
+      If PainterBackend::ConfigurationBase::per_draw_header()
+      is true, then the store holds one element per
+      header, see header_change(), instead of one
+      element per attribute.
      */
     c_array<uint32_t> m_header_attributes;
 
@@ -141,6 +145,83 @@ namespace fastuidraw
                unsigned int attributes_written,
                unsigned int indices_written) const = 0;
 
+    /*!
+      Called to indicate that the index values written
+      to \ref m_indices from indices_written onwards are
+      relative to base_vertex, i.e. an index value I
+      refers to the attribute at m_attributes[I + base_vertex].
+      The base vertex is 0 until the first call to
+      base_vertex_change(). A PainterPacker only calls
+      base_vertex_change() if the PainterBackend that
+      created the PainterDraw has
+      PainterBackend::ConfigurationBase::supports_base_vertex()
+      as true; a derived class whose backend sets that
+      value must implement this method. Default
+      implementation asserts.
+      \param base_vertex value added to index values at draw
+      \param indices_written total number of indices written to m_indices -before- the change
+     */
+    virtual
+    void
+    base_vertex_change(unsigned int base_vertex,
+                       unsigned int indices_written) const;
+
+    /*!
+      Called to indicate that the indices written to
+      \ref m_indices from indices_written onwards are of
+      vertices whose header location is the value at
+      m_header_attributes[header_entry]. A PainterPacker
+      only calls header_change() if the PainterBackend that
+      created the PainterDraw has
+      PainterBackend::ConfigurationBase::per_draw_header()
+      as true; a derived class whose backend sets that
+      value must implement this method. Default
+      implementation asserts.
+      \param header_entry index into \ref m_header_attributes of the header location
+      \param indices_written total number of indices written to m_indices -before- the change
+     */
+    virtual
+    void
+    header_change(unsigned int header_entry,
+                  unsigned int indices_written) const;
+
+    /*!
+      Returns the version of the persistent region of
+      \ref m_store (see
+      PainterBackend::ConfigurationBase::persistent_store_blocks())
+      that the buffer backing this PainterDraw holds, i.e.
+      the value last passed to persistent_store_written()
+      on a PainterDraw that shares the same backing buffer.
+      A return value of 0 indicates that the backing holds
+      no persistent data. A PainterPacker only calls
+      persistent_store_version() if the PainterBackend that
+      created the PainterDraw has
+      PainterBackend::ConfigurationBase::persistent_store_blocks()
+      non-zero. Default implementation returns 0.
+     */
+    virtual
+    unsigned int
+    persistent_store_version(void) const;
+
+    /*!
+      Called by a PainterPacker after it wrote to the
+      persistent region of \ref m_store to indicate that
+      the persistent region of the buffer backing this
+      PainterDraw is now at the given version. Only the
+      blocks in the given range were written, the other
+      blocks of the persistent region are unchanged from
+      the version given by persistent_store_version().
+      Default implementation does nothing.
+      \param version new version of the persistent region
+      \param blocks range of blocks (a block being
+                    PainterBackend::ConfigurationBase::alignment()
+                    generic_data values) of \ref m_store written
+     */
+    virtual
+    void
+    persistent_store_written(unsigned int version,
+                             range_type<unsigned int> blocks) const;
+
     /*!
       Adds a delayed action to the action list.
       \param h handle to action to add.
@@ -79,6 +79,316 @@ namespace fastuidraw
       header_added(const PainterHeader &original_value, c_array<generic_data> mapped_location) = 0;
     };
 
+    /*!
+      A Stats gives counters of how a PainterPacker packed
+      the data of its draws between begin() and end(). The
+      values are reset on begin().
+     */
+    class Stats
+    {
+    public:
+      /*!
+        Ctor, initializes all counters as 0.
+       */
+      Stats(void):
+        m_number_draws(0),
+        m_new_draw_attribute_room(0),
+        m_new_draw_index_room(0),
+        m_new_draw_store_room(0),
+        m_new_draw_header_room(0),
+        m_draw_breaks(0),
+        m_draw_breaks_item_group(0),
+        m_draw_breaks_blend_group(0),
+        m_draw_breaks_brush(0),
+        m_draw_breaks_blend_mode(0),
+        m_draw_breaks_stencil(0),
+        m_draw_breaks_eliminated(0),
+        m_attribute_bytes(0),
+        m_header_attribute_bytes(0),
+        m_index_bytes(0),
+        m_data_store_bytes(0),
+        m_packed_value_cache_hits(0),
+        m_packed_value_cache_misses(0),
+        m_packed_value_persistent_hits(0),
+        m_persistent_store_bytes(0),
+        m_attributes_per_draw(0),
+        m_indices_per_draw(0),
+        m_store_blocks_per_draw(0),
+        m_draw_size_changes(0)
+      {}
+
+      /*!
+        Number of PainterDraw objects mapped with
+        PainterBackend::map_draw().
+       */
+      uint64_t m_number_draws;
+
+      /*!
+        Number of times a new PainterDraw was mapped because
+        PainterDraw::m_attributes did not have enough room.
+       */
+      uint64_t m_new_draw_attribute_room;
+
+      /*!
+        Number of times a new PainterDraw was mapped because
+        PainterDraw::m_indices did not have enough room.
+       */
+      uint64_t m_new_draw_index_room;
+
+      /*!
+        Number of times a new PainterDraw was mapped because
+        PainterDraw::m_store did not have enough room.
+       */
+      uint64_t m_new_draw_store_room;
+
+      /*!
+        Number of times a new PainterDraw was mapped because
+        PainterDraw::m_header_attributes did not have enough
+        room, which only happens when
+        PainterBackend::ConfigurationBase::per_draw_header()
+        is true.
+       */
+      uint64_t m_new_draw_header_room;
+
+      /*!
+        Number of times PainterDraw::draw_break() was called.
+       */
+      uint64_t m_draw_breaks;
+
+      /*!
+        Number of calls to PainterDraw::draw_break() where
+        PainterShaderGroup::item_group() changed.
+       */
+      uint64_t m_draw_breaks_item_group;
+
+      /*!
+        Number of calls to PainterDraw::draw_break() where
+        PainterShaderGroup::blend_group() changed.
+       */
+      uint64_t m_draw_breaks_blend_group;
+
+      /*!
+        Number of calls to PainterDraw::draw_break() where
+        PainterShaderGroup::brush() changed in the bits of
+        PainterBackend::ConfigurationBase::brush_shader_mask().
+       */
+      uint64_t m_draw_breaks_brush;
+
+      /*!
+        Number of calls to PainterDraw::draw_break() where
+        PainterShaderGroup::packed_blend_mode() changed.
+       */
+      uint64_t m_draw_breaks_blend_mode;
+
+      /*!
+        Number of calls to PainterDraw::draw_break() where
+        PainterShaderGroup::stencil_ref() or
+        PainterShaderGroup::stencil_action() changed.
+       */
+      uint64_t m_draw_breaks_stencil;
+
+      /*!
+        Number of draw breaks removed by reordering draws,
+        see draw_reorder_window().
+       */
+      uint64_t m_draw_breaks_eliminated;
+
+      /*!
+        Number of bytes written to PainterDraw::m_attributes.
+       */
+      uint64_t m_attribute_bytes;
+
+      /*!
+        Number of bytes written to PainterDraw::m_header_attributes.
+       */
+      uint64_t m_header_attribute_bytes;
+
+      /*!
+        Number of bytes written to PainterDraw::m_indices.
+       */
+      uint64_t m_index_bytes;
+
+      /*!
+        Number of bytes written to PainterDraw::m_store,
+        not including the persistent region (see
+        m_persistent_store_bytes).
+       */
+      uint64_t m_data_store_bytes;
+
+      /*!
+        Number of times the data of a PainterPackedValue
+        was already in the PainterDraw::m_store of the
+        current PainterDraw and was not packed again.
+       */
+      uint64_t m_packed_value_cache_hits;
+
+      /*!
+        Number of times the data of a PainterPackedValue
+        was copied to PainterDraw::m_store.
+       */
+      uint64_t m_packed_value_cache_misses;
+
+      /*!
+        Number of times the data of a PainterPackedValue
+        was referenced from the persistent region of
+        PainterDraw::m_store (see
+        PainterBackend::ConfigurationBase::persistent_store_blocks())
+        and thus was not copied.
+       */
+      uint64_t m_packed_value_persistent_hits;
+
+      /*!
+        Number of bytes written to the persistent region
+        of PainterDraw::m_store to bring the persistent
+        region of the buffer backing each PainterDraw
+        up to date.
+       */
+      uint64_t m_persistent_store_bytes;
+
+      /*!
+        Size of PainterDraw::m_attributes of the last
+        PainterDraw mapped. The size is fixed unless the
+        PainterBackend adapts its buffer sizes to the amount
+        of data drawn (see PainterBackend::ensure_room()).
+       */
+      uint64_t m_attributes_per_draw;
+
+      /*!
+        Size of PainterDraw::m_indices of the last
+        PainterDraw mapped.
+       */
+      uint64_t m_indices_per_draw;
+
+      /*!
+        Size of PainterDraw::m_store of the last PainterDraw
+        mapped in blocks, a block being
+        PainterBackend::ConfigurationBase::alignment()
+        generic_data values.
+       */
+      uint64_t m_store_blocks_per_draw;
+
+      /*!
+        Number of times a PainterDraw was mapped whose sizes
+        differ from those of the PainterDraw mapped before it.
+       */
+      uint64_t m_draw_size_changes;
+    };
+
+    /*!
+      A CommandList records draw_generic() calls into its own
+      attribute, index and data store buffers so that the draws
+      can later be added to a PainterPacker in one go with
+      PainterPacker::draw_command_list(). A CommandList does
+      not access the PainterPacker that created it after its
+      ctor, thus different CommandList objects can be recorded
+      from different threads simultaneously (and while the
+      PainterPacker is drawing). A single CommandList object
+      is NOT thread safe. Because recording reads (but does not
+      copy) the PainterPackedValue objects of the
+      PainterPackerData passed, those values must stay alive
+      and unmodified for the duration of the recording call.
+     */
+    class CommandList:fastuidraw::noncopyable
+    {
+    public:
+      /*!
+        Ctor.
+        \param packer PainterPacker whose data packing
+                      parameters to use; the list may only
+                      be drawn by the same PainterPacker.
+       */
+      explicit
+      CommandList(const PainterPacker &packer);
+
+      ~CommandList();
+
+      /*!
+        Set the blend shader for the draws that follow. If
+        the blend shader is never set on a CommandList, its
+        draws use the blend shader of the PainterPacker
+        active when the list is drawn by
+        PainterPacker::draw_command_list().
+        \param h blend shader to use for blending, must not be NULL.
+        \param packed_blend_mode 3D API blend mode packed via BlendMode::packed().
+       */
+      void
+      blend_shader(const reference_counted_ptr<PainterBlendShader> &h,
+                   BlendMode::packed_value packed_blend_mode);
+
+      /*!
+        Record drawing of generic attribute data, see
+        PainterPacker::draw_generic() for the meaning of
+        the arguments.
+       */
+      void
+      draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+                   const PainterPackerData &data,
+                   const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+                   const_c_array<const_c_array<PainterIndex> > index_chunks,
+                   unsigned int z);
+
+      /*!
+        Record drawing of generic attribute data, see
+        PainterPacker::draw_generic() for the meaning of
+        the arguments.
+       */
+      void
+      draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+                   const PainterPackerData &data,
+                   const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+                   const_c_array<const_c_array<PainterIndex> > index_chunks,
+                   const_c_array<unsigned int> attrib_chunk_selector,
+                   unsigned int z);
+
+      /*!
+        Record drawing of generic attribute data whose item
+        matrix and clip equations are not recorded; instead,
+        when the list is drawn with the overload of
+        PainterPacker::draw_command_list() taking item
+        matrices, the draw uses the item matrix at index
+        matrix_slot and the clip equations passed there.
+        The values of PainterPackerData::m_matrix and
+        PainterPackerData::m_clip of data are ignored. See
+        PainterPacker::draw_generic() for the meaning of the
+        other arguments.
+        \param matrix_slot index into the array of item matrices
+                           passed to PainterPacker::draw_command_list()
+       */
+      void
+      draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+                   const PainterPackerData &data,
+                   const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+                   const_c_array<const_c_array<PainterIndex> > index_chunks,
+                   const_c_array<unsigned int> attrib_chunk_selector,
+                   unsigned int z, unsigned int matrix_slot);
+
+      /*!
+        Returns the number of draws recorded.
+       */
+      unsigned int
+      number_draws(void) const;
+
+      /*!
+        Returns one more than the largest matrix slot
+        passed to a draw_generic() call taking a matrix
+        slot, i.e. the number of item matrices that must
+        be passed to PainterPacker::draw_command_list().
+       */
+      unsigned int
+      number_matrix_slots(void) const;
+
+      /*!
+        Remove all recorded draws; the memory of the
+        buffers is kept for future recording.
+       */
+      void
+      clear(void);
+
+    private:
+      friend class PainterPacker;
+      void *m_d;
+    };
+
     /*!
       Ctor.
       \param backend handle to PainterBackend for the constructed PainterPacker
@@ -136,6 +446,89 @@ namespace fastuidraw
     blend_shader(const reference_counted_ptr<PainterBlendShader> &h,
                  BlendMode::packed_value packed_blend_mode);
 
+    /*!
+      Returns the active stencil reference value,
+      see stencil_state().
+     */
+    uint32_t
+    stencil_ref(void) const;
+
+    /*!
+      Returns the active stencil action, see stencil_state().
+     */
+    enum PainterShaderGroup::stencil_action_t
+    stencil_action(void) const;
+
+    /*!
+      Sets the stencil state passed as PainterShaderGroup::stencil_ref()
+      and PainterShaderGroup::stencil_action() to PainterDraw::draw_break()
+      for the draws that follow. Only meaningful if
+      PainterBackend::ConfigurationBase::stencil_clipping() is true.
+      Draws held back for reordering (see draw_reorder_window())
+      are added before the stencil state changes. Initial value
+      is a reference value of 0 with PainterShaderGroup::stencil_test.
+      \param ref stencil reference value
+      \param action how the stencil buffer is used and modified
+     */
+    void
+    stencil_state(uint32_t ref, enum PainterShaderGroup::stencil_action_t action);
+
+    /*!
+      Returns the maximum number of draws held back to be
+      reordered, see draw_reorder_window(unsigned int).
+     */
+    unsigned int
+    draw_reorder_window(void) const;
+
+    /*!
+      Set the maximum number of draws that are held back so
+      that they can be reordered to reduce the number of draw
+      breaks (see PainterDraw::draw_break()). A value of 0
+      disables reordering, which is the default. Held back
+      draws are grouped by the shader group values that
+      trigger a draw break (item group, blend group, brush and
+      blend mode). A draw is only moved before a draw it
+      was added after if the two draws give the same result
+      in either order, i.e. if the rectangles of
+      PainterPackerData::m_has_bounds of both draws are given
+      and do not intersect, or if neither reads the framebuffer
+      (i.e. their blend shaders are not
+      PainterBlendShader::framebuffer_fetch and their blend
+      modes do not use the destination value) and they have
+      different z-values, since the depth test passes on
+      greater or equal z. The attributes of a held back draw
+      are written to the current PainterDraw when the draw is
+      added, only its indices are held back. If reordering the
+      held back draws does not remove a draw break, they are
+      drawn in the order they were added. Draws with a
+      DataCallBack and the draws of draw_command_list() are
+      not reordered, and held back draws are added before them.
+      The number of draw breaks removed is given by
+      Stats::m_draw_breaks_eliminated of stats().
+      \param v maximum number of draws to hold back
+     */
+    void
+    draw_reorder_window(unsigned int v);
+
+    /*!
+      Returns the Stats of the drawing since the last
+      call to begin().
+     */
+    const Stats&
+    stats(void) const;
+
+    /*!
+      Returns true if the header and the values of a draw
+      fit into the data store of a PainterDraw into which
+      nothing has been packed. A draw for which this returns
+      false cannot be drawn since its data is too large for
+      any PainterDraw. May only be called between begin()
+      and end().
+      \param draw values of the draw
+     */
+    bool
+    fits_in_data_store(const PainterPackerData &draw) const;
+
     /*!
       Indicate to start drawing. Commands are buffered and not
       set to the backend until end() or flush() is called.
@@ -204,6 +597,50 @@ namespace fastuidraw
                  unsigned int z,
                  const reference_counted_ptr<DataCallBack> &call_back = reference_counted_ptr<DataCallBack>());
 
+    /*!
+      Draw the contents of a CommandList. The recorded draws
+      are added in the order they were recorded, after any
+      draws previously added to this PainterPacker, with their
+      data store locations rebased to where their data lands
+      in PainterDraw::m_store. May only be called between a
+      begin() / end() pair and from the thread that uses this
+      PainterPacker; the CommandList must not be recorded to
+      during the call.
+      \param list CommandList whose draws to add, must have been
+                  created from this PainterPacker
+      \param z_offset value added to the z value of each recorded draw
+      \param call_back if non-NULL handle, call back called when attribute data
+                       is added.
+     */
+    void
+    draw_command_list(const CommandList &list, unsigned int z_offset = 0,
+                      const reference_counted_ptr<DataCallBack> &call_back = reference_counted_ptr<DataCallBack>());
+
+    /*!
+      Draw the contents of a CommandList, providing the item
+      matrix and clip equations of those draws that were
+      recorded with a matrix slot. Draws recorded without a
+      matrix slot use their recorded values. The values of
+      matrices and clip are packed into PainterDraw::m_store
+      once per PainterDraw they are used in, rather than once
+      per draw. See draw_command_list(const CommandList&, unsigned int, const reference_counted_ptr<DataCallBack>&)
+      for the remaining arguments and restrictions.
+      \param list CommandList whose draws to add, must have been
+                  created from this PainterPacker
+      \param matrices item matrices of the matrix slots, size must
+                      be atleast CommandList::number_matrix_slots()
+      \param clip clip equations for the draws recorded with a matrix slot
+      \param z_offset value added to the z value of each recorded draw
+      \param call_back if non-NULL handle, call back called when attribute data
+                       is added.
+     */
+    void
+    draw_command_list(const CommandList &list,
+                      const_c_array<PainterPackedValue<PainterItemMatrix> > matrices,
+                      const PainterPackedValue<PainterClipEquations> &clip,
+                      unsigned int z_offset = 0,
+                      const reference_counted_ptr<DataCallBack> &call_back = reference_counted_ptr<DataCallBack>());
+
     /*!
       Returns the PainterBackend::PerformanceHints of the underlying
       PainterBackend of this PainterPacker.
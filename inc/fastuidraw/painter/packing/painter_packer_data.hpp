@@ -36,7 +36,8 @@ namespace fastuidraw
     /*!
       Ctor. Intitializes all fields as default nothings.
      */
-    PainterPackerData(void)
+    PainterPackerData(void):
+      m_has_bounds(false)
     {}
 
     /*!
@@ -46,7 +47,8 @@ namespace fastuidraw
      */
     explicit
     PainterPackerData(const PainterData &obj):
-      PainterData(obj)
+      PainterData(obj),
+      m_has_bounds(false)
     {}
 
     /*!
@@ -58,6 +60,27 @@ namespace fastuidraw
       value for the transformation matrix.
      */
     value<PainterItemMatrix> m_matrix;
+
+    /*!
+      If true, \ref m_bounds_min and \ref m_bounds_max are
+      the corners of a rectangle in normalized device
+      coordinates that contains every fragment of the draw.
+      A PainterPacker uses the rectangle to move a draw
+      past the draws whose rectangles it does not
+      intersect, see PainterPacker::draw_reorder_window().
+      Default value is false.
+     */
+    bool m_has_bounds;
+
+    /*!
+      Min-corner of the rectangle, see \ref m_has_bounds.
+     */
+    vec2 m_bounds_min;
+
+    /*!
+      Max-corner of the rectangle, see \ref m_has_bounds.
+     */
+    vec2 m_bounds_max;
   };
 
 /*! @} */
@@ -34,6 +34,34 @@ namespace fastuidraw
   class PainterShaderGroup:noncopyable
   {
   public:
+    /*!
+      Enumeration of how a draw uses and modifies the stencil
+      buffer when PainterBackend::ConfigurationBase::stencil_clipping()
+      is true. In all cases, a fragment passes the stencil test
+      only if the stencil value equals stencil_ref().
+     */
+    enum stencil_action_t
+      {
+        /*!
+          Draw normally; the stencil buffer is not modified.
+         */
+        stencil_test,
+
+        /*!
+          Increment the stencil value of the fragments that
+          pass the stencil test; the color and depth buffers
+          are not modified and the depth test is not performed.
+         */
+        stencil_increment,
+
+        /*!
+          Decrement the stencil value of the fragments that
+          pass the stencil test; the color and depth buffers
+          are not modified and the depth test is not performed.
+         */
+        stencil_decrement,
+      };
+
     /*!
       The group (see PainterShader::group())
       of the active blend shader.
@@ -61,6 +89,19 @@ namespace fastuidraw
     BlendMode::packed_value
     packed_blend_mode(void) const;
 
+    /*!
+      The stencil reference value against which the stencil
+      test is performed, see stencil_action_t.
+     */
+    uint32_t
+    stencil_ref(void) const;
+
+    /*!
+      How the stencil buffer is used and modified.
+     */
+    enum stencil_action_t
+    stencil_action(void) const;
+
   protected:
     /*!
       Ctor, do NOT derive from PainterShaderGroup, doing
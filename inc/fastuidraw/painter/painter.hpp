@@ -32,6 +32,53 @@ namespace fastuidraw
   @{
  */
 
+  /*!
+    A PainterRecording holds a sequence of draws made with
+    a Painter between Painter::begin_recording() and
+    Painter::end_recording(). The draws are recorded with
+    their attribute, index and data store values already
+    packed so that drawing a recording with
+    Painter::draw_recording() only copies the data and sets
+    the transformation, clipping and z-values. A recording
+    can be drawn any number of times, with any transformation
+    and clipping, but only by the Painter that recorded it.
+   */
+  class PainterRecording:noncopyable
+  {
+  public:
+    /*!
+      Ctor, the recording is initialized as empty.
+     */
+    PainterRecording(void);
+
+    ~PainterRecording();
+
+    /*!
+      Returns the number of draws recorded.
+     */
+    unsigned int
+    number_draws(void) const;
+
+    /*!
+      Returns the amount by which Painter::draw_recording()
+      increments Painter::current_z(), i.e. the amount by
+      which z was incremented when recording.
+     */
+    unsigned int
+    z_range(void) const;
+
+    /*!
+      Remove all recorded draws; the memory of the
+      recording is kept for future recording.
+     */
+    void
+    clear(void);
+
+  private:
+    friend class Painter;
+    void *m_d;
+  };
+
   /*!
     Painter wraps around PainterPacker to implement a classic
     2D rendering interface:
@@ -219,6 +266,99 @@ namespace fastuidraw
     void
     target_resolution(int w, int h);
 
+    /*!
+      Sets the maximum distance, in pixels, allowed between
+      the curves of a Path and the line segments used to draw
+      it when the Path is filled, stroked or used to clip.
+      Paths are then drawn with Path::tessellation(float) const
+      passing this value divided by the operator norm of the
+      current transformation (as computed from the values of
+      target_resolution()), so that zoomed out paths use fewer
+      vertices and zoomed in paths stay smooth. A value of zero
+      or less indicates to always use Path::tessellation(void) const.
+      Paths drawn while recording (see begin_recording()) always
+      use Path::tessellation(void) const. Default value is 0.25.
+      \param v new value
+     */
+    void
+    curve_flatness(float v);
+
+    /*!
+      Returns the value set by curve_flatness(float).
+     */
+    float
+    curve_flatness(void) const;
+
+    /*!
+      Sets the maximum distance, in pixels, that stroking may
+      move the line segments of a Path by drawing from a
+      simplified tessellation (see Path::simplified_tessellation()).
+      A Path stroked with stroke_path(), stroke_path_pixel_width(),
+      stroke_dashed_path() or stroke_dashed_path_pixel_width()
+      whose stroking width in pixels is no more than
+      stroke_lod_max_width() is stroked from
+      Path::simplified_tessellation(float) const passing this value
+      divided by the operator norm of the current transformation, so
+      that the number of vertices of thin strokes of paths with many
+      points follows how many pixels the path covers. The dash pattern
+      of a dashed stroke is applied along the simplified segments. A
+      value of zero or less indicates to never simplify. Paths stroked
+      while recording (see begin_recording()) are never simplified.
+      Default value is 0.5.
+      \param v new value
+     */
+    void
+    stroke_lod_distance(float v);
+
+    /*!
+      Returns the value set by stroke_lod_distance(float).
+     */
+    float
+    stroke_lod_distance(void) const;
+
+    /*!
+      Sets the maximum width, in pixels, of a stroke for the
+      stroke to be drawn from a simplified tessellation, see
+      stroke_lod_distance(float). Wider strokes are not simplified
+      because removing the point shared by two edges replaces the
+      join between them with a bevel, which is visible for wide
+      strokes. The width is given by
+      StrokingDataSelectorBase::stroking_width(); if it returns
+      false, the stroke is not simplified. Default value is 2.0.
+      \param v new value
+     */
+    void
+    stroke_lod_max_width(float v);
+
+    /*!
+      Returns the value set by stroke_lod_max_width(float).
+     */
+    float
+    stroke_lod_max_width(void) const;
+
+    /*!
+      Sets if the edges of stroked paths are drawn from the
+      data of StrokedPath::edge_segment_point_set instead of
+      StrokedPath::edge_point_set. The points of an edge
+      segment carry only the segment and the stroke shader
+      computes the normal from it, which takes 4 vertices
+      and 9 indices per segment of the tessellation instead
+      of 6 vertices and 15 indices. Applies to stroke_path()
+      and stroke_dashed_path(). The stroke shaders of the
+      PainterShaderSet must handle points of type
+      StrokedPath::offset_edge_segment, as the default
+      shaders of the GLSL backend do. Default value is false.
+      \param v new value
+     */
+    void
+    stroke_with_edge_segments(bool v);
+
+    /*!
+      Returns the value set by stroke_with_edge_segments(bool).
+     */
+    bool
+    stroke_with_edge_segments(void) const;
+
     /*!
       Indicate to start drawing with methods of this Painter.
       Drawing commands sent to 3D hardware are buffered and not
@@ -237,6 +377,74 @@ namespace fastuidraw
     void
     end(void);
 
+    /*!
+      Start recording draws to a PainterRecording, clearing
+      any draws it previously held. While recording, the draw
+      methods of this Painter do not draw, instead they add
+      to the recording. Recording starts with the identity
+      transformation, z at 0 and no clipping; the clip
+      methods (clipInRect(), clipInPath(), clipOutPath()) and
+      the draw methods taking a PainterPacker::DataCallBack
+      with a non-NULL callback may not be used while
+      recording. Changes to the transformation and blending
+      made while recording are recorded. The state of the
+      Painter at begin_recording() is restored by
+      end_recording(). Must be called within a begin()/end()
+      pair and recordings cannot be nested.
+      \param recording PainterRecording to which to record
+     */
+    void
+    begin_recording(PainterRecording &recording);
+
+    /*!
+      End recording started with begin_recording().
+     */
+    void
+    end_recording(void);
+
+    /*!
+      Draw the contents of a PainterRecording. Each draw
+      of the recording is drawn with the current transformation
+      concatenated by the transformation active when it was
+      recorded, with the current clipping and with its
+      recorded z offset by current_z(). After drawing,
+      current_z() is incremented by PainterRecording::z_range().
+      The blend shader of draws made before any blend change
+      in the recording is the current blend shader.
+      \param recording PainterRecording to draw, must have
+                       been recorded by this Painter
+     */
+    void
+    draw_recording(const PainterRecording &recording);
+
+    /*!
+      Returns the value of PainterPacker::draw_reorder_window()
+      of the PainterPacker used by this Painter.
+     */
+    unsigned int
+    draw_reorder_window(void) const;
+
+    /*!
+      Set the value of PainterPacker::draw_reorder_window()
+      of the PainterPacker used by this Painter. The draws of
+      the stroke, fill, glyph and polygon methods pass along
+      the bounding rectangle, in normalized device coordinates,
+      of the same box used to cull them; draws whose rectangles
+      do not overlap can be reordered even when they blend. The
+      draws of the clip methods are never reordered.
+      \param v maximum number of draws to hold back for reordering
+     */
+    void
+    draw_reorder_window(unsigned int v);
+
+    /*!
+      Returns the PainterPacker::Stats of the PainterPacker
+      used by this Painter, i.e. the counters of how the draws
+      since the last call to begin() were packed.
+     */
+    const PainterPacker::Stats&
+    packer_stats(void) const;
+
     /*!
       Concats the current transformation matrix
       by a given matrix.
@@ -328,7 +536,15 @@ namespace fastuidraw
     /*!
       Clip-out by a path, i.e. set the clipping to be
       the intersection of the current clipping against
-      the -complement- of the fill of a path.
+      the -complement- of the fill of a path. If
+      PainterBackend::ConfigurationBase::stencil_clipping()
+      is true for the backend of the Painter, path clipping
+      is done with the stencil buffer: each of clipOutPath()
+      and clipInPath() adds one stencil level (up to 255
+      nested levels, after which clipping falls back to
+      depth occluders), draws the path once to the stencil
+      buffer and on restore() draws a single quad to the
+      stencil buffer.
       \param path path by which to clip out
       \param fill_rule fill rule to apply to path
      */
@@ -619,6 +835,46 @@ namespace fastuidraw
     fill_path(const PainterData &draw, const Path &path, const CustomFillRuleBase &fill_rule,
               const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
 
+    /*!
+      Fill a path analytically: the segments of the tessellation
+      of the path are packed as a PainterAnalyticFillParams and
+      the shader computes the coverage of the fill for each pixel
+      of the bounding box of the path, thus no triangulation of
+      the path is computed on the CPU. The item shader data of
+      draw is ignored. Prefer this for paths that change often.
+      Each pixel only walks the segments of its bands, see
+      PainterAnalyticFillParams. If the segments are too many
+      for the data store of a PainterDraw (see
+      PainterPacker::fits_in_data_store()), the path is instead
+      drawn with fill_path() and PainterShaderSet::fill_shader().
+      \param shader shader with which to fill the path, the shader
+                    must accept the exact same format as
+                    PainterShaderSet::analytic_fill_shader()
+      \param draw data for how to draw
+      \param path path to fill
+      \param fill_rule fill rule with which to fill the path
+      \param call_back if non-NULL handle, call back called when attribute data
+                       is added.
+     */
+    void
+    fill_path_analytic(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
+                       const Path &path, enum PainterEnums::fill_rule_t fill_rule,
+                       const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
+    /*!
+      Fill a path analytically using the default shader
+      PainterShaderSet::analytic_fill_shader(), see
+      fill_path_analytic(const reference_counted_ptr<PainterItemShader>&, const PainterData&, const Path&, enum PainterEnums::fill_rule_t, const reference_counted_ptr<PainterPacker::DataCallBack>&).
+      \param draw data for how to draw
+      \param path path to fill
+      \param fill_rule fill rule with which to fill the path
+      \param call_back if non-NULL handle, call back called when attribute data
+                       is added.
+     */
+    void
+    fill_path_analytic(const PainterData &draw, const Path &path, enum PainterEnums::fill_rule_t fill_rule,
+                       const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
     /*!
       Draw a convex polygon using a custom shader.
       \param draw data for how to draw
@@ -0,0 +1,167 @@
+/*!
+ * \file painter_analytic_fill_params.hpp
+ * \brief file painter_analytic_fill_params.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#pragma once
+
+#include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/painter/painter_enums.hpp>
+#include <fastuidraw/painter/painter_shader_data.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Painter
+  @{
+ */
+
+  /*!
+    Class to specify the data for filling a path analytically,
+    i.e. without triangulating the path on the CPU. The data
+    is the line segments of the contours of a TessellatedPath
+    and the fill rule. The shader PainterShaderSet::analytic_fill_shader()
+    computes the coverage of each pixel from the winding numbers
+    of the pixel (see compute_coverage()) so that only the segments
+    need to be uploaded when a path changes.
+
+    The bounding box of the segments is cut into number_bands()
+    horizontal bands and number_bands() vertical bands; each band
+    lists the segments that may cross it. A pixel only walks the
+    segments of the horizontal band and of the vertical band that
+    contain it, so the cost per pixel is proportional to the number
+    of segments of those bands rather than to number_segments().
+
+    The data is packed as follows: the header, as according to
+    PainterAnalyticFillParams::analytic_fill_data_offset_t, is
+    followed by the band table starting at the next block of the
+    data store; the band table has 2 * number_bands() entries,
+    first those of the horizontal bands in order of increasing
+    y-coordinate, then those of the vertical bands in order of
+    increasing x-coordinate. Each entry starts on a block of the
+    data store and is packed as 2 uints: the offset in blocks
+    from the start of the data to the first segment of the band
+    and the number of segments of the band. The segments of the
+    bands follow the band table; each segment is packed as 4
+    floats (start.x, start.y, end.x, end.y) and starts on a block
+    of the data store. A segment that crosses several bands is
+    packed once for each band.
+   */
+  class PainterAnalyticFillParams:public PainterItemShaderData
+  {
+  public:
+    /*!
+      Enumeration that provides offsets for the header
+      of the analytic fill data.
+     */
+    enum analytic_fill_data_offset_t
+      {
+        analytic_fill_number_segments_offset, /*!< offset to number of segments (packed as uint) */
+        analytic_fill_fill_rule_offset, /*!< offset to the fill rule (packed as uint) */
+        analytic_fill_number_bands_offset, /*!< offset to the number of bands in each direction (packed as uint) */
+        analytic_fill_band_min_x_offset, /*!< offset to the min x-coordinate of the bands (packed as float) */
+        analytic_fill_band_min_y_offset, /*!< offset to the min y-coordinate of the bands (packed as float) */
+        analytic_fill_band_scale_x_offset, /*!< offset to the reciprocal of the width of a vertical band (packed as float) */
+        analytic_fill_band_scale_y_offset, /*!< offset to the reciprocal of the height of a horizontal band (packed as float) */
+
+        analytic_fill_static_data_size /*!< size of the header of the analytic fill data */
+      };
+
+    /*!
+      Sizes of the data of a single segment, of an entry
+      of the band table and the maximum number of bands
+      in each direction.
+     */
+    enum
+      {
+        analytic_fill_segment_size = 4, /*!< size of the data of a segment */
+        analytic_fill_band_size = 2, /*!< size of the data of an entry of the band table */
+        analytic_fill_max_number_bands = 32 /*!< maximum value of number_bands() */
+      };
+
+    /*!
+      Ctor, the path is empty and the fill rule is
+      PainterEnums::nonzero_fill_rule.
+     */
+    PainterAnalyticFillParams(void);
+
+    /*!
+      Set the segments from the contours of a TessellatedPath.
+      Each contour is closed. The values are -copied-.
+      \param P TessellatedPath from which to take the segments
+     */
+    PainterAnalyticFillParams&
+    path(const TessellatedPath &P);
+
+    /*!
+      Returns the number of segments.
+     */
+    unsigned int
+    number_segments(void) const;
+
+    /*!
+      Returns the number of horizontal bands, which is also
+      the number of vertical bands. The number of bands grows
+      with number_segments(), up to analytic_fill_max_number_bands.
+     */
+    unsigned int
+    number_bands(void) const;
+
+    /*!
+      The fill rule.
+     */
+    enum PainterEnums::fill_rule_t
+    fill_rule(void) const;
+
+    /*!
+      Set the value returned by fill_rule(void) const.
+      \param f value to use
+     */
+    PainterAnalyticFillParams&
+    fill_rule(enum PainterEnums::fill_rule_t f);
+
+    /*!
+      Returns the winding number of a point, i.e. the sum
+      over the segments that cross the ray going from the
+      point in the direction of increasing x-coordinate of
+      +1 if the segment goes in the direction of increasing
+      y-coordinate and -1 otherwise. As in the shader, only
+      the segments of the horizontal band of the point are
+      examined.
+      \param p point in item coordinates
+     */
+    int
+    winding_number(const vec2 &p) const;
+
+    /*!
+      CPU reference of the coverage computed by the shader
+      PainterShaderSet::analytic_fill_shader(). The coverage is
+      a weighted average of the fill rule applied to two fractional
+      winding numbers, the first from the ray in the direction
+      of increasing x-coordinate and the second from the ray in
+      the direction of increasing y-coordinate. A segment that
+      crosses a ray at less than half a pixel from the point
+      contributes linearly in the distance of the crossing and
+      each ray is weighted by how near its nearest crossing is.
+      \param p point in item coordinates
+      \param pixels_per_unit number of pixels per unit of item
+                             coordinates in each coordinate
+     */
+    float
+    compute_coverage(const vec2 &p, const vec2 &pixels_per_unit) const;
+  };
+/*! @} */
+
+} //namespace fastuidraw
@@ -53,6 +53,7 @@ namespace fastuidraw
         bevel_joins_closing_edge, /*!< index for bevel join data with closing edge */
         miter_joins_closing_edge, /*!< index for miter join data with closing edge */
         edge_closing_edge, /*!< index for edge data including closing edge */
+        edge_segment_closing_edge, /*!< index for edge data made of edge segments (see StrokedPath::edge_segment_point_set) including closing edge */
 
         number_with_closing_edge, /*!< number of types with closing edge */
 
@@ -60,6 +61,7 @@ namespace fastuidraw
         bevel_joins_no_closing_edge, /*!< index for bevel join data without closing edge */
         miter_joins_no_closing_edge, /*!< index for miter join data without closing edge */
         edge_no_closing_edge, /*!< index for edge data not including closing edge */
+        edge_segment_no_closing_edge, /*!< index for edge data made of edge segments (see StrokedPath::edge_segment_point_set) not including closing edge */
 
         rounded_cap, /*!< index for rounded cap data */
         square_cap,  /*!< index for square cap data */
@@ -114,6 +116,17 @@ namespace fastuidraw
       - PainterAttribute::m_attrib2 .y -> StrokedPath::point::m_edge_length (float)
       - PainterAttribute::m_attrib2 .z -> StrokedPath::point::m_open_contour_length (float)
       - PainterAttribute::m_attrib2 .w -> StrokedPath::point::m_closed_contour_length (float)
+
+      The chunks are not created by set_data(); instead the
+      chunks that come from the same StrokedPath::point_set_t
+      (for example all the chunks of the rounded joins) are
+      created the first time one of them is fetched with
+      attribute_data_chunk(), index_data_chunk() or
+      increment_z_value(). Fetching the arrays of all chunks
+      (attribute_data_chunks(), index_data_chunks(),
+      increment_z_values() and non_empty_index_data_chunks())
+      creates all the chunks. A reference to path is held until
+      the data is set again.
      */
     void
     set_data(const reference_counted_ptr<const StrokedPath> &path);
@@ -286,6 +299,18 @@ namespace fastuidraw
     const_c_array<unsigned int>
     non_empty_index_data_chunks(void) const;
 
+    /*!
+      Gives the bounding box, in item coordinates, of the
+      positions of the attribute data. For data set from a
+      StrokedPath, the box is that of the points of the path,
+      i.e. it does not include the extent added by stroking.
+      Returns false if there is no attribute data.
+      \param[out] pmin location to which to write the min-corner
+      \param[out] pmax location to which to write the max-corner
+     */
+    bool
+    bounding_box(vec2 &pmin, vec2 &pmax) const;
+
     /*!
       Returns by how much to increment a z-value
       (see Painter::increment_z()) when using
@@ -340,6 +365,112 @@ namespace fastuidraw
     chunk_from_join(enum stroking_data_t tp, unsigned int J);
 
   private:
+    friend class PainterAttributeDataHierarchy;
+    friend class StrokedPath;
+
+    /* same as set_data(const reference_counted_ptr<const StrokedPath>&)
+       but does not hold a reference to the StrokedPath, for the
+       PainterAttributeData owned by the StrokedPath itself.
+     */
+    void
+    set_data_without_reference(const StrokedPath *path);
+
+    void *m_d;
+  };
+
+  /*!
+    A PainterAttributeDataHierarchy partitions the triangles of
+    a PainterAttributeData spatially into a tree of nodes, each
+    node having a bounding box. Each leaf of the tree holds a
+    PainterAttributeData that has the same chunk layout and the
+    same increment_z_value() for each partitioned chunk as the
+    source PainterAttributeData but holds only those triangles
+    whose center is within the region of the leaf. A Painter uses the hierarchy to send only
+    those triangles that are near the visible region of a path.
+    The position of an attribute is read from the .xy() of
+    PainterAttribute::m_attrib0 (packed as floats) which is where
+    the data of FilledPath and StrokedPath have the position.
+   */
+  class PainterAttributeDataHierarchy:noncopyable
+  {
+  public:
+    /*!
+      Ctor.
+      \param data PainterAttributeData from which to take the triangles,
+                  the object must stay alive for the lifetime of the
+                  PainterAttributeDataHierarchy
+      \param number_chunks only the chunks [0, number_chunks) of data
+                           are present in the leaves of the hierarchy
+      \param max_triangles_per_leaf a node is split if it has more than
+                                    this many triangles. If data has no
+                                    more triangles than this value, the
+                                    hierarchy is just a single leaf whose
+                                    data() is data.
+     */
+    PainterAttributeDataHierarchy(const PainterAttributeData &data,
+                                  unsigned int number_chunks,
+                                  unsigned int max_triangles_per_leaf = 1024);
+
+    /*!
+      Ctor. The leaves only hold the triangles of the named
+      chunks of the source data; the other chunks of the leaves
+      are empty. Only the named chunks of data are fetched, so
+      the chunks of a PainterAttributeData set from a StrokedPath
+      that are not named are not created.
+      \param data PainterAttributeData from which to take the triangles,
+                  the object must stay alive for the lifetime of the
+                  PainterAttributeDataHierarchy
+      \param chunks which chunks of data to partition
+      \param max_triangles_per_leaf a node is split if it has more than
+                                    this many triangles. If data has no
+                                    more triangles than this value, the
+                                    hierarchy is just a single leaf whose
+                                    data() is data.
+     */
+    PainterAttributeDataHierarchy(const PainterAttributeData &data,
+                                  const_c_array<unsigned int> chunks,
+                                  unsigned int max_triangles_per_leaf = 1024);
+
+    ~PainterAttributeDataHierarchy();
+
+    /*!
+      Returns the number of nodes of the hierarchy;
+      node 0 is the root of the hierarchy.
+     */
+    unsigned int
+    number_nodes(void) const;
+
+    /*!
+      Gives the bounding box of the positions of the
+      attributes of a node. Returns false if the node
+      has no triangles.
+      \param node which node with node < number_nodes()
+      \param[out] pmin location to which to write the min-corner
+      \param[out] pmax location to which to write the max-corner
+     */
+    bool
+    bounding_box(unsigned int node, vec2 &pmin, vec2 &pmax) const;
+
+    /*!
+      Returns the children of a node, an empty
+      array indicates that the node is a leaf.
+      \param node which node with node < number_nodes()
+     */
+    const_c_array<unsigned int>
+    children(unsigned int node) const;
+
+    /*!
+      Returns the data of a leaf node, it is an error
+      to call this on a node that is not a leaf.
+      \param node which node with node < number_nodes()
+     */
+    const PainterAttributeData&
+    data(unsigned int node) const;
+
+  private:
+    void
+    create_leaves(void);
+
     void *m_d;
   };
 /*! @} */
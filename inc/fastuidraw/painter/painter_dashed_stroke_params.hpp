@@ -151,6 +151,16 @@ namespace fastuidraw
     static
     reference_counted_ptr<const DashEvaluatorBase>
     dash_evaluator(void);
+
+    /*!
+      Constructs and returns a StrokingDataSelectorBase compatible
+      with the data of PainterDashedStrokeParams.
+      \param pixel_width if true, the stroking width is in pixels,
+                         otherwise it is in item coordinates
+     */
+    static
+    reference_counted_ptr<const StrokingDataSelectorBase>
+    stroking_data_selector(bool pixel_width);
   };
 /*! @} */
 
@@ -54,6 +54,29 @@ namespace fastuidraw
     compute_dash_interval(const PainterShaderData::DataBase *data,
                           float distance,
                           range_type<float> &out_interval) const = 0;
+
+    /*!
+      Computes which values of a sorted array of distances are
+      within the solid part of dashing. The default implementation
+      calls compute_dash_interval() once for each interval of the
+      dashing that contains a value of the array and finds the
+      values within that interval by binary search. Hence the cost
+      is proportional to the number of such intervals and not to
+      the number of distances. Returns the number of ranges written
+      to out_ranges.
+      \param data PainterItemShaderData::DataBase object holding the data to
+                  be sent to the shader
+      \param sorted_distances distances sorted in increasing order
+      \param[out] out_ranges location to which to write the ranges into
+                             sorted_distances of the values that are within
+                             the solid part of dashing, in increasing order.
+                             Must be at least as large as sorted_distances
+     */
+    virtual
+    unsigned int
+    compute_dash_ranges(const PainterShaderData::DataBase *data,
+                        const_c_array<float> sorted_distances,
+                        c_array<range_type<unsigned int> > out_ranges) const;
   };
 
   /*!
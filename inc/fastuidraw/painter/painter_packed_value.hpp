@@ -72,9 +72,12 @@ namespace fastuidraw
     already copied to PainterDraw::m_store. If already
     on a store, then rather than copying the data again, the data is
     reused. The object behind the handle is NOT thread safe. In addition
-    the underlying reference count is not either. Hence any access
-    (even dtor, copy ctor and equality operator) on a fixed object cannot
-    be done from multiple threads simutaneously. A fixed
+    the underlying reference count is not either unless the
+    PainterPackedValue was created by a PainterPackedValuePool in
+    concurrent mode. Hence, for objects created by a non-concurrent
+    PainterPackedValuePool, any access (even dtor, copy ctor and
+    equality operator) on a fixed object cannot be done from multiple
+    threads simutaneously. A fixed
     PainterPackedValue can be used by different Painter (and PainterPacker)
     objects subject to the condition that the data store alignment (see
     PainterPacker::Configuration::alignment()) is the same for each of these
@@ -117,7 +120,7 @@ namespace fastuidraw
     unsigned int
     alignment_packing(void) const
     {
-      return this->m_d->alignment_packing();
+      return PainterPackedValueBase::alignment_packing();
     }
 
     /*!
@@ -186,10 +189,18 @@ namespace fastuidraw
 
   /*!
     A PainterPackedValuePool can be used to create PainterPackedValue
-    objects. Just like PainterPackedValue, PainterPackedValuePool is
-    NOT thread safe, as such it is not a safe operation to use the
+    objects. By default, just like PainterPackedValue, PainterPackedValuePool
+    is NOT thread safe, as such it is not a safe operation to use the
     same PainterPackedValuePool object from multiple threads at the
-    same time. A fixed PainterPackedValuePool can create PainterPackedValue
+    same time. A PainterPackedValuePool constructed in concurrent
+    mode can be used to create PainterPackedValue objects from multiple
+    threads simultaneously; in addition the reference counts of the
+    PainterPackedValue objects it creates are atomic, so handles to the
+    same value can be copied and released from different threads.
+    Only the reference count is made thread safe: packing the value
+    into a PainterDraw (i.e. using it in a draw of a PainterPacker)
+    must still not be done from multiple threads simultaneously.
+    A fixed PainterPackedValuePool can create PainterPackedValue
     objects used by different Painter (and PainterPacker) objects subject
     to the condition that the data store alignment (see
     PainterPacker::Configuration::alignment()) is the same for each of
@@ -202,9 +213,14 @@ namespace fastuidraw
       Ctor.
       \param painter_alignment the alignment to create packed data, see
                                 PainterPacker::Configuration::alignment()
+      \param concurrent if true, the PainterPackedValuePool and the reference
+                        counts of the PainterPackedValue objects it creates
+                        are thread safe. The allocation of slots is lock-free
+                        and threads allocate from different free lists
+                        depending on their thread ID.
      */
     explicit
-    PainterPackedValuePool(int painter_alignment);
+    PainterPackedValuePool(int painter_alignment, bool concurrent = false);
 
     ~PainterPackedValuePool();
 
@@ -167,6 +167,23 @@ namespace fastuidraw
     PainterShaderSet&
     fill_shader(const reference_counted_ptr<PainterItemShader> &sh);
 
+    /*!
+      Shader for filling of paths analytically. The vertex
+      shader takes attribute data as formatted by
+      PainterAttributeData for the default fill shader, the
+      item shader data is a PainterAnalyticFillParams and the
+      fragment shader computes the coverage of the fill.
+     */
+    const reference_counted_ptr<PainterItemShader>&
+    analytic_fill_shader(void) const;
+
+    /*!
+      Set the value returned by analytic_fill_shader(void) const.
+      \param sh value to use
+     */
+    PainterShaderSet&
+    analytic_fill_shader(const reference_counted_ptr<PainterItemShader> &sh);
+
     /*!
       Blend shaders. If an element is a NULL shader, then that
       blend mode is not supported.
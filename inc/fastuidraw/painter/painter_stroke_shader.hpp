@@ -20,8 +20,10 @@
 #pragma once
 
 
+#include <fastuidraw/util/reference_counted.hpp>
 #include <fastuidraw/painter/painter_item_shader.hpp>
 #include <fastuidraw/painter/painter_enums.hpp>
+#include <fastuidraw/painter/painter_shader_data.hpp>
 
 namespace fastuidraw
 {
@@ -30,6 +32,54 @@ namespace fastuidraw
   @{
  */
 
+  /*!
+    A StrokingDataSelectorBase is the interface used by Painter
+    to know how far stroking extends from the path so that it
+    can cull stroking that is outside of the current clipping.
+   */
+  class StrokingDataSelectorBase:
+    public reference_counted<StrokingDataSelectorBase>::default_base
+  {
+  public:
+    /*!
+      To be implemented by a derived class to compute how far
+      the stroking, including joins, caps and the anti-alias
+      fuzz, extends from the path. The distance is given as the
+      sum of a distance in pixels and a distance in item
+      coordinates. Returns false if the distance cannot be
+      bounded, for example miter-joins without a miter-limit.
+      \param data PainterItemShaderData::DataBase object holding the data to
+                  be sent to the shader
+      \param[out] out_pixel_distance distance in pixels
+      \param[out] out_item_space_distance distance in item coordinates
+     */
+    virtual
+    bool
+    stroking_distances(const PainterShaderData::DataBase *data,
+                       float &out_pixel_distance,
+                       float &out_item_space_distance) const = 0;
+
+    /*!
+      To be optionally implemented by a derived class to give
+      the width of the stroking, without joins, caps and the
+      anti-alias fuzz, as the sum of a width in pixels and a
+      width in item coordinates. A Painter uses the width to
+      decide if a path is thin enough to be stroked from a
+      simplified tessellation, see Painter::stroke_lod_max_width().
+      Returns false if the width is not known, which is what
+      the default implementation does.
+      \param data PainterItemShaderData::DataBase object holding the data to
+                  be sent to the shader
+      \param[out] out_pixel_width width in pixels
+      \param[out] out_item_space_width width in item coordinates
+     */
+    virtual
+    bool
+    stroking_width(const PainterShaderData::DataBase *data,
+                   float &out_pixel_width,
+                   float &out_item_space_width) const;
+  };
+
   /*!
     A PainterStrokeShader hold shading for
     both stroking with and without anit-aliasing.
@@ -151,6 +201,22 @@ namespace fastuidraw
     PainterStrokeShader&
     non_aa_shader(const reference_counted_ptr<PainterItemShader> &sh);
 
+    /*!
+      The StrokingDataSelectorBase that interprets the
+      data of the shaders of this PainterStrokeShader.
+      If the value is NULL, then Painter does not cull
+      stroking done with this PainterStrokeShader.
+     */
+    const reference_counted_ptr<const StrokingDataSelectorBase>&
+    stroking_data_selector(void) const;
+
+    /*!
+      Set the value returned by stroking_data_selector(void) const.
+      \param sh value to use
+     */
+    PainterStrokeShader&
+    stroking_data_selector(const reference_counted_ptr<const StrokingDataSelectorBase> &sh);
+
   private:
     void *m_d;
   };
@@ -25,6 +25,7 @@
 #include <fastuidraw/util/c_array.hpp>
 #include <fastuidraw/util/reference_counted.hpp>
 #include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/path_tessellation_pool.hpp>
 
 namespace fastuidraw  {
 
@@ -40,7 +41,7 @@ namespace fastuidraw  {
   to the first point.
  */
 class PathContour:
-    public reference_counted<PathContour>::non_concurrent
+    public reference_counted<PathContour>::atomic
 {
 public:
 
@@ -50,7 +51,7 @@ public:
     the shape of an edge.
    */
   class interpolator_base:
-    public reference_counted<interpolator_base>::non_concurrent
+    public reference_counted<interpolator_base>::atomic
   {
   public:
     /*!
@@ -92,15 +93,23 @@ public:
       are to be filled; the other fields of TessellatedPath::point are
       filled by TessellatedPath using the named fields. In addition to
       filling the output array, the function shall return the number of
-      points needed to perform the required tessellation.
+      points needed to perform the required tessellation. If
+      out_max_distance is not NULL, the routine shall also write
+      to it the maximum distance between the curve and the line
+      segments of the tessellation; TessellatedPath::max_distance()
+      is computed from these values.
 
       \param tess_params tessellation parameters
       \param out_data location to which to write the edge tessellated
+      \param out_max_distance if non-NULL, location to which to write
+                              the maximum distance between the curve
+                              and the line segments of the tessellation
      */
     virtual
     unsigned int
     produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
-                         c_array<TessellatedPath::point> out_data) const = 0;
+                         c_array<TessellatedPath::point> out_data,
+                         float *out_max_distance) const = 0;
 
     /*!
       To be implemented by a derived class to create and
@@ -135,7 +144,8 @@ public:
     virtual
     unsigned int
     produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
-                         c_array<TessellatedPath::point> out_data) const;
+                         c_array<TessellatedPath::point> out_data,
+                         float *out_max_distance) const;
 
     virtual
     interpolator_base*
@@ -164,7 +174,8 @@ public:
     virtual
     unsigned int
     produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
-                         c_array<TessellatedPath::point> out_data) const;
+                         c_array<TessellatedPath::point> out_data,
+                         float *out_max_distance) const;
 
     /*!
       To be implemented by a derived class to compute datum of the curve
@@ -181,6 +192,25 @@ public:
     void
     compute(float in_t, vec2 &outp, vec2 &outp_t, vec2 &outp_tt) const = 0;
 
+    /*!
+      Compute the datum of the curve at several times at once; the
+      tessellation of an interpolator_generic evaluates the curve
+      through this function. A derived class should implement it
+      when evaluating many times together is cheaper than calling
+      compute(float, vec2&, vec2&, vec2&) const for each of them.
+      Default implementation calls compute(float, vec2&, vec2&, vec2&) const
+      for each element of in_t. All arrays must be the same size.
+      \param in_t (input) times at which to evaluate the curve,
+                  each in the range [0, 1]
+      \param outp (output) location to which to write the positions
+      \param outp_t (output) location to which to write the first derivatives
+      \param outp_tt (output) location to which to write the second derivatives
+     */
+    virtual
+    void
+    compute_batch(const_c_array<float> in_t, c_array<vec2> outp,
+                  c_array<vec2> outp_t, c_array<vec2> outp_tt) const;
+
   private:
   };
 
@@ -226,6 +256,11 @@ public:
     void
     compute(float in_t, vec2 &outp, vec2 &outp_t, vec2 &outp_tt) const;
 
+    virtual
+    void
+    compute_batch(const_c_array<float> in_t, c_array<vec2> outp,
+                  c_array<vec2> outp_t, c_array<vec2> outp_tt) const;
+
     virtual
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const;
@@ -262,7 +297,8 @@ public:
 
     unsigned int
     produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
-                         c_array<TessellatedPath::point> out_data) const;
+                         c_array<TessellatedPath::point> out_data,
+                         float *out_max_distance) const;
 
     virtual
     interpolator_base*
@@ -790,6 +826,74 @@ public:
   const reference_counted_ptr<const TessellatedPath>&
   tessellation(void) const;
 
+  /*!
+    Return a tessellation of this Path whose
+    TessellatedPath::max_distance() is no more than
+    a given value. The tessellations are cached by
+    level, where each level halves (or doubles) the
+    TessellatedPath::TessellationParams::m_curve_tessellation
+    of tessellation_params(), and the coarsest level
+    meeting the bound is returned; if no level meets
+    the bound, the finest level is returned. Like
+    tessellation(void) const, the cache is cleared
+    whenever this Path changes its geometry or
+    tessellation parameters.
+    \param max_distance maximum distance, in coordinates
+                        of the Path, allowed between the
+                        curves of the Path and the segments
+                        of the tessellation; a value of zero
+                        or less returns tessellation(void) const
+   */
+  const reference_counted_ptr<const TessellatedPath>&
+  tessellation(float max_distance) const;
+
+  /*!
+    Return a tessellation of this Path that is simplified
+    (see TessellatedPath::TessellatedPath(const TessellatedPath&, float))
+    so that its line segments are within a given distance of the
+    curves of this Path, i.e. its TessellatedPath::max_distance()
+    is no more than the distance unless even the finest level of
+    tessellation(float) const is farther. Simplifying removes the
+    points of a polyline that do not change its shape by more than
+    the distance, so that a Path with many points that is drawn
+    small uses far fewer points. The simplified tessellations
+    are cached by the distance rounded down to a power of 2,
+    and like tessellation(void) const, the cache is cleared
+    whenever this Path changes its geometry or tessellation
+    parameters.
+    \param max_distance maximum distance, in coordinates
+                        of the Path, allowed between the
+                        curves of the Path and the segments
+                        of the simplified tessellation; a value
+                        of zero or less returns tessellation(void) const
+   */
+  const reference_counted_ptr<const TessellatedPath>&
+  simplified_tessellation(float max_distance) const;
+
+  /*!
+    Start constructing the value returned by tessellation(void) const,
+    together with its TessellatedPath::filled() and
+    TessellatedPath::stroked(), on a worker thread of a
+    PathTessellationPool. While the job is not complete,
+    tessellation_pending() returns true and a Painter skips
+    drawing this Path; calling tessellation(void) const before
+    the job completes waits for it. Changing the geometry or the
+    tessellation parameters of this Path drops the job. Returns
+    the job, which is NULL if tessellation(void) const has already
+    been constructed. If a job is already in progress, returns
+    that job instead of starting a new one.
+    \param pool PathTessellationPool to perform the job
+   */
+  reference_counted_ptr<const PathTessellationPool::Job>
+  tessellate_async(const reference_counted_ptr<PathTessellationPool> &pool) const;
+
+  /*!
+    Returns true if and only if a job started by
+    tessellate_async() has not yet completed.
+   */
+  bool
+  tessellation_pending(void) const;
+
 private:
   void *m_d;
 };
@@ -0,0 +1,132 @@
+/*!
+ * \file path_tessellation_pool.hpp
+ * \brief file path_tessellation_pool.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/fastuidraw_memory.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/tessellated_path.hpp>
+
+namespace fastuidraw  {
+
+///@cond
+class Path;
+namespace detail { class PathTessellationPoolAccess; }
+///@endcond
+
+/*!\addtogroup Core
+  @{
+ */
+
+/*!
+  A PathTessellationPool is a set of worker threads that construct
+  the TessellatedPath of a Path together with its FilledPath and
+  StrokedPath away from the thread that uses the Path. The
+  PainterAttributeData and PainterAttributeDataHierarchy objects
+  of those are not made by the workers; they are made lazily by
+  the thread that draws the Path and only for the styles used. The usual way to use a PathTessellationPool
+  is via Path::tessellate_async(). The edges of a Path are
+  tessellated by all the worker threads together (see
+  TessellatedPath::TessellatedPath(const Path&, TessellationParams, const PathTessellationPool*)),
+  so a large Path does not keep a single worker busy while the
+  others are idle.
+ */
+class PathTessellationPool:
+    public reference_counted<PathTessellationPool>::atomic
+{
+public:
+  /*!
+    A Job is a handle to the construction of the
+    tessellation of a Path by a PathTessellationPool.
+   */
+  class Job:
+    public reference_counted<Job>::atomic
+  {
+  public:
+    ~Job();
+
+    /*!
+      Returns true if the job has completed, i.e.
+      tessellation() will not wait.
+     */
+    bool
+    ready(void) const;
+
+    /*!
+      Wait until the job has completed.
+     */
+    void
+    wait(void) const;
+
+    /*!
+      Waits until the job has completed and returns the
+      TessellatedPath it constructed. The returned object
+      has TessellatedPath::filled() and TessellatedPath::stroked()
+      already constructed.
+     */
+    const reference_counted_ptr<const TessellatedPath>&
+    tessellation(void) const;
+
+  private:
+    friend class PathTessellationPool;
+
+    Job(const Path &path, const PathTessellationPool *pool);
+
+    void *m_d;
+  };
+
+  /*!
+    Ctor.
+    \param number_threads number of worker threads, a value
+                          of 0 is treated as 1
+   */
+  explicit
+  PathTessellationPool(unsigned int number_threads = 1);
+
+  /*!
+    Dtor. Waits for all jobs added with add_job() to
+    complete before the worker threads are stopped.
+   */
+  ~PathTessellationPool();
+
+  /*!
+    Returns the number of worker threads.
+   */
+  unsigned int
+  number_threads(void) const;
+
+  /*!
+    Add a job to construct the tessellation of a Path
+    with the parameters of Path::tessellation_params().
+    The Path is copied, so later changes to it do not
+    affect the job.
+    \param path Path to tessellate
+   */
+  reference_counted_ptr<const Job>
+  add_job(const Path &path);
+
+private:
+  friend class detail::PathTessellationPoolAccess;
+
+  void *m_d;
+};
+
+/*! @} */
+
+}
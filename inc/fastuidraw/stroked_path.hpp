@@ -28,6 +28,7 @@ namespace fastuidraw  {
 
 ///@cond
 class PainterAttributeData;
+class PainterAttributeDataHierarchy;
 class TessellatedPath;
 class Path;
 ///@endcond
@@ -38,13 +39,17 @@ class Path;
 
 /*!
   A StrokedPath represents the data needed to draw a path stroked.
-  It contains -all- the data needed to stroke a path regardless of
+  It provides -all- the data needed to stroke a path regardless of
   stroking style. in particular, for a given TessellatedPath,
   one only needs to construct a StrokedPath <i>once</i> regardless
-  of how one strokes the original path for drawing.
+  of how one strokes the original path for drawing. The data of
+  each \ref point_set_t, including the data of the edges, is created
+  the first time it is requested. The creation is not thread safe,
+  i.e. the first request for a point set must not be done
+  concurrently with other uses of the StrokedPath.
  */
 class StrokedPath:
-    public reference_counted<StrokedPath>::non_concurrent
+    public reference_counted<StrokedPath>::atomic
 {
 public:
   /*!
@@ -89,6 +94,15 @@ public:
        */
       offset_cap_join,
 
+      /*!
+        The point is a corner of the quad of a single segment
+        of an edge of the path. Such points carry only the
+        segment itself: the normal is computed from the vector
+        to the other end of the segment. See \ref
+        edge_segment_point_set.
+       */
+      offset_edge_segment,
+
       /*!
         Number different point types with respect to rendering
        */
@@ -135,6 +149,20 @@ public:
        */
       cap_join_point_set,
 
+      /*!
+        Select the set of points for edges where each segment
+        of the tessellation is drawn as a quad of 4 points of
+        type \ref offset_edge_segment instead of the 6 points
+        of \ref edge_point_set. Segments are joined to the next
+        segment of the same edge by one triangle. There are no
+        points on the path itself; instead point::on_boundary()
+        is +1 on one side of the segment and -1 on the other
+        side. The points of a segment have the same depth as
+        the points of the segment in \ref edge_point_set.
+        Segments of zero length are skipped.
+       */
+      edge_segment_point_set,
+
       /*!
         Number point set types
        */
@@ -269,6 +297,8 @@ public:
       m_on_boundary is interpolated across the triangle
       the center of stroking the value is 0 and the
       value has absolute value +1 on the boundary.
+      For points of type \ref offset_edge_segment, the
+      sign gives on which side of the segment the point is.
      */
     int
     on_boundary(void) const
@@ -362,9 +392,19 @@ public:
         The vector n0 represents the normal of the path going into the join,
         the vector n1 represents the normal of the path going out of the join
         and t represents how much to interpolate from n0 to n1.
+      - For those with offset_type() being StrokedPath::offset_edge_segment,
+        m_auxilary_offset is the vector from m_position to the other
+        end of the segment and m_pre_offset.x() is +1 or -1 giving
+        the side. The value is given by the following code
+        \code
+        vec2 t(m_auxilary_offset / m_auxilary_offset.magnitude());
+        offset = m_pre_offset.x() * vec2(-t.y(), t.x());
+        \endcode
+        This is the same computation the stroke vertex shader
+        performs, so it serves as a reference for that shader.
      */
     vec2
-    offset_vector(void);
+    offset_vector(void) const;
 
     /*!
       When offset_type() is offset_miter_join, returns the distance
@@ -438,6 +478,20 @@ public:
   unsigned int
   number_contours(void) const;
 
+  /*!
+    Returns the min-corner of the bounding box of the
+    TessellatedPath from which the StrokedPath was made.
+   */
+  vec2
+  bounding_box_min(void) const;
+
+  /*!
+    Returns the max-corner of the bounding box of the
+    TessellatedPath from which the StrokedPath was made.
+   */
+  vec2
+  bounding_box_max(void) const;
+
   /*!
     Returns the number of joins for the named contour
     of the generating path. Joint numbering is so that
@@ -477,6 +531,30 @@ public:
   range_type<unsigned int>
   indices_range(enum point_set_t tp, unsigned int contour, unsigned int J) const;
 
+  /*!
+    Returns the distance from the start of its contour of each
+    join, sorted in increasing order. The join at index I is
+    the join whose chunk in painter_data() is given by passing
+    sorted_join_ids(including_closing_edge)[I] to
+    PainterAttributeData::chunk_from_join(). The table is made
+    at ctor so that dashed stroking can find the joins within
+    the dash pattern without visiting every join.
+    \param including_closing_edge if false, the joins of the
+                                  closing edges are not included
+   */
+  const_c_array<float>
+  sorted_join_distances(bool including_closing_edge) const;
+
+  /*!
+    Returns the join ids, i.e. the values to pass to
+    PainterAttributeData::chunk_from_join(), in the same
+    order as sorted_join_distances().
+    \param including_closing_edge if false, the joins of the
+                                  closing edges are not included
+   */
+  const_c_array<unsigned int>
+  sorted_join_ids(bool including_closing_edge) const;
+
   /*!
     Returns data that can be passed to a PainterPacker
     to stroke a path.
@@ -484,6 +562,20 @@ public:
   const PainterAttributeData&
   painter_data(void) const;
 
+  /*!
+    Returns a PainterAttributeDataHierarchy that spatially
+    partitions the triangles of a single chunk of painter_data().
+    A Painter uses it to send only those portions of the path
+    that are near the visible region when the path is stroked.
+    The hierarchy of a chunk is created the first time it is
+    requested.
+    \param chunk which chunk, must be one of the values of
+                 PainterAttributeData::stroking_data_t other
+                 than PainterAttributeData::stroking_data_count
+   */
+  const PainterAttributeDataHierarchy&
+  painter_data_hierarchy(unsigned int chunk) const;
+
 private:
   void *m_d;
 };
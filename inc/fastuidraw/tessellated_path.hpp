@@ -31,6 +31,7 @@ namespace fastuidraw  {
 
 ///@cond
 class Path;
+class PathTessellationPool;
 ///@endcond
 
 /*!\addtogroup Core
@@ -41,7 +42,7 @@ class Path;
   A TessellatedPath represents the tessellation of a Path.
  */
 class TessellatedPath:
-    public reference_counted<TessellatedPath>::non_concurrent
+    public reference_counted<TessellatedPath>::atomic
 {
 public:
   /*!
@@ -56,7 +57,8 @@ public:
      */
     TessellationParams(void):
       m_curve_tessellation(float(M_PI)/30.0f),
-      m_max_segments(32)
+      m_max_segments(32),
+      m_fill_triangulation(FilledPath::default_triangulation())
     {}
 
     /*!
@@ -67,7 +69,8 @@ public:
     operator!=(const TessellationParams &rhs) const
     {
       return m_curve_tessellation != rhs.m_curve_tessellation
-        || m_max_segments != rhs.m_max_segments;
+        || m_max_segments != rhs.m_max_segments
+        || m_fill_triangulation != rhs.m_fill_triangulation;
     }
 
     /*!
@@ -84,6 +87,12 @@ public:
       PathContour of a Path.
      */
     unsigned int m_max_segments;
+
+    /*!
+      Specifies how filled() triangulates the path,
+      initial value is FilledPath::default_triangulation().
+     */
+    enum FilledPath::triangulation_t m_fill_triangulation;
   };
 
   /*!
@@ -140,8 +149,32 @@ public:
     Ctor. Construct a TessellatedPath from a Path
     \param input source path to tessellate
     \param P parameters on how to tessellate the source Path
+    \param pool if non-NULL, the edges of the source Path are
+                tessellated by the worker threads of pool together
+                with the calling thread; the edges are independent
+                of each other and the result is the same as when
+                tessellating on the calling thread only. It is
+                safe to pass the pool from a job of that pool.
    */
-  TessellatedPath(const Path &input, TessellationParams P);
+  TessellatedPath(const Path &input, TessellationParams P,
+                  const PathTessellationPool *pool = NULL);
+
+  /*!
+    Ctor. Construct a TessellatedPath that simplifies another
+    TessellatedPath by removing points (with the Douglas-Peucker
+    algorithm) so that the line segments move by no more than
+    a given distance. The end points of the contours without
+    their closing edge are kept. When the point shared by two
+    edges is removed, the two edges become one edge; as such
+    the simplified TessellatedPath can have fewer joins than
+    the input.
+    \param input TessellatedPath to simplify
+    \param max_deviation maximum distance, in coordinates of
+                         the path, between the line segments
+                         of input and the line segments of the
+                         simplified TessellatedPath
+   */
+  TessellatedPath(const TessellatedPath &input, float max_deviation);
 
   ~TessellatedPath();
 
@@ -243,6 +276,19 @@ public:
   vec2
   bounding_box_size(void) const;
 
+  /*!
+    Returns the maximum distance between the curves of
+    the Path and the line segments of the tessellation,
+    in the coordinates of the Path, as reported by
+    PathContour::interpolator_base::produce_tessellation()
+    for each edge. The edges of a
+    PathContour::interpolator_generic measure the distance
+    by sampling the curve between the end points of each
+    segment.
+   */
+  float
+  max_distance(void) const;
+
   /*!
     Returns this TessellatedPath stroked. The StrokedPath object
     is constructed lazily.
@@ -203,6 +203,28 @@ fastuidraw_gluNewTess_release(void);
 #endif
 
 
+/*
+  An arena from which a tessellator allocates its mesh, sweep-line
+  dictionary and priority queues. Memory freed by the tessellator
+  is kept by the arena for reuse and all of it is returned to the
+  arena when it is reset. An arena may be shared by tessellators
+  used on the same thread, but it may only be reset (or deleted)
+  when no tessellator using it is within a polygon.
+ */
+class fastuidraw_GLUarena;
+
+fastuidraw_GLUarena* fastuidraw_gluNewArena(void);
+void fastuidraw_gluDeleteArena(fastuidraw_GLUarena *arena);
+void fastuidraw_gluResetArena(fastuidraw_GLUarena *arena);
+
+/*
+  set the arena from which the tessellator allocates, a value
+  of NULL (the default) means to allocate from the heap. Must not
+  be called between fastuidraw_gluTessBeginPolygon() and
+  fastuidraw_gluTessEndPolygon().
+ */
+void fastuidraw_gluTessArena(fastuidraw_GLUtesselator *tess, fastuidraw_GLUarena *arena);
+
 void fastuidraw_gluTessBeginContour (fastuidraw_GLUtesselator* tess);
 void fastuidraw_gluTessBeginPolygon (fastuidraw_GLUtesselator* tess, void* data);
 void fastuidraw_gluTessEndContour (fastuidraw_GLUtesselator* tess);
@@ -33,7 +33,191 @@
 */
 
 #include "memalloc.hpp"
+#include "glu-tess.hpp"
 #include <string.h>
+#include <vector>
+#include <algorithm>
+#include <boost/thread.hpp>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+
+/* A fastuidraw_GLUarena hands out memory from large blocks.
+ * Every allocation is preceded by a header holding its size;
+ * small allocations that are freed go to a free list for their
+ * size and are reused by later allocations of the same size,
+ * large allocations are only returned on reset().
+ */
+class fastuidraw_GLUarena:fastuidraw::noncopyable
+{
+public:
+  fastuidraw_GLUarena(void);
+  ~fastuidraw_GLUarena();
+
+  void*
+  allocate(size_t n);
+
+  void*
+  reallocate(void *p, size_t n);
+
+  void
+  release(void *p);
+
+  void
+  reset(void);
+
+private:
+  enum
+    {
+      granularity = sizeof(double),
+      max_small_size = 32 * granularity,
+      block_size = 64 * 1024
+    };
+
+  static
+  size_t&
+  size_of_allocation(void *p)
+  {
+    return *(static_cast<size_t*>(p) - 1);
+  }
+
+  std::vector<char*> m_blocks, m_large;
+  unsigned int m_blocks_in_use;
+  size_t m_used;
+  fastuidraw::vecN<void*, max_small_size / granularity> m_free;
+};
+
+namespace
+{
+  void
+  no_cleanup(fastuidraw_GLUarena*)
+  {}
+
+  boost::thread_specific_ptr<fastuidraw_GLUarena> current_arena(&no_cleanup);
+}
+
+fastuidraw_GLUarena::
+fastuidraw_GLUarena(void):
+  m_blocks_in_use(0),
+  m_used(block_size),
+  m_free(static_cast<void*>(NULL))
+{}
+
+fastuidraw_GLUarena::
+~fastuidraw_GLUarena()
+{
+  reset();
+  for(unsigned int i = 0, endi = m_blocks.size(); i < endi; ++i)
+    {
+      FASTUIDRAWfree(m_blocks[i]);
+    }
+}
+
+void*
+fastuidraw_GLUarena::
+allocate(size_t n)
+{
+  char *p;
+
+  n = std::max(granularity * ((n + granularity - 1) / granularity), size_t(granularity));
+  if(n > max_small_size)
+    {
+      p = static_cast<char*>(FASTUIDRAWmalloc(n + granularity));
+      if(p == NULL)
+        {
+          return NULL;
+        }
+      m_large.push_back(p);
+    }
+  else if(m_free[n / granularity - 1] != NULL)
+    {
+      void *q;
+
+      q = m_free[n / granularity - 1];
+      m_free[n / granularity - 1] = *static_cast<void**>(q);
+      return q;
+    }
+  else
+    {
+      if(m_used + n + granularity > block_size)
+        {
+          if(m_blocks_in_use == m_blocks.size())
+            {
+              p = static_cast<char*>(FASTUIDRAWmalloc(block_size));
+              if(p == NULL)
+                {
+                  return NULL;
+                }
+              m_blocks.push_back(p);
+            }
+          ++m_blocks_in_use;
+          m_used = 0;
+        }
+      p = m_blocks[m_blocks_in_use - 1] + m_used;
+      m_used += n + granularity;
+    }
+
+  p += granularity;
+  size_of_allocation(p) = n;
+  return p;
+}
+
+void*
+fastuidraw_GLUarena::
+reallocate(void *p, size_t n)
+{
+  void *q;
+
+  if(p == NULL)
+    {
+      return allocate(n);
+    }
+
+  if(n <= size_of_allocation(p))
+    {
+      return p;
+    }
+
+  q = allocate(n);
+  if(q != NULL)
+    {
+      memcpy(q, p, size_of_allocation(p));
+      release(p);
+    }
+  return q;
+}
+
+void
+fastuidraw_GLUarena::
+release(void *p)
+{
+  size_t n;
+
+  if(p == NULL)
+    {
+      return;
+    }
+
+  n = size_of_allocation(p);
+  if(n <= max_small_size)
+    {
+      *static_cast<void**>(p) = m_free[n / granularity - 1];
+      m_free[n / granularity - 1] = p;
+    }
+}
+
+void
+fastuidraw_GLUarena::
+reset(void)
+{
+  for(unsigned int i = 0, endi = m_large.size(); i < endi; ++i)
+    {
+      FASTUIDRAWfree(m_large[i]);
+    }
+  m_large.clear();
+  m_blocks_in_use = 0;
+  m_used = block_size;
+  std::fill(m_free.begin(), m_free.end(), static_cast<void*>(NULL));
+}
 
 int glu_fastuidraw_gl_memInit( size_t maxFast )
 {
@@ -46,9 +230,72 @@ int glu_fastuidraw_gl_memInit( size_t maxFast )
    return 1;
 }
 
-#ifdef MEMORY_DEBUG
 void *glu_fastuidraw_gl_memAlloc( size_t n )
 {
-  return memset( FASTUIDRAWmalloc( n ), 0xa5, n );
-}
+  fastuidraw_GLUarena *arena;
+  void *p;
+
+  arena = current_arena.get();
+  p = (arena != NULL) ? arena->allocate( n ) : FASTUIDRAWmalloc( n );
+#ifdef MEMORY_DEBUG
+  if( p != NULL ) {
+    memset( p, 0xa5, n );
+  }
 #endif
+  return p;
+}
+
+void *glu_fastuidraw_gl_memRealloc( void *p, size_t n )
+{
+  fastuidraw_GLUarena *arena;
+
+  arena = current_arena.get();
+  return (arena != NULL) ? arena->reallocate( p, n ) : FASTUIDRAWrealloc( p, n );
+}
+
+void glu_fastuidraw_gl_memFree( void *p )
+{
+  fastuidraw_GLUarena *arena;
+
+  arena = current_arena.get();
+  if( arena != NULL ) {
+    arena->release( p );
+  } else {
+    FASTUIDRAWfree( p );
+  }
+}
+
+glu_fastuidraw_gl_arena_scope::
+glu_fastuidraw_gl_arena_scope( fastuidraw_GLUarena *arena ):
+  m_prev(current_arena.get())
+{
+  if( arena != m_prev ) {
+    current_arena.reset( arena );
+  }
+}
+
+glu_fastuidraw_gl_arena_scope::
+~glu_fastuidraw_gl_arena_scope()
+{
+  if( current_arena.get() != m_prev ) {
+    current_arena.reset( m_prev );
+  }
+}
+
+fastuidraw_GLUarena *
+fastuidraw_gluNewArena( void )
+{
+  return FASTUIDRAWnew fastuidraw_GLUarena();
+}
+
+void
+fastuidraw_gluDeleteArena( fastuidraw_GLUarena *arena )
+{
+  FASTUIDRAWdelete( arena );
+}
+
+void
+fastuidraw_gluResetArena( fastuidraw_GLUarena *arena )
+{
+  arena->reset();
+}
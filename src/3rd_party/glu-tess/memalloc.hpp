@@ -38,18 +38,39 @@
 #include <stdlib.h>
 #include <fastuidraw/util/fastuidraw_memory.hpp>
 
-#define memRealloc      FASTUIDRAWrealloc
-#define memFree         FASTUIDRAWfree
+class fastuidraw_GLUarena;
+
+#define memRealloc      glu_fastuidraw_gl_memRealloc
+#define memFree         glu_fastuidraw_gl_memFree
+#define memAlloc        glu_fastuidraw_gl_memAlloc
 
 #define memInit         glu_fastuidraw_gl_memInit
 /*extern void           glu_fastuidraw_gl_memInit( size_t );*/
 extern int              glu_fastuidraw_gl_memInit( size_t );
 
-#ifndef MEMORY_DEBUG
-#define memAlloc        FASTUIDRAWmalloc
-#else
-#define memAlloc        glu_fastuidraw_gl_memAlloc
+/* memAlloc, memRealloc and memFree allocate from the arena
+ * of the innermost glu_fastuidraw_gl_arena_scope of the
+ * calling thread, and from the heap if there is none.
+ */
 extern void *           glu_fastuidraw_gl_memAlloc( size_t );
-#endif
+extern void *           glu_fastuidraw_gl_memRealloc( void *, size_t );
+extern void             glu_fastuidraw_gl_memFree( void * );
+
+/* Makes an arena current for the calling thread for the
+ * lifetime of the object; a NULL arena means to use the heap.
+ * Each entry point of the tessellator that creates or destroys
+ * mesh elements opens a scope for the arena of the tessellator.
+ */
+class glu_fastuidraw_gl_arena_scope
+{
+public:
+  explicit
+  glu_fastuidraw_gl_arena_scope( fastuidraw_GLUarena *arena );
+
+  ~glu_fastuidraw_gl_arena_scope();
+
+private:
+  fastuidraw_GLUarena *m_prev;
+};
 
 #endif
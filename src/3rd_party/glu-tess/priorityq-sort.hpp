@@ -55,7 +55,7 @@
 #define PQhandle                PQSortHandle
 #define PriorityQ               PriorityQSort
 
-#define pqNewPriorityQ(leq)     glu_fastuidraw_gl_pqSortNewPriorityQ(leq)
+#define pqNewPriorityQ(leq,size) glu_fastuidraw_gl_pqSortNewPriorityQ(leq,size)
 #define pqDeletePriorityQ(pq)   glu_fastuidraw_gl_pqSortDeletePriorityQ(pq)
 
 /* The basic operations are insertion of a new key (pqInsert),
@@ -103,7 +103,7 @@ struct PriorityQ {
   int           (*leq)(PQkey key1, PQkey key2);
 };
 
-PriorityQ       *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2) );
+PriorityQ       *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2), long size );
 void            pqDeletePriorityQ( PriorityQ *pq );
 
 int             pqInit( PriorityQ *pq );
@@ -46,9 +46,13 @@
 
 #include "priorityq-sort.hpp"
 
-/* really glu_fastuidraw_gl_pqSortNewPriorityQ */
-PriorityQ *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2) )
+/* really glu_fastuidraw_gl_pqSortNewPriorityQ, size is the
+ * number of keys that will be inserted before pqInit, the
+ * key array is allocated large enough to hold them at once.
+ */
+PriorityQ *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2), long size )
 {
+  long max = (size < INIT_SIZE) ? INIT_SIZE : size + 1;
   PriorityQ *pq = (PriorityQ *)memAlloc( sizeof( PriorityQ ));
   if (pq == NULL) return NULL;
 
@@ -58,7 +62,7 @@ PriorityQ *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2) )
      return NULL;
   }
 
-  pq->keys = (PQHeapKey *)memAlloc( INIT_SIZE * sizeof(pq->keys[0]) );
+  pq->keys = (PQHeapKey *)memAlloc( max * sizeof(pq->keys[0]) );
   if (pq->keys == NULL) {
      glu_fastuidraw_gl_pqHeapDeletePriorityQ(pq->heap);
      memFree(pq);
@@ -66,7 +70,7 @@ PriorityQ *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2) )
   }
 
   pq->size = 0;
-  pq->max = INIT_SIZE;
+  pq->max = max;
   pq->initialized = FALSE;
   pq->leq = leq;
   return pq;
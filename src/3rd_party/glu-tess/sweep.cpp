@@ -1232,12 +1232,17 @@ static int InitPriorityQ( fastuidraw_GLUtesselator *tess )
 {
   PriorityQ *pq;
   GLUvertex *v, *vHead;
+  long count = 0;
+
+  vHead = &tess->mesh->vHead;
+  for( v = vHead->next; v != vHead; v = v->next ) {
+    ++count;
+  }
 
   /* glu_fastuidraw_gl_pqSortNewPriorityQ */
-  pq = tess->pq = pqNewPriorityQ( (int (*)(PQkey, PQkey)) glu_fastuidraw_gl_vertLeq );
+  pq = tess->pq = pqNewPriorityQ( (int (*)(PQkey, PQkey)) glu_fastuidraw_gl_vertLeq, count );
   if (pq == NULL) return 0;
 
-  vHead = &tess->mesh->vHead;
   for( v = vHead->next; v != vHead; v = v->next ) {
     v->pqHandle = pqInsert( pq, v ); /* glu_fastuidraw_gl_pqSortInsert */
     if (v->pqHandle == LONG_MAX) break;
@@ -179,7 +179,8 @@ fastuidraw_gluNewTess_release( void )
   if (memInit( MAX_FAST_ALLOC ) == 0) {
      return 0;                  /* out of memory */
   }
-  tess = (fastuidraw_GLUtesselator *)memAlloc( sizeof( fastuidraw_GLUtesselator ));
+  /* the tessellator itself never lives in an arena */
+  tess = (fastuidraw_GLUtesselator *)FASTUIDRAWmalloc( sizeof( fastuidraw_GLUtesselator ));
   if (tess == NULL) {
      return 0;                  /* out of memory */
   }
@@ -209,6 +210,7 @@ fastuidraw_gluNewTess_release( void )
   tess->callWindingData= &glu_fastuidraw_gl_noWindingData;
 
   tess->polygonData= NULL;
+  tess->arena = NULL;
 
   tess->fastuidraw_alloc_tracker = NULL;
 
@@ -277,8 +279,18 @@ fastuidraw_gluDeleteTess_debug(fastuidraw_GLUtesselator* tess, const char *file,
 void REGALFASTUIDRAW_GLU_CALL
 fastuidraw_gluDeleteTess_release( fastuidraw_GLUtesselator *tess )
 {
-  RequireState( tess, T_DORMANT );
-  memFree( tess );
+  {
+    glu_fastuidraw_gl_arena_scope scope( tess->arena );
+    RequireState( tess, T_DORMANT );
+  }
+  FASTUIDRAWfree( tess );
+}
+
+void REGALFASTUIDRAW_GLU_CALL
+fastuidraw_gluTessArena( fastuidraw_GLUtesselator *tess, fastuidraw_GLUarena *arena )
+{
+  assert( tess->state == T_DORMANT );
+  tess->arena = arena;
 }
 
 void REGALFASTUIDRAW_GLU_CALL
@@ -483,6 +495,7 @@ void REGALFASTUIDRAW_GLU_CALL
 fastuidraw_gluTessVertex( fastuidraw_GLUtesselator *tess, double x, double y, unsigned int data )
 {
   int tooLarge = FALSE;
+  glu_fastuidraw_gl_arena_scope scope( tess->arena );
 
   RequireState( tess, T_IN_CONTOUR );
 
@@ -521,6 +534,7 @@ fastuidraw_gluTessVertex( fastuidraw_GLUtesselator *tess, double x, double y, un
 void REGALFASTUIDRAW_GLU_CALL
 fastuidraw_gluTessBeginPolygon( fastuidraw_GLUtesselator *tess, void *data )
 {
+  glu_fastuidraw_gl_arena_scope scope( tess->arena );
   RequireState( tess, T_DORMANT );
 
   tess->state = T_IN_POLYGON;
@@ -535,6 +549,7 @@ fastuidraw_gluTessBeginPolygon( fastuidraw_GLUtesselator *tess, void *data )
 void REGALFASTUIDRAW_GLU_CALL
 fastuidraw_gluTessBeginContour( fastuidraw_GLUtesselator *tess )
 {
+  glu_fastuidraw_gl_arena_scope scope( tess->arena );
   RequireState( tess, T_IN_POLYGON );
 
   tess->state = T_IN_CONTOUR;
@@ -552,6 +567,7 @@ fastuidraw_gluTessBeginContour( fastuidraw_GLUtesselator *tess )
 void REGALFASTUIDRAW_GLU_CALL
 fastuidraw_gluTessEndContour( fastuidraw_GLUtesselator *tess )
 {
+  glu_fastuidraw_gl_arena_scope scope( tess->arena );
   RequireState( tess, T_IN_CONTOUR );
   tess->state = T_IN_POLYGON;
 }
@@ -560,6 +576,7 @@ void REGALFASTUIDRAW_GLU_CALL
 fastuidraw_gluTessEndPolygon( fastuidraw_GLUtesselator *tess )
 {
   GLUmesh *mesh;
+  glu_fastuidraw_gl_arena_scope scope( tess->arena );
 
   if (setjmp(tess->env) != 0) {
      /* come back here if out of memory */
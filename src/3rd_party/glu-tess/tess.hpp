@@ -121,6 +121,8 @@ struct fastuidraw_GLUtesselator {
 
   void *polygonData;            /* client data for current polygon */
 
+  fastuidraw_GLUarena *arena;   /* where the mesh, dict and pq are allocated */
+
   /*for tracking tessellation creation, only active in debug
    */
   void *fastuidraw_alloc_tracker;
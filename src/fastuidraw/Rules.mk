@@ -23,7 +23,8 @@ include $(dir)/Rules.mk
 dir := $(d)/gl_backend
 include $(dir)/Rules.mk
 
-LIBRARY_SOURCES += $(call filelist, image.cpp colorstop.cpp colorstop_atlas.cpp path.cpp tessellated_path.cpp stroked_path.cpp filled_path.cpp)
+LIBRARY_SOURCES += $(call filelist, image.cpp colorstop.cpp colorstop_atlas.cpp path.cpp tessellated_path.cpp stroked_path.cpp filled_path.cpp \
+	path_tessellation_pool.cpp)
 
 # Begin standard footer
 d		:= $(dirstack_$(sp))
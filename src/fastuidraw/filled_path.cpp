@@ -19,14 +19,15 @@
 
 #include <vector>
 #include <map>
-#include <list>
 #include <algorithm>
+#include <boost/atomic.hpp>
 
 #include <fastuidraw/filled_path.hpp>
 #include <fastuidraw/tessellated_path.hpp>
 #include <fastuidraw/path.hpp>
 #include <fastuidraw/painter/painter_attribute_data.hpp>
 #include "private/util_private.hpp"
+#include "private/sweep_triangulator.hpp"
 
 /* internal header
  */
@@ -38,21 +39,19 @@ namespace
     public fastuidraw::reference_counted<per_winding_data>::non_concurrent
   {
   public:
-    per_winding_data(void):
-      m_count(0)
+    per_winding_data(void)
     {}
 
     void
     add_index(unsigned int idx)
     {
       m_indices.push_back(idx);
-      ++m_count;
     }
 
     unsigned int
     count(void) const
     {
-      return m_count;
+      return m_indices.size();
     }
 
     void
@@ -61,14 +60,13 @@ namespace
             fastuidraw::const_c_array<unsigned int> &sub_range)
     {
       assert(count() + offset <= dest.size());
-      std::copy(m_indices.begin(), m_indices.end(), &dest[offset]);
+      std::copy(m_indices.begin(), m_indices.end(), dest.c_ptr() + offset);
       sub_range = dest.sub_array(offset, count());
       offset += count();
     }
 
   private:
-    std::list<unsigned int> m_indices;
-    unsigned int m_count;
+    std::vector<unsigned int> m_indices;
   };
 
   typedef std::map<int, fastuidraw::reference_counted_ptr<per_winding_data> > winding_index_hoard;
@@ -87,8 +85,8 @@ namespace
          - bounding box points (4 points)
          - added points from tessellation
      */
-    explicit
-    tesser(std::vector<fastuidraw::vec2> &points);
+    tesser(std::vector<fastuidraw::vec2> &points,
+           fastuidraw_GLUarena *arena);
 
     virtual
     ~tesser(void);
@@ -159,14 +157,16 @@ namespace
     static
     void
     execute_path(std::vector<fastuidraw::vec2> &points,
+                 fastuidraw_GLUarena *arena,
                  const fastuidraw::TessellatedPath &P,
                  winding_index_hoard &hoard)
     {
-      non_zero_tesser NZ(points, P, hoard);
+      non_zero_tesser NZ(points, arena, P, hoard);
     }
 
   private:
     non_zero_tesser(std::vector<fastuidraw::vec2> &points,
+                    fastuidraw_GLUarena *arena,
                     const fastuidraw::TessellatedPath &P,
                     winding_index_hoard &hoard);
 
@@ -194,15 +194,17 @@ namespace
     static
     void
     execute_path(std::vector<fastuidraw::vec2> &points,
+                 fastuidraw_GLUarena *arena,
                  const fastuidraw::TessellatedPath &P,
                  winding_index_hoard &hoard)
     {
-      zero_tesser Z(points, P, hoard);
+      zero_tesser Z(points, arena, P, hoard);
     }
 
   private:
 
     zero_tesser(std::vector<fastuidraw::vec2> &points,
+                fastuidraw_GLUarena *arena,
                 const fastuidraw::TessellatedPath &P,
                 winding_index_hoard &hoard);
 
@@ -221,12 +223,41 @@ namespace
     fastuidraw::reference_counted_ptr<per_winding_data> &m_indices;
   };
 
+  class sweep_tesser:private fastuidraw::sweep_triangulator
+  {
+  public:
+
+    static
+    void
+    execute_path(std::vector<fastuidraw::vec2> &points,
+                 const fastuidraw::TessellatedPath &P,
+                 winding_index_hoard &hoard)
+    {
+      sweep_tesser S(points, P, hoard);
+    }
+
+  private:
+    sweep_tesser(std::vector<fastuidraw::vec2> &points,
+                 const fastuidraw::TessellatedPath &P,
+                 winding_index_hoard &hoard);
+
+    virtual
+    void
+    add_triangle(int winding_number, unsigned int a,
+                 unsigned int b, unsigned int c);
+
+    winding_index_hoard &m_hoard;
+    int m_current_winding;
+    fastuidraw::reference_counted_ptr<per_winding_data> m_current_indices;
+  };
+
   class builder:fastuidraw::noncopyable
   {
   public:
     explicit
     builder(const fastuidraw::TessellatedPath &P,
-            std::vector<fastuidraw::vec2> &pts);
+            std::vector<fastuidraw::vec2> &pts,
+            enum fastuidraw::FilledPath::triangulation_t tri);
 
     ~builder();
 
@@ -245,11 +276,12 @@ namespace
     std::vector<fastuidraw::vec2> &m_points;
   };
 
+
   class FilledPathPrivate
   {
   public:
-    explicit
-    FilledPathPrivate(const fastuidraw::TessellatedPath &P);
+    FilledPathPrivate(const fastuidraw::TessellatedPath &P,
+                      enum fastuidraw::FilledPath::triangulation_t tri);
 
     ~FilledPathPrivate();
 
@@ -281,16 +313,24 @@ namespace
     fastuidraw::const_c_array<unsigned int> m_even_winding, m_zero_winding;
 
     fastuidraw::PainterAttributeData *m_attribute_data;
+    fastuidraw::PainterAttributeDataHierarchy *m_attribute_data_hierarchy;
   };
+
+  /* read by every TessellatedPath::TessellationParams ctor, which
+     also runs on the worker threads of a PathTessellationPool
+   */
+  boost::atomic<int> default_triangulation_value(fastuidraw::FilledPath::glu_triangulation);
 }
 
 ////////////////////////////////////////
 // tesser methods
 tesser::
-tesser(std::vector<fastuidraw::vec2> &points):
+tesser(std::vector<fastuidraw::vec2> &points,
+       fastuidraw_GLUarena *arena):
   m_points(points)
 {
   m_tess = fastuidraw_gluNewTess;
+  fastuidraw_gluTessArena(m_tess, arena);
   fastuidraw_gluTessCallbackBegin(m_tess, &begin_callBack);
   fastuidraw_gluTessCallbackVertex(m_tess, &vertex_callBack);
   fastuidraw_gluTessCallbackCombine(m_tess, &combine_callback);
@@ -452,9 +492,10 @@ winding_callBack(int winding_number, void *tess)
 // non_zero_tesser methods
 non_zero_tesser::
 non_zero_tesser(std::vector<fastuidraw::vec2> &points,
+                fastuidraw_GLUarena *arena,
                 const fastuidraw::TessellatedPath &P,
                 winding_index_hoard &hoard):
-  tesser(points),
+  tesser(points, arena),
   m_hoard(hoard),
   m_current_winding(0)
 {
@@ -502,9 +543,10 @@ fill_region(int winding_number)
 // zero_tesser methods
 zero_tesser::
 zero_tesser(std::vector<fastuidraw::vec2> &points,
+            fastuidraw_GLUarena *arena,
             const fastuidraw::TessellatedPath &P,
             winding_index_hoard &hoard):
-  tesser(points),
+  tesser(points, arena),
   m_indices(hoard[0])
 {
   if(!m_indices)
@@ -544,19 +586,102 @@ fill_region(int winding_number)
     FASTUIDRAW_GLU_FALSE;
 }
 
+///////////////////////////////
+// sweep_tesser methods
+sweep_tesser::
+sweep_tesser(std::vector<fastuidraw::vec2> &points,
+             const fastuidraw::TessellatedPath &P,
+             winding_index_hoard &hoard):
+  fastuidraw::sweep_triangulator(points),
+  m_hoard(hoard),
+  m_current_winding(0)
+{
+  unsigned int box(P.point_data().size());
+
+  /* the contours are fed exactly as tesser::add_path()
+     does, i.e. the last point of each edge is skipped
+     because it is the first point of the next edge.
+   */
+  for(unsigned int o = 0, endo = P.number_contours(); o < endo; ++o)
+    {
+      unsigned int first(0), prev(0);
+      bool has_prev(false);
+
+      for(unsigned int e = 0, ende = P.number_edges(o); e < ende; ++e)
+        {
+          fastuidraw::range_type<unsigned int> R(P.edge_range(o, e));
+          for(unsigned int v = R.m_begin; v + 1 < R.m_end; ++v)
+            {
+              if(has_prev)
+                {
+                  add_edge(prev, v);
+                }
+              else
+                {
+                  first = v;
+                  has_prev = true;
+                }
+              prev = v;
+            }
+        }
+
+      if(has_prev)
+        {
+          add_edge(prev, first);
+        }
+    }
+  set_boundary(box, box + 1, box + 2, box + 3);
+  triangulate();
+}
+
+void
+sweep_tesser::
+add_triangle(int winding_number, unsigned int a,
+             unsigned int b, unsigned int c)
+{
+  if(!m_current_indices || m_current_winding != winding_number)
+    {
+      fastuidraw::reference_counted_ptr<per_winding_data> &h(m_hoard[winding_number]);
+      m_current_winding = winding_number;
+      if(!h)
+        {
+          h = FASTUIDRAWnew per_winding_data();
+        }
+      m_current_indices = h;
+    }
+  m_current_indices->add_index(a);
+  m_current_indices->add_index(b);
+  m_current_indices->add_index(c);
+}
+
 /////////////////////////////////////////
 // builder methods
 builder::
-builder(const fastuidraw::TessellatedPath &P, std::vector<fastuidraw::vec2> &points):
+builder(const fastuidraw::TessellatedPath &P, std::vector<fastuidraw::vec2> &points,
+        enum fastuidraw::FilledPath::triangulation_t tri):
   m_points(points)
 {
   init_points(P);
 
+  if(tri == fastuidraw::FilledPath::sweep_line_triangulation)
+    {
+      sweep_tesser::execute_path(m_points, P, m_hoard);
+      return;
+    }
+
+  /* both passes allocate their meshes from the same arena,
+     which is reset between them so that the second pass
+     reuses the memory of the first.
+   */
+  fastuidraw_GLUarena *arena(fastuidraw_gluNewArena());
+
   // std::cout << "Non-zero building\n";
-  non_zero_tesser::execute_path(m_points, P, m_hoard);
+  non_zero_tesser::execute_path(m_points, arena, P, m_hoard);
+  fastuidraw_gluResetArena(arena);
 
   // std::cout << "Zero building\n";
-  zero_tesser::execute_path(m_points, P, m_hoard);
+  zero_tesser::execute_path(m_points, arena, P, m_hoard);
+  fastuidraw_gluDeleteArena(arena);
 }
 
 builder::
@@ -678,10 +803,12 @@ fill_indices(std::vector<unsigned int> &indices,
 /////////////////////////////////
 // FilledPathPrivate methods
 FilledPathPrivate::
-FilledPathPrivate(const fastuidraw::TessellatedPath &P):
-  m_attribute_data(NULL)
+FilledPathPrivate(const fastuidraw::TessellatedPath &P,
+                  enum fastuidraw::FilledPath::triangulation_t tri):
+  m_attribute_data(NULL),
+  m_attribute_data_hierarchy(NULL)
 {
-  builder B(P, m_points);
+  builder B(P, m_points, tri);
   unsigned int even_non_zero_start, zero_start;
 
   B.fill_indices(m_indices, m_per_fill, even_non_zero_start, zero_start);
@@ -727,6 +854,11 @@ FilledPathPrivate(const fastuidraw::TessellatedPath &P):
 FilledPathPrivate::
 ~FilledPathPrivate()
 {
+  if(m_attribute_data_hierarchy != NULL)
+    {
+      FASTUIDRAWdelete(m_attribute_data_hierarchy);
+    }
+
   if(m_attribute_data != NULL)
     {
       FASTUIDRAWdelete(m_attribute_data);
@@ -738,7 +870,13 @@ FilledPathPrivate::
 fastuidraw::FilledPath::
 FilledPath(const TessellatedPath &P)
 {
-  m_d = FASTUIDRAWnew FilledPathPrivate(P);
+  m_d = FASTUIDRAWnew FilledPathPrivate(P, P.tessellation_parameters().m_fill_triangulation);
+}
+
+fastuidraw::FilledPath::
+FilledPath(const TessellatedPath &P, enum triangulation_t tri)
+{
+  m_d = FASTUIDRAWnew FilledPathPrivate(P, tri);
 }
 
 fastuidraw::FilledPath::
@@ -787,6 +925,22 @@ painter_data(void) const
   return *d->m_attribute_data;
 }
 
+const fastuidraw::PainterAttributeDataHierarchy&
+fastuidraw::FilledPath::
+painter_data_hierarchy(void) const
+{
+  FilledPathPrivate *d;
+  d = reinterpret_cast<FilledPathPrivate*>(m_d);
+
+  if(d->m_attribute_data_hierarchy == NULL)
+    {
+      const PainterAttributeData &data(painter_data());
+      d->m_attribute_data_hierarchy =
+        FASTUIDRAWnew PainterAttributeDataHierarchy(data, data.index_data_chunks().size());
+    }
+  return *d->m_attribute_data_hierarchy;
+}
+
 fastuidraw::const_c_array<fastuidraw::vec2>
 fastuidraw::FilledPath::
 points(void) const
@@ -840,3 +994,17 @@ even_winding_indices(void) const
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
   return d->m_even_winding;
 }
+
+enum fastuidraw::FilledPath::triangulation_t
+fastuidraw::FilledPath::
+default_triangulation(void)
+{
+  return static_cast<enum triangulation_t>(default_triangulation_value.load());
+}
+
+void
+fastuidraw::FilledPath::
+default_triangulation(enum triangulation_t tri)
+{
+  default_triangulation_value.store(tri);
+}
@@ -57,7 +57,13 @@ namespace
       m_header_bo(0),
       m_index_bo(0),
       m_data_bo(0),
-      m_data_tbo(0)
+      m_data_tbo(0),
+      m_pool(0),
+      m_slot(0),
+      m_persistent_version(0),
+      m_attributes_per_buffer(0),
+      m_indices_per_buffer(0),
+      m_blocks_per_data_buffer(0)
     {}
 
     GLuint m_vao;
@@ -65,6 +71,21 @@ namespace
     GLuint m_data_tbo;
     enum fastuidraw::gl::PainterBackendGL::data_store_backing_t m_data_store_backing;
     unsigned int m_data_store_binding_point;
+
+    /* location within painter_vao_pool and the version
+       of the persistent region of m_data_bo; the value
+       of m_persistent_version is only maintained for the
+       element held by painter_vao_pool.
+     */
+    unsigned int m_pool, m_slot;
+    unsigned int m_persistent_version;
+
+    /* sizes of the buffers of the painter_vao, they
+       may lag behind the sizes of painter_vao_pool
+       until the painter_vao is requested again.
+     */
+    unsigned int m_attributes_per_buffer, m_indices_per_buffer;
+    unsigned int m_blocks_per_data_buffer;
   };
 
   class painter_vao_pool:fastuidraw::noncopyable
@@ -78,33 +99,53 @@ namespace
 
     ~painter_vao_pool();
 
+    static
     unsigned int
-    attribute_buffer_size(void) const
+    attribute_buffer_size(const painter_vao &vao)
     {
-      return m_attribute_buffer_size;
+      return vao.m_attributes_per_buffer * sizeof(fastuidraw::PainterAttribute);
     }
 
+    static
     unsigned int
-    header_buffer_size(void) const
+    header_buffer_size(const painter_vao &vao)
     {
-      return m_header_buffer_size;
+      return vao.m_attributes_per_buffer * sizeof(uint32_t);
     }
 
+    static
     unsigned int
-    index_buffer_size(void) const
+    index_buffer_size(const painter_vao &vao)
     {
-      return m_index_buffer_size;
+      return vao.m_indices_per_buffer * sizeof(fastuidraw::PainterIndex);
     }
 
     unsigned int
-    data_buffer_size(void) const
+    data_buffer_size(const painter_vao &vao) const
     {
-      return m_data_buffer_size;
+      return vao.m_blocks_per_data_buffer * m_alignment * sizeof(fastuidraw::generic_data);
     }
 
     painter_vao
     request_vao(void);
 
+    /* called by a DrawCommand when it is unmapped
+       to record how much of its buffers were used
+     */
+    void
+    record_usage(unsigned int attributes_written,
+                 unsigned int indices_written,
+                 unsigned int data_store_written);
+
+    void
+    ensure_room(unsigned int attributes, unsigned int indices);
+
+    unsigned int&
+    persistent_version(const painter_vao &vao)
+    {
+      return m_vaos[vao.m_pool][vao.m_slot].m_persistent_version;
+    }
+
     void
     next_pool(void);
 
@@ -121,10 +162,22 @@ namespace
     GLuint
     generate_bo(GLenum bind_target, GLsizei psize);
 
-    unsigned int m_attribute_buffer_size, m_header_buffer_size;
-    unsigned int m_index_buffer_size;
-    int m_alignment, m_blocks_per_data_buffer;
-    unsigned int m_data_buffer_size;
+    void
+    resize_buffers(painter_vao &vao);
+
+    static
+    unsigned int
+    adapt_size(unsigned int current, unsigned int demand,
+               unsigned int min_value, unsigned int max_value);
+
+    void
+    adapt_sizes(void);
+
+    unsigned int m_attributes_per_buffer, m_indices_per_buffer;
+    unsigned int m_blocks_per_data_buffer;
+    int m_alignment;
+    bool m_per_draw_header;
+    unsigned int m_persistent_store_blocks;
     enum fastuidraw::gl::PainterBackendGL::data_store_backing_t m_data_store_backing;
     enum fastuidraw::gl::detail::tex_buffer_support_t m_tex_buffer_support;
     fastuidraw::glsl::PainterBackendGLSL::BindingPoints m_binding_points;
@@ -132,6 +185,16 @@ namespace
     unsigned int m_current, m_pool;
     std::vector<std::vector<painter_vao> > m_vaos;
     std::vector<GLuint> m_ubos;
+
+    /* adaptive sizing: bounds of the sizes and the demand
+       of the current frame, see adapt_sizes(); m_chunk_sizes
+       is the largest chunk passed to ensure_room(), the sizes
+       never shrink below it.
+     */
+    bool m_adaptive;
+    fastuidraw::uvec3 m_min_sizes, m_max_sizes;
+    fastuidraw::uvec2 m_chunk_sizes;
+    fastuidraw::uvec3 m_frame_demand;
   };
 
   bool
@@ -182,6 +245,11 @@ namespace
     compute_base_config(const fastuidraw::gl::PainterBackendGL::ConfigurationGL &P,
                         const fastuidraw::PainterBackend::ConfigurationBase &config_base);
 
+    static
+    unsigned int
+    compute_data_blocks_per_store_buffer(enum fastuidraw::gl::PainterBackendGL::data_store_backing_t backing,
+                                         unsigned int requested, unsigned int alignment);
+
     const program_set&
     programs(bool rebuild);
 
@@ -227,20 +295,31 @@ namespace
   {
   public:
     DrawEntry(const fastuidraw::BlendMode &mode,
+              const fastuidraw::PainterShaderGroup &groups,
               PainterBackendGLPrivate *pr,
               unsigned int pz);
 
+    DrawEntry(const fastuidraw::BlendMode &mode,
+              const fastuidraw::PainterShaderGroup &groups);
 
+    explicit
     DrawEntry(const fastuidraw::BlendMode &mode);
 
     void
-    add_entry(GLsizei count, const void *offset);
+    add_entry(GLsizei count, const void *offset,
+              GLint base_vertex, GLuint base_instance);
 
     void
-    draw(void) const;
+    draw(bool stencil_clipping) const;
 
   private:
 
+    void
+    draw_base_vertex(void) const;
+
+    void
+    draw_base_instance(void) const;
+
     static
     GLenum
     convert_blend_op(enum fastuidraw::BlendMode::op_t v);
@@ -249,9 +328,17 @@ namespace
     GLenum
     convert_blend_func(enum fastuidraw::BlendMode::func_t v);
 
+    void
+    set_stencil_state(void) const;
+
     fastuidraw::BlendMode m_blend_mode;
+    uint32_t m_stencil_ref;
+    enum fastuidraw::PainterShaderGroup::stencil_action_t m_stencil_action;
     std::vector<GLsizei> m_counts;
     std::vector<const GLvoid*> m_indices;
+    std::vector<GLint> m_base_vertices;
+    std::vector<GLuint> m_base_instances;
+    bool m_uses_base_vertex, m_uses_base_instance;
     PainterBackendGLPrivate *m_private;
     unsigned int m_choice;
   };
@@ -274,6 +361,25 @@ namespace
                const fastuidraw::PainterShaderGroup &new_shaders,
                unsigned int attributes_written, unsigned int indices_written) const;
 
+    virtual
+    void
+    base_vertex_change(unsigned int base_vertex,
+                       unsigned int indices_written) const;
+
+    virtual
+    void
+    header_change(unsigned int header_entry,
+                  unsigned int indices_written) const;
+
+    virtual
+    unsigned int
+    persistent_store_version(void) const;
+
+    virtual
+    void
+    persistent_store_written(unsigned int version,
+                             fastuidraw::range_type<unsigned int> blocks) const;
+
     virtual
     void
     draw(void) const;
@@ -292,8 +398,12 @@ namespace
     add_entry(unsigned int indices_written) const;
 
     PainterBackendGLPrivate *m_pr;
+    painter_vao_pool *m_hnd;
     painter_vao m_vao;
+    mutable fastuidraw::range_type<unsigned int> m_persistent_written;
     mutable unsigned int m_attributes_written, m_indices_written;
+    mutable GLint m_base_vertex;
+    mutable GLuint m_header_entry, m_headers_written;
     mutable std::list<DrawEntry> m_draws;
   };
 
@@ -319,7 +429,14 @@ namespace
       m_assign_layout_to_varyings(false),
       m_assign_binding_points(true),
       m_use_ubo_for_uniforms(false),
-      m_separate_program_for_discard(true)
+      m_separate_program_for_discard(true),
+      m_use_base_vertex(true),
+      m_use_per_draw_header(false),
+      m_persistent_store_blocks(0),
+      m_adaptive_buffer_sizing(false),
+      m_min_attributes_per_buffer(4 * 1024),
+      m_min_indices_per_buffer((m_min_attributes_per_buffer * 6) / 4),
+      m_min_data_blocks_per_store_buffer(1024)
     {}
 
     unsigned int m_attributes_per_buffer;
@@ -341,6 +458,13 @@ namespace
     bool m_assign_binding_points;
     bool m_use_ubo_for_uniforms;
     bool m_separate_program_for_discard;
+    bool m_use_base_vertex;
+    bool m_use_per_draw_header;
+    unsigned int m_persistent_store_blocks;
+    bool m_adaptive_buffer_sizing;
+    unsigned int m_min_attributes_per_buffer;
+    unsigned int m_min_indices_per_buffer;
+    unsigned int m_min_data_blocks_per_store_buffer;
   };
 
 }
@@ -352,20 +476,44 @@ painter_vao_pool(const fastuidraw::gl::PainterBackendGL::ConfigurationGL &params
                  const fastuidraw::PainterBackend::ConfigurationBase &params_base,
                  enum fastuidraw::gl::detail::tex_buffer_support_t tex_buffer_support,
                  const fastuidraw::glsl::PainterBackendGLSL::BindingPoints &binding_points):
-  m_attribute_buffer_size(params.attributes_per_buffer() * sizeof(fastuidraw::PainterAttribute)),
-  m_header_buffer_size(params.attributes_per_buffer() * sizeof(uint32_t)),
-  m_index_buffer_size(params.indices_per_buffer() * sizeof(fastuidraw::PainterIndex)),
-  m_alignment(params_base.alignment()),
+  m_attributes_per_buffer(params.attributes_per_buffer()),
+  m_indices_per_buffer(params.indices_per_buffer()),
   m_blocks_per_data_buffer(params.data_blocks_per_store_buffer()),
-  m_data_buffer_size(m_blocks_per_data_buffer * m_alignment * sizeof(fastuidraw::generic_data)),
+  m_alignment(params_base.alignment()),
+  m_per_draw_header(params_base.per_draw_header()),
+  m_persistent_store_blocks(params_base.persistent_store_blocks()),
   m_data_store_backing(params.data_store_backing()),
   m_tex_buffer_support(tex_buffer_support),
   m_binding_points(binding_points),
   m_current(0),
   m_pool(0),
   m_vaos(params.number_pools()),
-  m_ubos(params.number_pools(), 0)
-{}
+  m_ubos(params.number_pools(), 0),
+  m_adaptive(params.adaptive_buffer_sizing()),
+  m_max_sizes(m_attributes_per_buffer, m_indices_per_buffer, m_blocks_per_data_buffer),
+  m_chunk_sizes(0, 0),
+  m_frame_demand(0, 0, 0)
+{
+  using namespace fastuidraw;
+
+  m_min_sizes[0] = t_min(m_max_sizes[0], params.min_attributes_per_buffer());
+  m_min_sizes[1] = t_min(m_max_sizes[1], params.min_indices_per_buffer());
+
+  /* the size of a UBO backed data store is baked into
+     the shaders, and the persistent region must not take
+     more than half of the data store.
+   */
+  if(m_data_store_backing == gl::PainterBackendGL::data_store_ubo)
+    {
+      m_min_sizes[2] = m_max_sizes[2];
+    }
+  else
+    {
+      m_min_sizes[2] = t_min(m_max_sizes[2],
+                             t_max(params.min_data_blocks_per_store_buffer(),
+                                   2 * m_persistent_store_blocks));
+    }
+}
 
 painter_vao_pool::
 ~painter_vao_pool()
@@ -434,12 +582,19 @@ request_vao(void)
       glBindVertexArray(m_vaos[m_pool][m_current].m_vao);
 
       m_vaos[m_pool][m_current].m_data_store_backing = m_data_store_backing;
+      m_vaos[m_pool][m_current].m_pool = m_pool;
+      m_vaos[m_pool][m_current].m_slot = m_current;
+
+      m_vaos[m_pool][m_current].m_attributes_per_buffer = m_attributes_per_buffer;
+      m_vaos[m_pool][m_current].m_indices_per_buffer = m_indices_per_buffer;
+      m_vaos[m_pool][m_current].m_blocks_per_data_buffer = m_blocks_per_data_buffer;
 
       switch(m_data_store_backing)
         {
         case fastuidraw::gl::PainterBackendGL::data_store_tbo:
           {
-            m_vaos[m_pool][m_current].m_data_bo = generate_bo(GL_TEXTURE_BUFFER, m_data_buffer_size);
+            m_vaos[m_pool][m_current].m_data_bo = generate_bo(GL_TEXTURE_BUFFER,
+                                                              data_buffer_size(m_vaos[m_pool][m_current]));
             m_vaos[m_pool][m_current].m_data_store_binding_point = m_binding_points.data_store_buffer_tbo();
             generate_tbos(m_vaos[m_pool][m_current]);
           }
@@ -447,7 +602,8 @@ request_vao(void)
 
         case fastuidraw::gl::PainterBackendGL::data_store_ubo:
           {
-            m_vaos[m_pool][m_current].m_data_bo = generate_bo(GL_ARRAY_BUFFER, m_data_buffer_size);
+            m_vaos[m_pool][m_current].m_data_bo = generate_bo(GL_ARRAY_BUFFER,
+                                                              data_buffer_size(m_vaos[m_pool][m_current]));
             m_vaos[m_pool][m_current].m_data_store_binding_point = m_binding_points.data_store_buffer_ubo();
           }
           break;
@@ -456,8 +612,10 @@ request_vao(void)
       /* generate_bo leaves the returned buffer object bound to
          the passed binding target.
       */
-      m_vaos[m_pool][m_current].m_attribute_bo = generate_bo(GL_ARRAY_BUFFER, m_attribute_buffer_size);
-      m_vaos[m_pool][m_current].m_index_bo = generate_bo(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer_size);
+      m_vaos[m_pool][m_current].m_attribute_bo = generate_bo(GL_ARRAY_BUFFER,
+                                                             attribute_buffer_size(m_vaos[m_pool][m_current]));
+      m_vaos[m_pool][m_current].m_index_bo = generate_bo(GL_ELEMENT_ARRAY_BUFFER,
+                                                         index_buffer_size(m_vaos[m_pool][m_current]));
 
       glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::primary_attrib_slot);
       v = fastuidraw::gl::opengl_trait_values<fastuidraw::uvec4>(sizeof(fastuidraw::PainterAttribute),
@@ -474,13 +632,25 @@ request_vao(void)
                                                                  offsetof(fastuidraw::PainterAttribute, m_attrib2));
       fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::uint_attrib_slot, v);
 
-      m_vaos[m_pool][m_current].m_header_bo = generate_bo(GL_ARRAY_BUFFER, m_header_buffer_size);
+      m_vaos[m_pool][m_current].m_header_bo = generate_bo(GL_ARRAY_BUFFER,
+                                                          header_buffer_size(m_vaos[m_pool][m_current]));
       glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::header_attrib_slot);
       v = fastuidraw::gl::opengl_trait_values<uint32_t>();
       fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::header_attrib_slot, v);
+      if(m_per_draw_header)
+        {
+          /* the header location is fetched per instance, the
+             base instance of each draw selects the entry.
+           */
+          glVertexAttribDivisor(fastuidraw::glsl::PainterBackendGLSL::header_attrib_slot, 1);
+        }
 
       glBindVertexArray(0);
     }
+  else
+    {
+      resize_buffers(m_vaos[m_pool][m_current]);
+    }
 
   return_value = m_vaos[m_pool][m_current];
   ++m_current;
@@ -488,10 +658,135 @@ request_vao(void)
   return return_value;
 }
 
+void
+painter_vao_pool::
+resize_buffers(painter_vao &vao)
+{
+  /* The buffer objects are kept and only their backing
+     store is respecified, so that the VAO and the TBO
+     continue to source from them. Respecifying is done
+     through GL_ARRAY_BUFFER to leave the element array
+     binding of any bound VAO untouched.
+   */
+  if(vao.m_attributes_per_buffer != m_attributes_per_buffer)
+    {
+      vao.m_attributes_per_buffer = m_attributes_per_buffer;
+      glBindBuffer(GL_ARRAY_BUFFER, vao.m_attribute_bo);
+      glBufferData(GL_ARRAY_BUFFER, attribute_buffer_size(vao), NULL, GL_STREAM_DRAW);
+      glBindBuffer(GL_ARRAY_BUFFER, vao.m_header_bo);
+      glBufferData(GL_ARRAY_BUFFER, header_buffer_size(vao), NULL, GL_STREAM_DRAW);
+    }
+
+  if(vao.m_indices_per_buffer != m_indices_per_buffer)
+    {
+      vao.m_indices_per_buffer = m_indices_per_buffer;
+      glBindBuffer(GL_ARRAY_BUFFER, vao.m_index_bo);
+      glBufferData(GL_ARRAY_BUFFER, index_buffer_size(vao), NULL, GL_STREAM_DRAW);
+    }
+
+  if(vao.m_blocks_per_data_buffer != m_blocks_per_data_buffer)
+    {
+      vao.m_blocks_per_data_buffer = m_blocks_per_data_buffer;
+      vao.m_persistent_version = 0;
+      glBindBuffer(GL_ARRAY_BUFFER, vao.m_data_bo);
+      glBufferData(GL_ARRAY_BUFFER, data_buffer_size(vao), NULL, GL_STREAM_DRAW);
+    }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void
+painter_vao_pool::
+record_usage(unsigned int attributes_written,
+             unsigned int indices_written,
+             unsigned int data_store_written)
+{
+  /* the persistent region is shared by all PainterDraw
+     objects, so it counts only once towards the demand.
+   */
+  unsigned int blocks;
+
+  blocks = data_store_written / m_alignment;
+  assert(blocks >= m_persistent_store_blocks);
+  if(m_frame_demand[2] == 0)
+    {
+      m_frame_demand[2] = m_persistent_store_blocks;
+    }
+  m_frame_demand[0] += attributes_written;
+  m_frame_demand[1] += indices_written;
+  m_frame_demand[2] += blocks - m_persistent_store_blocks;
+}
+
+unsigned int
+painter_vao_pool::
+adapt_size(unsigned int current, unsigned int demand,
+           unsigned int min_value, unsigned int max_value)
+{
+  unsigned int target;
+
+  /* grow at once to fit the demand with 25% headroom, but
+     only shrink (by half) once the demand is under a quarter
+     of the current size so that the sizes do not oscillate
+     between frames.
+   */
+  target = demand + demand / 4;
+  if(target > current)
+    {
+      current = fastuidraw::t_max(target, 2 * current);
+    }
+  else if(target < current / 4)
+    {
+      current = current / 2;
+    }
+  return fastuidraw::t_max(min_value, fastuidraw::t_min(max_value, current));
+}
+
+void
+painter_vao_pool::
+adapt_sizes(void)
+{
+  using namespace fastuidraw;
+
+  m_attributes_per_buffer = adapt_size(m_attributes_per_buffer, m_frame_demand[0],
+                                       t_min(m_max_sizes[0], t_max(m_min_sizes[0], m_chunk_sizes[0])),
+                                       m_max_sizes[0]);
+  m_indices_per_buffer = adapt_size(m_indices_per_buffer, m_frame_demand[1],
+                                    t_min(m_max_sizes[1], t_max(m_min_sizes[1], m_chunk_sizes[1])),
+                                    m_max_sizes[1]);
+  m_blocks_per_data_buffer = adapt_size(m_blocks_per_data_buffer, m_frame_demand[2],
+                                        m_min_sizes[2], m_max_sizes[2]);
+  m_frame_demand = uvec3(0, 0, 0);
+}
+
+void
+painter_vao_pool::
+ensure_room(unsigned int attributes, unsigned int indices)
+{
+  using namespace fastuidraw;
+
+  if(!m_adaptive)
+    {
+      return;
+    }
+
+  /* remember the chunk so that the sizes do not shrink
+     below it again, and grow right away so that the
+     next VAO requested holds it.
+   */
+  m_chunk_sizes[0] = t_max(m_chunk_sizes[0], attributes);
+  m_chunk_sizes[1] = t_max(m_chunk_sizes[1], indices);
+  m_attributes_per_buffer = t_max(m_attributes_per_buffer, t_min(m_max_sizes[0], attributes));
+  m_indices_per_buffer = t_max(m_indices_per_buffer, t_min(m_max_sizes[1], indices));
+}
+
 void
 painter_vao_pool::
 next_pool(void)
 {
+  if(m_adaptive)
+    {
+      adapt_sizes();
+    }
+
   ++m_pool;
   if(m_pool == m_vaos.size())
     {
@@ -549,38 +844,103 @@ generate_bo(GLenum bind_target, GLsizei psize)
 // DrawEntry methods
 DrawEntry::
 DrawEntry(const fastuidraw::BlendMode &mode,
+          const fastuidraw::PainterShaderGroup &groups,
           PainterBackendGLPrivate *pr,
           unsigned int pz):
   m_blend_mode(mode),
+  m_stencil_ref(groups.stencil_ref()),
+  m_stencil_action(groups.stencil_action()),
+  m_uses_base_vertex(false),
+  m_uses_base_instance(false),
   m_private(pr),
   m_choice(pz)
 {}
 
+DrawEntry::
+DrawEntry(const fastuidraw::BlendMode &mode,
+          const fastuidraw::PainterShaderGroup &groups):
+  m_blend_mode(mode),
+  m_stencil_ref(groups.stencil_ref()),
+  m_stencil_action(groups.stencil_action()),
+  m_uses_base_vertex(false),
+  m_uses_base_instance(false),
+  m_private(NULL),
+  m_choice(fastuidraw::gl::PainterBackendGL::number_program_types)
+{}
 
 DrawEntry::
 DrawEntry(const fastuidraw::BlendMode &mode):
   m_blend_mode(mode),
+  m_stencil_ref(0),
+  m_stencil_action(fastuidraw::PainterShaderGroup::stencil_test),
+  m_uses_base_vertex(false),
+  m_uses_base_instance(false),
   m_private(NULL),
   m_choice(fastuidraw::gl::PainterBackendGL::number_program_types)
 {}
 
 void
 DrawEntry::
-add_entry(GLsizei count, const void *offset)
+add_entry(GLsizei count, const void *offset,
+          GLint base_vertex, GLuint base_instance)
 {
   m_counts.push_back(count);
   m_indices.push_back(offset);
+  m_base_vertices.push_back(base_vertex);
+  m_base_instances.push_back(base_instance);
+  m_uses_base_vertex = m_uses_base_vertex || (base_vertex != 0);
+  m_uses_base_instance = m_uses_base_instance || (base_instance != 0);
 }
 
 void
 DrawEntry::
-draw(void) const
+set_stencil_state(void) const
+{
+  /* the draws that increment or decrement the stencil
+     buffer are the clipping draws of Painter which must
+     not affect the color or depth buffers.
+   */
+  glStencilFunc(GL_EQUAL, m_stencil_ref, ~0u);
+  switch(m_stencil_action)
+    {
+    case fastuidraw::PainterShaderGroup::stencil_increment:
+      glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+      break;
+
+    case fastuidraw::PainterShaderGroup::stencil_decrement:
+      glStencilOp(GL_KEEP, GL_KEEP, GL_DECR);
+      break;
+
+    default:
+      glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    }
+
+  if(m_stencil_action == fastuidraw::PainterShaderGroup::stencil_test)
+    {
+      glEnable(GL_DEPTH_TEST);
+      glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    }
+  else
+    {
+      glDisable(GL_DEPTH_TEST);
+      glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    }
+}
+
+void
+DrawEntry::
+draw(bool stencil_clipping) const
 {
   if(m_private)
     {
       m_private->m_programs[m_choice]->use_program();
     }
 
+  if(stencil_clipping)
+    {
+      set_stencil_state();
+    }
+
   if(m_blend_mode.blending_on())
     {
       glEnable(GL_BLEND);
@@ -597,6 +957,20 @@ draw(void) const
     }
   assert(!m_counts.empty());
   assert(m_counts.size() == m_indices.size());
+  assert(m_counts.size() == m_base_vertices.size());
+  assert(m_counts.size() == m_base_instances.size());
+
+  if(m_uses_base_instance)
+    {
+      draw_base_instance();
+      return;
+    }
+
+  if(m_uses_base_vertex)
+    {
+      draw_base_vertex();
+      return;
+    }
 
   /* TODO:
      Get rid of this unholy mess of #ifdef's here and move
@@ -630,6 +1004,81 @@ draw(void) const
   #endif
 }
 
+void
+DrawEntry::
+draw_base_vertex(void) const
+{
+  #ifndef FASTUIDRAW_GL_USE_GLES
+    {
+      glMultiDrawElementsBaseVertex(GL_TRIANGLES, &m_counts[0],
+                                    fastuidraw::gl::opengl_trait<fastuidraw::PainterIndex>::type,
+                                    &m_indices[0], m_counts.size(),
+                                    &m_base_vertices[0]);
+    }
+  #else
+    {
+      if(FASTUIDRAWglfunctionExists(glMultiDrawElementsBaseVertexEXT))
+        {
+          glMultiDrawElementsBaseVertexEXT(GL_TRIANGLES, &m_counts[0],
+                                           fastuidraw::gl::opengl_trait<fastuidraw::PainterIndex>::type,
+                                           &m_indices[0], m_counts.size(),
+                                           &m_base_vertices[0]);
+        }
+      else
+        {
+          for(unsigned int i = 0, endi = m_counts.size(); i < endi; ++i)
+            {
+              if(FASTUIDRAWglfunctionExists(glDrawElementsBaseVertex))
+                {
+                  glDrawElementsBaseVertex(GL_TRIANGLES, m_counts[i],
+                                           fastuidraw::gl::opengl_trait<fastuidraw::PainterIndex>::type,
+                                           m_indices[i], m_base_vertices[i]);
+                }
+              else if(FASTUIDRAWglfunctionExists(glDrawElementsBaseVertexOES))
+                {
+                  glDrawElementsBaseVertexOES(GL_TRIANGLES, m_counts[i],
+                                              fastuidraw::gl::opengl_trait<fastuidraw::PainterIndex>::type,
+                                              m_indices[i], m_base_vertices[i]);
+                }
+              else
+                {
+                  glDrawElementsBaseVertexEXT(GL_TRIANGLES, m_counts[i],
+                                              fastuidraw::gl::opengl_trait<fastuidraw::PainterIndex>::type,
+                                              m_indices[i], m_base_vertices[i]);
+                }
+            }
+        }
+    }
+  #endif
+}
+
+void
+DrawEntry::
+draw_base_instance(void) const
+{
+  /* there is no multi-draw with a base instance short of
+     indirect draws, so each entry is its own draw call.
+   */
+  for(unsigned int i = 0, endi = m_counts.size(); i < endi; ++i)
+    {
+      #ifndef FASTUIDRAW_GL_USE_GLES
+        {
+          glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, m_counts[i],
+                                                        fastuidraw::gl::opengl_trait<fastuidraw::PainterIndex>::type,
+                                                        m_indices[i], 1, m_base_vertices[i],
+                                                        m_base_instances[i]);
+        }
+      #else
+        {
+          glDrawElementsInstancedBaseVertexBaseInstanceEXT(GL_TRIANGLES, m_counts[i],
+                                                           fastuidraw::gl::opengl_trait<fastuidraw::PainterIndex>::type,
+                                                           m_indices[i], 1, m_base_vertices[i],
+                                                           m_base_instances[i]);
+        }
+      #endif
+    }
+}
+
 GLenum
 DrawEntry::
 convert_blend_op(enum fastuidraw::BlendMode::op_t v)
@@ -699,43 +1148,55 @@ DrawCommand(painter_vao_pool *hnd,
             const fastuidraw::gl::PainterBackendGL::ConfigurationGL &params,
             PainterBackendGLPrivate *pr):
   m_pr(pr),
+  m_hnd(hnd),
   m_vao(hnd->request_vao()),
+  m_persistent_written(0, 0),
   m_attributes_written(0),
-  m_indices_written(0)
+  m_indices_written(0),
+  m_base_vertex(0),
+  m_header_entry(0),
+  m_headers_written(0)
 {
   /* map the buffers and set to the c_array<> fields of
      fastuidraw::PainterDraw to the mapping location.
   */
   void *attr_bo, *index_bo, *data_bo, *header_bo;
-  uint32_t flags;
+  uint32_t flags, data_flags;
 
   flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
 
+  /* the persistent region of the data store must
+     survive the mapping, so do not invalidate it.
+   */
+  data_flags = (params.persistent_store_blocks() > 0) ?
+    GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT :
+    flags;
+
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_attribute_bo);
-  attr_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->attribute_buffer_size(), flags);
+  attr_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->attribute_buffer_size(m_vao), flags);
   assert(attr_bo != NULL);
 
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_header_bo);
-  header_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->header_buffer_size(), flags);
+  header_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->header_buffer_size(m_vao), flags);
   assert(header_bo != NULL);
 
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vao.m_index_bo);
-  index_bo = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, hnd->index_buffer_size(), flags);
+  index_bo = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, hnd->index_buffer_size(m_vao), flags);
   assert(index_bo != NULL);
 
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_data_bo);
-  data_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->data_buffer_size(), flags);
+  data_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->data_buffer_size(m_vao), data_flags);
   assert(data_bo != NULL);
 
   m_attributes = fastuidraw::c_array<fastuidraw::PainterAttribute>(reinterpret_cast<fastuidraw::PainterAttribute*>(attr_bo),
-                                                                 params.attributes_per_buffer());
+                                                                 m_vao.m_attributes_per_buffer);
   m_indices = fastuidraw::c_array<fastuidraw::PainterIndex>(reinterpret_cast<fastuidraw::PainterIndex*>(index_bo),
-                                                          params.indices_per_buffer());
+                                                          m_vao.m_indices_per_buffer);
   m_store = fastuidraw::c_array<fastuidraw::generic_data>(reinterpret_cast<fastuidraw::generic_data*>(data_bo),
-                                                          hnd->data_buffer_size() / sizeof(fastuidraw::generic_data));
+                                                          hnd->data_buffer_size(m_vao) / sizeof(fastuidraw::generic_data));
 
   m_header_attributes = fastuidraw::c_array<uint32_t>(reinterpret_cast<uint32_t*>(header_bo),
-                                                     params.attributes_per_buffer());
+                                                     m_vao.m_attributes_per_buffer);
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -747,13 +1208,17 @@ draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
            const fastuidraw::PainterShaderGroup &new_shaders,
            unsigned int attributes_written, unsigned int indices_written) const
 {
-  /* if the blend mode changes, then we need to start a new DrawEntry
+  /* if the blend mode or stencil state changes, then we need
+     to start a new DrawEntry
    */
   fastuidraw::BlendMode::packed_value old_mode, new_mode;
   uint32_t new_disc, old_disc;
+  bool stencil_change;
 
   old_mode = old_shaders.packed_blend_mode();
   new_mode = new_shaders.packed_blend_mode();
+  stencil_change = old_shaders.stencil_ref() != new_shaders.stencil_ref()
+    || old_shaders.stencil_action() != new_shaders.stencil_action();
 
   old_disc = old_shaders.item_group() & shader_group_discard_mask;
   new_disc = new_shaders.item_group() & shader_group_discard_mask;
@@ -769,15 +1234,15 @@ draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
         {
           add_entry(indices_written);
         }
-      m_draws.push_back(DrawEntry(fastuidraw::BlendMode(new_mode), m_pr, pz));
+      m_draws.push_back(DrawEntry(fastuidraw::BlendMode(new_mode), new_shaders, m_pr, pz));
     }
-  else if(old_mode != new_mode)
+  else if(old_mode != new_mode || stencil_change)
     {
       if(!m_draws.empty())
         {
           add_entry(indices_written);
         }
-      m_draws.push_back(fastuidraw::BlendMode(new_mode));
+      m_draws.push_back(DrawEntry(fastuidraw::BlendMode(new_mode), new_shaders));
     }
   else
     {
@@ -790,6 +1255,41 @@ draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
   FASTUIDRAWunused(attributes_written);
 }
 
+void
+DrawCommand::
+base_vertex_change(unsigned int base_vertex,
+                   unsigned int indices_written) const
+{
+  assert(m_pr->m_params.use_base_vertex());
+
+  /* the indices before indices_written use the old
+     base vertex; close them off in their own entry.
+   */
+  if(indices_written > m_indices_written)
+    {
+      add_entry(indices_written);
+    }
+  m_base_vertex = base_vertex;
+}
+
+void
+DrawCommand::
+header_change(unsigned int header_entry,
+              unsigned int indices_written) const
+{
+  assert(m_pr->m_params.use_per_draw_header());
+
+  /* the indices before indices_written use the old
+     header entry; close them off in their own entry.
+   */
+  if(indices_written > m_indices_written)
+    {
+      add_entry(indices_written);
+    }
+  m_header_entry = header_entry;
+  m_headers_written = fastuidraw::t_max(m_headers_written, m_header_entry + 1);
+}
+
 void
 DrawCommand::
 draw(void) const
@@ -819,14 +1319,32 @@ draw(void) const
       m_pr->m_programs[fastuidraw::gl::PainterBackendGL::program_without_discard]->use_program();
     }
 
+  bool stencil_clipping(m_pr->m_p->configuration_base().stencil_clipping());
   for(std::list<DrawEntry>::const_iterator iter = m_draws.begin(),
         end = m_draws.end(); iter != end; ++iter)
     {
-      iter->draw();
+      iter->draw(stencil_clipping);
     }
   glBindVertexArray(0);
 }
 
+unsigned int
+DrawCommand::
+persistent_store_version(void) const
+{
+  return m_hnd->persistent_version(m_vao);
+}
+
+void
+DrawCommand::
+persistent_store_written(unsigned int version,
+                         fastuidraw::range_type<unsigned int> blocks) const
+{
+  assert(blocks.m_end <= m_pr->m_params.persistent_store_blocks());
+  m_hnd->persistent_version(m_vao) = version;
+  m_persistent_written = blocks;
+}
+
 void
 DrawCommand::
 unmap_implement(unsigned int attributes_written,
@@ -836,21 +1354,42 @@ unmap_implement(unsigned int attributes_written,
   m_attributes_written = attributes_written;
   add_entry(indices_written);
   assert(m_indices_written == indices_written);
+  m_hnd->record_usage(attributes_written, indices_written, data_store_written);
 
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_attribute_bo);
   glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, attributes_written * sizeof(fastuidraw::PainterAttribute));
   glUnmapBuffer(GL_ARRAY_BUFFER);
 
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_header_bo);
-  glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, attributes_written * sizeof(uint32_t));
+  if(m_pr->m_params.use_per_draw_header())
+    {
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, m_headers_written * sizeof(uint32_t));
+    }
+  else
+    {
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, attributes_written * sizeof(uint32_t));
+    }
   glUnmapBuffer(GL_ARRAY_BUFFER);
 
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vao.m_index_bo);
   glFlushMappedBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, indices_written * sizeof(fastuidraw::PainterIndex));
   glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER);
 
+  unsigned int persistent_end, block_size;
+
+  block_size = m_pr->m_p->configuration_base().alignment() * sizeof(fastuidraw::generic_data);
+  persistent_end = m_pr->m_params.persistent_store_blocks() * block_size;
+  assert(persistent_end <= data_store_written * sizeof(fastuidraw::generic_data));
+
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_data_bo);
-  glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, data_store_written * sizeof(fastuidraw::generic_data));
+  if(m_persistent_written.m_begin < m_persistent_written.m_end)
+    {
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER,
+                               m_persistent_written.m_begin * block_size,
+                               (m_persistent_written.m_end - m_persistent_written.m_begin) * block_size);
+    }
+  glFlushMappedBufferRange(GL_ARRAY_BUFFER, persistent_end,
+                           data_store_written * sizeof(fastuidraw::generic_data) - persistent_end);
   glUnmapBuffer(GL_ARRAY_BUFFER);
 }
 
@@ -863,12 +1402,12 @@ add_entry(unsigned int indices_written) const
 
   if(m_draws.empty())
     {
-      m_draws.push_back(fastuidraw::BlendMode());
+      m_draws.push_back(DrawEntry(fastuidraw::BlendMode()));
     }
   assert(indices_written >= m_indices_written);
   count = indices_written - m_indices_written;
   offset += m_indices_written;
-  m_draws.back().add_entry(count, offset);
+  m_draws.back().add_entry(count, offset, m_base_vertex, m_header_entry);
   m_indices_written = indices_written;
 }
 
@@ -917,9 +1456,90 @@ compute_base_config(const fastuidraw::gl::PainterBackendGL::ConfigurationGL &par
       //using UBO's requires that the data store alignment is 4.
       return_value.alignment(4);
     }
+
+  gl::ContextProperties ctx;
+  bool have_base_vertex;
+
+  #ifdef FASTUIDRAW_GL_USE_GLES
+    {
+      have_base_vertex = ctx.version() >= ivec2(3, 2)
+        || ctx.has_extension("GL_OES_draw_elements_base_vertex")
+        || ctx.has_extension("GL_EXT_draw_elements_base_vertex");
+    }
+  #else
+    {
+      have_base_vertex = ctx.version() >= ivec2(3, 2)
+        || ctx.has_extension("GL_ARB_draw_elements_base_vertex");
+    }
+  #endif
+
+  bool have_base_instance;
+
+  #ifdef FASTUIDRAW_GL_USE_GLES
+    {
+      have_base_instance = ctx.has_extension("GL_EXT_base_instance");
+    }
+  #else
+    {
+      have_base_instance = ctx.version() >= ivec2(4, 2)
+        || ctx.has_extension("GL_ARB_base_instance");
+    }
+  #endif
+
+  return_value
+    .supports_base_vertex(params.use_base_vertex() && have_base_vertex)
+    .per_draw_header(params.use_per_draw_header() && have_base_instance);
+
+  if(params.persistent_store_blocks() > 0)
+    {
+      enum gl::PainterBackendGL::data_store_backing_t backing;
+      unsigned int num_blocks;
+
+      backing = params.data_store_backing();
+      if(gl::detail::compute_tex_buffer_support() == gl::detail::tex_buffer_not_supported)
+        {
+          backing = gl::PainterBackendGL::data_store_ubo;
+        }
+      num_blocks = compute_data_blocks_per_store_buffer(backing, params.data_blocks_per_store_buffer(),
+                                                        return_value.alignment());
+      return_value.persistent_store_blocks(t_min(params.persistent_store_blocks(), num_blocks / 2));
+    }
+  else
+    {
+      return_value.persistent_store_blocks(0);
+    }
   return return_value;
 }
 
+unsigned int
+PainterBackendGLPrivate::
+compute_data_blocks_per_store_buffer(enum fastuidraw::gl::PainterBackendGL::data_store_backing_t backing,
+                                     unsigned int requested, unsigned int alignment)
+{
+  /* Query GL what is good size for data store buffer. Size is dependent
+     how the data store is backed.
+   */
+  switch(backing)
+    {
+    case fastuidraw::gl::PainterBackendGL::data_store_tbo:
+      {
+        unsigned int max_texture_buffer_size(0);
+        max_texture_buffer_size = fastuidraw::gl::context_get<GLint>(GL_MAX_TEXTURE_BUFFER_SIZE);
+        return fastuidraw::t_min(max_texture_buffer_size, requested);
+      }
+
+    case fastuidraw::gl::PainterBackendGL::data_store_ubo:
+      {
+        unsigned int max_ubo_size_bytes, max_num_blocks, block_size_bytes;
+        block_size_bytes = alignment * sizeof(fastuidraw::generic_data);
+        max_ubo_size_bytes = fastuidraw::gl::context_get<GLint>(GL_MAX_UNIFORM_BLOCK_SIZE);
+        max_num_blocks = max_ubo_size_bytes / block_size_bytes;
+        return fastuidraw::t_min(max_num_blocks, requested);
+      }
+    }
+  return requested;
+}
+
 fastuidraw::glsl::PainterBackendGLSL::ConfigurationGLSL
 PainterBackendGLPrivate::
 compute_glsl_config(const fastuidraw::gl::PainterBackendGL::ConfigurationGL &params)
@@ -988,30 +1608,11 @@ configure_backend(void)
       m_params.data_store_backing(fastuidraw::gl::PainterBackendGL::data_store_ubo);
     }
 
-  /* Query GL what is good size for data store buffer. Size is dependent
-     how the data store is backed.
-   */
-  switch(m_params.data_store_backing())
-    {
-    case fastuidraw::gl::PainterBackendGL::data_store_tbo:
-      {
-        unsigned int max_texture_buffer_size(0);
-        max_texture_buffer_size = fastuidraw::gl::context_get<GLint>(GL_MAX_TEXTURE_BUFFER_SIZE);
-        m_params.data_blocks_per_store_buffer(fastuidraw::t_min(max_texture_buffer_size,
-                                                                m_params.data_blocks_per_store_buffer()));
-      }
-      break;
-
-    case fastuidraw::gl::PainterBackendGL::data_store_ubo:
-      {
-        unsigned int max_ubo_size_bytes, max_num_blocks, block_size_bytes;
-        block_size_bytes = m_p->configuration_base().alignment() * sizeof(fastuidraw::generic_data);
-        max_ubo_size_bytes = fastuidraw::gl::context_get<GLint>(GL_MAX_UNIFORM_BLOCK_SIZE);
-        max_num_blocks = max_ubo_size_bytes / block_size_bytes;
-        m_params.data_blocks_per_store_buffer(fastuidraw::t_min(max_num_blocks,
-                                                                m_params.data_blocks_per_store_buffer()));
-      }
-    }
+  m_params.data_blocks_per_store_buffer(compute_data_blocks_per_store_buffer(m_params.data_store_backing(),
+                                                                           m_params.data_blocks_per_store_buffer(),
+                                                                           m_p->configuration_base().alignment()));
+  m_params.persistent_store_blocks(m_p->configuration_base().persistent_store_blocks());
+  assert(2 * m_params.persistent_store_blocks() <= m_params.data_blocks_per_store_buffer());
 
   if(!m_params.use_hw_clip_planes())
     {
@@ -1042,6 +1643,8 @@ configure_backend(void)
       #endif
     }
   assert(m_params.use_hw_clip_planes() == m_p->configuration_glsl().use_hw_clip_planes());
+  m_params.use_base_vertex(m_p->configuration_base().supports_base_vertex());
+  m_params.use_per_draw_header(m_p->configuration_base().per_draw_header());
 
   fastuidraw::gl::ColorStopAtlasGL *color;
   assert(dynamic_cast<fastuidraw::gl::ColorStopAtlasGL*>(m_params.colorstop_atlas().get()));
@@ -1381,6 +1984,13 @@ setget_implement(bool, assign_layout_to_varyings)
 setget_implement(bool, assign_binding_points)
 setget_implement(bool, use_ubo_for_uniforms)
 setget_implement(bool, separate_program_for_discard)
+setget_implement(bool, use_base_vertex)
+setget_implement(bool, use_per_draw_header)
+setget_implement(unsigned int, persistent_store_blocks)
+setget_implement(bool, adaptive_buffer_sizing)
+setget_implement(unsigned int, min_attributes_per_buffer)
+setget_implement(unsigned int, min_indices_per_buffer)
+setget_implement(unsigned int, min_data_blocks_per_store_buffer)
 
 #undef setget_implement
 
@@ -1489,7 +2099,15 @@ on_pre_draw(void)
 
   glEnable(GL_DEPTH_TEST);
   glDepthFunc(GL_GEQUAL);
-  glDisable(GL_STENCIL_TEST);
+  if(configuration_base().stencil_clipping())
+    {
+      glEnable(GL_STENCIL_TEST);
+      glStencilMask(~0u);
+    }
+  else
+    {
+      glDisable(GL_STENCIL_TEST);
+    }
 
   if(d->m_number_clip_planes > 0)
     {
@@ -1612,6 +2230,14 @@ on_post_draw(void)
   glUseProgram(0);
   glBindVertexArray(0);
 
+  /* the last draw may have been a stencil clipping draw
+     that masks color writes.
+   */
+  if(configuration_base().stencil_clipping())
+    {
+      glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    }
+
   if(d->m_tex_buffer_support != fastuidraw::gl::detail::tex_buffer_not_supported)
     {
       glBindBuffer(GL_TEXTURE_BUFFER, 0);
@@ -1677,3 +2303,12 @@ map_draw(void)
 
   return FASTUIDRAWnew DrawCommand(d->m_pool, d->m_params, d);
 }
+
+void
+fastuidraw::gl::PainterBackendGL::
+ensure_room(unsigned int attributes, unsigned int indices)
+{
+  PainterBackendGLPrivate *d;
+  d = reinterpret_cast<PainterBackendGLPrivate*>(m_d);
+  d->m_pool->ensure_room(attributes, indices);
+}
@@ -26,6 +26,7 @@
 #include <fastuidraw/painter/painter_brush.hpp>
 #include <fastuidraw/painter/painter_shader_data.hpp>
 #include <fastuidraw/painter/painter_dashed_stroke_params.hpp>
+#include <fastuidraw/painter/painter_analytic_fill_params.hpp>
 #include <fastuidraw/painter/painter_stroke_params.hpp>
 #include <fastuidraw/glsl/painter_blend_shader_glsl.hpp>
 #include <fastuidraw/glsl/painter_item_shader_glsl.hpp>
@@ -463,6 +464,16 @@ add_enums(fastuidraw::glsl::ShaderSource &src)
     .add_macro("fastuidraw_shader_transformation_translation_num_blocks", number_blocks(alignment, PainterBrush::transformation_translation_data_size))
     .add_macro("fastuidraw_stroke_dashed_stroking_params_header_num_blocks",
                number_blocks(alignment, PainterDashedStrokeParams::stroke_static_data_size))
+    .add_macro("fastuidraw_analytic_fill_header_num_blocks",
+               number_blocks(alignment, PainterAnalyticFillParams::analytic_fill_static_data_size))
+    .add_macro("fastuidraw_analytic_fill_segment_num_blocks",
+               number_blocks(alignment, PainterAnalyticFillParams::analytic_fill_segment_size))
+    .add_macro("fastuidraw_analytic_fill_band_num_blocks",
+               number_blocks(alignment, PainterAnalyticFillParams::analytic_fill_band_size))
+    .add_macro("fastuidraw_odd_even_fill_rule", PainterEnums::odd_even_fill_rule)
+    .add_macro("fastuidraw_complement_odd_even_fill_rule", PainterEnums::complement_odd_even_fill_rule)
+    .add_macro("fastuidraw_nonzero_fill_rule", PainterEnums::nonzero_fill_rule)
+    .add_macro("fastuidraw_complement_nonzero_fill_rule", PainterEnums::complement_nonzero_fill_rule)
 
     .add_macro("fastuidraw_item_shader_bit0", PainterHeader::item_shader_bit0)
     .add_macro("fastuidraw_item_shader_num_bits", PainterHeader::item_shader_num_bits)
@@ -475,6 +486,7 @@ add_enums(fastuidraw::glsl::ShaderSource &src)
     .add_macro("fastuidraw_stroke_offset_rounded_cap", StrokedPath::offset_rounded_cap)
     .add_macro("fastuidraw_stroke_offset_square_cap", StrokedPath::offset_square_cap)
     .add_macro("fastuidraw_stroke_offset_cap_join", StrokedPath::offset_cap_join)
+    .add_macro("fastuidraw_stroke_offset_edge_segment", StrokedPath::offset_edge_segment)
     .add_macro("fastuidraw_stroke_offset_type_bit0", StrokedPath::offset_type_bit0)
     .add_macro("fastuidraw_stroke_offset_type_num_bits", StrokedPath::offset_type_num_bits)
     .add_macro("fastuidraw_stroke_sin_sign_mask", StrokedPath::sin_sign_mask)
@@ -675,6 +687,22 @@ stream_unpack_code(fastuidraw::glsl::ShaderSource &str)
                               "fastuidraw_dashed_stroking_params_header",
                               true);
   }
+
+  {
+    shader_unpack_value_set<PainterAnalyticFillParams::analytic_fill_static_data_size> labels;
+    labels
+      .set(PainterAnalyticFillParams::analytic_fill_number_segments_offset, ".number_segments", shader_unpack_value::uint_type)
+      .set(PainterAnalyticFillParams::analytic_fill_fill_rule_offset, ".fill_rule", shader_unpack_value::uint_type)
+      .set(PainterAnalyticFillParams::analytic_fill_number_bands_offset, ".number_bands", shader_unpack_value::uint_type)
+      .set(PainterAnalyticFillParams::analytic_fill_band_min_x_offset, ".band_min_x")
+      .set(PainterAnalyticFillParams::analytic_fill_band_min_y_offset, ".band_min_y")
+      .set(PainterAnalyticFillParams::analytic_fill_band_scale_x_offset, ".band_scale_x")
+      .set(PainterAnalyticFillParams::analytic_fill_band_scale_y_offset, ".band_scale_y")
+      .stream_unpack_function(alignment, str,
+                              "fastuidraw_read_analytic_fill_header",
+                              "fastuidraw_analytic_fill_header",
+                              true);
+  }
 }
 
 void
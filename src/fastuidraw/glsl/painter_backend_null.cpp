@@ -0,0 +1,703 @@
+/*!
+ * \file painter_backend_null.cpp
+ * \brief file painter_backend_null.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <vector>
+#include <fastuidraw/glsl/painter_backend_null.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  /* The atlas backing stores created by PainterBackendNull
+     only track their dimensions; the data sent to them is
+     dropped since nothing will ever sample from them.
+   */
+  class NullGlyphTexelStore:public fastuidraw::GlyphAtlasTexelBackingStoreBase
+  {
+  public:
+    NullGlyphTexelStore(void):
+      fastuidraw::GlyphAtlasTexelBackingStoreBase(1024, 1024, 16, true)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, int, int, fastuidraw::const_c_array<uint8_t>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int)
+    {}
+  };
+
+  class NullGlyphGeometryStore:public fastuidraw::GlyphAtlasGeometryBackingStoreBase
+  {
+  public:
+    NullGlyphGeometryStore(void):
+      fastuidraw::GlyphAtlasGeometryBackingStoreBase(4, 1024 * 256, true)
+    {}
+
+    virtual
+    void
+    set_values(unsigned int, fastuidraw::const_c_array<fastuidraw::generic_data>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(unsigned int)
+    {}
+  };
+
+  class NullColorStore:public fastuidraw::AtlasColorBackingStoreBase
+  {
+  public:
+    NullColorStore(void):
+      fastuidraw::AtlasColorBackingStoreBase(2048, 2048, 1, true)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, int, int, fastuidraw::const_c_array<fastuidraw::u8vec4>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int)
+    {}
+  };
+
+  class NullIndexStore:public fastuidraw::AtlasIndexBackingStoreBase
+  {
+  public:
+    NullIndexStore(void):
+      fastuidraw::AtlasIndexBackingStoreBase(256, 256, 4, true)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, int, int,
+             fastuidraw::const_c_array<fastuidraw::ivec3>,
+             int, const fastuidraw::AtlasColorBackingStoreBase*, int)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, int, int,
+             fastuidraw::const_c_array<fastuidraw::ivec3>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int)
+    {}
+  };
+
+  class NullColorStopStore:public fastuidraw::ColorStopBackingStore
+  {
+  public:
+    NullColorStopStore(void):
+      fastuidraw::ColorStopBackingStore(1024, 32, true)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, fastuidraw::const_c_array<fastuidraw::u8vec4>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int)
+    {}
+  };
+
+  class ConfigurationNullPrivate
+  {
+  public:
+    ConfigurationNullPrivate(void):
+      m_attributes_per_buffer(512 * 512),
+      m_indices_per_buffer((m_attributes_per_buffer * 3) / 2),
+      m_data_blocks_per_store_buffer(1024 * 64),
+      m_record_draw_breaks(false),
+      m_break_on_shader_change(false)
+    {}
+
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> m_glyph_atlas;
+    fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> m_image_atlas;
+    fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas> m_colorstop_atlas;
+    unsigned int m_attributes_per_buffer;
+    unsigned int m_indices_per_buffer;
+    unsigned int m_data_blocks_per_store_buffer;
+    bool m_record_draw_breaks;
+    bool m_break_on_shader_change;
+  };
+
+  /* Host memory that backs a single PainterDraw; the
+     buffers are recycled once a flush completes.
+   */
+  class host_buffer
+  {
+  public:
+    host_buffer(unsigned int num_attributes,
+                unsigned int num_indices,
+                unsigned int num_store):
+      m_attributes(num_attributes),
+      m_header_attributes(num_attributes),
+      m_indices(num_indices),
+      m_store(num_store),
+      m_persistent_version(0)
+    {}
+
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+    std::vector<uint32_t> m_header_attributes;
+    std::vector<fastuidraw::PainterIndex> m_indices;
+    std::vector<fastuidraw::generic_data> m_store;
+
+    /* version of the persistent region of m_store, see
+       PainterDraw::persistent_store_version()
+     */
+    unsigned int m_persistent_version;
+  };
+
+  class host_buffer_pool:fastuidraw::noncopyable
+  {
+  public:
+    host_buffer_pool(unsigned int num_attributes,
+                     unsigned int num_indices,
+                     unsigned int num_store):
+      m_num_attributes(num_attributes),
+      m_num_indices(num_indices),
+      m_num_store(num_store),
+      m_current(0)
+    {}
+
+    ~host_buffer_pool();
+
+    host_buffer*
+    request_buffer(void);
+
+    void
+    release_buffers(void)
+    {
+      m_current = 0;
+    }
+
+  private:
+    unsigned int m_num_attributes, m_num_indices, m_num_store;
+    unsigned int m_current;
+    std::vector<host_buffer*> m_buffers;
+  };
+
+  class PainterBackendNullPrivate;
+
+  class DrawCommand:public fastuidraw::PainterDraw
+  {
+  public:
+    DrawCommand(host_buffer *buffer, PainterBackendNullPrivate *pr);
+
+    virtual
+    void
+    draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
+               const fastuidraw::PainterShaderGroup &new_shaders,
+               unsigned int attributes_written, unsigned int indices_written) const;
+
+    virtual
+    void
+    base_vertex_change(unsigned int base_vertex,
+                       unsigned int indices_written) const;
+
+    virtual
+    void
+    header_change(unsigned int header_entry,
+                  unsigned int indices_written) const;
+
+    virtual
+    unsigned int
+    persistent_store_version(void) const;
+
+    virtual
+    void
+    persistent_store_written(unsigned int version,
+                             fastuidraw::range_type<unsigned int> blocks) const;
+
+    virtual
+    void
+    draw(void) const;
+
+  protected:
+    virtual
+    void
+    unmap_implement(unsigned int attributes_written,
+                    unsigned int indices_written,
+                    unsigned int data_store_written) const;
+
+  private:
+    host_buffer *m_buffer;
+    PainterBackendNullPrivate *m_pr;
+    mutable unsigned int m_attributes_written, m_indices_written, m_data_store_written;
+    mutable unsigned int m_number_draw_breaks;
+    mutable unsigned int m_number_base_vertex_changes;
+    mutable unsigned int m_headers_written;
+    mutable std::vector<fastuidraw::glsl::PainterBackendNull::DrawBreak> m_draw_breaks;
+  };
+
+  class PainterBackendNullPrivate
+  {
+  public:
+    PainterBackendNullPrivate(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config_null,
+                              const fastuidraw::PainterBackend::ConfigurationBase &config_base,
+                              fastuidraw::glsl::PainterBackendNull *p);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>
+    compute_glyph_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config_null);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>
+    compute_image_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config_null);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>
+    compute_colorstop_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config_null);
+
+    fastuidraw::glsl::PainterBackendNull::ConfigurationNull m_params;
+    host_buffer_pool m_pool;
+    fastuidraw::glsl::PainterBackendNull::DrawStats m_stats;
+    std::vector<fastuidraw::glsl::PainterBackendNull::DrawBreak> m_draw_breaks;
+    fastuidraw::glsl::PainterBackendNull *m_p;
+  };
+}
+
+//////////////////////////////////////////
+// host_buffer_pool methods
+host_buffer_pool::
+~host_buffer_pool()
+{
+  for(unsigned int i = 0, endi = m_buffers.size(); i < endi; ++i)
+    {
+      FASTUIDRAWdelete(m_buffers[i]);
+    }
+}
+
+host_buffer*
+host_buffer_pool::
+request_buffer(void)
+{
+  if(m_current == m_buffers.size())
+    {
+      m_buffers.push_back(FASTUIDRAWnew host_buffer(m_num_attributes, m_num_indices, m_num_store));
+    }
+  return m_buffers[m_current++];
+}
+
+//////////////////////////////////////////
+// DrawCommand methods
+DrawCommand::
+DrawCommand(host_buffer *buffer, PainterBackendNullPrivate *pr):
+  m_buffer(buffer),
+  m_pr(pr),
+  m_attributes_written(0),
+  m_indices_written(0),
+  m_data_store_written(0),
+  m_number_draw_breaks(0),
+  m_number_base_vertex_changes(0),
+  m_headers_written(0)
+{
+  m_attributes = fastuidraw::make_c_array(buffer->m_attributes);
+  m_header_attributes = fastuidraw::make_c_array(buffer->m_header_attributes);
+  m_indices = fastuidraw::make_c_array(buffer->m_indices);
+  m_store = fastuidraw::make_c_array(buffer->m_store);
+}
+
+void
+DrawCommand::
+draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
+           const fastuidraw::PainterShaderGroup &new_shaders,
+           unsigned int attributes_written, unsigned int indices_written) const
+{
+  ++m_number_draw_breaks;
+  if(m_pr->m_params.record_draw_breaks())
+    {
+      fastuidraw::glsl::PainterBackendNull::DrawBreak D;
+
+      D.m_item_group = fastuidraw::uvec2(old_shaders.item_group(), new_shaders.item_group());
+      D.m_blend_group = fastuidraw::uvec2(old_shaders.blend_group(), new_shaders.blend_group());
+      D.m_brush = fastuidraw::uvec2(old_shaders.brush(), new_shaders.brush());
+      D.m_blend_mode[0] = old_shaders.packed_blend_mode();
+      D.m_blend_mode[1] = new_shaders.packed_blend_mode();
+      D.m_attributes_written = attributes_written;
+      D.m_indices_written = indices_written;
+      D.m_draw = 0;
+      m_draw_breaks.push_back(D);
+    }
+}
+
+void
+DrawCommand::
+base_vertex_change(unsigned int base_vertex,
+                   unsigned int indices_written) const
+{
+  assert(m_pr->m_p->configuration_base().supports_base_vertex());
+  FASTUIDRAWunused(base_vertex);
+  FASTUIDRAWunused(indices_written);
+  ++m_number_base_vertex_changes;
+}
+
+void
+DrawCommand::
+header_change(unsigned int header_entry,
+              unsigned int indices_written) const
+{
+  assert(m_pr->m_p->configuration_base().per_draw_header());
+  FASTUIDRAWunused(indices_written);
+  m_headers_written = fastuidraw::t_max(m_headers_written, header_entry + 1);
+}
+
+unsigned int
+DrawCommand::
+persistent_store_version(void) const
+{
+  return m_buffer->m_persistent_version;
+}
+
+void
+DrawCommand::
+persistent_store_written(unsigned int version,
+                         fastuidraw::range_type<unsigned int> blocks) const
+{
+  assert(blocks.m_end <= m_pr->m_p->configuration_base().persistent_store_blocks());
+  FASTUIDRAWunused(blocks);
+  m_buffer->m_persistent_version = version;
+}
+
+void
+DrawCommand::
+unmap_implement(unsigned int attributes_written,
+                unsigned int indices_written,
+                unsigned int data_store_written) const
+{
+  m_attributes_written = attributes_written;
+  m_indices_written = indices_written;
+  m_data_store_written = data_store_written;
+}
+
+void
+DrawCommand::
+draw(void) const
+{
+  fastuidraw::glsl::PainterBackendNull::DrawStats &S(m_pr->m_stats);
+
+  assert(unmapped());
+  for(unsigned int i = 0, endi = m_draw_breaks.size(); i < endi; ++i)
+    {
+      m_draw_breaks[i].m_draw = S.m_number_draws;
+      m_pr->m_draw_breaks.push_back(m_draw_breaks[i]);
+    }
+
+  ++S.m_number_draws;
+  S.m_number_draw_breaks += m_number_draw_breaks;
+  S.m_number_base_vertex_changes += m_number_base_vertex_changes;
+  S.m_attributes_written += m_attributes_written;
+  S.m_indices_written += m_indices_written;
+  S.m_data_store_written += m_data_store_written;
+  S.m_attribute_bytes += m_attributes_written * sizeof(fastuidraw::PainterAttribute);
+  if(m_pr->m_p->configuration_base().per_draw_header())
+    {
+      S.m_header_attribute_bytes += m_headers_written * sizeof(uint32_t);
+    }
+  else
+    {
+      S.m_header_attribute_bytes += m_attributes_written * sizeof(uint32_t);
+    }
+  S.m_index_bytes += m_indices_written * sizeof(fastuidraw::PainterIndex);
+  S.m_data_store_bytes += m_data_store_written * sizeof(fastuidraw::generic_data);
+}
+
+//////////////////////////////////////////
+// PainterBackendNullPrivate methods
+PainterBackendNullPrivate::
+PainterBackendNullPrivate(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config_null,
+                          const fastuidraw::PainterBackend::ConfigurationBase &config_base,
+                          fastuidraw::glsl::PainterBackendNull *p):
+  m_params(config_null),
+  m_pool(config_null.attributes_per_buffer(),
+         config_null.indices_per_buffer(),
+         config_null.data_blocks_per_store_buffer() * config_base.alignment()),
+  m_p(p)
+{
+  m_params
+    .glyph_atlas(m_p->glyph_atlas())
+    .image_atlas(m_p->image_atlas())
+    .colorstop_atlas(m_p->colorstop_atlas());
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>
+PainterBackendNullPrivate::
+compute_glyph_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config_null)
+{
+  using namespace fastuidraw;
+  reference_counted_ptr<GlyphAtlasTexelBackingStoreBase> texels;
+  reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> geometry;
+
+  if(config_null.glyph_atlas())
+    {
+      return config_null.glyph_atlas();
+    }
+
+  texels = FASTUIDRAWnew NullGlyphTexelStore();
+  geometry = FASTUIDRAWnew NullGlyphGeometryStore();
+  return FASTUIDRAWnew GlyphAtlas(texels, geometry);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>
+PainterBackendNullPrivate::
+compute_image_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config_null)
+{
+  using namespace fastuidraw;
+  reference_counted_ptr<AtlasColorBackingStoreBase> color;
+  reference_counted_ptr<AtlasIndexBackingStoreBase> index;
+
+  if(config_null.image_atlas())
+    {
+      return config_null.image_atlas();
+    }
+
+  color = FASTUIDRAWnew NullColorStore();
+  index = FASTUIDRAWnew NullIndexStore();
+  return FASTUIDRAWnew ImageAtlas(32, 4, color, index);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>
+PainterBackendNullPrivate::
+compute_colorstop_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config_null)
+{
+  using namespace fastuidraw;
+  reference_counted_ptr<ColorStopBackingStore> store;
+
+  if(config_null.colorstop_atlas())
+    {
+      return config_null.colorstop_atlas();
+    }
+
+  store = FASTUIDRAWnew NullColorStopStore();
+  return FASTUIDRAWnew ColorStopAtlas(store);
+}
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendNull::ConfigurationNull methods
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+ConfigurationNull(void)
+{
+  m_d = FASTUIDRAWnew ConfigurationNullPrivate();
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+ConfigurationNull(const ConfigurationNull &obj)
+{
+  ConfigurationNullPrivate *d;
+  d = reinterpret_cast<ConfigurationNullPrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew ConfigurationNullPrivate(*d);
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+~ConfigurationNull()
+{
+  ConfigurationNullPrivate *d;
+  d = reinterpret_cast<ConfigurationNullPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull&
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+operator=(const ConfigurationNull &rhs)
+{
+  if(this != &rhs)
+    {
+      ConfigurationNullPrivate *d, *rhs_d;
+      d = reinterpret_cast<ConfigurationNullPrivate*>(m_d);
+      rhs_d = reinterpret_cast<ConfigurationNullPrivate*>(rhs.m_d);
+      *d = *rhs_d;
+    }
+  return *this;
+}
+
+#define setget_implement(type, name)                                    \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull&              \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull::             \
+  name(type v)                                                          \
+  {                                                                     \
+    ConfigurationNullPrivate *d;                                        \
+    d = reinterpret_cast<ConfigurationNullPrivate*>(m_d);               \
+    d->m_##name = v;                                                    \
+    return *this;                                                       \
+  }                                                                     \
+                                                                        \
+  type                                                                  \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull::             \
+  name(void) const                                                      \
+  {                                                                     \
+    ConfigurationNullPrivate *d;                                        \
+    d = reinterpret_cast<ConfigurationNullPrivate*>(m_d);               \
+    return d->m_##name;                                                 \
+  }
+
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>&, glyph_atlas)
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>&, image_atlas)
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>&, colorstop_atlas)
+setget_implement(unsigned int, attributes_per_buffer)
+setget_implement(unsigned int, indices_per_buffer)
+setget_implement(unsigned int, data_blocks_per_store_buffer)
+setget_implement(bool, record_draw_breaks)
+setget_implement(bool, break_on_shader_change)
+
+#undef setget_implement
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendNull methods
+fastuidraw::glsl::PainterBackendNull::
+PainterBackendNull(const ConfigurationNull &config_null,
+                   const ConfigurationGLSL &config_glsl,
+                   const ConfigurationBase &config_base):
+  PainterBackendGLSL(PainterBackendNullPrivate::compute_glyph_atlas(config_null),
+                     PainterBackendNullPrivate::compute_image_atlas(config_null),
+                     PainterBackendNullPrivate::compute_colorstop_atlas(config_null),
+                     config_glsl, config_base)
+{
+  m_d = FASTUIDRAWnew PainterBackendNullPrivate(config_null, config_base, this);
+}
+
+fastuidraw::glsl::PainterBackendNull::
+~PainterBackendNull()
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+const fastuidraw::glsl::PainterBackendNull::ConfigurationNull&
+fastuidraw::glsl::PainterBackendNull::
+configuration_null(void) const
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  return d->m_params;
+}
+
+const fastuidraw::glsl::PainterBackendNull::DrawStats&
+fastuidraw::glsl::PainterBackendNull::
+stats(void) const
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  return d->m_stats;
+}
+
+fastuidraw::const_c_array<fastuidraw::glsl::PainterBackendNull::DrawBreak>
+fastuidraw::glsl::PainterBackendNull::
+draw_breaks(void) const
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  return make_c_array(d->m_draw_breaks);
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+reset_stats(void)
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  d->m_stats = DrawStats();
+  d->m_draw_breaks.clear();
+}
+
+uint32_t
+fastuidraw::glsl::PainterBackendNull::
+compute_item_shader_group(PainterShader::Tag tag,
+                          const reference_counted_ptr<PainterItemShader> &shader)
+{
+  FASTUIDRAWunused(shader);
+  return configuration_null().break_on_shader_change() ? tag.m_ID : 0u;
+}
+
+uint32_t
+fastuidraw::glsl::PainterBackendNull::
+compute_blend_shader_group(PainterShader::Tag tag,
+                           const reference_counted_ptr<PainterBlendShader> &shader)
+{
+  FASTUIDRAWunused(shader);
+  return configuration_null().break_on_shader_change() ? tag.m_ID : 0u;
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+on_pre_draw(void)
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  ++d->m_stats.m_number_flushes;
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+on_post_draw(void)
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  d->m_pool.release_buffers();
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw>
+fastuidraw::glsl::PainterBackendNull::
+map_draw(void)
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  return FASTUIDRAWnew DrawCommand(d->m_pool.request_buffer(), d);
+}
@@ -354,10 +354,20 @@ create_stroke_shader(enum PainterEnums::cap_style stroke_style,
   using namespace fastuidraw::PainterEnums;
 
   PainterStrokeShader return_value;
+  reference_counted_ptr<const StrokingDataSelectorBase> se;
+
+  /* stroke_style is number_cap_styles exactly when the
+     shader is for non-dashed stroking.
+   */
+  se = (stroke_style == number_cap_styles) ?
+    PainterStrokeParams::stroking_data_selector(pixel_width_stroking) :
+    PainterDashedStrokeParams::stroking_data_selector(pixel_width_stroking);
+
   return_value
     .aa_shader_pass1(create_stroke_item_shader(stroke_style, pixel_width_stroking, uber_stroke_opaque_pass))
     .aa_shader_pass2(create_stroke_item_shader(stroke_style, pixel_width_stroking, uber_stroke_aa_pass))
-    .non_aa_shader(create_stroke_item_shader(stroke_style, pixel_width_stroking, uber_stroke_non_aa));
+    .non_aa_shader(create_stroke_item_shader(stroke_style, pixel_width_stroking, uber_stroke_non_aa))
+    .stroking_data_selector(se);
   return return_value;
 }
 
@@ -398,6 +408,27 @@ create_fill_shader(void)
   return shader;
 }
 
+reference_counted_ptr<PainterItemShader>
+ShaderSetCreator::
+create_analytic_fill_shader(void)
+{
+  reference_counted_ptr<PainterItemShader> shader;
+  varying_list varyings;
+
+  varyings
+    .add_float_varying("fastuidraw_analytic_fill_x")
+    .add_float_varying("fastuidraw_analytic_fill_y");
+  shader = FASTUIDRAWnew PainterItemShaderGLSL(false,
+                                               ShaderSource()
+                                               .add_source("fastuidraw_painter_analytic_fill.vert.glsl.resource_string",
+                                                           ShaderSource::from_resource),
+                                               ShaderSource()
+                                               .add_source("fastuidraw_painter_analytic_fill.frag.glsl.resource_string",
+                                                           ShaderSource::from_resource),
+                                               varyings);
+  return shader;
+}
+
 PainterShaderSet
 ShaderSetCreator::
 create_shader_set(void)
@@ -413,6 +444,7 @@ create_shader_set(void)
     .dashed_stroke_shader(create_dashed_stroke_shader_set(false))
     .pixel_width_dashed_stroke_shader(create_dashed_stroke_shader_set(true))
     .fill_shader(create_fill_shader())
+    .analytic_fill_shader(create_analytic_fill_shader())
     .blend_shaders(create_blend_shaders());
   return return_value;
 }
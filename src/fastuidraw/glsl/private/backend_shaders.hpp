@@ -105,6 +105,9 @@ public:
   reference_counted_ptr<PainterItemShader>
   create_fill_shader(void);
 
+  reference_counted_ptr<PainterItemShader>
+  create_analytic_fill_shader(void);
+
   PainterShaderSet
   create_shader_set(void);
 
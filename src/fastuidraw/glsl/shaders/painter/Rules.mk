@@ -25,6 +25,8 @@ LIBRARY_RESOURCE_STRING += $(call filelist, fastuidraw_painter_main.vert.glsl.re
 	fastuidraw_painter_stroke.frag.glsl.resource_string \
 	fastuidraw_painter_fill.vert.glsl.resource_string \
 	fastuidraw_painter_fill.frag.glsl.resource_string \
+	fastuidraw_painter_analytic_fill.vert.glsl.resource_string \
+	fastuidraw_painter_analytic_fill.frag.glsl.resource_string \
 	fastuidraw_painter_compute_local_distance_from_pixel_distance.glsl.resource_string \
 	)
 
@@ -8,9 +8,13 @@ d		:= $(dir)
 dir := $(d)/packing
 include $(dir)/Rules.mk
 
+dir := $(d)/private
+include $(dir)/Rules.mk
+
 LIBRARY_SOURCES += $(call filelist, painter_attribute_data.cpp \
 	painter_brush.cpp painter_stroke_params.cpp \
 	painter_dashed_stroke_params.cpp \
+	painter_analytic_fill_params.cpp \
 	painter.cpp painter_enums.cpp \
 	painter_shader_data.cpp \
 	painter_clip_equations.cpp \
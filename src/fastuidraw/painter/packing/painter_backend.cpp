@@ -61,11 +61,19 @@ namespace
   public:
     ConfigurationPrivate(void):
       m_brush_shader_mask(0),
-      m_alignment(4)
+      m_alignment(4),
+      m_supports_base_vertex(false),
+      m_per_draw_header(false),
+      m_persistent_store_blocks(0),
+      m_stencil_clipping(false)
     {}
 
     uint32_t m_brush_shader_mask;
     int m_alignment;
+    bool m_supports_base_vertex;
+    bool m_per_draw_header;
+    unsigned int m_persistent_store_blocks;
+    bool m_stencil_clipping;
   };
 }
 
@@ -179,6 +187,82 @@ alignment(int v)
   return *this;
 }
 
+bool
+fastuidraw::PainterBackend::ConfigurationBase::
+supports_base_vertex(void) const
+{
+  ConfigurationPrivate *d;
+  d = reinterpret_cast<ConfigurationPrivate*>(m_d);
+  return d->m_supports_base_vertex;
+}
+
+fastuidraw::PainterBackend::ConfigurationBase&
+fastuidraw::PainterBackend::ConfigurationBase::
+supports_base_vertex(bool v)
+{
+  ConfigurationPrivate *d;
+  d = reinterpret_cast<ConfigurationPrivate*>(m_d);
+  d->m_supports_base_vertex = v;
+  return *this;
+}
+
+bool
+fastuidraw::PainterBackend::ConfigurationBase::
+per_draw_header(void) const
+{
+  ConfigurationPrivate *d;
+  d = reinterpret_cast<ConfigurationPrivate*>(m_d);
+  return d->m_per_draw_header;
+}
+
+fastuidraw::PainterBackend::ConfigurationBase&
+fastuidraw::PainterBackend::ConfigurationBase::
+per_draw_header(bool v)
+{
+  ConfigurationPrivate *d;
+  d = reinterpret_cast<ConfigurationPrivate*>(m_d);
+  d->m_per_draw_header = v;
+  return *this;
+}
+
+unsigned int
+fastuidraw::PainterBackend::ConfigurationBase::
+persistent_store_blocks(void) const
+{
+  ConfigurationPrivate *d;
+  d = reinterpret_cast<ConfigurationPrivate*>(m_d);
+  return d->m_persistent_store_blocks;
+}
+
+fastuidraw::PainterBackend::ConfigurationBase&
+fastuidraw::PainterBackend::ConfigurationBase::
+persistent_store_blocks(unsigned int v)
+{
+  ConfigurationPrivate *d;
+  d = reinterpret_cast<ConfigurationPrivate*>(m_d);
+  d->m_persistent_store_blocks = v;
+  return *this;
+}
+
+bool
+fastuidraw::PainterBackend::ConfigurationBase::
+stencil_clipping(void) const
+{
+  ConfigurationPrivate *d;
+  d = reinterpret_cast<ConfigurationPrivate*>(m_d);
+  return d->m_stencil_clipping;
+}
+
+fastuidraw::PainterBackend::ConfigurationBase&
+fastuidraw::PainterBackend::ConfigurationBase::
+stencil_clipping(bool v)
+{
+  ConfigurationPrivate *d;
+  d = reinterpret_cast<ConfigurationPrivate*>(m_d);
+  d->m_stencil_clipping = v;
+  return *this;
+}
+
 ////////////////////////////////////
 // fastuidraw::PainterBackend methods
 fastuidraw::PainterBackend::
@@ -302,6 +386,7 @@ register_shader(const PainterShaderSet &shaders)
   register_shader(shaders.dashed_stroke_shader());
   register_shader(shaders.pixel_width_dashed_stroke_shader());
   register_shader(shaders.fill_shader());
+  register_shader(shaders.analytic_fill_shader());
   register_shader(shaders.glyph_shader());
   register_shader(shaders.glyph_shader_anisotropic());
   register_shader(shaders.blend_shaders());
@@ -378,3 +463,11 @@ configuration_base(void) const
   d = reinterpret_cast<PainterBackendPrivate*>(m_d);
   return d->m_config;
 }
+
+void
+fastuidraw::PainterBackend::
+ensure_room(unsigned int attributes, unsigned int indices)
+{
+  FASTUIDRAWunused(attributes);
+  FASTUIDRAWunused(indices);
+}
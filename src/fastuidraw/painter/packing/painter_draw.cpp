@@ -143,6 +143,42 @@ add_action(const reference_counted_ptr<DelayedAction> &h) const
   d->m_actions.push_back(h);
 }
 
+void
+fastuidraw::PainterDraw::
+base_vertex_change(unsigned int base_vertex,
+                   unsigned int indices_written) const
+{
+  FASTUIDRAWunused(base_vertex);
+  FASTUIDRAWunused(indices_written);
+  assert(!"PainterDraw::base_vertex_change() called on a PainterDraw that does not support base vertex");
+}
+
+void
+fastuidraw::PainterDraw::
+header_change(unsigned int header_entry,
+              unsigned int indices_written) const
+{
+  FASTUIDRAWunused(header_entry);
+  FASTUIDRAWunused(indices_written);
+  assert(!"PainterDraw::header_change() called on a PainterDraw that does not support per draw headers");
+}
+
+unsigned int
+fastuidraw::PainterDraw::
+persistent_store_version(void) const
+{
+  return 0;
+}
+
+void
+fastuidraw::PainterDraw::
+persistent_store_written(unsigned int version,
+                         range_type<unsigned int> blocks) const
+{
+  FASTUIDRAWunused(version);
+  FASTUIDRAWunused(blocks);
+}
+
 void
 fastuidraw::PainterDraw::
 unmap(unsigned int attributes_written,
@@ -20,11 +20,17 @@
 
 #include <vector>
 #include <list>
+#include <algorithm>
 #include <cstring>
 
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <boost/functional/hash.hpp>
+
 #include <fastuidraw/painter/packing/painter_packer.hpp>
 #include <fastuidraw/painter/painter_header.hpp>
 #include "../../private/util_private.hpp"
+#include "../../private/interval_allocator.hpp"
 
 namespace
 {
@@ -35,8 +41,26 @@ namespace
     uint32_t m_item_group;
     uint32_t m_brush;
     uint64_t m_blend_mode;
+    uint32_t m_stencil_ref;
+    enum fastuidraw::PainterShaderGroup::stencil_action_t m_stencil_action;
   };
 
+  /* Copy index values adding offset to each; the loop
+     is kept on raw pointers so that the compiler can
+     vectorize it.
+   */
+  void
+  copy_indices_with_offset(fastuidraw::PainterIndex *dst,
+                           const fastuidraw::PainterIndex *src,
+                           unsigned int count,
+                           fastuidraw::PainterIndex offset)
+  {
+    for(unsigned int i = 0; i < count; ++i)
+      {
+        dst[i] = src[i] + offset;
+      }
+  }
+
   template<typename T>
   const T&
   fetch_value(const fastuidraw::PainterData::value<T> &obj)
@@ -55,6 +79,39 @@ namespace
     return default_value;
   }
 
+  inline
+  bool
+  blend_func_reads_dst(enum fastuidraw::BlendMode::func_t f)
+  {
+    return f == fastuidraw::BlendMode::DST_COLOR
+      || f == fastuidraw::BlendMode::ONE_MINUS_DST_COLOR
+      || f == fastuidraw::BlendMode::DST_ALPHA
+      || f == fastuidraw::BlendMode::ONE_MINUS_DST_ALPHA
+      || f == fastuidraw::BlendMode::SRC_ALPHA_SATURATE;
+  }
+
+  /* returns true if the blend mode gives a value that
+     does not depend on the value already in the
+     framebuffer.
+   */
+  bool
+  blend_mode_ignores_dst(const fastuidraw::BlendMode &md)
+  {
+    if(!md.blending_on())
+      {
+        return true;
+      }
+
+    return md.equation_rgb() != fastuidraw::BlendMode::MIN
+      && md.equation_rgb() != fastuidraw::BlendMode::MAX
+      && md.equation_alpha() != fastuidraw::BlendMode::MIN
+      && md.equation_alpha() != fastuidraw::BlendMode::MAX
+      && md.func_dst_rgb() == fastuidraw::BlendMode::ZERO
+      && md.func_dst_alpha() == fastuidraw::BlendMode::ZERO
+      && !blend_func_reads_dst(md.func_src_rgb())
+      && !blend_func_reads_dst(md.func_src_alpha());
+  }
+
   class PainterShaderGroupPrivate:
     public fastuidraw::PainterShaderGroup,
     public PainterShaderGroupValues
@@ -74,10 +131,34 @@ namespace
     }
   };
 
-  /* QUESTION
-      - does the reference count to a pool need to be thread safe?
+  /* returns true if drawing with the values of group
+     after drawing with the values of prev needs a
+     draw break, see per_draw_command::start_indices().
+   */
+  bool
+  needs_draw_break(const PainterShaderGroupPrivate &prev,
+                   const PainterShaderGroupPrivate &group,
+                   uint32_t brush_shader_mask)
+  {
+    return group.m_item_group != prev.m_item_group
+      || group.m_blend_group != prev.m_blend_group
+      || (brush_shader_mask & (group.m_brush ^ prev.m_brush)) != 0u
+      || group.m_blend_mode != prev.m_blend_mode
+      || group.m_stencil_ref != prev.m_stencil_ref
+      || group.m_stencil_action != prev.m_stencil_action;
+  }
+
+  /* A PoolBase holds the free slots of a pool of entries.
+     In non-concurrent mode the free slots are a simple stack.
+     In concurrent mode the free slots form a lock-free stack
+     (a Treiber stack) whose head packs the slot index in
+     the low 32-bits and a tag in the high 32-bits; the tag
+     is incremented on each change to avoid the ABA problem.
+     The reference count to a pool is atomic because in
+     concurrent mode entries of a pool may be released from
+     any thread.
    */
-  class PoolBase:public fastuidraw::reference_counted<PoolBase>::non_concurrent
+  class PoolBase:public fastuidraw::reference_counted<PoolBase>::default_base
   {
   public:
     enum
@@ -85,36 +166,48 @@ namespace
         pool_size = 1024
       };
 
-    PoolBase(void):
-      m_free_slots_back(pool_size - 1)
+    explicit
+    PoolBase(bool concurrent):
+      m_concurrent(concurrent),
+      m_free_slots_back(pool_size - 1),
+      m_next(NULL)
     {
       for(unsigned int i = 0; i < pool_size; ++i)
         {
           m_free_slots[i] = pool_size - 1 - i;
         }
+
+      if(m_concurrent)
+        {
+          m_next = FASTUIDRAWnew boost::atomic<int>[pool_size];
+          for(unsigned int i = 0; i < pool_size; ++i)
+            {
+              m_next[i].store(static_cast<int>(i) + 1, boost::memory_order_relaxed);
+            }
+          m_next[pool_size - 1].store(-1, boost::memory_order_relaxed);
+        }
+      m_head.store(pack_head(0, 0), boost::memory_order_relaxed);
     }
 
     ~PoolBase()
     {
-      assert(m_free_slots_back == pool_size - 1);
+      assert(m_concurrent || m_free_slots_back == pool_size - 1);
+      if(m_next != NULL)
+        {
+          FASTUIDRAWdelete_array(m_next);
+        }
     }
 
     int
     aquire_slot(void)
     {
-      /* Should we make this thread safe? We can make it
-         thread safe by using atomic operation on m_free_slots_back.
-         The following code would make it thread safe.
-
-         return_value = m_free_slots_back.fetch_sub(1, boost::memory_order_aquire)
-         if(return_value < 0)
-           {
-              m_free_slots_back.fetch_add(1, boost::memory_order_aquire);
-           }
-         return return_value;
-       */
       int return_value(-1);
 
+      if(m_concurrent)
+        {
+          return aquire_slot_concurrent();
+        }
+
       if(m_free_slots_back >= 0)
         {
           return_value = m_free_slots[m_free_slots_back];
@@ -126,37 +219,253 @@ namespace
     void
     release_slot(int v)
     {
-      /* Should we make this thread safe? We can make it
-         thread safe by using atomic operation on m_free_slots_back.
-         The following code would make it thread safe.
-
-         int S;
-         S = m_free_slots_back.fetch_add(1, boost::memory_order_release);
-         boost::atomic_thread_fence(boost::memory_order_acquire);
-         assert(S < pool_size);
-         m_free_slots[S] = v;
-       */
       assert(v >= 0);
       assert(v < pool_size);
 
+      if(m_concurrent)
+        {
+          release_slot_concurrent(v);
+          return;
+        }
+
       ++m_free_slots_back;
 
       assert(m_free_slots_back < pool_size);
       m_free_slots[m_free_slots_back] = v;
     }
 
+    bool
+    concurrent(void) const
+    {
+      return m_concurrent;
+    }
+
   private:
+    static
+    uint64_t
+    pack_head(uint32_t tag, int slot)
+    {
+      return (uint64_t(tag) << 32u) | uint64_t(uint32_t(slot));
+    }
+
+    static
+    int
+    head_slot(uint64_t h)
+    {
+      return int(uint32_t(h & 0xFFFFFFFFu));
+    }
+
+    static
+    uint32_t
+    head_tag(uint64_t h)
+    {
+      return uint32_t(h >> 32u);
+    }
+
+    int
+    aquire_slot_concurrent(void)
+    {
+      uint64_t head, new_head;
+      int slot;
+
+      head = m_head.load(boost::memory_order_acquire);
+      do
+        {
+          slot = head_slot(head);
+          if(slot < 0)
+            {
+              return -1;
+            }
+          new_head = pack_head(head_tag(head) + 1,
+                               m_next[slot].load(boost::memory_order_relaxed));
+        }
+      while(!m_head.compare_exchange_weak(head, new_head,
+                                          boost::memory_order_acquire,
+                                          boost::memory_order_acquire));
+      return slot;
+    }
+
+    void
+    release_slot_concurrent(int v)
+    {
+      uint64_t head, new_head;
+
+      head = m_head.load(boost::memory_order_relaxed);
+      do
+        {
+          m_next[v].store(head_slot(head), boost::memory_order_relaxed);
+          new_head = pack_head(head_tag(head) + 1, v);
+        }
+      while(!m_head.compare_exchange_weak(head, new_head,
+                                          boost::memory_order_release,
+                                          boost::memory_order_relaxed));
+    }
+
+    bool m_concurrent;
+
+    /* used in non-concurrent mode */
     int m_free_slots_back;
     fastuidraw::vecN<int, pool_size> m_free_slots;
+
+    /* used in concurrent mode, m_next is only
+       allocated for a concurrent pool
+     */
+    boost::atomic<uint64_t> m_head;
+    boost::atomic<int> *m_next;
+  };
+
+  /* A PersistentStore is the host side shadow of the persistent
+     region of PainterDraw::m_store, see
+     PainterBackend::ConfigurationBase::persistent_store_blocks().
+     The data of a PainterPackedValue is allocated into the region
+     once and the blocks written are marked dirty. When a new
+     PainterDraw is mapped, the pending writes are published as a
+     new sequence and the blocks that the buffer backing the
+     PainterDraw does not yet hold are copied to it. Thus a value
+     allocated while a PainterDraw is filled can be referenced
+     directly starting with the next PainterDraw. The last
+     reference to a value can be dropped from any thread, so
+     frees are only queued and are applied at begin().
+   */
+  class PersistentStore:
+    public fastuidraw::reference_counted<PersistentStore>::default_base
+  {
+  public:
+    PersistentStore(unsigned int number_blocks, unsigned int alignment):
+      m_alignment(alignment),
+      m_shadow(number_blocks * alignment),
+      m_allocator(number_blocks),
+      m_high_water(0),
+      m_dirty(number_blocks, 0),
+      m_sequence(0)
+    {}
+
+    unsigned int
+    alignment(void) const
+    {
+      return m_alignment;
+    }
+
+    /* sequence of published values */
+    unsigned int
+    sequence(void) const
+    {
+      return m_sequence;
+    }
+
+    /* Returns the block at which data is placed or -1
+       if there is no room; the data becomes available
+       at sequence() + 1.
+     */
+    int
+    allocate(fastuidraw::const_c_array<fastuidraw::generic_data> data)
+    {
+      int block;
+      unsigned int num_blocks;
+
+      assert(data.size() % m_alignment == 0);
+      num_blocks = data.size() / m_alignment;
+      if(num_blocks == 0)
+        {
+          return -1;
+        }
+
+      block = m_allocator.allocate_interval(num_blocks);
+      if(block >= 0)
+        {
+          unsigned int b(block);
+
+          std::copy(data.begin(), data.end(), m_shadow.begin() + b * m_alignment);
+          m_dirty.m_begin = std::min(m_dirty.m_begin, b);
+          m_dirty.m_end = std::max(m_dirty.m_end, b + num_blocks);
+          m_high_water = std::max(m_high_water, b + num_blocks);
+        }
+      return block;
+    }
+
+    /* may be called from any thread */
+    void
+    request_free(int block, unsigned int num_blocks)
+    {
+      boost::lock_guard<boost::mutex> M(m_free_mutex);
+      m_pending_frees.push_back(fastuidraw::range_type<int>(block, block + num_blocks));
+    }
+
+    void
+    apply_frees(void)
+    {
+      boost::lock_guard<boost::mutex> M(m_free_mutex);
+      for(std::vector<fastuidraw::range_type<int> >::const_iterator iter = m_pending_frees.begin(),
+            end = m_pending_frees.end(); iter != end; ++iter)
+        {
+          m_allocator.free_interval(iter->m_begin, iter->m_end - iter->m_begin);
+        }
+      m_pending_frees.clear();
+    }
+
+    /* publish the pending writes and bring the persistent
+       region of the buffer backing draw up to date; returns
+       the sequence that draw holds afterwards.
+     */
+    unsigned int
+    sync(const fastuidraw::PainterDraw &draw,
+         fastuidraw::PainterPacker::Stats &stats);
+
+  private:
+    enum
+      {
+        max_log_size = 16
+      };
+
+    class log_entry
+    {
+    public:
+      unsigned int m_version;
+      fastuidraw::range_type<unsigned int> m_blocks;
+    };
+
+    /* versions are unique across all PersistentStore
+       objects, so that a buffer synced by a different
+       PersistentStore is never mistaken as up to date.
+     */
+    static
+    unsigned int
+    next_version(void)
+    {
+      static boost::atomic<unsigned int> counter(0);
+      unsigned int v;
+      do
+        {
+          v = counter.fetch_add(1, boost::memory_order_relaxed) + 1;
+        }
+      while(v == 0);
+      return v;
+    }
+
+    unsigned int m_alignment;
+    std::vector<fastuidraw::generic_data> m_shadow;
+    fastuidraw::interval_allocator m_allocator;
+    unsigned int m_high_water;
+    fastuidraw::range_type<unsigned int> m_dirty;
+
+    /* m_log[i] is the sequence m_sequence - m_log.size() + 1 + i */
+    unsigned int m_sequence;
+    std::vector<log_entry> m_log;
+
+    boost::mutex m_free_mutex;
+    std::vector<fastuidraw::range_type<int> > m_pending_frees;
   };
 
-  class EntryBase
+  class EntryBase:fastuidraw::noncopyable
   {
   public:
 
     EntryBase(void):
+      m_persistent_location(0),
+      m_persistent_sequence(0),
       m_raw_value(NULL),
-      m_pool_slot(-1)
+      m_pool_slot(-1),
+      m_count(0)
     {}
 
     void
@@ -164,7 +473,15 @@ namespace
     {
       assert(m_pool);
       assert(m_pool_slot >= 0);
-      m_count.add_reference();
+      if(m_concurrent)
+        {
+          m_count.fetch_add(1, boost::memory_order_relaxed);
+        }
+      else
+        {
+          m_count.store(m_count.load(boost::memory_order_relaxed) + 1,
+                        boost::memory_order_relaxed);
+        }
     }
 
     void
@@ -172,11 +489,43 @@ namespace
     {
       assert(m_pool);
       assert(m_pool_slot >= 0);
-      if(m_count.remove_reference())
+
+      bool last_reference;
+      if(m_concurrent)
+        {
+          last_reference = (m_count.fetch_sub(1, boost::memory_order_release) == 1);
+          if(last_reference)
+            {
+              boost::atomic_thread_fence(boost::memory_order_acquire);
+            }
+        }
+      else
+        {
+          int c;
+          c = m_count.load(boost::memory_order_relaxed) - 1;
+          m_count.store(c, boost::memory_order_relaxed);
+          last_reference = (c == 0);
+        }
+
+      if(last_reference)
         {
-          m_pool->release_slot(m_pool_slot);
+          /* clear the fields before giving back the slot
+             because once the slot is back in the pool,
+             another thread may take it into use.
+           */
+          fastuidraw::reference_counted_ptr<PoolBase> pool(m_pool);
+          int slot(m_pool_slot);
+
+          if(m_persistent_store)
+            {
+              m_persistent_store->request_free(m_persistent_location,
+                                               m_data.size() / m_alignment);
+              m_persistent_store = NULL;
+            }
+
           m_pool_slot = -1;
           m_pool = NULL;
+          pool->release_slot(slot);
         }
     }
 
@@ -198,6 +547,13 @@ namespace
      */
     unsigned int m_alignment;
 
+    /* if non-NULL, m_data is also placed in the persistent
+       region at block m_persistent_location starting with
+       sequence m_persistent_sequence of m_persistent_store
+     */
+    fastuidraw::reference_counted_ptr<PersistentStore> m_persistent_store;
+    unsigned int m_persistent_location, m_persistent_sequence;
+
   protected:
     /* pointer to raw state member held
        by derived class
@@ -208,12 +564,14 @@ namespace
      */
     fastuidraw::reference_counted_ptr<PoolBase> m_pool;
     int m_pool_slot;
+    bool m_concurrent;
 
   private:
-    /* Entry reference count is not thread safe because
-       the objects themselves are not.
+    /* Entry reference count is atomic only if the pool
+       is in concurrent mode; in non-concurrent mode the
+       increment and decrement are plain load and stores.
     */
-    fastuidraw::reference_count_non_concurrent m_count;
+    boost::atomic<int> m_count;
   };
 
   template<typename T>
@@ -234,6 +592,7 @@ namespace
       m_pool = p;
       m_state = st;
       m_pool_slot = slot;
+      m_concurrent = p->concurrent();
 
       this->m_begin_id = -1;
       this->m_draw_command_id = 0;
@@ -251,6 +610,11 @@ namespace
   class Pool:public PoolBase
   {
   public:
+    explicit
+    Pool(bool concurrent):
+      PoolBase(concurrent)
+    {}
+
     /* Returning NULL indicates no free entries left in the pool
      */
     Entry<T>*
@@ -272,42 +636,114 @@ namespace
     fastuidraw::vecN<Entry<T>, PoolBase::pool_size> m_data;
   };
 
+  /* A PoolSet is a set of chains of pools. In non-concurrent
+     mode there is exactly one chain. In concurrent mode, there
+     are number_chains chains and a thread allocates from the
+     chain selected by its thread ID, thus threads only contend
+     with the (few) threads sharing the same chain instead of
+     all contending on one free list. A new pool is added to a
+     chain when its current pool runs out of free slots; this
+     is the only operation that takes a lock.
+   */
   template<typename T>
   class PoolSet:fastuidraw::noncopyable
   {
   public:
+    enum
+      {
+        number_chains = 16
+      };
 
-    PoolSet(void)
+    explicit
+    PoolSet(bool concurrent):
+      m_concurrent(concurrent),
+      m_chains(concurrent ? number_chains : 1)
     {
-      m_pools.push_back(FASTUIDRAWnew Pool<T>());
+      for(unsigned int i = 0, endi = m_chains.size(); i < endi; ++i)
+        {
+          m_chains[i].add_pool(NULL, m_concurrent);
+        }
     }
 
     Entry<T>*
     allocate(const T &st, int alignment)
     {
-      Entry<T> *return_value;
+      Entry<T> *return_value(NULL);
+      chain &C(m_chains[chain_index()]);
 
-      return_value = m_pools.back()->allocate(st, alignment);
-      if(!return_value)
+      while(!return_value)
         {
-          m_pools.push_back(FASTUIDRAWnew Pool<T>());
-          return_value = m_pools.back()->allocate(st, alignment);
-        }
+          Pool<T> *p;
 
-      assert(return_value);
+          p = C.m_current.load(boost::memory_order_acquire);
+          return_value = p->allocate(st, alignment);
+          if(!return_value)
+            {
+              C.add_pool(p, m_concurrent);
+            }
+        }
       return return_value;
     }
 
   private:
-    std::vector<fastuidraw::reference_counted_ptr<Pool<T> > > m_pools;
+    class chain
+    {
+    public:
+      chain(void):
+        m_current(NULL)
+      {}
+
+      chain(const chain &obj):
+        m_current(obj.m_current.load()),
+        m_pools(obj.m_pools)
+      {}
+
+      /* add a new pool to the chain if the current
+         pool is still full_pool
+       */
+      void
+      add_pool(Pool<T> *full_pool, bool concurrent)
+      {
+        fastuidraw::autolock_mutex m(m_mutex);
+        if(m_current.load(boost::memory_order_relaxed) == full_pool)
+          {
+            fastuidraw::reference_counted_ptr<Pool<T> > p;
+
+            p = FASTUIDRAWnew Pool<T>(concurrent);
+            m_pools.push_back(p);
+            m_current.store(p.get(), boost::memory_order_release);
+          }
+      }
+
+      boost::atomic<Pool<T>*> m_current;
+      boost::mutex m_mutex;
+      std::vector<fastuidraw::reference_counted_ptr<Pool<T> > > m_pools;
+    };
+
+    unsigned int
+    chain_index(void) const
+    {
+      if(!m_concurrent)
+        {
+          return 0;
+        }
+      return boost::hash<boost::thread::id>()(boost::this_thread::get_id()) % number_chains;
+    }
+
+    bool m_concurrent;
+    std::vector<chain> m_chains;
   };
 
   class PainterPackedValuePoolPrivate
   {
   public:
-    explicit
-    PainterPackedValuePoolPrivate(int d):
-      m_alignment(d)
+    PainterPackedValuePoolPrivate(int d, bool concurrent):
+      m_alignment(d),
+      m_brush_pool(concurrent),
+      m_clip_equations_pool(concurrent),
+      m_item_matrix_pool(concurrent),
+      m_item_shader_data_pool(concurrent),
+      m_blend_shader_data_pool(concurrent)
     {}
 
     int m_alignment;
@@ -329,74 +765,380 @@ namespace
     uint32_t m_blend_shader_data_loc;
   };
 
-  class PainterPackerPrivate;
+  /* Painter state already packed into a contiguous range
+     of generic_data; the locations are relative to the
+     start of the range.
+   */
+  class prepacked_state
+  {
+  public:
+    prepacked_state(void):
+      m_matrix(NULL),
+      m_clip(NULL)
+    {}
 
-  class per_draw_command
+    fastuidraw::const_c_array<fastuidraw::generic_data> m_data;
+    painter_state_location m_location;
+    fastuidraw::reference_counted_ptr<const fastuidraw::Image> m_image;
+    fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> m_color_stops;
+
+    /* if non-NULL, the item matrix and clip equations are
+       not in m_data but come from these packed values.
+     */
+    const fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> *m_matrix;
+    const fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> *m_clip;
+  };
+
+  class recorded_draw
   {
   public:
-    per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
-                     const fastuidraw::PainterBackend::ConfigurationBase &config);
+    recorded_draw(void):
+      m_blend_mode(0),
+      m_brush_shader(0),
+      m_z(0),
+      m_matrix_slot(0),
+      m_store_range(0, 0),
+      m_attrib_chunk_range(0, 0),
+      m_index_chunk_range(0, 0),
+      m_selector_range(0, 0)
+    {}
 
-    unsigned int
-    attribute_room(void)
-    {
-      assert(m_attributes_written <= m_draw_command->m_attributes.size());
-      return m_draw_command->m_attributes.size() - m_attributes_written;
-    }
+    /* vecN declares an assignment operator but no copy
+       ctor, so the ranges are built from their components
+       rather than relying on the implicit copy ctor.
+     */
+    recorded_draw(const recorded_draw &obj):
+      m_shader(obj.m_shader),
+      m_blend_shader(obj.m_blend_shader),
+      m_blend_mode(obj.m_blend_mode),
+      m_brush_shader(obj.m_brush_shader),
+      m_z(obj.m_z),
+      m_matrix_slot(obj.m_matrix_slot),
+      m_store_range(obj.m_store_range.x(), obj.m_store_range.y()),
+      m_attrib_chunk_range(obj.m_attrib_chunk_range.x(), obj.m_attrib_chunk_range.y()),
+      m_index_chunk_range(obj.m_index_chunk_range.x(), obj.m_index_chunk_range.y()),
+      m_selector_range(obj.m_selector_range.x(), obj.m_selector_range.y()),
+      m_location(obj.m_location),
+      m_image(obj.m_image),
+      m_color_stops(obj.m_color_stops)
+    {}
 
-    unsigned int
-    index_room(void)
+    recorded_draw&
+    operator=(const recorded_draw &rhs)
     {
-      assert(m_indices_written <= m_draw_command->m_indices.size());
-      return m_draw_command->m_indices.size() - m_indices_written;
+      m_shader = rhs.m_shader;
+      m_blend_shader = rhs.m_blend_shader;
+      m_blend_mode = rhs.m_blend_mode;
+      m_brush_shader = rhs.m_brush_shader;
+      m_z = rhs.m_z;
+      m_matrix_slot = rhs.m_matrix_slot;
+      m_store_range = rhs.m_store_range;
+      m_attrib_chunk_range = rhs.m_attrib_chunk_range;
+      m_index_chunk_range = rhs.m_index_chunk_range;
+      m_selector_range = rhs.m_selector_range;
+      m_location = rhs.m_location;
+      m_image = rhs.m_image;
+      m_color_stops = rhs.m_color_stops;
+      return *this;
     }
 
-    unsigned int
-    store_room(void)
-    {
-      unsigned int s;
-      s = store_written();
-      assert(s <= m_draw_command->m_store.size());
-      return m_draw_command->m_store.size() - s;
-    }
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_shader;
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> m_blend_shader;
+    uint64_t m_blend_mode;
+    uint32_t m_brush_shader;
+    unsigned int m_z;
 
-    unsigned int
-    store_written(void)
-    {
-      return current_block() * m_alignment;
-    }
+    /* index into the matrices passed to draw_command_list()
+       or no_matrix_slot if the matrix and clip are recorded
+     */
+    unsigned int m_matrix_slot;
+
+    /* ranges are [begin, end) into the arrays of
+       CommandListPrivate
+     */
+    fastuidraw::uvec2 m_store_range;
+    fastuidraw::uvec2 m_attrib_chunk_range;
+    fastuidraw::uvec2 m_index_chunk_range;
+    fastuidraw::uvec2 m_selector_range;
+
+    painter_state_location m_location;
+    fastuidraw::reference_counted_ptr<const fastuidraw::Image> m_image;
+    fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> m_color_stops;
+  };
+
+  class CommandListPrivate
+  {
+  public:
+    enum
+      {
+        no_matrix_slot = ~0u
+      };
 
+    explicit
+    CommandListPrivate(const fastuidraw::PainterPacker *p, unsigned int alignment):
+      m_packer(p),
+      m_alignment(alignment),
+      m_blend_mode(0),
+      m_number_matrix_slots(0)
+    {}
+
+    template<typename T>
     void
-    unmap(void)
-    {
-      m_draw_command->unmap(m_attributes_written, m_indices_written, store_written());
-    }
+    record_state(const fastuidraw::PainterData::value<T> &obj, uint32_t &location);
 
     void
-    pack_painter_state(const fastuidraw::PainterPackerData &state,
-                       PainterPackerPrivate *p, painter_state_location &out_data);
+    record_state(const fastuidraw::PainterPackerData &state, recorded_draw &out_draw);
 
-    unsigned int
-    pack_header(unsigned int header_size,
-                uint32_t brush_shader,
-                const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
-                uint64_t blend_mode,
-                const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &item_shader,
-                unsigned int z,
-                const painter_state_location &loc,
-                const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+    void
+    record_chunks(fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+                  fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+                  fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+                  recorded_draw &out_draw);
 
-    fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> m_draw_command;
-    unsigned int m_attributes_written, m_indices_written;
+    void
+    record_draw(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                const fastuidraw::PainterPackerData &data,
+                fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+                fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+                fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+                unsigned int z, unsigned int matrix_slot);
 
-  private:
-    fastuidraw::c_array<fastuidraw::generic_data>
-    allocate_store(unsigned int num_elements);
+    void
+    clear(void);
 
-    unsigned int
-    current_block(void)
+    fastuidraw::const_c_array<fastuidraw::PainterAttribute>
+    attribute_chunk(unsigned int I) const
     {
-      return m_store_blocks_written;
+      const fastuidraw::uvec2 &R(m_attrib_chunks[I]);
+      return fastuidraw::make_c_array(m_attributes).sub_array(R[0], R[1] - R[0]);
+    }
+
+    fastuidraw::const_c_array<fastuidraw::PainterIndex>
+    index_chunk(unsigned int I) const
+    {
+      const fastuidraw::uvec2 &R(m_index_chunks[I]);
+      return fastuidraw::make_c_array(m_indices).sub_array(R[0], R[1] - R[0]);
+    }
+
+    const fastuidraw::PainterPacker *m_packer;
+    unsigned int m_alignment;
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> m_blend_shader;
+    uint64_t m_blend_mode;
+    unsigned int m_number_matrix_slots;
+
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+    std::vector<fastuidraw::PainterIndex> m_indices;
+    std::vector<fastuidraw::generic_data> m_store;
+    std::vector<fastuidraw::uvec2> m_attrib_chunks;
+    std::vector<fastuidraw::uvec2> m_index_chunks;
+    std::vector<unsigned int> m_selectors;
+    std::vector<recorded_draw> m_draws;
+  };
+
+  /* A draw held back by the reordering of PainterPacker.
+     Its attributes, header and state are written to the
+     current PainterDraw when the draw is added; only its
+     indices, the held_chunk values of m_chunks, wait
+     for the draw order to be chosen.
+   */
+  class held_draw
+  {
+  public:
+    held_draw(void):
+      m_header_entry(0),
+      m_z(0),
+      m_order_independent(false),
+      m_has_bounds(false),
+      m_min_x(0.0f), m_min_y(0.0f),
+      m_max_x(0.0f), m_max_y(0.0f),
+      m_chunks(0, 0)
+    {}
+
+    /* returns true if the result of drawing a and b
+       does not depend on the order they are drawn
+     */
+    static
+    bool
+    commute(const held_draw &a, const held_draw &b);
+
+    PainterShaderGroupPrivate m_group;
+
+    /* entry to PainterDraw::m_header_attributes if the
+       PainterDraw has a header per draw
+     */
+    unsigned int m_header_entry;
+    unsigned int m_z;
+    bool m_order_independent;
+
+    /* rectangle in normalized device coordinates that
+       holds every fragment of the draw if m_has_bounds
+     */
+    bool m_has_bounds;
+    float m_min_x, m_min_y, m_max_x, m_max_y;
+
+    /* range into PainterPackerPrivate::m_held_chunks */
+    fastuidraw::range_type<unsigned int> m_chunks;
+  };
+
+  class held_chunk
+  {
+  public:
+    held_chunk(unsigned int begin, unsigned int end, unsigned int attrib_offset):
+      m_indices(begin, end),
+      m_attrib_offset(attrib_offset)
+    {}
+
+    /* range into PainterPackerPrivate::m_held_indices */
+    fastuidraw::range_type<unsigned int> m_indices;
+    unsigned int m_attrib_offset;
+  };
+
+  class PainterPackerPrivate;
+
+  class per_draw_command
+  {
+  public:
+    per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
+                     const fastuidraw::PainterBackend::ConfigurationBase &config);
+
+    unsigned int
+    attribute_room(void)
+    {
+      assert(m_attributes_written <= m_draw_command->m_attributes.size());
+      return m_draw_command->m_attributes.size() - m_attributes_written;
+    }
+
+    unsigned int
+    index_room(void)
+    {
+      assert(m_indices_written + m_indices_held <= m_draw_command->m_indices.size());
+      return m_draw_command->m_indices.size() - m_indices_written - m_indices_held;
+    }
+
+    unsigned int
+    store_room(void)
+    {
+      unsigned int s;
+      s = store_written();
+      assert(s <= m_draw_command->m_store.size());
+      return m_draw_command->m_store.size() - s;
+    }
+
+    unsigned int
+    store_written(void)
+    {
+      return current_block() * m_alignment;
+    }
+
+    unsigned int
+    header_room(void)
+    {
+      if(!m_per_draw_header)
+        {
+          return m_draw_command->m_header_attributes.size();
+        }
+      assert(m_headers_written <= m_draw_command->m_header_attributes.size());
+      return m_draw_command->m_header_attributes.size() - m_headers_written;
+    }
+
+    bool
+    per_draw_header(void) const
+    {
+      return m_per_draw_header;
+    }
+
+    void
+    unmap(fastuidraw::PainterPacker::Stats &stats)
+    {
+      unsigned int headers;
+
+      headers = (m_per_draw_header) ? m_headers_written : m_attributes_written;
+      stats.m_attribute_bytes += m_attributes_written * sizeof(fastuidraw::PainterAttribute);
+      stats.m_header_attribute_bytes += headers * sizeof(uint32_t);
+      stats.m_index_bytes += m_indices_written * sizeof(fastuidraw::PainterIndex);
+      stats.m_data_store_bytes += (store_written() - m_persistent_blocks * m_alignment) * sizeof(fastuidraw::generic_data);
+      m_draw_command->unmap(m_attributes_written, m_indices_written, store_written());
+    }
+
+    void
+    pack_painter_state(const fastuidraw::PainterPackerData &state,
+                       PainterPackerPrivate *p, painter_state_location &out_data);
+
+    void
+    pack_painter_state(const prepacked_state &state,
+                       PainterPackerPrivate *p, painter_state_location &out_data);
+
+    /* copy index data to m_draw_command->m_indices where
+       the index values are relative to attrib_offset
+     */
+    void
+    pack_indices(fastuidraw::const_c_array<fastuidraw::PainterIndex> src,
+                 unsigned int attrib_offset);
+
+    /* if held is not NULL, the shader group values and the
+       header entry are written to it and the call to
+       start_indices() is left to the caller
+     */
+    unsigned int
+    pack_header(unsigned int header_size,
+                uint32_t brush_shader,
+                const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
+                uint64_t blend_mode,
+                uint32_t stencil_ref,
+                enum fastuidraw::PainterShaderGroup::stencil_action_t stencil_action,
+                const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &item_shader,
+                unsigned int z,
+                const painter_state_location &loc,
+                const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back,
+                fastuidraw::PainterPacker::Stats &stats,
+                held_draw *held);
+
+    /* issue the draw break and header change, if any, for
+       the indices of a draw whose header was packed with the
+       shader group values group to header entry header_entry
+     */
+    void
+    start_indices(const PainterShaderGroupPrivate &group,
+                  unsigned int header_entry,
+                  fastuidraw::PainterPacker::Stats &stats);
+
+    const PainterShaderGroupPrivate&
+    prev_state(void) const
+    {
+      return m_prev_state;
+    }
+
+    uint32_t
+    brush_shader_mask(void) const
+    {
+      return m_brush_shader_mask;
+    }
+
+    fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> m_draw_command;
+    unsigned int m_attributes_written, m_indices_written;
+
+    /* number of indices of held back draws, room for them
+       is kept in m_draw_command->m_indices
+     */
+    unsigned int m_indices_held;
+
+    /* sequence of the PersistentStore the persistent
+       region of m_draw_command holds
+     */
+    unsigned int m_persistent_sequence;
+
+  private:
+    fastuidraw::c_array<fastuidraw::generic_data>
+    allocate_store(unsigned int num_elements);
+
+    void
+    retain_resources(const fastuidraw::reference_counted_ptr<const fastuidraw::Image> &image,
+                     const fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> &color_stops);
+
+    unsigned int
+    current_block(void)
+    {
+      return m_store_blocks_written;
     }
 
     void
@@ -439,7 +1181,12 @@ namespace
     }
 
     unsigned int m_store_blocks_written;
+    unsigned int m_persistent_blocks;
     unsigned int m_alignment;
+    bool m_supports_base_vertex;
+    unsigned int m_base_vertex;
+    bool m_per_draw_header;
+    unsigned int m_headers_written;
     fastuidraw::reference_counted_ptr<const fastuidraw::Image> m_last_image;
     fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> m_last_color_stop;
     std::list<fastuidraw::reference_counted_ptr<const fastuidraw::Image> > m_images_active;
@@ -454,6 +1201,11 @@ namespace
   {
   public:
     std::vector<unsigned int> m_attribs_loaded;
+    std::vector<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > m_attrib_chunks;
+    std::vector<fastuidraw::const_c_array<fastuidraw::PainterIndex> > m_index_chunks;
+    std::vector<unsigned int> m_reorder_order;
+    std::vector<bool> m_reorder_emitted;
+    std::vector<unsigned int> m_reorder_skipped;
   };
 
   class PainterPackerPrivate
@@ -463,15 +1215,82 @@ namespace
     PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
                          fastuidraw::PainterPacker *p);
 
+    enum new_command_reason_t
+      {
+        new_command_begin,
+        new_command_attribute_room,
+        new_command_index_room,
+        new_command_store_room,
+        new_command_header_room,
+      };
+
     void
-    start_new_command(void);
+    start_new_command(enum new_command_reason_t reason);
 
     void
     upload_draw_state(const fastuidraw::PainterPackerData &draw_state);
 
+    void
+    upload_draw_state(const prepacked_state &draw_state);
+
+    void
+    draw_recorded(const CommandListPrivate &list, const recorded_draw &R,
+                  const fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> *matrix,
+                  const fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> *clip,
+                  unsigned int z_offset,
+                  const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+
+    void
+    reorder_draw(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                 const fastuidraw::PainterPackerData &draw,
+                 fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+                 fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+                 fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+                 unsigned int z);
+
+    /* write the indices of the held back draws to the
+       current PainterDraw in the order of compute_reorder()
+     */
+    void
+    flush_reorder(void);
+
+    /* computes m_work_room.m_reorder_order from m_held_draws;
+       if reordering does not remove a draw break, the order
+       is the order in which the draws were added.
+     */
+    void
+    compute_reorder(void);
+
+    bool
+    order_independent(void);
+
+    template<typename T>
+    void
+    draw_generic_implement(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                           const T &draw_state, uint32_t brush_shader,
+                           const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
+                           uint64_t blend_mode,
+                           fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+                           fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+                           fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+                           unsigned int z,
+                           const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back,
+                           const held_draw *hold = NULL);
+
     unsigned int
     compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state);
 
+    /* true if the data of d can be referenced from
+       the persistent region of the current PainterDraw
+     */
+    bool
+    persistent_resolved(const EntryBase *d)
+    {
+      return d->m_persistent_store
+        && d->m_persistent_store == m_persistent_store
+        && d->m_persistent_sequence <= m_accumulated_draws.back().m_persistent_sequence;
+    }
+
     template<typename T>
     unsigned int
     compute_room_needed_for_packing(const fastuidraw::PainterData::value<T> &obj)
@@ -480,8 +1299,9 @@ namespace
         {
           EntryBase *d;
           d = reinterpret_cast<EntryBase*>(obj.m_packed_value.opaque_data());
-          if(d->m_painter == m_p && d->m_begin_id == m_number_begins
-             && d->m_draw_command_id == m_accumulated_draws.size())
+          if((d->m_painter == m_p && d->m_begin_id == m_number_begins
+              && d->m_draw_command_id == m_accumulated_draws.size())
+             || persistent_resolved(d))
             {
               return 0;
             }
@@ -501,24 +1321,160 @@ namespace
         }
     };
 
+    /* room needed to pack a value into a PainterDraw
+       that does not yet hold it.
+     */
+    template<typename T>
+    unsigned int
+    compute_room_needed_for_packing_fresh(const fastuidraw::PainterData::value<T> &obj)
+    {
+      if(obj.m_packed_value)
+        {
+          EntryBase *d;
+          d = reinterpret_cast<EntryBase*>(obj.m_packed_value.opaque_data());
+          return d->m_data.size();
+        }
+      else if(obj.m_value != NULL)
+        {
+          return obj.m_value->data_size(m_alignment);
+        }
+      else
+        {
+          static T v;
+          return v.data_size(m_alignment);
+        }
+    }
+
     fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> m_backend;
     fastuidraw::PainterShaderSet m_default_shaders;
     unsigned int m_alignment;
     unsigned int m_header_size;
 
+    /* the data store room of the most recently mapped
+       PainterDraw before anything is packed into it.
+     */
+    unsigned int m_fresh_store_room;
+
     fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> m_blend_shader;
     uint64_t m_blend_mode;
+    uint32_t m_stencil_ref;
+    enum fastuidraw::PainterShaderGroup::stencil_action_t m_stencil_action;
     painter_state_location m_painter_state_location;
     int m_number_begins;
 
     std::vector<per_draw_command> m_accumulated_draws;
     fastuidraw::PainterPacker *m_p;
 
+    /* NULL if the backend has no persistent region */
+    fastuidraw::reference_counted_ptr<PersistentStore> m_persistent_store;
+
+    /* draws held back by the reordering, all of which are
+       in the current PainterDraw; m_number_held_draws is
+       the number of draw_generic() calls held back.
+     */
+    unsigned int m_reorder_window, m_number_held_draws;
+    std::vector<held_draw> m_held_draws;
+    std::vector<held_chunk> m_held_chunks;
+    std::vector<fastuidraw::PainterIndex> m_held_indices;
+
+    fastuidraw::PainterPacker::Stats m_stats;
+
+    /* sizes of the arrays of the last PainterDraw mapped,
+       not reset on begin()
+     */
+    fastuidraw::uvec3 m_draw_sizes;
     PainterPackerPrivateWorkroom m_work_room;
   };
 }
 
 
+//////////////////////////////////////////
+// PersistentStore methods
+unsigned int
+PersistentStore::
+sync(const fastuidraw::PainterDraw &draw,
+     fastuidraw::PainterPacker::Stats &stats)
+{
+  if(m_dirty.m_begin < m_dirty.m_end)
+    {
+      log_entry L;
+
+      L.m_version = next_version();
+      L.m_blocks = m_dirty;
+      m_log.push_back(L);
+      if(m_log.size() > max_log_size)
+        {
+          m_log.erase(m_log.begin());
+        }
+      ++m_sequence;
+      m_dirty = fastuidraw::range_type<unsigned int>(m_allocator.size(), 0);
+    }
+
+  if(m_log.empty())
+    {
+      return m_sequence;
+    }
+
+  unsigned int draw_version, version;
+  fastuidraw::range_type<unsigned int> R(0, m_high_water);
+
+  draw_version = draw.persistent_store_version();
+  version = m_log.back().m_version;
+  if(draw_version == version)
+    {
+      return m_sequence;
+    }
+
+  /* if the draw holds a version still in the log, only
+     the blocks written since that version are copied,
+     otherwise the entire used region is copied.
+   */
+  for(unsigned int i = 0, endi = m_log.size(); i < endi; ++i)
+    {
+      if(m_log[i].m_version == draw_version)
+        {
+          R = fastuidraw::range_type<unsigned int>(m_high_water, 0);
+          for(unsigned int j = i + 1; j < endi; ++j)
+            {
+              R.m_begin = std::min(R.m_begin, m_log[j].m_blocks.m_begin);
+              R.m_end = std::max(R.m_end, m_log[j].m_blocks.m_end);
+            }
+          break;
+        }
+    }
+
+  assert(R.m_begin < R.m_end);
+  assert(R.m_end * m_alignment <= draw.m_store.size());
+  std::copy(m_shadow.begin() + R.m_begin * m_alignment,
+            m_shadow.begin() + R.m_end * m_alignment,
+            draw.m_store.begin() + R.m_begin * m_alignment);
+  stats.m_persistent_store_bytes += (R.m_end - R.m_begin) * m_alignment * sizeof(fastuidraw::generic_data);
+  draw.persistent_store_written(version, R);
+  return m_sequence;
+}
+
+//////////////////////////////////////////
+// held_draw methods
+bool
+held_draw::
+commute(const held_draw &a, const held_draw &b)
+{
+  /* draws that do not blend with what is already drawn
+     give the same result in either order when the depth
+     test decides which one is visible; draws that do not
+     touch a common pixel give the same result in either
+     order whatever their blending.
+   */
+  if(a.m_order_independent && b.m_order_independent && a.m_z != b.m_z)
+    {
+      return true;
+    }
+
+  return a.m_has_bounds && b.m_has_bounds
+    && (a.m_max_x < b.m_min_x || b.m_max_x < a.m_min_x
+        || a.m_max_y < b.m_min_y || b.m_max_y < a.m_min_y);
+}
+
 //////////////////////////////////////////
 // per_draw_command methods
 per_draw_command::
@@ -527,13 +1483,22 @@ per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::Paint
   m_draw_command(r),
   m_attributes_written(0),
   m_indices_written(0),
-  m_store_blocks_written(0),
+  m_indices_held(0),
+  m_persistent_sequence(0),
+  m_store_blocks_written(config.persistent_store_blocks()),
+  m_persistent_blocks(config.persistent_store_blocks()),
   m_alignment(config.alignment()),
+  m_supports_base_vertex(config.supports_base_vertex()),
+  m_base_vertex(0),
+  m_per_draw_header(config.per_draw_header()),
+  m_headers_written(0),
   m_brush_shader_mask(config.brush_shader_mask())
 {
   m_prev_state.m_item_group = 0;
   m_prev_state.m_brush = 0;
   m_prev_state.m_blend_group = 0;
+  m_prev_state.m_stencil_ref = 0;
+  m_prev_state.m_stencil_action = fastuidraw::PainterShaderGroup::stencil_test;
 }
 
 
@@ -556,10 +1521,41 @@ pack_state_data(PainterPackerPrivate *p,
   if(d->m_painter == p->m_p && d->m_begin_id == p->m_number_begins
      && d->m_draw_command_id == p->m_accumulated_draws.size())
     {
+      ++p->m_stats.m_packed_value_cache_hits;
       location = d->m_offset;
       return;
     }
 
+  if(p->persistent_resolved(d))
+    {
+      ++p->m_stats.m_packed_value_persistent_hits;
+      location = d->m_persistent_location;
+      return;
+    }
+
+  ++p->m_stats.m_packed_value_cache_misses;
+
+  /* if the data was already copied into an earlier PainterDraw,
+     the value is used across PainterDraw objects; place it in
+     the persistent region so that the PainterDraw objects after
+     this one can refer to it without copying it. Values used by
+     a single PainterDraw (most item matrices and clip equations)
+     are not placed, so they do not fill the persistent region.
+   */
+  if(p->m_persistent_store && !d->m_persistent_store
+     && d->m_painter != NULL
+     && d->m_alignment == p->m_persistent_store->alignment())
+    {
+      int block;
+      block = p->m_persistent_store->allocate(fastuidraw::make_c_array(d->m_data));
+      if(block >= 0)
+        {
+          d->m_persistent_store = p->m_persistent_store;
+          d->m_persistent_location = block;
+          d->m_persistent_sequence = p->m_persistent_store->sequence() + 1;
+        }
+    }
+
   /* data not in current data store add
      it to the current store.
    */
@@ -594,15 +1590,80 @@ pack_painter_state(const fastuidraw::PainterPackerData &state,
      API.
    */
   const fastuidraw::PainterBrush &brush(fetch_value(state.m_brush));
-  if(brush.image() && m_last_image != brush.image())
+  retain_resources(brush.image(), brush.color_stops());
+}
+
+void
+per_draw_command::
+pack_indices(fastuidraw::const_c_array<fastuidraw::PainterIndex> src,
+             unsigned int attrib_offset)
+{
+  fastuidraw::c_array<fastuidraw::PainterIndex> dst;
+
+  dst = m_draw_command->m_indices.sub_array(m_indices_written, src.size());
+  if(m_supports_base_vertex)
+    {
+      /* the index values are relative to the base vertex,
+         thus the chunk is copied unchanged and the base
+         vertex changes instead
+       */
+      if(attrib_offset != m_base_vertex)
+        {
+          m_base_vertex = attrib_offset;
+          m_draw_command->base_vertex_change(m_base_vertex, m_indices_written);
+        }
+      std::memcpy(dst.c_ptr(), src.c_ptr(), sizeof(fastuidraw::PainterIndex) * src.size());
+    }
+  else
+    {
+      copy_indices_with_offset(dst.c_ptr(), src.c_ptr(), src.size(), attrib_offset);
+    }
+  m_indices_written += src.size();
+}
+
+void
+per_draw_command::
+pack_painter_state(const prepacked_state &state,
+                   PainterPackerPrivate *p, painter_state_location &out_data)
+{
+  fastuidraw::c_array<fastuidraw::generic_data> dst;
+  uint32_t base;
+
+  base = current_block();
+  dst = allocate_store(state.m_data.size());
+  std::copy(state.m_data.begin(), state.m_data.end(), dst.begin());
+
+  out_data.m_clipping_data_loc = base + state.m_location.m_clipping_data_loc;
+  out_data.m_item_matrix_data_loc = base + state.m_location.m_item_matrix_data_loc;
+  out_data.m_brush_shader_data_loc = base + state.m_location.m_brush_shader_data_loc;
+  out_data.m_item_shader_data_loc = base + state.m_location.m_item_shader_data_loc;
+  out_data.m_blend_shader_data_loc = base + state.m_location.m_blend_shader_data_loc;
+
+  if(state.m_matrix)
+    {
+      assert(state.m_clip);
+      pack_state_data(p, reinterpret_cast<EntryBase*>(state.m_matrix->opaque_data()),
+                      out_data.m_item_matrix_data_loc);
+      pack_state_data(p, reinterpret_cast<EntryBase*>(state.m_clip->opaque_data()),
+                      out_data.m_clipping_data_loc);
+    }
+  retain_resources(state.m_image, state.m_color_stops);
+}
+
+void
+per_draw_command::
+retain_resources(const fastuidraw::reference_counted_ptr<const fastuidraw::Image> &image,
+                 const fastuidraw::reference_counted_ptr<const fastuidraw::ColorStopSequenceOnAtlas> &color_stops)
+{
+  if(image && m_last_image != image)
     {
-      m_last_image = brush.image();
+      m_last_image = image;
       m_images_active.push_back(m_last_image);
     }
 
-  if(brush.color_stops() && m_last_color_stop != brush.color_stops())
+  if(color_stops && m_last_color_stop != color_stops)
     {
-      m_last_color_stop = brush.color_stops();
+      m_last_color_stop = color_stops;
       m_color_stops_active.push_back(m_last_color_stop);
     }
 }
@@ -613,12 +1674,16 @@ pack_header(unsigned int header_size,
             uint32_t brush_shader,
             const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
             uint64_t blend_mode,
+            uint32_t stencil_ref,
+            enum fastuidraw::PainterShaderGroup::stencil_action_t stencil_action,
             const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &item_shader,
             unsigned int z,
             const painter_state_location &loc,
-            const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+            const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back,
+            fastuidraw::PainterPacker::Stats &stats,
+            held_draw *held)
 {
-  unsigned int return_value;
+  unsigned int return_value, header_entry(0);
   fastuidraw::c_array<fastuidraw::generic_data> dst;
   fastuidraw::PainterHeader header;
 
@@ -641,6 +1706,8 @@ pack_header(unsigned int header_size,
   current.m_brush = brush_shader;
   current.m_blend_group = blend.m_group;
   current.m_blend_mode = blend_mode;
+  current.m_stencil_ref = stencil_ref;
+  current.m_stencil_action = stencil_action;
 
   header.m_clip_equations_location = loc.m_clipping_data_loc;
   header.m_item_matrix_location = loc.m_item_matrix_data_loc;
@@ -653,18 +1720,27 @@ pack_header(unsigned int header_size,
   header.m_z = z;
   header.pack_data(m_alignment, dst);
 
-  if(current.m_item_group != m_prev_state.m_item_group
-     || current.m_blend_group != m_prev_state.m_blend_group
-     || (m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u
-     || current.m_blend_mode != m_prev_state.m_blend_mode)
+  if(m_per_draw_header)
     {
-      m_draw_command->draw_break(m_prev_state, current,
-                                 m_attributes_written,
-                                 m_indices_written);
+      /* the header location goes to the table of header
+         locations of the PainterDraw instead of to each
+         vertex.
+       */
+      header_entry = m_headers_written;
+      m_draw_command->m_header_attributes[m_headers_written] = return_value;
+      ++m_headers_written;
+    }
+
+  if(held)
+    {
+      held->m_group = current;
+      held->m_header_entry = header_entry;
+    }
+  else
+    {
+      start_indices(current, header_entry, stats);
     }
 
-  m_prev_state = current;
-
   if(call_back)
     {
       call_back->header_added(header, dst);
@@ -673,60 +1749,744 @@ pack_header(unsigned int header_size,
   return return_value;
 }
 
+void
+per_draw_command::
+start_indices(const PainterShaderGroupPrivate &current,
+              unsigned int header_entry,
+              fastuidraw::PainterPacker::Stats &stats)
+{
+  bool item_break, blend_break, brush_break, blend_mode_break, stencil_break;
+
+  item_break = current.m_item_group != m_prev_state.m_item_group;
+  blend_break = current.m_blend_group != m_prev_state.m_blend_group;
+  brush_break = (m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u;
+  blend_mode_break = current.m_blend_mode != m_prev_state.m_blend_mode;
+  stencil_break = current.m_stencil_ref != m_prev_state.m_stencil_ref
+    || current.m_stencil_action != m_prev_state.m_stencil_action;
+  if(item_break || blend_break || brush_break || blend_mode_break || stencil_break)
+    {
+      ++stats.m_draw_breaks;
+      stats.m_draw_breaks_item_group += item_break ? 1u : 0u;
+      stats.m_draw_breaks_blend_group += blend_break ? 1u : 0u;
+      stats.m_draw_breaks_brush += brush_break ? 1u : 0u;
+      stats.m_draw_breaks_blend_mode += blend_mode_break ? 1u : 0u;
+      stats.m_draw_breaks_stencil += stencil_break ? 1u : 0u;
+      m_draw_command->draw_break(m_prev_state, current,
+                                 m_attributes_written,
+                                 m_indices_written);
+    }
+
+  m_prev_state = current;
+  if(m_per_draw_header)
+    {
+      m_draw_command->header_change(header_entry, m_indices_written);
+    }
+}
+
 ///////////////////////////////////////////
 // PainterPackerPrivate methods
 PainterPackerPrivate::
 PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
                      fastuidraw::PainterPacker *p):
   m_backend(backend),
-  m_p(p)
+  m_stencil_ref(0),
+  m_stencil_action(fastuidraw::PainterShaderGroup::stencil_test),
+  m_p(p),
+  m_reorder_window(0),
+  m_number_held_draws(0),
+  m_draw_sizes(0, 0, 0)
 {
   m_alignment = m_backend->configuration_base().alignment();
   m_header_size = fastuidraw::PainterHeader::data_size(m_alignment);
+  m_fresh_store_room = 0;
   m_default_shaders = m_backend->default_shaders();
   m_number_begins = 0;
+
+  unsigned int persistent_blocks;
+  persistent_blocks = m_backend->configuration_base().persistent_store_blocks();
+  if(persistent_blocks > 0)
+    {
+      m_persistent_store = FASTUIDRAWnew PersistentStore(persistent_blocks, m_alignment);
+    }
+}
+
+void
+PainterPackerPrivate::
+start_new_command(enum new_command_reason_t reason)
+{
+  if(!m_accumulated_draws.empty())
+    {
+      /* the held back draws have their attributes in the
+         current PainterDraw, so their indices go there too.
+       */
+      flush_reorder();
+      m_accumulated_draws.back().unmap(m_stats);
+    }
+
+  switch(reason)
+    {
+    case new_command_attribute_room:
+      ++m_stats.m_new_draw_attribute_room;
+      break;
+    case new_command_index_room:
+      ++m_stats.m_new_draw_index_room;
+      break;
+    case new_command_store_room:
+      ++m_stats.m_new_draw_store_room;
+      break;
+    case new_command_header_room:
+      ++m_stats.m_new_draw_header_room;
+      break;
+    default:
+      break;
+    }
+  ++m_stats.m_number_draws;
+
+  fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> r;
+  fastuidraw::uvec3 sizes;
+
+  r = m_backend->map_draw();
+  sizes = fastuidraw::uvec3(r->m_attributes.size(), r->m_indices.size(),
+                            r->m_store.size() / m_alignment);
+  if(sizes != m_draw_sizes)
+    {
+      if(m_draw_sizes != fastuidraw::uvec3(0, 0, 0))
+        {
+          ++m_stats.m_draw_size_changes;
+        }
+      m_draw_sizes = sizes;
+    }
+  m_stats.m_attributes_per_draw = sizes[0];
+  m_stats.m_indices_per_draw = sizes[1];
+  m_stats.m_store_blocks_per_draw = sizes[2];
+  m_accumulated_draws.push_back(per_draw_command(r, m_backend->configuration_base()));
+  if(m_persistent_store)
+    {
+      m_accumulated_draws.back().m_persistent_sequence = m_persistent_store->sync(*r, m_stats);
+    }
+  m_fresh_store_room = m_accumulated_draws.back().store_room();
+}
+
+unsigned int
+PainterPackerPrivate::
+compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state)
+{
+  unsigned int R(0);
+  R += compute_room_needed_for_packing(draw_state.m_clip);
+  R += compute_room_needed_for_packing(draw_state.m_matrix);
+  R += compute_room_needed_for_packing(draw_state.m_brush);
+  R += compute_room_needed_for_packing(draw_state.m_item_shader_data);
+  R += compute_room_needed_for_packing(draw_state.m_blend_shader_data);
+  return R;
+}
+
+void
+PainterPackerPrivate::
+upload_draw_state(const fastuidraw::PainterPackerData &draw_state)
+{
+  unsigned int needed_room;
+
+  assert(!m_accumulated_draws.empty());
+  needed_room = compute_room_needed_for_packing(draw_state);
+  if(needed_room > m_accumulated_draws.back().store_room())
+    {
+      start_new_command(new_command_store_room);
+    }
+  m_accumulated_draws.back().pack_painter_state(draw_state, this, m_painter_state_location);
+}
+
+void
+PainterPackerPrivate::
+upload_draw_state(const prepacked_state &draw_state)
+{
+  unsigned int needed_room;
+
+  assert(!m_accumulated_draws.empty());
+  needed_room = draw_state.m_data.size();
+  if(draw_state.m_matrix)
+    {
+      assert(draw_state.m_clip);
+      needed_room += compute_room_needed_for_packing(fastuidraw::PainterData::value<fastuidraw::PainterItemMatrix>(*draw_state.m_matrix));
+      needed_room += compute_room_needed_for_packing(fastuidraw::PainterData::value<fastuidraw::PainterClipEquations>(*draw_state.m_clip));
+    }
+
+  if(needed_room > m_accumulated_draws.back().store_room())
+    {
+      start_new_command(new_command_store_room);
+    }
+  m_accumulated_draws.back().pack_painter_state(draw_state, this, m_painter_state_location);
+}
+
+void
+PainterPackerPrivate::
+draw_recorded(const CommandListPrivate &list, const recorded_draw &R,
+              const fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> *matrix,
+              const fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> *clip,
+              unsigned int z_offset,
+              const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+{
+  prepacked_state state;
+  fastuidraw::const_c_array<unsigned int> selector;
+
+  state.m_data = fastuidraw::make_c_array(list.m_store).sub_array(R.m_store_range[0],
+                                                                  R.m_store_range[1] - R.m_store_range[0]);
+  state.m_location = R.m_location;
+  state.m_image = R.m_image;
+  state.m_color_stops = R.m_color_stops;
+  state.m_matrix = matrix;
+  state.m_clip = clip;
+  selector = fastuidraw::make_c_array(list.m_selectors).sub_array(R.m_selector_range[0],
+                                                                  R.m_selector_range[1] - R.m_selector_range[0]);
+
+  m_work_room.m_attrib_chunks.clear();
+  for(unsigned int c = R.m_attrib_chunk_range[0]; c < R.m_attrib_chunk_range[1]; ++c)
+    {
+      m_work_room.m_attrib_chunks.push_back(list.attribute_chunk(c));
+    }
+
+  m_work_room.m_index_chunks.clear();
+  for(unsigned int c = R.m_index_chunk_range[0]; c < R.m_index_chunk_range[1]; ++c)
+    {
+      m_work_room.m_index_chunks.push_back(list.index_chunk(c));
+    }
+
+  if(R.m_blend_shader)
+    {
+      draw_generic_implement(R.m_shader, state, R.m_brush_shader,
+                             R.m_blend_shader, R.m_blend_mode,
+                             fastuidraw::make_c_array(m_work_room.m_attrib_chunks),
+                             fastuidraw::make_c_array(m_work_room.m_index_chunks),
+                             selector, R.m_z + z_offset, call_back);
+    }
+  else
+    {
+      draw_generic_implement(R.m_shader, state, R.m_brush_shader,
+                             m_blend_shader, m_blend_mode,
+                             fastuidraw::make_c_array(m_work_room.m_attrib_chunks),
+                             fastuidraw::make_c_array(m_work_room.m_index_chunks),
+                             selector, R.m_z + z_offset, call_back);
+    }
+}
+
+void
+PainterPackerPrivate::
+reorder_draw(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+             const fastuidraw::PainterPackerData &draw,
+             fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+             fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+             fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+             unsigned int z)
+{
+  held_draw hold;
+
+  hold.m_z = z;
+  hold.m_order_independent = order_independent();
+  hold.m_has_bounds = draw.m_has_bounds;
+  if(draw.m_has_bounds)
+    {
+      hold.m_min_x = draw.m_bounds_min.x();
+      hold.m_min_y = draw.m_bounds_min.y();
+      hold.m_max_x = draw.m_bounds_max.x();
+      hold.m_max_y = draw.m_bounds_max.y();
+    }
+
+  draw_generic_implement(shader, draw, fetch_value(draw.m_brush).shader(),
+                         m_blend_shader, m_blend_mode,
+                         attrib_chunks, index_chunks, attrib_chunk_selector,
+                         z, fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack>(),
+                         &hold);
+
+  ++m_number_held_draws;
+  if(m_number_held_draws >= m_reorder_window)
+    {
+      flush_reorder();
+    }
+}
+
+bool
+PainterPackerPrivate::
+order_independent(void)
+{
+  /* with the depth test passing on greater or equal z, the
+     result of two draws of different z does not depend on
+     their order as long as neither blends with what is
+     already drawn.
+   */
+  return m_blend_shader
+    && m_blend_shader->type() != fastuidraw::PainterBlendShader::framebuffer_fetch
+    && blend_mode_ignores_dst(fastuidraw::BlendMode(m_blend_mode));
+}
+
+void
+PainterPackerPrivate::
+compute_reorder(void)
+{
+  const std::vector<held_draw> &draws(m_held_draws);
+  std::vector<unsigned int> &order(m_work_room.m_reorder_order);
+  std::vector<bool> &emitted(m_work_room.m_reorder_emitted);
+  std::vector<unsigned int> &skipped(m_work_room.m_reorder_skipped);
+  const per_draw_command &cmd(m_accumulated_draws.back());
+  uint32_t brush_mask(cmd.brush_shader_mask());
+  unsigned int breaks_before(0), breaks_after(0);
+
+  /* Greedy: take the first draw not yet taken, then pull
+     forward each later draw with the same shader group
+     values that commutes with every draw it skips.
+   */
+  order.clear();
+  emitted.clear();
+  emitted.resize(draws.size(), false);
+  for(unsigned int first = 0, endi = draws.size(); first < endi; ++first)
+    {
+      if(emitted[first])
+        {
+          continue;
+        }
+
+      const PainterShaderGroupPrivate &key(draws[first].m_group);
+
+      emitted[first] = true;
+      order.push_back(first);
+      skipped.clear();
+      for(unsigned int c = first + 1; c < endi; ++c)
+        {
+          bool can_move;
+
+          if(emitted[c])
+            {
+              continue;
+            }
+
+          can_move = !needs_draw_break(key, draws[c].m_group, brush_mask);
+          for(unsigned int s = 0, ends = skipped.size(); can_move && s < ends; ++s)
+            {
+              can_move = held_draw::commute(draws[c], draws[skipped[s]]);
+            }
+
+          if(can_move)
+            {
+              emitted[c] = true;
+              order.push_back(c);
+            }
+          else
+            {
+              skipped.push_back(c);
+            }
+        }
+    }
+
+  for(unsigned int i = 0, endi = order.size(); i < endi; ++i)
+    {
+      const PainterShaderGroupPrivate &a((i == 0) ? cmd.prev_state() : draws[i - 1].m_group);
+      const PainterShaderGroupPrivate &b((i == 0) ? cmd.prev_state() : draws[order[i - 1]].m_group);
+
+      breaks_before += needs_draw_break(a, draws[i].m_group, brush_mask) ? 1u : 0u;
+      breaks_after += needs_draw_break(b, draws[order[i]].m_group, brush_mask) ? 1u : 0u;
+    }
+
+  if(breaks_after < breaks_before)
+    {
+      m_stats.m_draw_breaks_eliminated += breaks_before - breaks_after;
+    }
+  else
+    {
+      for(unsigned int i = 0, endi = order.size(); i < endi; ++i)
+        {
+          order[i] = i;
+        }
+    }
+}
+
+void
+PainterPackerPrivate::
+flush_reorder(void)
+{
+  m_number_held_draws = 0;
+  if(m_held_draws.empty())
+    {
+      return;
+    }
+
+  per_draw_command &cmd(m_accumulated_draws.back());
+
+  compute_reorder();
+  for(std::vector<unsigned int>::const_iterator iter = m_work_room.m_reorder_order.begin(),
+        end = m_work_room.m_reorder_order.end(); iter != end; ++iter)
+    {
+      const held_draw &H(m_held_draws[*iter]);
+
+      cmd.start_indices(H.m_group, H.m_header_entry, m_stats);
+      for(unsigned int c = H.m_chunks.m_begin; c < H.m_chunks.m_end; ++c)
+        {
+          const held_chunk &C(m_held_chunks[c]);
+          fastuidraw::const_c_array<fastuidraw::PainterIndex> src;
+
+          src = fastuidraw::make_c_array(m_held_indices).sub_array(C.m_indices.m_begin,
+                                                                   C.m_indices.m_end - C.m_indices.m_begin);
+          cmd.m_indices_held -= src.size();
+          cmd.pack_indices(src, C.m_attrib_offset);
+        }
+    }
+
+  assert(cmd.m_indices_held == 0);
+  m_held_draws.clear();
+  m_held_chunks.clear();
+  m_held_indices.clear();
+}
+
+template<typename T>
+void
+PainterPackerPrivate::
+draw_generic_implement(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                       const T &draw_state, uint32_t brush_shader,
+                       const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
+                       uint64_t blend_mode,
+                       fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+                       fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+                       fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+                       unsigned int z,
+                       const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back,
+                       const held_draw *hold)
+{
+  bool allocate_header;
+  unsigned int header_loc;
+  const unsigned int NOT_LOADED = ~0u;
+
+  assert((attrib_chunk_selector.empty() && attrib_chunks.size() == index_chunks.size())
+         || (attrib_chunk_selector.size() == index_chunks.size()) );
+
+  if(attrib_chunks.empty() || !shader)
+    {
+      /* should we emit a warning message that the PainterItemShader
+         was missing the item shader value?
+       */
+      return;
+    }
+
+  m_work_room.m_attribs_loaded.clear();
+  m_work_room.m_attribs_loaded.resize(attrib_chunk_selector.size(), NOT_LOADED);
+
+  assert(shader);
+
+  upload_draw_state(draw_state);
+  allocate_header = true;
+
+  for(unsigned chunk = 0, num_chunks = index_chunks.size(); chunk < num_chunks; ++chunk)
+    {
+      unsigned int attrib_room, index_room, data_room;
+      unsigned int attrib_src, needed_attrib_room;
+
+      attrib_room = m_accumulated_draws.back().attribute_room();
+      index_room = m_accumulated_draws.back().index_room();
+      data_room = m_accumulated_draws.back().store_room();
+
+      if(attrib_chunk_selector.empty())
+        {
+          attrib_src = chunk;
+          needed_attrib_room = attrib_chunks[attrib_src].size();
+        }
+      else
+        {
+          attrib_src = attrib_chunk_selector[chunk];
+          needed_attrib_room = (m_work_room.m_attribs_loaded[attrib_src] == NOT_LOADED) ?
+            attrib_chunks[attrib_src].size() :
+            0;
+        }
+
+      if(index_chunks[chunk].empty() || attrib_chunks[attrib_src].empty())
+        {
+          continue;
+        }
+
+      if(attrib_room < needed_attrib_room || index_room < index_chunks[chunk].size()
+         || (allocate_header && (data_room < m_header_size || m_accumulated_draws.back().header_room() == 0)))
+        {
+          enum new_command_reason_t reason;
+
+          if(attrib_room < needed_attrib_room)
+            {
+              reason = new_command_attribute_room;
+            }
+          else if(index_room < index_chunks[chunk].size())
+            {
+              reason = new_command_index_room;
+            }
+          else if(data_room < m_header_size)
+            {
+              reason = new_command_store_room;
+            }
+          else
+            {
+              reason = new_command_header_room;
+            }
+
+          /* let a backend whose buffer sizes adapt make
+             sure that the new PainterDraw can hold the
+             whole chunk.
+           */
+          m_backend->ensure_room(attrib_chunks[attrib_src].size(), index_chunks[chunk].size());
+          start_new_command(reason);
+          upload_draw_state(draw_state);
+
+          /* reset attribs_loaded[] and recompute needed_attrib_room
+           */
+          if(!attrib_chunk_selector.empty())
+            {
+              std::fill(m_work_room.m_attribs_loaded.begin(), m_work_room.m_attribs_loaded.end(), NOT_LOADED);
+              needed_attrib_room = attrib_chunks[attrib_src].size();
+            }
+
+          attrib_room = m_accumulated_draws.back().attribute_room();
+          index_room = m_accumulated_draws.back().index_room();
+          data_room = m_accumulated_draws.back().store_room();
+          allocate_header = true;
+
+          if(attrib_room < needed_attrib_room || index_room < index_chunks[chunk].size())
+            {
+              assert(!"Unable to fit chunk into freshly allocated draw command, not good!");
+              continue;
+            }
+
+          assert(data_room >= m_header_size);
+        }
+
+      per_draw_command &cmd(m_accumulated_draws.back());
+      if(allocate_header)
+        {
+          held_draw *held(NULL);
+
+          /* a held back draw that does not fit in one PainterDraw
+             is held back as one draw for each PainterDraw, since
+             the held back draws are written when a PainterDraw
+             is started.
+           */
+          if(hold)
+            {
+              m_held_draws.push_back(*hold);
+              m_held_draws.back().m_chunks = fastuidraw::range_type<unsigned int>(m_held_chunks.size(),
+                                                                                  m_held_chunks.size());
+              held = &m_held_draws.back();
+            }
+
+          allocate_header = false;
+          header_loc = cmd.pack_header(m_header_size,
+                                       brush_shader,
+                                       blend_shader,
+                                       blend_mode,
+                                       m_stencil_ref,
+                                       m_stencil_action,
+                                       shader,
+                                       z, m_painter_state_location,
+                                       call_back, m_stats, held);
+        }
+
+      /* copy attribute data and get offset into attribute buffer
+         where attributes are copied
+       */
+      unsigned int attrib_offset;
+
+      if(needed_attrib_room > 0)
+        {
+          fastuidraw::c_array<fastuidraw::PainterAttribute> attrib_dst_ptr;
+          fastuidraw::const_c_array<fastuidraw::PainterAttribute> attrib_src_ptr;
+          fastuidraw::c_array<uint32_t> header_dst_ptr;
+
+          attrib_src_ptr = attrib_chunks[attrib_src];
+          attrib_dst_ptr = cmd.m_draw_command->m_attributes.sub_array(cmd.m_attributes_written, attrib_src_ptr.size());
+
+          std::copy(attrib_src_ptr.begin(), attrib_src_ptr.end(), attrib_dst_ptr.begin());
+          if(!cmd.per_draw_header())
+            {
+              header_dst_ptr = cmd.m_draw_command->m_header_attributes.sub_array(cmd.m_attributes_written, attrib_src_ptr.size());
+              std::fill(header_dst_ptr.begin(), header_dst_ptr.end(), header_loc);
+            }
+
+          if(!attrib_chunk_selector.empty())
+            {
+              assert(m_work_room.m_attribs_loaded[attrib_src] == NOT_LOADED);
+              m_work_room.m_attribs_loaded[attrib_src] = cmd.m_attributes_written;
+            }
+          attrib_offset = cmd.m_attributes_written;
+          cmd.m_attributes_written += attrib_dst_ptr.size();
+        }
+      else
+        {
+          assert(!attrib_chunk_selector.empty());
+          assert(m_work_room.m_attribs_loaded[attrib_src] != NOT_LOADED);
+          attrib_offset = m_work_room.m_attribs_loaded[attrib_src];
+        }
+
+      if(hold)
+        {
+          fastuidraw::const_c_array<fastuidraw::PainterIndex> src(index_chunks[chunk]);
+          unsigned int begin(m_held_indices.size());
+
+          /* the index values cannot be written until the order
+             of the held back draws is known; only they are copied,
+             the attributes are already in the PainterDraw.
+           */
+          m_held_indices.insert(m_held_indices.end(), src.begin(), src.end());
+          m_held_chunks.push_back(held_chunk(begin, m_held_indices.size(), attrib_offset));
+          m_held_draws.back().m_chunks.m_end = m_held_chunks.size();
+          cmd.m_indices_held += src.size();
+        }
+      else
+        {
+          cmd.pack_indices(index_chunks[chunk], attrib_offset);
+        }
+    }
+}
+
+//////////////////////////////////////////
+// CommandListPrivate methods
+template<typename T>
+void
+CommandListPrivate::
+record_state(const fastuidraw::PainterData::value<T> &obj, uint32_t &location)
+{
+  unsigned int offset;
+
+  offset = m_store.size();
+  if(obj.m_packed_value)
+    {
+      EntryBase *e;
+      e = reinterpret_cast<EntryBase*>(obj.m_packed_value.opaque_data());
+      assert(e->m_alignment == m_alignment);
+      m_store.insert(m_store.end(), e->m_data.begin(), e->m_data.end());
+    }
+  else
+    {
+      const T &v(fetch_value(obj));
+      unsigned int sz;
+
+      sz = v.data_size(m_alignment);
+      m_store.resize(offset + sz);
+      v.pack_data(m_alignment, fastuidraw::make_c_array(m_store).sub_array(offset, sz));
+    }
+  location = offset / m_alignment;
+}
+
+void
+CommandListPrivate::
+record_state(const fastuidraw::PainterPackerData &state, recorded_draw &out_draw)
+{
+  /* record the locations relative to the start of the
+     draw's range within m_store; the range is copied as
+     one block into PainterDraw::m_store when drawn.
+   */
+  painter_state_location &L(out_draw.m_location);
+
+  out_draw.m_store_range[0] = m_store.size();
+  if(out_draw.m_matrix_slot == no_matrix_slot)
+    {
+      record_state(state.m_clip, L.m_clipping_data_loc);
+      record_state(state.m_matrix, L.m_item_matrix_data_loc);
+    }
+  else
+    {
+      /* filled in when the list is drawn */
+      L.m_clipping_data_loc = out_draw.m_store_range[0] / m_alignment;
+      L.m_item_matrix_data_loc = out_draw.m_store_range[0] / m_alignment;
+    }
+  record_state(state.m_item_shader_data, L.m_item_shader_data_loc);
+  record_state(state.m_blend_shader_data, L.m_blend_shader_data_loc);
+  record_state(state.m_brush, L.m_brush_shader_data_loc);
+  out_draw.m_store_range[1] = m_store.size();
+
+  uint32_t base(out_draw.m_store_range[0] / m_alignment);
+  L.m_clipping_data_loc -= base;
+  L.m_item_matrix_data_loc -= base;
+  L.m_item_shader_data_loc -= base;
+  L.m_blend_shader_data_loc -= base;
+  L.m_brush_shader_data_loc -= base;
 }
 
 void
-PainterPackerPrivate::
-start_new_command(void)
+CommandListPrivate::
+record_chunks(fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+              fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+              fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+              recorded_draw &out_draw)
 {
-  if(!m_accumulated_draws.empty())
+  out_draw.m_attrib_chunk_range[0] = m_attrib_chunks.size();
+  for(unsigned int i = 0; i < attrib_chunks.size(); ++i)
     {
-      m_accumulated_draws.back().unmap();
+      fastuidraw::uvec2 R;
+
+      R[0] = m_attributes.size();
+      m_attributes.insert(m_attributes.end(), attrib_chunks[i].begin(), attrib_chunks[i].end());
+      R[1] = m_attributes.size();
+      m_attrib_chunks.push_back(R);
     }
+  out_draw.m_attrib_chunk_range[1] = m_attrib_chunks.size();
 
-  fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> r;
-  r = m_backend->map_draw();
-  m_accumulated_draws.push_back(per_draw_command(r, m_backend->configuration_base()));
-}
+  out_draw.m_index_chunk_range[0] = m_index_chunks.size();
+  for(unsigned int i = 0; i < index_chunks.size(); ++i)
+    {
+      fastuidraw::uvec2 R;
 
-unsigned int
-PainterPackerPrivate::
-compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state)
-{
-  unsigned int R(0);
-  R += compute_room_needed_for_packing(draw_state.m_clip);
-  R += compute_room_needed_for_packing(draw_state.m_matrix);
-  R += compute_room_needed_for_packing(draw_state.m_brush);
-  R += compute_room_needed_for_packing(draw_state.m_item_shader_data);
-  R += compute_room_needed_for_packing(draw_state.m_blend_shader_data);
-  return R;
+      R[0] = m_indices.size();
+      m_indices.insert(m_indices.end(), index_chunks[i].begin(), index_chunks[i].end());
+      R[1] = m_indices.size();
+      m_index_chunks.push_back(R);
+    }
+  out_draw.m_index_chunk_range[1] = m_index_chunks.size();
+
+  out_draw.m_selector_range[0] = m_selectors.size();
+  m_selectors.insert(m_selectors.end(), attrib_chunk_selector.begin(), attrib_chunk_selector.end());
+  out_draw.m_selector_range[1] = m_selectors.size();
 }
 
 void
-PainterPackerPrivate::
-upload_draw_state(const fastuidraw::PainterPackerData &draw_state)
+CommandListPrivate::
+record_draw(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+            const fastuidraw::PainterPackerData &data,
+            fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+            fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+            fastuidraw::const_c_array<unsigned int> attrib_chunk_selector,
+            unsigned int z, unsigned int matrix_slot)
 {
-  unsigned int needed_room;
+  assert((attrib_chunk_selector.empty() && attrib_chunks.size() == index_chunks.size())
+         || (attrib_chunk_selector.size() == index_chunks.size()) );
 
-  assert(!m_accumulated_draws.empty());
-  needed_room = compute_room_needed_for_packing(draw_state);
-  if(needed_room > m_accumulated_draws.back().store_room())
+  if(attrib_chunks.empty() || !shader)
     {
-      start_new_command();
+      return;
     }
-  m_accumulated_draws.back().pack_painter_state(draw_state, this, m_painter_state_location);
+
+  const fastuidraw::PainterBrush &brush(fetch_value(data.m_brush));
+
+  m_draws.push_back(recorded_draw());
+  recorded_draw &R(m_draws.back());
+
+  R.m_shader = shader;
+  R.m_blend_shader = m_blend_shader;
+  R.m_blend_mode = m_blend_mode;
+  R.m_brush_shader = brush.shader();
+  R.m_image = brush.image();
+  R.m_color_stops = brush.color_stops();
+  R.m_z = z;
+  R.m_matrix_slot = matrix_slot;
+  if(matrix_slot != no_matrix_slot)
+    {
+      m_number_matrix_slots = fastuidraw::t_max(m_number_matrix_slots, matrix_slot + 1);
+    }
+  record_state(data, R);
+  record_chunks(attrib_chunks, index_chunks, attrib_chunk_selector, R);
+}
+
+void
+CommandListPrivate::
+clear(void)
+{
+  m_attributes.clear();
+  m_indices.clear();
+  m_store.clear();
+  m_attrib_chunks.clear();
+  m_index_chunks.clear();
+  m_selectors.clear();
+  m_draws.clear();
+  m_number_matrix_slots = 0;
 }
 
 /////////////////////////////////////////
@@ -767,6 +2527,122 @@ packed_blend_mode(void) const
   return d->m_blend_mode;
 }
 
+uint32_t
+fastuidraw::PainterShaderGroup::
+stencil_ref(void) const
+{
+  const PainterShaderGroupPrivate *d;
+  d = static_cast<const PainterShaderGroupPrivate*>(this);
+  return d->m_stencil_ref;
+}
+
+enum fastuidraw::PainterShaderGroup::stencil_action_t
+fastuidraw::PainterShaderGroup::
+stencil_action(void) const
+{
+  const PainterShaderGroupPrivate *d;
+  d = static_cast<const PainterShaderGroupPrivate*>(this);
+  return d->m_stencil_action;
+}
+
+///////////////////////////////////////////
+// fastuidraw::PainterPacker::CommandList methods
+fastuidraw::PainterPacker::CommandList::
+CommandList(const PainterPacker &packer)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(packer.m_d);
+  m_d = FASTUIDRAWnew CommandListPrivate(&packer, d->m_alignment);
+}
+
+fastuidraw::PainterPacker::CommandList::
+~CommandList()
+{
+  CommandListPrivate *d;
+  d = reinterpret_cast<CommandListPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+void
+fastuidraw::PainterPacker::CommandList::
+blend_shader(const reference_counted_ptr<PainterBlendShader> &h,
+             BlendMode::packed_value packed_blend_mode)
+{
+  CommandListPrivate *d;
+  d = reinterpret_cast<CommandListPrivate*>(m_d);
+  assert(h);
+  d->m_blend_shader = h;
+  d->m_blend_mode = packed_blend_mode;
+}
+
+void
+fastuidraw::PainterPacker::CommandList::
+draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+             const PainterPackerData &data,
+             const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+             const_c_array<const_c_array<PainterIndex> > index_chunks,
+             unsigned int z)
+{
+  draw_generic(shader, data, attrib_chunks, index_chunks,
+               const_c_array<unsigned int>(), z);
+}
+
+void
+fastuidraw::PainterPacker::CommandList::
+draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+             const PainterPackerData &data,
+             const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+             const_c_array<const_c_array<PainterIndex> > index_chunks,
+             const_c_array<unsigned int> attrib_chunk_selector,
+             unsigned int z)
+{
+  draw_generic(shader, data, attrib_chunks, index_chunks,
+               attrib_chunk_selector, z, CommandListPrivate::no_matrix_slot);
+}
+
+void
+fastuidraw::PainterPacker::CommandList::
+draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
+             const PainterPackerData &data,
+             const_c_array<const_c_array<PainterAttribute> > attrib_chunks,
+             const_c_array<const_c_array<PainterIndex> > index_chunks,
+             const_c_array<unsigned int> attrib_chunk_selector,
+             unsigned int z, unsigned int matrix_slot)
+{
+  CommandListPrivate *d;
+  d = reinterpret_cast<CommandListPrivate*>(m_d);
+  d->record_draw(shader, data, attrib_chunks, index_chunks,
+                 attrib_chunk_selector, z, matrix_slot);
+}
+
+unsigned int
+fastuidraw::PainterPacker::CommandList::
+number_draws(void) const
+{
+  CommandListPrivate *d;
+  d = reinterpret_cast<CommandListPrivate*>(m_d);
+  return d->m_draws.size();
+}
+
+unsigned int
+fastuidraw::PainterPacker::CommandList::
+number_matrix_slots(void) const
+{
+  CommandListPrivate *d;
+  d = reinterpret_cast<CommandListPrivate*>(m_d);
+  return d->m_number_matrix_slots;
+}
+
+void
+fastuidraw::PainterPacker::CommandList::
+clear(void)
+{
+  CommandListPrivate *d;
+  d = reinterpret_cast<CommandListPrivate*>(m_d);
+  d->clear();
+}
+
 ////////////////////////////////////////////
 // fastuidraw::PainterPacker methods
 fastuidraw::PainterPacker::
@@ -785,6 +2661,54 @@ fastuidraw::PainterPacker::
   m_d = NULL;
 }
 
+unsigned int
+fastuidraw::PainterPacker::
+draw_reorder_window(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_reorder_window;
+}
+
+void
+fastuidraw::PainterPacker::
+draw_reorder_window(unsigned int v)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  if(v < d->m_number_held_draws)
+    {
+      d->flush_reorder();
+    }
+  d->m_reorder_window = v;
+}
+
+bool
+fastuidraw::PainterPacker::
+fits_in_data_store(const PainterPackerData &draw) const
+{
+  PainterPackerPrivate *d;
+  unsigned int needed;
+
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  needed = d->m_header_size
+    + d->compute_room_needed_for_packing_fresh(draw.m_clip)
+    + d->compute_room_needed_for_packing_fresh(draw.m_matrix)
+    + d->compute_room_needed_for_packing_fresh(draw.m_brush)
+    + d->compute_room_needed_for_packing_fresh(draw.m_item_shader_data)
+    + d->compute_room_needed_for_packing_fresh(draw.m_blend_shader_data);
+  return needed <= d->m_fresh_store_room;
+}
+
+const fastuidraw::PainterPacker::Stats&
+fastuidraw::PainterPacker::
+stats(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_stats;
+}
+
 void
 fastuidraw::PainterPacker::
 begin(void)
@@ -793,7 +2717,12 @@ begin(void)
   d = reinterpret_cast<PainterPackerPrivate*>(m_d);
 
   assert(d->m_accumulated_draws.empty());
-  d->start_new_command();
+  d->m_stats = Stats();
+  if(d->m_persistent_store)
+    {
+      d->m_persistent_store->apply_frees();
+    }
+  d->start_new_command(PainterPackerPrivate::new_command_begin);
   ++d->m_number_begins;
 }
 
@@ -804,9 +2733,10 @@ flush(void)
 {
   PainterPackerPrivate *d;
   d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  d->flush_reorder();
   if(!d->m_accumulated_draws.empty())
     {
-      d->m_accumulated_draws.back().unmap();
+      d->m_accumulated_draws.back().unmap(d->m_stats);
     }
 
   d->m_backend->on_pre_draw();
@@ -854,142 +2784,65 @@ draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
   PainterPackerPrivate *d;
   d = reinterpret_cast<PainterPackerPrivate*>(m_d);
 
-  bool allocate_header;
-  unsigned int header_loc;
-  const unsigned int NOT_LOADED = ~0u;
-
-  assert((attrib_chunk_selector.empty() && attrib_chunks.size() == index_chunks.size())
-         || (attrib_chunk_selector.size() == index_chunks.size()) );
-
-  if(attrib_chunks.empty() || !shader)
+  /* draws with a call back are never reordered since
+     the caller may act on the PainterDraw they land in
+     before the draws that follow are added.
+   */
+  if(d->m_reorder_window > 0 && !call_back)
     {
-      /* should we emit a warning message that the PainterItemShader
-         was missing the item shader value?
-       */
+      d->reorder_draw(shader, draw, attrib_chunks, index_chunks,
+                      attrib_chunk_selector, z);
       return;
     }
 
-  d->m_work_room.m_attribs_loaded.clear();
-  d->m_work_room.m_attribs_loaded.resize(attrib_chunk_selector.size(), NOT_LOADED);
+  d->flush_reorder();
+  d->draw_generic_implement(shader, draw, fetch_value(draw.m_brush).shader(),
+                            d->m_blend_shader, d->m_blend_mode,
+                            attrib_chunks, index_chunks, attrib_chunk_selector,
+                            z, call_back);
+}
 
-  assert(shader);
+void
+fastuidraw::PainterPacker::
+draw_command_list(const CommandList &list, unsigned int z_offset,
+                  const reference_counted_ptr<DataCallBack> &call_back)
+{
+  draw_command_list(list, const_c_array<PainterPackedValue<PainterItemMatrix> >(),
+                    PainterPackedValue<PainterClipEquations>(),
+                    z_offset, call_back);
+}
 
-  d->upload_draw_state(draw);
-  allocate_header = true;
+void
+fastuidraw::PainterPacker::
+draw_command_list(const CommandList &list,
+                  const_c_array<PainterPackedValue<PainterItemMatrix> > matrices,
+                  const PainterPackedValue<PainterClipEquations> &clip,
+                  unsigned int z_offset,
+                  const reference_counted_ptr<DataCallBack> &call_back)
+{
+  PainterPackerPrivate *d;
+  const CommandListPrivate *list_d;
 
-  for(unsigned chunk = 0, num_chunks = index_chunks.size(); chunk < num_chunks; ++chunk)
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  list_d = reinterpret_cast<const CommandListPrivate*>(list.m_d);
+  assert(list_d->m_packer == this);
+  assert(matrices.size() >= list_d->m_number_matrix_slots);
+  assert(list_d->m_number_matrix_slots == 0 || clip);
+
+  d->flush_reorder();
+  for(std::vector<recorded_draw>::const_iterator iter = list_d->m_draws.begin(),
+        end = list_d->m_draws.end(); iter != end; ++iter)
     {
-      unsigned int attrib_room, index_room, data_room;
-      unsigned int attrib_src, needed_attrib_room;
-
-      attrib_room = d->m_accumulated_draws.back().attribute_room();
-      index_room = d->m_accumulated_draws.back().index_room();
-      data_room = d->m_accumulated_draws.back().store_room();
-
-      if(attrib_chunk_selector.empty())
-        {
-          attrib_src = chunk;
-          needed_attrib_room = attrib_chunks[attrib_src].size();
-        }
-      else
-        {
-          attrib_src = attrib_chunk_selector[chunk];
-          needed_attrib_room = (d->m_work_room.m_attribs_loaded[attrib_src] == NOT_LOADED) ?
-            attrib_chunks[attrib_src].size() :
-            0;
-        }
-
-      if(index_chunks[chunk].empty() || attrib_chunks[attrib_src].empty())
-        {
-          continue;
-        }
-
-      if(attrib_room < needed_attrib_room || index_room < index_chunks[chunk].size()
-         || (allocate_header && data_room < d->m_header_size))
-        {
-          d->start_new_command();
-          d->upload_draw_state(draw);
-
-          /* reset attribs_loaded[] and recompute needed_attrib_room
-           */
-          if(!attrib_chunk_selector.empty())
-            {
-              std::fill(d->m_work_room.m_attribs_loaded.begin(), d->m_work_room.m_attribs_loaded.end(), NOT_LOADED);
-              needed_attrib_room = attrib_chunks[attrib_src].size();
-            }
-
-          attrib_room = d->m_accumulated_draws.back().attribute_room();
-          index_room = d->m_accumulated_draws.back().index_room();
-          data_room = d->m_accumulated_draws.back().store_room();
-          allocate_header = true;
-
-          if(attrib_room < needed_attrib_room || index_room < index_chunks[chunk].size())
-            {
-              assert(!"Unable to fit chunk into freshly allocated draw command, not good!");
-              continue;
-            }
-
-          assert(data_room >= d->m_header_size);
-        }
-
-      per_draw_command &cmd(d->m_accumulated_draws.back());
-      if(allocate_header)
-        {
-          allocate_header = false;
-          header_loc = cmd.pack_header(d->m_header_size,
-                                       fetch_value(draw.m_brush).shader(),
-                                       d->m_blend_shader,
-                                       d->m_blend_mode,
-                                       shader,
-                                       z, d->m_painter_state_location,
-                                       call_back);
-        }
-
-      /* copy attribute data and get offset into attribute buffer
-         where attributes are copied
-       */
-      unsigned int attrib_offset;
+      const recorded_draw &R(*iter);
 
-      if(needed_attrib_room > 0)
+      if(R.m_matrix_slot != CommandListPrivate::no_matrix_slot)
         {
-          c_array<PainterAttribute> attrib_dst_ptr;
-          const_c_array<PainterAttribute> attrib_src_ptr;
-          c_array<uint32_t> header_dst_ptr;
-
-          attrib_src_ptr = attrib_chunks[attrib_src];
-          attrib_dst_ptr = cmd.m_draw_command->m_attributes.sub_array(cmd.m_attributes_written, attrib_src_ptr.size());
-          header_dst_ptr = cmd.m_draw_command->m_header_attributes.sub_array(cmd.m_attributes_written, attrib_src_ptr.size());
-
-          std::memcpy(attrib_dst_ptr.c_ptr(), attrib_src_ptr.c_ptr(), sizeof(PainterAttribute) * attrib_dst_ptr.size());
-          std::fill(header_dst_ptr.begin(), header_dst_ptr.end(), header_loc);
-
-          if(!attrib_chunk_selector.empty())
-            {
-              assert(d->m_work_room.m_attribs_loaded[attrib_src] == NOT_LOADED);
-              d->m_work_room.m_attribs_loaded[attrib_src] = cmd.m_attributes_written;
-            }
-          attrib_offset = cmd.m_attributes_written;
-          cmd.m_attributes_written += attrib_dst_ptr.size();
+          d->draw_recorded(*list_d, R, &matrices[R.m_matrix_slot], &clip, z_offset, call_back);
         }
       else
         {
-          assert(!attrib_chunk_selector.empty());
-          assert(d->m_work_room.m_attribs_loaded[attrib_src] != NOT_LOADED);
-          attrib_offset = d->m_work_room.m_attribs_loaded[attrib_src];
-        }
-
-      /* copy and adjust the index value by incrementing them by attrib_offset
-       */
-      c_array<PainterIndex> index_dst_ptr;
-      const_c_array<PainterIndex> index_src_ptr;
-
-      index_src_ptr = index_chunks[chunk];
-      index_dst_ptr = cmd.m_draw_command->m_indices.sub_array(cmd.m_indices_written, index_src_ptr.size());
-      for(unsigned int i = 0; i < index_dst_ptr.size(); ++i)
-        {
-          index_dst_ptr[i] = index_src_ptr[i] + attrib_offset;
+          d->draw_recorded(*list_d, R, NULL, NULL, z_offset, call_back);
         }
-      cmd.m_indices_written += index_dst_ptr.size();
     }
 }
 
@@ -1050,6 +2903,41 @@ blend_shader(const fastuidraw::reference_counted_ptr<PainterBlendShader> &h,
   d->m_blend_mode = pblend_mode;
 }
 
+uint32_t
+fastuidraw::PainterPacker::
+stencil_ref(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_stencil_ref;
+}
+
+enum fastuidraw::PainterShaderGroup::stencil_action_t
+fastuidraw::PainterPacker::
+stencil_action(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_stencil_action;
+}
+
+void
+fastuidraw::PainterPacker::
+stencil_state(uint32_t ref, enum PainterShaderGroup::stencil_action_t action)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  if(ref != d->m_stencil_ref || action != d->m_stencil_action)
+    {
+      /* held back draws are drawn with the stencil state
+         active when they were added
+       */
+      d->flush_reorder();
+      d->m_stencil_ref = ref;
+      d->m_stencil_action = action;
+    }
+}
+
 const fastuidraw::PainterShaderSet&
 fastuidraw::PainterPacker::
 default_shaders(void) const
@@ -1223,9 +3111,9 @@ raw_value(void) const
 /////////////////////////////////////////////////////
 // PainterPackedValuePool methods
 fastuidraw::PainterPackedValuePool::
-PainterPackedValuePool(int alignment)
+PainterPackedValuePool(int alignment, bool concurrent)
 {
-  m_d = FASTUIDRAWnew PainterPackedValuePoolPrivate(alignment);
+  m_d = FASTUIDRAWnew PainterPackedValuePoolPrivate(alignment, concurrent);
 }
 
 fastuidraw::PainterPackedValuePool::
@@ -23,6 +23,7 @@
 #include <fastuidraw/util/math.hpp>
 #include <fastuidraw/painter/painter_header.hpp>
 #include <fastuidraw/painter/painter.hpp>
+#include <fastuidraw/painter/painter_analytic_fill_params.hpp>
 
 #include "../private/util_private.hpp"
 
@@ -285,13 +286,25 @@ namespace
       m_set_occluder_z.swap(pz);
     }
 
+    /* entry of a path clipped with the stencil buffer, cl
+       is the clipping at the time the path was clipped.
+     */
+    explicit
+    occluder_stack_entry(const fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> &cl):
+      m_stencil_clip(cl)
+    {}
+
     void
-    on_pop(fastuidraw::Painter *p);
+    on_pop(fastuidraw::Painter *p, PainterPrivate *d);
 
   private:
     /* action to execute on popping.
      */
     std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PainterDraw::DelayedAction> > m_set_occluder_z;
+
+    /* non-NULL if the entry is a stencil level
+     */
+    fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> m_stencil_clip;
   };
 
   class state_stack_entry
@@ -335,6 +348,44 @@ namespace
     std::vector<float> m_clipper_floats;
     std::vector<fastuidraw::PainterIndex> m_indices;
     std::vector<fastuidraw::PainterAttribute> m_attribs;
+    std::vector<fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> > m_recording_matrices;
+    std::vector<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > m_attrib_chunks;
+    std::vector<const fastuidraw::PainterAttributeData*> m_leaves;
+    std::vector<unsigned int> m_nodes;
+    std::vector<fastuidraw::range_type<unsigned int> > m_dash_ranges;
+  };
+
+  class PainterRecordingPrivate
+  {
+  public:
+    PainterRecordingPrivate(void):
+      m_packer(NULL),
+      m_list(NULL),
+      m_z_range(0)
+    {}
+
+    ~PainterRecordingPrivate()
+    {
+      if(m_list)
+        {
+          FASTUIDRAWdelete(m_list);
+        }
+    }
+
+    void
+    reset(const fastuidraw::PainterPacker *packer);
+
+    unsigned int
+    matrix_slot(const fastuidraw::float3x3 &m);
+
+    const fastuidraw::PainterPacker *m_packer;
+    fastuidraw::PainterPacker::CommandList *m_list;
+
+    /* item matrix of each matrix slot of m_list,
+       relative to the transformation at begin_recording()
+     */
+    std::vector<fastuidraw::float3x3> m_matrices;
+    unsigned int m_z_range;
   };
 
   class AtrribIndex
@@ -347,14 +398,16 @@ namespace
   class StrokingData
   {
   public:
-    AtrribIndex m_edges;
+    std::vector<AtrribIndex> m_edges;
     unsigned int m_edge_zinc;
 
     std::vector<AtrribIndex> m_joins;
     unsigned int m_join_zinc;
 
-    AtrribIndex m_caps;
+    std::vector<AtrribIndex> m_caps;
     unsigned int m_cap_zinc;
+
+    bool m_culled;
   };
 
   class PainterPrivate
@@ -366,6 +419,115 @@ namespace
     bool
     rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh);
 
+    bool
+    box_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &pmax,
+                  float pixel_distance);
+
+    bool
+    data_is_culled(const fastuidraw::PainterAttributeData &data,
+                   float pixel_distance, float item_space_distance);
+
+    bool
+    stroking_distances(const fastuidraw::PainterStrokeShader &shader,
+                       const fastuidraw::PainterData &draw,
+                       float &pixel_distance, float &item_space_distance);
+
+    void
+    set_draw_bounds(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &pmax,
+                    float pixel_distance);
+
+    void
+    set_draw_bounds(const fastuidraw::PainterAttributeData &data,
+                    float pixel_distance, float item_space_distance);
+
+    void
+    clear_draw_bounds(void)
+    {
+      m_has_draw_bounds = false;
+    }
+
+    float
+    item_pixel_scale(void);
+
+    const fastuidraw::TessellatedPath&
+    tessellation(const fastuidraw::Path &path);
+
+    const fastuidraw::TessellatedPath&
+    stroke_tessellation(const fastuidraw::Path &path,
+                        const fastuidraw::PainterStrokeShader &shader,
+                        const fastuidraw::PainterData &draw);
+
+    /* A Path whose tessellation is still being built by a
+       PathTessellationPool is not drawn, unless recording,
+       since a recording is drawn later.
+     */
+    bool
+    path_is_pending(const fastuidraw::Path &path)
+    {
+      return !m_recording && path.tessellation_pending();
+    }
+
+    void
+    select_leaves(const fastuidraw::PainterAttributeDataHierarchy &hierarchy,
+                  bool can_cull, float pixel_distance, float item_space_distance);
+
+    void
+    fill_path_leaves(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                     const fastuidraw::PainterData &draw,
+                     enum fastuidraw::PainterEnums::fill_rule_t fill_rule,
+                     const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+
+    void
+    fill_path_leaves(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                     const fastuidraw::PainterData &draw,
+                     const fastuidraw::Painter::CustomFillRuleBase &fill_rule,
+                     const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+
+    static
+    void
+    stroking_chunks(enum fastuidraw::PainterEnums::cap_style cp,
+                    enum fastuidraw::PainterEnums::join_style js,
+                    bool edge_segments,
+                    enum fastuidraw::PainterAttributeData::stroking_data_t &edge,
+                    enum fastuidraw::PainterAttributeData::stroking_data_t &cap,
+                    enum fastuidraw::PainterAttributeData::stroking_data_t &join);
+
+    void
+    grab_stroking_chunks(unsigned int chunk, std::vector<AtrribIndex> &dst);
+
+    /* the stencil buffer has 8 bits, past 255 nested
+       levels clipping falls back to occluders.
+     */
+    bool
+    use_stencil_clip(void)
+    {
+      return m_stencil_clipping && m_stencil_level < 255u;
+    }
+
+    /* returns the clip equations cl pushed out by one pixel
+       so that round off error does not miss pixels
+     */
+    fastuidraw::PainterClipEquations
+    expanded_clip(const fastuidraw::PainterClipEquations &cl);
+
+    /* draws a quad covering the clipping region cl to
+       the stencil buffer
+     */
+    void
+    stencil_clip_region(fastuidraw::Painter *p,
+                        const fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> &cl,
+                        uint32_t stencil_ref,
+                        enum fastuidraw::PainterShaderGroup::stencil_action_t action);
+
+    template<typename T>
+    void
+    stencil_clip_path(fastuidraw::Painter *p, const fastuidraw::Path &path,
+                      const T &fill_rule, bool clip_in);
+
+    void
+    stencil_clip_pop(fastuidraw::Painter *p,
+                     const fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> &cl);
+
     void
     draw_generic_check(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
                        const fastuidraw::PainterData &draw,
@@ -434,6 +596,10 @@ namespace
       m_current_clip = v.value();
     }
 
+    void
+    blend_shader(const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &h,
+                 fastuidraw::BlendMode::packed_value mode);
+
     void
     stroke_path_helper(const StrokingData &str,
                        const fastuidraw::PainterStrokeShader &shader,
@@ -442,6 +608,11 @@ namespace
                        const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
 
     fastuidraw::vec2 m_one_pixel_width;
+    float m_curve_flatness;
+    float m_stroke_lod_distance, m_stroke_lod_max_width;
+    bool m_stroke_with_edge_segments;
+    bool m_stencil_clipping;
+    unsigned int m_stencil_level;
     unsigned int m_current_z;
     clip_rect_state m_clip_rect_state;
     std::vector<occluder_stack_entry> m_occluder_stack;
@@ -456,6 +627,23 @@ namespace
     fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> m_current_clip_state;
     clip_rect m_clip_rect_in_item_coordinates;
     PainterWorkRoom m_work_room;
+
+    /* if m_has_draw_bounds is true, the draws sent to
+       m_core are within [m_draw_bounds_min, m_draw_bounds_max]
+       in normalized device coordinates, the values are
+       passed along as PainterPackerData::m_bounds_min
+       and PainterPackerData::m_bounds_max.
+     */
+    bool m_has_draw_bounds;
+    fastuidraw::vec2 m_draw_bounds_min, m_draw_bounds_max;
+
+    /* non-NULL exactly when between begin_recording()
+       and end_recording(), m_recording_restore holds
+       the state to restore at end_recording().
+     */
+    PainterRecordingPrivate *m_recording;
+    state_stack_entry m_recording_restore;
+    unsigned int m_recording_restore_z;
   };
 
 }
@@ -516,8 +704,14 @@ scale(float s)
 // occluder_stack_entry methods
 void
 occluder_stack_entry::
-on_pop(fastuidraw::Painter *p)
+on_pop(fastuidraw::Painter *p, PainterPrivate *d)
 {
+  if(m_stencil_clip)
+    {
+      d->stencil_clip_pop(p, m_stencil_clip);
+      return;
+    }
+
   /* depth test is GL_GEQUAL, so we need to increment the Z
      before hand so that the occluders block all that
      is drawn below them.
@@ -620,11 +814,47 @@ set_painter_core_clip(const fastuidraw::PainterPackedValue<fastuidraw::PainterCl
   return return_value;
 }
 
+//////////////////////////////////
+// PainterRecordingPrivate methods
+void
+PainterRecordingPrivate::
+reset(const fastuidraw::PainterPacker *packer)
+{
+  if(m_packer != packer)
+    {
+      if(m_list)
+        {
+          FASTUIDRAWdelete(m_list);
+        }
+      m_packer = packer;
+      m_list = FASTUIDRAWnew fastuidraw::PainterPacker::CommandList(*packer);
+    }
+  m_list->clear();
+  m_matrices.clear();
+  m_z_range = 0;
+}
+
+unsigned int
+PainterRecordingPrivate::
+matrix_slot(const fastuidraw::float3x3 &m)
+{
+  /* consecutive draws almost always share the
+     transformation, so only compare against the
+     last slot.
+   */
+  if(m_matrices.empty() || m_matrices.back().raw_data() != m.raw_data())
+    {
+      m_matrices.push_back(m);
+    }
+  return m_matrices.size() - 1;
+}
+
 //////////////////////////////////
 // PainterPrivate methods
 PainterPrivate::
 PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend):
-  m_pool(backend->configuration_base().alignment())
+  m_pool(backend->configuration_base().alignment()),
+  m_recording(NULL)
 {
   m_core = FASTUIDRAWnew fastuidraw::PainterPacker(backend);
   m_reset_brush = m_pool.create_packed_value(fastuidraw::PainterBrush());
@@ -633,6 +863,13 @@ PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> bac
   m_identiy_matrix = m_pool.create_packed_value(fastuidraw::PainterItemMatrix());
   m_current_z = 1;
   m_one_pixel_width = fastuidraw::vec2(0.0f, 0.0f);
+  m_has_draw_bounds = false;
+  m_curve_flatness = 0.25f;
+  m_stroke_lod_distance = 0.5f;
+  m_stroke_lod_max_width = 2.0f;
+  m_stroke_with_edge_segments = false;
+  m_stencil_clipping = backend->configuration_base().stencil_clipping();
+  m_stencil_level = 0;
 }
 
 void
@@ -643,6 +880,16 @@ clip_against_planes(fastuidraw::const_c_array<fastuidraw::vec2> pts,
   const fastuidraw::PainterClipEquations &eqs(m_current_clip);
   const fastuidraw::PainterItemMatrix &m(m_current_item_matrix);
 
+  if(m_recording)
+    {
+      /* the clipping is not known until the
+         recording is drawn, so nothing to clip.
+       */
+      out_pts.resize(pts.size());
+      std::copy(pts.begin(), pts.end(), out_pts.begin());
+      return;
+    }
+
   /* Clip planes are in clip coordinates, i.e.
        ClipDistance[i] = dot(M * p, clip_equation[i])
                        = dot(p, transpose(M)(clip_equation[i])
@@ -813,33 +1060,453 @@ clip_against_plane(const fastuidraw::vec3 &clip_eq,
 bool
 PainterPrivate::
 rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
+{
+  return box_is_culled(pmin, pmin + wh, 0.0f);
+}
+
+bool
+PainterPrivate::
+box_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &pmax,
+              float pixel_distance)
 {
   /* apply the current transformation matrix to
      the corners of the clipping rectangle and check
      if there is a clipping plane for which all
      those points are on the wrong size.
    */
-  fastuidraw::vec2 pmax(wh + pmin);
   fastuidraw::vecN<fastuidraw::vec3, 4> pts;
   pts[0] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmin.x(), pmin.y(), 1.0f);
   pts[1] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmin.x(), pmax.y(), 1.0f);
   pts[2] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmax.y(), 1.0f);
   pts[3] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmin.y(), 1.0f);
 
+  fastuidraw::PainterClipEquations clip_eq;
   if(m_clip_rect_state.m_clip_rect.m_enabled)
     {
       /* use equations of from clip state
        */
-      return all_pts_culled_by_one_half_plane(pts, m_current_clip);
+      clip_eq = m_current_clip;
     }
   else
     {
-      fastuidraw::PainterClipEquations clip_eq;
       clip_eq.m_clip_equations[0] = fastuidraw::vec3( 1.0f,  0.0f, 1.0f);
       clip_eq.m_clip_equations[1] = fastuidraw::vec3(-1.0f,  0.0f, 1.0f);
       clip_eq.m_clip_equations[2] = fastuidraw::vec3( 0.0f,  1.0f, 1.0f);
       clip_eq.m_clip_equations[3] = fastuidraw::vec3( 0.0f, -1.0f, 1.0f);
-      return all_pts_culled_by_one_half_plane(pts, clip_eq);
+    }
+
+  if(pixel_distance > 0.0f)
+    {
+      /* push each clip equation out by pixel_distance
+         pixels; a pixel is 2 / resolution in normalized
+         device coordinates.
+       */
+      for(unsigned int i = 0; i < 4; ++i)
+        {
+          fastuidraw::vec3 &eq(clip_eq.m_clip_equations[i]);
+          eq.z() += 2.0f * pixel_distance * (fastuidraw::t_abs(eq.x()) * m_one_pixel_width.x()
+                                             + fastuidraw::t_abs(eq.y()) * m_one_pixel_width.y());
+        }
+    }
+  return all_pts_culled_by_one_half_plane(pts, clip_eq);
+}
+
+bool
+PainterPrivate::
+data_is_culled(const fastuidraw::PainterAttributeData &data,
+               float pixel_distance, float item_space_distance)
+{
+  fastuidraw::vec2 pmin, pmax;
+
+  /* when recording, the transformation and clipping
+     are those at the time the recording is drawn,
+     thus we cannot cull.
+   */
+  if(m_recording || !data.bounding_box(pmin, pmax))
+    {
+      return false;
+    }
+
+  pmin -= fastuidraw::vec2(item_space_distance, item_space_distance);
+  pmax += fastuidraw::vec2(item_space_distance, item_space_distance);
+  return box_is_culled(pmin, pmax, pixel_distance);
+}
+
+void
+PainterPrivate::
+set_draw_bounds(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &pmax,
+                float pixel_distance)
+{
+  fastuidraw::vecN<fastuidraw::vec3, 4> pts;
+  fastuidraw::vec2 pad;
+
+  /* the bounds are only meaningful for the transformation
+     in effect when drawing, which is not known when recording;
+     without the resolution, the padding is not known either.
+   */
+  m_has_draw_bounds = false;
+  if(m_recording || m_one_pixel_width.x() <= 0.0f || m_one_pixel_width.y() <= 0.0f)
+    {
+      return;
+    }
+
+  pts[0] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmin.x(), pmin.y(), 1.0f);
+  pts[1] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmin.x(), pmax.y(), 1.0f);
+  pts[2] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmax.y(), 1.0f);
+  pts[3] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmin.y(), 1.0f);
+  for(unsigned int i = 0; i < 4; ++i)
+    {
+      fastuidraw::vec2 p;
+
+      /* a corner behind the eye makes the box unbounded
+         in normalized device coordinates.
+       */
+      if(pts[i].z() <= 0.0f)
+        {
+          return;
+        }
+
+      p = fastuidraw::vec2(pts[i].x(), pts[i].y()) / pts[i].z();
+      if(i == 0)
+        {
+          m_draw_bounds_min = p;
+          m_draw_bounds_max = p;
+        }
+      else
+        {
+          m_draw_bounds_min.x() = fastuidraw::t_min(m_draw_bounds_min.x(), p.x());
+          m_draw_bounds_min.y() = fastuidraw::t_min(m_draw_bounds_min.y(), p.y());
+          m_draw_bounds_max.x() = fastuidraw::t_max(m_draw_bounds_max.x(), p.x());
+          m_draw_bounds_max.y() = fastuidraw::t_max(m_draw_bounds_max.y(), p.y());
+        }
+    }
+
+  /* pad by an extra pixel for the pixels that the
+     rasterization of the boundary touches; a pixel
+     is 2 / resolution in normalized device coordinates.
+   */
+  pad = 2.0f * (pixel_distance + 1.0f) * m_one_pixel_width;
+  m_draw_bounds_min -= pad;
+  m_draw_bounds_max += pad;
+  m_has_draw_bounds = true;
+}
+
+void
+PainterPrivate::
+set_draw_bounds(const fastuidraw::PainterAttributeData &data,
+                float pixel_distance, float item_space_distance)
+{
+  fastuidraw::vec2 pmin, pmax;
+
+  if(data.bounding_box(pmin, pmax))
+    {
+      pmin -= fastuidraw::vec2(item_space_distance, item_space_distance);
+      pmax += fastuidraw::vec2(item_space_distance, item_space_distance);
+      set_draw_bounds(pmin, pmax, pixel_distance);
+    }
+  else
+    {
+      m_has_draw_bounds = false;
+    }
+}
+
+bool
+PainterPrivate::
+stroking_distances(const fastuidraw::PainterStrokeShader &shader,
+                   const fastuidraw::PainterData &draw,
+                   float &pixel_distance, float &item_space_distance)
+{
+  const fastuidraw::PainterShaderData::DataBase *raw_data;
+
+  if(!shader.stroking_data_selector()
+     || (!draw.m_item_shader_data.m_packed_value && !draw.m_item_shader_data.m_value))
+    {
+      return false;
+    }
+
+  raw_data = draw.m_item_shader_data.data().data_base();
+  return raw_data != NULL
+    && shader.stroking_data_selector()->stroking_distances(raw_data, pixel_distance, item_space_distance);
+}
+
+float
+PainterPrivate::
+item_pixel_scale(void)
+{
+  /* operator norm of the linear portion of the map from item
+     coordinates to pixel coordinates; for a projective item
+     matrix this is the value at the item coordinate origin.
+   */
+  const fastuidraw::float3x3 &m(m_current_item_matrix.m_item_matrix);
+  float w, a, b, c, d, s, det;
+
+  w = fastuidraw::t_abs(m(2, 2));
+  if(w <= 0.0f || m_one_pixel_width.x() <= 0.0f || m_one_pixel_width.y() <= 0.0f)
+    {
+      return 0.0f;
+    }
+
+  a = 0.5f * m(0, 0) / (w * m_one_pixel_width.x());
+  b = 0.5f * m(0, 1) / (w * m_one_pixel_width.x());
+  c = 0.5f * m(1, 0) / (w * m_one_pixel_width.y());
+  d = 0.5f * m(1, 1) / (w * m_one_pixel_width.y());
+
+  /* the largest singular value of [a b; c d] */
+  s = a * a + b * b + c * c + d * d;
+  det = a * d - b * c;
+  return std::sqrt(0.5f * (s + std::sqrt(fastuidraw::t_max(0.0f, s * s - 4.0f * det * det))));
+}
+
+const fastuidraw::TessellatedPath&
+PainterPrivate::
+tessellation(const fastuidraw::Path &path)
+{
+  float scale;
+
+  /* a recording is drawn later with a transformation that is
+     not known yet, so it uses the tessellation of the Path
+     as specified by Path::tessellation_params().
+   */
+  if(m_recording || m_curve_flatness <= 0.0f)
+    {
+      return *path.tessellation();
+    }
+
+  scale = item_pixel_scale();
+  if(scale <= 0.0f)
+    {
+      return *path.tessellation();
+    }
+  return *path.tessellation(m_curve_flatness / scale);
+}
+
+const fastuidraw::TessellatedPath&
+PainterPrivate::
+stroke_tessellation(const fastuidraw::Path &path,
+                    const fastuidraw::PainterStrokeShader &shader,
+                    const fastuidraw::PainterData &draw)
+{
+  const fastuidraw::PainterShaderData::DataBase *raw_data;
+  float scale, pixel_width, item_space_width;
+
+  if(m_recording || m_stroke_lod_distance <= 0.0f || !shader.stroking_data_selector()
+     || (!draw.m_item_shader_data.m_packed_value && !draw.m_item_shader_data.m_value))
+    {
+      return tessellation(path);
+    }
+
+  scale = item_pixel_scale();
+  raw_data = draw.m_item_shader_data.data().data_base();
+  if(scale <= 0.0f || raw_data == NULL
+     || !shader.stroking_data_selector()->stroking_width(raw_data, pixel_width, item_space_width)
+     || pixel_width + item_space_width * scale > m_stroke_lod_max_width)
+    {
+      return tessellation(path);
+    }
+  return *path.simplified_tessellation(m_stroke_lod_distance / scale);
+}
+
+void
+PainterPrivate::
+select_leaves(const fastuidraw::PainterAttributeDataHierarchy &hierarchy,
+              bool can_cull, float pixel_distance, float item_space_distance)
+{
+  /* walk the hierarchy, skipping those nodes whose bounding
+     box is outside of the clipping region.
+   */
+  m_work_room.m_leaves.clear();
+  m_work_room.m_nodes.clear();
+  m_work_room.m_nodes.push_back(0);
+  can_cull = can_cull && !m_recording;
+
+  while(!m_work_room.m_nodes.empty())
+    {
+      unsigned int node;
+      fastuidraw::const_c_array<unsigned int> children;
+
+      node = m_work_room.m_nodes.back();
+      m_work_room.m_nodes.pop_back();
+
+      if(can_cull)
+        {
+          fastuidraw::vec2 pmin, pmax;
+          if(!hierarchy.bounding_box(node, pmin, pmax))
+            {
+              continue;
+            }
+
+          pmin -= fastuidraw::vec2(item_space_distance, item_space_distance);
+          pmax += fastuidraw::vec2(item_space_distance, item_space_distance);
+          if(box_is_culled(pmin, pmax, pixel_distance))
+            {
+              continue;
+            }
+        }
+
+      children = hierarchy.children(node);
+      if(children.empty())
+        {
+          m_work_room.m_leaves.push_back(&hierarchy.data(node));
+        }
+      else
+        {
+          for(unsigned int c = children.size(); c > 0; --c)
+            {
+              m_work_room.m_nodes.push_back(children[c - 1]);
+            }
+        }
+    }
+}
+
+void
+PainterPrivate::
+fill_path_leaves(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                 const fastuidraw::PainterData &draw,
+                 enum fastuidraw::PainterEnums::fill_rule_t fill_rule,
+                 const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+{
+  m_work_room.m_attrib_chunks.clear();
+  m_work_room.m_index_chunks.clear();
+  m_work_room.m_selector.clear();
+
+  for(unsigned int i = 0, endi = m_work_room.m_leaves.size(); i < endi; ++i)
+    {
+      const fastuidraw::PainterAttributeData *leaf(m_work_room.m_leaves[i]);
+      fastuidraw::const_c_array<fastuidraw::PainterIndex> chunk;
+
+      chunk = leaf->index_data_chunk(fill_rule);
+      if(!chunk.empty())
+        {
+          m_work_room.m_selector.push_back(m_work_room.m_attrib_chunks.size());
+          m_work_room.m_attrib_chunks.push_back(leaf->attribute_data_chunk(0));
+          m_work_room.m_index_chunks.push_back(chunk);
+        }
+    }
+
+  if(!m_work_room.m_index_chunks.empty())
+    {
+      draw_generic_check(shader, draw,
+                         fastuidraw::make_c_array(m_work_room.m_attrib_chunks),
+                         fastuidraw::make_c_array(m_work_room.m_index_chunks),
+                         fastuidraw::make_c_array(m_work_room.m_selector),
+                         m_current_z, call_back);
+    }
+}
+
+void
+PainterPrivate::
+fill_path_leaves(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                 const fastuidraw::PainterData &draw,
+                 const fastuidraw::Painter::CustomFillRuleBase &fill_rule,
+                 const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+{
+  using namespace fastuidraw;
+
+  m_work_room.m_attrib_chunks.clear();
+  m_work_room.m_index_chunks.clear();
+  m_work_room.m_selector.clear();
+
+  for(unsigned int i = 0, endi = m_work_room.m_leaves.size(); i < endi; ++i)
+    {
+      const PainterAttributeData *leaf(m_work_room.m_leaves[i]);
+      unsigned int attrib_slot(m_work_room.m_attrib_chunks.size());
+
+      /* walk through what winding numbers are non-empty.
+       */
+      const_c_array<unsigned int> chks(leaf->non_empty_index_data_chunks());
+      for(unsigned int j = 0; j < chks.size(); ++j)
+        {
+          unsigned int k;
+          int winding_number;
+
+          k = chks[j];
+          if(k == PainterEnums::complement_nonzero_fill_rule || k >= PainterEnums::fill_rule_data_count)
+            {
+              winding_number = PainterAttributeData::winding_number_from_index_chunk(k);
+              if(fill_rule(winding_number))
+                {
+                  assert(!leaf->index_data_chunk(k).empty());
+                  if(attrib_slot == m_work_room.m_attrib_chunks.size())
+                    {
+                      m_work_room.m_attrib_chunks.push_back(leaf->attribute_data_chunk(0));
+                    }
+                  m_work_room.m_index_chunks.push_back(leaf->index_data_chunk(k));
+                  m_work_room.m_selector.push_back(attrib_slot);
+                }
+            }
+        }
+    }
+
+  if(!m_work_room.m_selector.empty())
+    {
+      draw_generic_check(shader, draw,
+                         make_c_array(m_work_room.m_attrib_chunks),
+                         make_c_array(m_work_room.m_index_chunks),
+                         make_c_array(m_work_room.m_selector),
+                         m_current_z, call_back);
+    }
+}
+
+void
+PainterPrivate::
+stroking_chunks(enum fastuidraw::PainterEnums::cap_style cp,
+                enum fastuidraw::PainterEnums::join_style js,
+                bool edge_segments,
+                enum fastuidraw::PainterAttributeData::stroking_data_t &edge,
+                enum fastuidraw::PainterAttributeData::stroking_data_t &cap,
+                enum fastuidraw::PainterAttributeData::stroking_data_t &join)
+{
+  using namespace fastuidraw;
+  using namespace PainterEnums;
+
+  switch(js)
+    {
+    case rounded_joins:
+      join = PainterAttributeData::rounded_joins_closing_edge;
+      break;
+    case bevel_joins:
+      join = PainterAttributeData::bevel_joins_closing_edge;
+      break;
+    case miter_joins:
+      join = PainterAttributeData::miter_joins_closing_edge;
+      break;
+    default:
+      join = PainterAttributeData::stroking_data_count;
+    }
+
+  switch(cp)
+    {
+    case rounded_caps:
+      cap = PainterAttributeData::rounded_cap;
+      break;
+    case square_caps:
+      cap = PainterAttributeData::square_cap;
+      break;
+    default:
+      cap = PainterAttributeData::stroking_data_count;
+    }
+
+  edge = edge_segments ?
+    PainterAttributeData::edge_segment_closing_edge :
+    PainterAttributeData::edge_closing_edge;
+  if(cp != close_contours)
+    {
+      join = PainterAttributeData::without_closing_edge(join);
+      edge = PainterAttributeData::without_closing_edge(edge);
+    }
+}
+
+void
+PainterPrivate::
+grab_stroking_chunks(unsigned int chunk, std::vector<AtrribIndex> &dst)
+{
+  for(unsigned int i = 0, endi = m_work_room.m_leaves.size(); i < endi; ++i)
+    {
+      const fastuidraw::PainterAttributeData *leaf(m_work_room.m_leaves[i]);
+
+      dst.push_back(AtrribIndex());
+      dst.back().m_attribs = leaf->attribute_data_chunk(chunk);
+      dst.back().m_indices = leaf->index_data_chunk(chunk);
     }
 }
 
@@ -853,15 +1520,165 @@ draw_generic_check(const fastuidraw::reference_counted_ptr<fastuidraw::PainterIt
                    unsigned int z,
                    const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
 {
-  if(!m_clip_rect_state.m_all_content_culled)
+  if(m_recording)
+    {
+      unsigned int slot;
+
+      /* the z-values written by the call backs
+         cannot be known when recording.
+       */
+      assert(!call_back);
+      FASTUIDRAWunused(call_back);
+      slot = m_recording->matrix_slot(m_current_item_matrix.m_item_matrix);
+      m_recording->m_list->draw_generic(shader, fastuidraw::PainterPackerData(draw),
+                                        attrib_chunks, index_chunks, attrib_chunk_selector,
+                                        z, slot);
+    }
+  else if(!m_clip_rect_state.m_all_content_culled)
     {
       fastuidraw::PainterPackerData p(draw);
       p.m_clip = current_clip_state();
       p.m_matrix = current_item_marix_state();
+      p.m_has_bounds = m_has_draw_bounds;
+      p.m_bounds_min = m_draw_bounds_min;
+      p.m_bounds_max = m_draw_bounds_max;
       m_core->draw_generic(shader, p, attrib_chunks, index_chunks, attrib_chunk_selector, z, call_back);
     }
 }
 
+void
+PainterPrivate::
+blend_shader(const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &h,
+             fastuidraw::BlendMode::packed_value mode)
+{
+  m_core->blend_shader(h, mode);
+  if(m_recording)
+    {
+      m_recording->m_list->blend_shader(h, mode);
+    }
+}
+
+fastuidraw::PainterClipEquations
+PainterPrivate::
+expanded_clip(const fastuidraw::PainterClipEquations &cl)
+{
+  fastuidraw::PainterClipEquations return_value(cl);
+  for(unsigned int i = 0; i < 4; ++i)
+    {
+      float f;
+      fastuidraw::vec3 &eq(return_value.m_clip_equations[i]);
+
+      f = fastuidraw::t_abs(eq.x()) * m_one_pixel_width.x() + fastuidraw::t_abs(eq.y()) * m_one_pixel_width.y();
+      eq.z() += f;
+    }
+  return return_value;
+}
+
+void
+PainterPrivate::
+stencil_clip_region(fastuidraw::Painter *p,
+                    const fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> &cl,
+                    uint32_t stencil_ref,
+                    enum fastuidraw::PainterShaderGroup::stencil_action_t action)
+{
+  /* the quad is in 3D API coordinates and covers all of
+     [-1, 1]x[-1, 1]; the clip equations (slightly enlarged
+     so that round off error does not miss pixels that the
+     path fill touched) restrict it to the clipping region.
+     Only the pixels passing the stencil test are affected,
+     so the enlarged region does not touch anything else.
+   */
+  fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> matrix_state;
+  fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> clip_state;
+  bool culled;
+
+  matrix_state = current_item_marix_state();
+  clip_state = current_clip_state();
+  culled = m_clip_rect_state.m_all_content_culled;
+
+  current_item_matrix_state(m_identiy_matrix);
+  set_current_clip(expanded_clip(cl.value()));
+  m_clip_rect_state.m_all_content_culled = false;
+  m_core->stencil_state(stencil_ref, action);
+  p->draw_quad(fastuidraw::PainterData(m_black_brush),
+               fastuidraw::vec2(-1.0f, -1.0f),
+               fastuidraw::vec2(-1.0f, +1.0f),
+               fastuidraw::vec2(+1.0f, +1.0f),
+               fastuidraw::vec2(+1.0f, -1.0f));
+
+  m_clip_rect_state.m_all_content_culled = culled;
+  current_clip_state(clip_state);
+  current_item_matrix_state(matrix_state);
+}
+
+template<typename T>
+void
+PainterPrivate::
+stencil_clip_path(fastuidraw::Painter *p, const fastuidraw::Path &path,
+                  const T &fill_rule, bool clip_in)
+{
+  /* The stencil value of the pixels within the clipping is
+     m_stencil_level and draws pass the stencil test only
+     where the stencil value equals m_stencil_level.
+      - clip-in: increment the pixels covered by the path
+      - clip-out: increment all pixels, then decrement the
+        pixels covered by the path
+     Both leave exactly the pixels of the new clipping at
+     m_stencil_level + 1. Since a pixel only passes the
+     stencil test before it is incremented (or decremented),
+     overlapping triangles of the fill affect it once.
+   */
+  fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> old_blend;
+  fastuidraw::BlendMode::packed_value old_blend_mode;
+  fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> clip;
+
+  old_blend = m_core->blend_shader();
+  old_blend_mode = m_core->blend_mode();
+  clip = current_clip_state();
+
+  p->blend_shader(fastuidraw::PainterEnums::blend_porter_duff_dst);
+  if(clip_in)
+    {
+      m_core->stencil_state(m_stencil_level, fastuidraw::PainterShaderGroup::stencil_increment);
+    }
+  else
+    {
+      stencil_clip_region(p, clip, m_stencil_level, fastuidraw::PainterShaderGroup::stencil_increment);
+      m_core->stencil_state(m_stencil_level + 1, fastuidraw::PainterShaderGroup::stencil_decrement);
+    }
+  p->fill_path(fastuidraw::PainterData(m_black_brush), path, fill_rule);
+
+  ++m_stencil_level;
+  m_core->stencil_state(m_stencil_level, fastuidraw::PainterShaderGroup::stencil_test);
+  blend_shader(old_blend, old_blend_mode);
+
+  m_occluder_stack.push_back(occluder_stack_entry(clip));
+}
+
+void
+PainterPrivate::
+stencil_clip_pop(fastuidraw::Painter *p,
+                 const fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> &cl)
+{
+  /* the pixels at m_stencil_level are within the clipping
+     region cl, decrementing them all restores the stencil
+     buffer to before the clip.
+   */
+  fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> old_blend;
+  fastuidraw::BlendMode::packed_value old_blend_mode;
+
+  assert(m_stencil_level > 0);
+  old_blend = m_core->blend_shader();
+  old_blend_mode = m_core->blend_mode();
+
+  p->blend_shader(fastuidraw::PainterEnums::blend_porter_duff_dst);
+  stencil_clip_region(p, cl, m_stencil_level, fastuidraw::PainterShaderGroup::stencil_decrement);
+
+  --m_stencil_level;
+  m_core->stencil_state(m_stencil_level, fastuidraw::PainterShaderGroup::stencil_test);
+  blend_shader(old_blend, old_blend_mode);
+}
+
 void
 PainterPrivate::
 stroke_path_helper(const StrokingData &str,
@@ -872,25 +1689,48 @@ stroke_path_helper(const StrokingData &str,
 {
   using namespace fastuidraw;
 
+  if(str.m_culled)
+    {
+      /* nothing is drawn, but the z-value still advances
+         as if the stroking were drawn so that the z-values
+         of later draws do not depend on culling.
+       */
+      if(!with_anti_aliasing || shader.aa_type() == PainterStrokeShader::draws_solid_then_fuzz)
+        {
+          m_current_z += str.m_edge_zinc + str.m_join_zinc + str.m_cap_zinc + 1;
+        }
+      return;
+    }
+
   unsigned int startz, zinc_sum(0);
   bool modify_z;
   const reference_counted_ptr<PainterItemShader> *sh;
-  std::vector<const_c_array<PainterAttribute> > vattrib_chunks(str.m_joins.size() + 2);
-  std::vector<const_c_array<PainterIndex> > vindex_chunks(str.m_joins.size() + 2);
+  unsigned int num_edges(str.m_edges.size()), num_caps(str.m_caps.size());
+  unsigned int num_chunks(num_edges + num_caps + str.m_joins.size());
+  std::vector<const_c_array<PainterAttribute> > vattrib_chunks(num_chunks);
+  std::vector<const_c_array<PainterIndex> > vindex_chunks(num_chunks);
   c_array<const_c_array<PainterAttribute> > attrib_chunks;
   c_array<const_c_array<PainterIndex> > index_chunks;
 
   attrib_chunks = make_c_array(vattrib_chunks);
   index_chunks = make_c_array(vindex_chunks);
 
-  attrib_chunks[0] = str.m_edges.m_attribs;
-  index_chunks [0] = str.m_edges.m_indices;
-  attrib_chunks[1] = str.m_caps.m_attribs;
-  index_chunks [1] = str.m_caps.m_indices;
+  /* chunks are ordered as: edges, caps, joins
+   */
+  for(unsigned int E = 0; E < num_edges; ++E)
+    {
+      attrib_chunks[E] = str.m_edges[E].m_attribs;
+      index_chunks [E] = str.m_edges[E].m_indices;
+    }
+  for(unsigned int C = 0; C < num_caps; ++C)
+    {
+      attrib_chunks[C + num_edges] = str.m_caps[C].m_attribs;
+      index_chunks [C + num_edges] = str.m_caps[C].m_indices;
+    }
   for(unsigned int J = 0, endJ = str.m_joins.size(); J < endJ; ++J)
     {
-      attrib_chunks[J + 2] = str.m_joins[J].m_attribs;
-      index_chunks [J + 2] = str.m_joins[J].m_indices;
+      attrib_chunks[J + num_edges + num_caps] = str.m_joins[J].m_attribs;
+      index_chunks [J + num_edges + num_caps] = str.m_joins[J].m_indices;
     }
 
   startz = m_current_z;
@@ -909,22 +1749,22 @@ stroke_path_helper(const StrokingData &str,
        */
       incr_z -= str.m_edge_zinc;
       draw_generic_check(*sh, draw,
-                         attrib_chunks.sub_array(0, 1),
-                         index_chunks.sub_array(0, 1),
+                         attrib_chunks.sub_array(0, num_edges),
+                         index_chunks.sub_array(0, num_edges),
                          fastuidraw::const_c_array<unsigned int>(),
                          startz + incr_z + 1, call_back);
 
       incr_z -= str.m_join_zinc;
       draw_generic_check(*sh, draw,
-                         attrib_chunks.sub_array(2),
-                         index_chunks.sub_array(2),
+                         attrib_chunks.sub_array(num_edges + num_caps),
+                         index_chunks.sub_array(num_edges + num_caps),
                          fastuidraw::const_c_array<unsigned int>(),
                          startz + incr_z + 1, call_back);
 
       incr_z -= str.m_cap_zinc;
       draw_generic_check(*sh, draw,
-                         attrib_chunks.sub_array(1, 1),
-                         index_chunks.sub_array(1, 1),
+                         attrib_chunks.sub_array(num_edges, num_caps),
+                         index_chunks.sub_array(num_edges, num_caps),
                          fastuidraw::const_c_array<unsigned int>(),
                          startz + incr_z + 1, call_back);
     }
@@ -999,6 +1839,7 @@ begin(bool reset_z)
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
 
+  assert(!d->m_recording);
   d->m_core->begin();
 
   if(reset_z)
@@ -1006,6 +1847,9 @@ begin(bool reset_z)
       d->m_current_z = 1;
     }
 
+  d->m_stencil_level = 0;
+  d->m_core->stencil_state(0, PainterShaderGroup::stencil_test);
+
   d->m_clip_rect_state.m_item_matrix_tricky = false;
   d->m_clip_rect_state.m_inverse_transpose_not_ready = false;
   d->m_clip_rect_state.m_clip_rect.m_enabled = false;
@@ -1028,11 +1872,12 @@ end(void)
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
 
+  assert(!d->m_recording);
   /* pop m_clip_stack to perform necessary writes
    */
   while(!d->m_occluder_stack.empty())
     {
-      d->m_occluder_stack.back().on_pop(this);
+      d->m_occluder_stack.back().on_pop(this, d);
       d->m_occluder_stack.pop_back();
     }
   /* clear state stack as well.
@@ -1041,6 +1886,117 @@ end(void)
   d->m_core->end();
 }
 
+void
+fastuidraw::Painter::
+begin_recording(PainterRecording &recording)
+{
+  PainterPrivate *d;
+  PainterRecordingPrivate *rec_d;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  rec_d = reinterpret_cast<PainterRecordingPrivate*>(recording.m_d);
+  assert(!d->m_recording);
+
+  rec_d->reset(d->m_core.get());
+
+  d->m_recording_restore.m_occluder_stack_position = d->m_occluder_stack.size();
+  d->m_recording_restore.m_matrix = d->current_item_marix_state();
+  d->m_recording_restore.m_clip = d->current_clip_state();
+  d->m_recording_restore.m_blend = d->m_core->blend_shader();
+  d->m_recording_restore.m_blend_mode = d->m_core->blend_mode();
+  d->m_recording_restore.m_clip_rect_state = d->m_clip_rect_state;
+  d->m_recording_restore_z = d->m_current_z;
+
+  d->m_recording = rec_d;
+  d->m_current_z = 0;
+  d->m_clip_rect_state = clip_rect_state();
+  d->current_item_matrix_state(d->m_identiy_matrix);
+}
+
+void
+fastuidraw::Painter::
+end_recording(void)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  assert(d->m_recording);
+  assert(d->m_occluder_stack.size() == d->m_recording_restore.m_occluder_stack_position);
+
+  d->m_recording->m_z_range = d->m_current_z;
+  d->m_recording = NULL;
+
+  const state_stack_entry &st(d->m_recording_restore);
+  d->m_clip_rect_state = st.m_clip_rect_state;
+  d->current_item_matrix_state(st.m_matrix);
+  d->current_clip_state(st.m_clip);
+  d->m_core->blend_shader(st.m_blend, st.m_blend_mode);
+  d->m_current_z = d->m_recording_restore_z;
+
+  d->m_recording_restore = state_stack_entry();
+}
+
+void
+fastuidraw::Painter::
+draw_recording(const PainterRecording &recording)
+{
+  PainterPrivate *d;
+  const PainterRecordingPrivate *rec_d;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  rec_d = reinterpret_cast<const PainterRecordingPrivate*>(recording.m_d);
+  assert(!d->m_recording);
+
+  if(!rec_d->m_list)
+    {
+      return;
+    }
+
+  assert(rec_d->m_packer == d->m_core.get());
+  if(!d->m_clip_rect_state.m_all_content_culled)
+    {
+      std::vector<PainterPackedValue<PainterItemMatrix> > &matrices(d->m_work_room.m_recording_matrices);
+      const float3x3 &m(d->m_current_item_matrix.m_item_matrix);
+
+      matrices.resize(rec_d->m_matrices.size());
+      for(unsigned int i = 0, endi = matrices.size(); i < endi; ++i)
+        {
+          matrices[i] = d->m_pool.create_packed_value(PainterItemMatrix(m * rec_d->m_matrices[i]));
+        }
+      d->m_core->draw_command_list(*rec_d->m_list, make_c_array(matrices),
+                                   d->current_clip_state(), d->m_current_z);
+      matrices.clear();
+    }
+  d->m_current_z += rec_d->m_z_range;
+}
+
+unsigned int
+fastuidraw::Painter::
+draw_reorder_window(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_core->draw_reorder_window();
+}
+
+void
+fastuidraw::Painter::
+draw_reorder_window(unsigned int v)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_core->draw_reorder_window(v);
+}
+
+const fastuidraw::PainterPacker::Stats&
+fastuidraw::Painter::
+packer_stats(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_core->stats();
+}
+
 void
 fastuidraw::Painter::
 draw_generic(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
@@ -1095,9 +2051,14 @@ draw_convex_polygon(const reference_counted_ptr<PainterItemShader> &shader,
 
   /* Draw a triangle fan centered at pts[0]
    */
+  vec2 pmin(pts[0]), pmax(pts[0]);
   d->m_work_room.m_attribs.resize(pts.size());
   for(unsigned int i = 0; i < pts.size(); ++i)
     {
+      pmin.x() = t_min(pmin.x(), pts[i].x());
+      pmin.y() = t_min(pmin.y(), pts[i].y());
+      pmax.x() = t_max(pmax.x(), pts[i].x());
+      pmax.y() = t_max(pmax.y(), pts[i].y());
       d->m_work_room.m_attribs[i].m_attrib0 = fastuidraw::pack_vec4(pts[i].x(), pts[i].y(), 0.0f, 0.0f);
       d->m_work_room.m_attribs[i].m_attrib1 = uvec4(0u, 0u, 0u, 0u);
       d->m_work_room.m_attribs[i].m_attrib2 = uvec4(0, 0, 0, 0);
@@ -1111,10 +2072,12 @@ draw_convex_polygon(const reference_counted_ptr<PainterItemShader> &shader,
       d->m_work_room.m_indices.push_back(i - 1);
       d->m_work_room.m_indices.push_back(i);
     }
+  d->set_draw_bounds(pmin, pmax, 0.0f);
   draw_generic(shader, draw,
                make_c_array(d->m_work_room.m_attribs),
                make_c_array(d->m_work_room.m_indices),
                call_back);
+  d->clear_draw_bounds();
 }
 
 void
@@ -1164,72 +2127,46 @@ draw_rect(const PainterData &draw, const vec2 &p, const vec2 &wh,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
   draw_rect(default_shaders().fill_shader(), draw, p, wh, call_back);
-}
-
-void
-fastuidraw::Painter::
-stroke_path(const PainterStrokeShader &shader, const PainterData &draw,
-            const PainterAttributeData &pdata,
-            enum PainterEnums::cap_style cp, enum PainterEnums::join_style js,
-            bool with_anti_aliasing,
-            const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
-{
-  PainterPrivate *d;
-  d = reinterpret_cast<PainterPrivate*>(m_d);
-
-  using namespace PainterEnums;
-  enum PainterAttributeData::stroking_data_t cap, join, edge;
-
-  switch(js)
-    {
-    case rounded_joins:
-      join = PainterAttributeData::rounded_joins_closing_edge;
-      break;
-    case bevel_joins:
-      join = PainterAttributeData::bevel_joins_closing_edge;
-      break;
-    case miter_joins:
-      join = PainterAttributeData::miter_joins_closing_edge;
-      break;
-    default:
-      join = PainterAttributeData::stroking_data_count;
-    }
+}
 
-  switch(cp)
+void
+fastuidraw::Painter::
+stroke_path(const PainterStrokeShader &shader, const PainterData &draw,
+            const PainterAttributeData &pdata,
+            enum PainterEnums::cap_style cp, enum PainterEnums::join_style js,
+            bool with_anti_aliasing,
+            const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  PainterPrivate *d;
+  float pixel_distance, item_space_distance;
+  enum PainterAttributeData::stroking_data_t edge, cap, join;
+  StrokingData str;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_work_room.m_leaves.clear();
+  if(d->stroking_distances(shader, draw, pixel_distance, item_space_distance))
     {
-    case rounded_caps:
-      cap = PainterAttributeData::rounded_cap;
-      break;
-    case square_caps:
-      cap = PainterAttributeData::square_cap;
-      break;
-    default:
-      cap = PainterAttributeData::stroking_data_count;
+      if(!d->data_is_culled(pdata, pixel_distance, item_space_distance))
+        {
+          d->m_work_room.m_leaves.push_back(&pdata);
+        }
+      d->set_draw_bounds(pdata, pixel_distance, item_space_distance);
     }
-
-  edge = PainterAttributeData::edge_closing_edge;
-  if(cp != close_contours)
+  else
     {
-      join = PainterAttributeData::without_closing_edge(join);
-      edge = PainterAttributeData::edge_no_closing_edge;
+      d->m_work_room.m_leaves.push_back(&pdata);
     }
 
-  StrokingData str;
-
-  str.m_edges.m_attribs = pdata.attribute_data_chunk(edge);
-  str.m_edges.m_indices = pdata.index_data_chunk(edge);
+  PainterPrivate::stroking_chunks(cp, js, d->m_stroke_with_edge_segments, edge, cap, join);
   str.m_edge_zinc = pdata.increment_z_value(edge);
-
-  str.m_caps.m_attribs = pdata.attribute_data_chunk(cap);
-  str.m_caps.m_indices = pdata.index_data_chunk(cap);
   str.m_cap_zinc = pdata.increment_z_value(cap);
-
-  str.m_joins.resize(1);
-  str.m_joins[0].m_attribs = pdata.attribute_data_chunk(join);
-  str.m_joins[0].m_indices = pdata.index_data_chunk(join);
   str.m_join_zinc = pdata.increment_z_value(join);
-
+  str.m_culled = d->m_work_room.m_leaves.empty();
+  d->grab_stroking_chunks(edge, str.m_edges);
+  d->grab_stroking_chunks(cap, str.m_caps);
+  d->grab_stroking_chunks(join, str.m_joins);
   d->stroke_path_helper(str, shader, draw, with_anti_aliasing, call_back);
+  d->clear_draw_bounds();
 }
 
 void
@@ -1240,8 +2177,54 @@ stroke_path(const PainterStrokeShader &shader, const PainterData &draw,
             bool with_anti_aliasing,
             const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  stroke_path(shader, draw, path.tessellation()->stroked()->painter_data(),
-              cp, js, with_anti_aliasing, call_back);
+  PainterPrivate *d;
+  float pixel_distance, item_space_distance;
+  bool can_cull;
+  enum PainterAttributeData::stroking_data_t edge, cap, join;
+  StrokingData str;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  if(d->path_is_pending(path))
+    {
+      return;
+    }
+
+  const StrokedPath &stroked(*d->stroke_tessellation(path, shader, draw).stroked());
+  const PainterAttributeData &pdata(stroked.painter_data());
+  can_cull = d->stroking_distances(shader, draw, pixel_distance, item_space_distance);
+
+  /* the z-increments come from the source data pdata;
+     each leaf of a hierarchy keeps the depth values of
+     pdata. Each chunk has its own hierarchy, so that the
+     data of the join and cap styles not used is not made.
+   */
+  PainterPrivate::stroking_chunks(cp, js, d->m_stroke_with_edge_segments, edge, cap, join);
+  str.m_edge_zinc = pdata.increment_z_value(edge);
+  str.m_cap_zinc = pdata.increment_z_value(cap);
+  str.m_join_zinc = pdata.increment_z_value(join);
+
+  d->select_leaves(stroked.painter_data_hierarchy(edge), can_cull, pixel_distance, item_space_distance);
+  d->grab_stroking_chunks(edge, str.m_edges);
+  if(cap != PainterAttributeData::stroking_data_count)
+    {
+      d->select_leaves(stroked.painter_data_hierarchy(cap), can_cull, pixel_distance, item_space_distance);
+      d->grab_stroking_chunks(cap, str.m_caps);
+    }
+  if(join != PainterAttributeData::stroking_data_count)
+    {
+      d->select_leaves(stroked.painter_data_hierarchy(join), can_cull, pixel_distance, item_space_distance);
+      d->grab_stroking_chunks(join, str.m_joins);
+    }
+  str.m_culled = str.m_edges.empty() && str.m_caps.empty() && str.m_joins.empty();
+  if(can_cull)
+    {
+      vec2 pad(item_space_distance, item_space_distance);
+      d->set_draw_bounds(stroked.bounding_box_min() - pad,
+                         stroked.bounding_box_max() + pad,
+                         pixel_distance);
+    }
+  d->stroke_path_helper(str, shader, draw, with_anti_aliasing, call_back);
+  d->clear_draw_bounds();
 }
 
 void
@@ -1306,59 +2289,95 @@ stroke_dashed_path(const PainterDashedStrokeShaderSet &shader, const PainterData
       join = PainterAttributeData::stroking_data_count;
     }
 
-  if(close_contour)
+  PainterPrivate *d;
+  float pixel_distance, item_space_distance;
+  bool can_cull;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  edge = d->m_stroke_with_edge_segments ?
+    PainterAttributeData::edge_segment_closing_edge :
+    PainterAttributeData::edge_closing_edge;
+  if(!close_contour)
     {
-      edge = PainterAttributeData::edge_closing_edge;
+      join = PainterAttributeData::without_closing_edge(join);
+      edge = PainterAttributeData::without_closing_edge(edge);
     }
-  else
+
+  if(d->path_is_pending(path))
     {
-      join = PainterAttributeData::without_closing_edge(join);
-      edge = PainterAttributeData::edge_no_closing_edge;
+      return;
     }
-  const PainterAttributeData &pdata(path.tessellation()->stroked()->painter_data());
-  str.m_edges.m_attribs = pdata.attribute_data_chunk(edge);
-  str.m_edges.m_indices = pdata.index_data_chunk(edge);
+
+  const StrokedPath &stroked(*d->stroke_tessellation(path, shader.shader(cp), draw).stroked());
+  const PainterAttributeData &pdata(stroked.painter_data());
+  can_cull = d->stroking_distances(shader.shader(cp), draw, pixel_distance, item_space_distance)
+    && !d->m_recording;
+  d->select_leaves(stroked.painter_data_hierarchy(edge), can_cull, pixel_distance, item_space_distance);
+
   str.m_edge_zinc = pdata.increment_z_value(edge);
+  str.m_culled = d->m_work_room.m_leaves.empty();
+  d->grab_stroking_chunks(edge, str.m_edges);
 
   //no caps
   str.m_cap_zinc = 0u;
 
   /* Those joins for which the distance value is inside the
      dash pattern, we include in str.m_joins with the join
-     type, for those outside, we take the cap-join at the
-     location. We know how many joins we need from the
-     value of pdata.increment_z_value(join).
+     type. The StrokedPath has the joins sorted by distance,
+     so the dash evaluator walks the dash pattern and that
+     table together and gives the ranges of the table that
+     are inside the dash pattern. The joins are not part of
+     the hierarchy, so those joins that are outside of the
+     clipping region are skipped here.
    */
   const PainterShaderData::DataBase *raw_data;
   raw_data = draw.m_item_shader_data.data().data_base();
 
   str.m_join_zinc = pdata.increment_z_value(join);
-  for(unsigned int J = 0; J < str.m_join_zinc; ++J)
+  if(str.m_join_zinc > 0 && !str.m_culled)
     {
-      const_c_array<PainterIndex> idx;
-      unsigned int chunk;
+      const_c_array<float> join_distances(stroked.sorted_join_distances(close_contour));
+      const_c_array<unsigned int> join_ids(stroked.sorted_join_ids(close_contour));
+      c_array<range_type<unsigned int> > ranges;
 
-      chunk = PainterAttributeData::chunk_from_join(join, J);
-      idx = pdata.index_data_chunk(chunk);
-      if(!idx.empty())
-        {
-          float dist;
-          range_type<float> dash_interval;
-          const_c_array<PainterAttribute> atr(pdata.attribute_data_chunk(chunk));
-          assert(!atr.empty());
+      assert(join_ids.size() == str.m_join_zinc);
+      d->m_work_room.m_dash_ranges.resize(join_distances.size());
+      ranges = make_c_array(d->m_work_room.m_dash_ranges);
+      ranges = ranges.sub_array(0, shader.dash_evaluator()->compute_dash_ranges(raw_data, join_distances, ranges));
 
-          dist = unpack_float(atr[0].m_attrib1.y());
-          if(shader.dash_evaluator()->compute_dash_interval(raw_data, dist, dash_interval))
+      for(unsigned int R = 0; R < ranges.size(); ++R)
+        {
+          for(unsigned int I = ranges[R].m_begin; I < ranges[R].m_end; ++I)
             {
-              str.m_joins.push_back(AtrribIndex());
-              str.m_joins.back().m_attribs = atr;
-              str.m_joins.back().m_indices = idx;
+              const_c_array<PainterIndex> idx;
+              unsigned int chunk;
+
+              chunk = PainterAttributeData::chunk_from_join(join, join_ids[I]);
+              idx = pdata.index_data_chunk(chunk);
+              if(!idx.empty())
+                {
+                  const_c_array<PainterAttribute> atr(pdata.attribute_data_chunk(chunk));
+                  assert(!atr.empty());
+
+                  if(can_cull)
+                    {
+                      vec2 p(unpack_float(atr[0].m_attrib0.x()), unpack_float(atr[0].m_attrib0.y()));
+                      vec2 r(item_space_distance, item_space_distance);
+                      if(d->box_is_culled(p - r, p + r, pixel_distance))
+                        {
+                          continue;
+                        }
+                    }
+
+                  assert(unpack_float(atr[0].m_attrib1.y()) == join_distances[I]);
+                  str.m_joins.push_back(AtrribIndex());
+                  str.m_joins.back().m_attribs = atr;
+                  str.m_joins.back().m_indices = idx;
+                }
             }
         }
     }
 
-  PainterPrivate *d;
-  d = reinterpret_cast<PainterPrivate*>(m_d);
   d->stroke_path_helper(str, shader.shader(cp), draw, with_anti_aliasing, call_back);
 }
 
@@ -1390,9 +2409,17 @@ fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterD
           const PainterAttributeData &data, enum PainterEnums::fill_rule_t fill_rule,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  draw_generic(shader, draw, data.attribute_data_chunk(0),
-               data.index_data_chunk(fill_rule),
-               call_back);
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  d->m_work_room.m_leaves.clear();
+  if(!d->data_is_culled(data, 0.0f, 0.0f))
+    {
+      d->m_work_room.m_leaves.push_back(&data);
+    }
+  d->set_draw_bounds(data, 0.0f, 0.0f);
+  d->fill_path_leaves(shader, draw, fill_rule, call_back);
+  d->clear_draw_bounds();
 }
 
 void
@@ -1401,7 +2428,18 @@ fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterD
           const Path &path, enum PainterEnums::fill_rule_t fill_rule,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  fill_path(shader, draw, path.tessellation()->filled()->painter_data(), fill_rule, call_back);
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  if(d->path_is_pending(path))
+    {
+      return;
+    }
+
+  const TessellatedPath &tess(d->tessellation(path));
+  d->select_leaves(tess.filled()->painter_data_hierarchy(), true, 0.0f, 0.0f);
+  d->set_draw_bounds(tess.bounding_box_min(), tess.bounding_box_max(), 0.0f);
+  d->fill_path_leaves(shader, draw, fill_rule, call_back);
+  d->clear_draw_bounds();
 }
 
 void
@@ -1421,39 +2459,14 @@ fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterD
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
 
-  d->m_work_room.m_index_chunks.clear();
-  d->m_work_room.m_selector.clear();
-
-  /* walk through what winding numbers are non-empty.
-   */
-  const_c_array<unsigned int> chks(data.non_empty_index_data_chunks());
-  for(unsigned int i = 0; i < chks.size(); ++i)
-    {
-      unsigned int k;
-      int winding_number;
-
-      k = chks[i];
-      if(k == PainterEnums::complement_nonzero_fill_rule || k >= PainterEnums::fill_rule_data_count)
-        {
-          winding_number = PainterAttributeData::winding_number_from_index_chunk(k);
-          if(fill_rule(winding_number))
-            {
-              const_c_array<PainterIndex> chunk;
-              assert(!data.index_data_chunk(k).empty());
-              chunk = data.index_data_chunk(k);
-              d->m_work_room.m_index_chunks.push_back(chunk);
-              d->m_work_room.m_selector.push_back(0);
-            }
-        }
-    }
-
-  if(!d->m_work_room.m_selector.empty())
+  d->m_work_room.m_leaves.clear();
+  if(!d->data_is_culled(data, 0.0f, 0.0f))
     {
-      draw_generic(shader, draw, data.attribute_data_chunks(),
-                   make_c_array(d->m_work_room.m_index_chunks),
-                   make_c_array(d->m_work_room.m_selector), call_back);
+      d->m_work_room.m_leaves.push_back(&data);
     }
-
+  d->set_draw_bounds(data, 0.0f, 0.0f);
+  d->fill_path_leaves(shader, draw, fill_rule, call_back);
+  d->clear_draw_bounds();
 }
 
 void
@@ -1462,7 +2475,18 @@ fill_path(const reference_counted_ptr<PainterItemShader> &shader,
           const PainterData &draw, const Path &path, const CustomFillRuleBase &fill_rule,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  fill_path(shader, draw, path.tessellation()->filled()->painter_data(), fill_rule, call_back);
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  if(d->path_is_pending(path))
+    {
+      return;
+    }
+
+  const TessellatedPath &tess(d->tessellation(path));
+  d->select_leaves(tess.filled()->painter_data_hierarchy(), true, 0.0f, 0.0f);
+  d->set_draw_bounds(tess.bounding_box_min(), tess.bounding_box_max(), 0.0f);
+  d->fill_path_leaves(shader, draw, fill_rule, call_back);
+  d->clear_draw_bounds();
 }
 
 void
@@ -1473,23 +2497,99 @@ fill_path(const PainterData &draw, const Path &path, const CustomFillRuleBase &f
   fill_path(default_shaders().fill_shader(), draw, path, fill_rule, call_back);
 }
 
+void
+fastuidraw::Painter::
+fill_path_analytic(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
+                   const Path &path, enum PainterEnums::fill_rule_t fill_rule,
+                   const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  if(d->path_is_pending(path))
+    {
+      return;
+    }
+
+  const TessellatedPath &tess(d->tessellation(path));
+  vec2 pmin, pmax;
+  float scale;
+
+  /* pad the bounding box by a pixel so that the
+     anti-aliasing of the boundary is not cut off.
+   */
+  scale = d->item_pixel_scale();
+  pmin = tess.bounding_box_min();
+  pmax = tess.bounding_box_max();
+  if(scale > 0.0f)
+    {
+      vec2 r(1.0f / scale, 1.0f / scale);
+      pmin -= r;
+      pmax += r;
+    }
+
+  if(!d->m_recording && d->box_is_culled(pmin, pmax, 0.0f))
+    {
+      return;
+    }
+
+  PainterAnalyticFillParams params;
+  PainterData data(draw);
+
+  params
+    .path(tess)
+    .fill_rule(fill_rule);
+  data.set(PainterData::value<PainterItemShaderData>(&params));
+
+  /* a path with too many segments cannot be packed,
+     triangulate it instead.
+   */
+  PainterPackerData packer_data(data);
+  packer_data.m_clip = d->current_clip_state();
+  packer_data.m_matrix = d->current_item_marix_state();
+  if(!d->m_core->fits_in_data_store(packer_data))
+    {
+      fill_path(default_shaders().fill_shader(), draw, path, fill_rule, call_back);
+      return;
+    }
+  draw_rect(shader, data, pmin, pmax - pmin, call_back);
+}
+
+void
+fastuidraw::Painter::
+fill_path_analytic(const PainterData &draw, const Path &path, enum PainterEnums::fill_rule_t fill_rule,
+                   const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  fill_path_analytic(default_shaders().analytic_fill_shader(), draw, path, fill_rule, call_back);
+}
+
 void
 fastuidraw::Painter::
 draw_glyphs(const PainterGlyphShader &shader, const PainterData &draw,
             const PainterAttributeData &data,
             const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
+  PainterPrivate *d;
+  bool culled;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  culled = d->data_is_culled(data, 0.0f, 0.0f);
+  d->set_draw_bounds(data, 0.0f, 0.0f);
+
   const_c_array<unsigned int> chks(data.non_empty_index_data_chunks());
   for(unsigned int i = 0; i < chks.size(); ++i)
     {
       unsigned int k;
 
       k = chks[i];
-      draw_generic(shader.shader(static_cast<enum glyph_type>(k)), draw,
-                   data.attribute_data_chunk(k), data.index_data_chunk(k),
-                   call_back);
+      if(!culled)
+        {
+          draw_generic(shader.shader(static_cast<enum glyph_type>(k)), draw,
+                       data.attribute_data_chunk(k), data.index_data_chunk(k),
+                       call_back);
+        }
       increment_z(data.increment_z_value(k));
     }
+  d->clear_draw_bounds();
 }
 
 void
@@ -1670,10 +2770,10 @@ restore(void)
   d->m_clip_rect_state = st.m_clip_rect_state;
   d->current_item_matrix_state(st.m_matrix);
   d->current_clip_state(st.m_clip);
-  d->m_core->blend_shader(st.m_blend, st.m_blend_mode);
+  d->blend_shader(st.m_blend, st.m_blend_mode);
   while(d->m_occluder_stack.size() > st.m_occluder_stack_position)
     {
-      d->m_occluder_stack.back().on_pop(this);
+      d->m_occluder_stack.back().on_pop(this, d);
       d->m_occluder_stack.pop_back();
     }
   d->m_state_stack.pop_back();
@@ -1702,6 +2802,11 @@ restore(void)
         - clipIn by path P
             1. clipIn by R, R = bounding box of P
             2. clipOut by R\P.
+
+        - with ConfigurationBase::stencil_clipping(), clipIn and clipOut
+          by a path are instead a level of the stencil buffer, see
+          PainterPrivate::stencil_clip_path(); popping draws one quad
+          to the stencil buffer instead of writing the occluder z-values.
 */
 
 void
@@ -1710,6 +2815,7 @@ clipOutPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
 {
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
+  assert(!d->m_recording);
 
   if(d->m_clip_rect_state.m_all_content_culled)
     {
@@ -1718,6 +2824,17 @@ clipOutPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
       return;
     }
 
+  /* clipping cannot be skipped, so wait for the tessellation
+     if it is being built by a PathTessellationPool.
+   */
+  path.tessellation();
+
+  if(d->use_stencil_clip())
+    {
+      d->stencil_clip_path(this, path, fill_rule, false);
+      return;
+    }
+
   reference_counted_ptr<PainterBlendShader> old_blend;
   BlendMode::packed_value old_blend_mode;
   reference_counted_ptr<ZDataCallBack> zdatacallback;
@@ -1744,6 +2861,7 @@ clipOutPath(const Path &path, const CustomFillRuleBase &fill_rule)
 {
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
+  assert(!d->m_recording);
 
   if(d->m_clip_rect_state.m_all_content_culled)
     {
@@ -1752,6 +2870,17 @@ clipOutPath(const Path &path, const CustomFillRuleBase &fill_rule)
       return;
     }
 
+  /* clipping cannot be skipped, so wait for the tessellation
+     if it is being built by a PathTessellationPool.
+   */
+  path.tessellation();
+
+  if(d->use_stencil_clip())
+    {
+      d->stencil_clip_path(this, path, fill_rule, false);
+      return;
+    }
+
   fastuidraw::reference_counted_ptr<PainterBlendShader> old_blend;
   BlendMode::packed_value old_blend_mode;
   reference_counted_ptr<ZDataCallBack> zdatacallback;
@@ -1778,6 +2907,7 @@ clipInPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
 {
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
+  assert(!d->m_recording);
 
   if(d->m_clip_rect_state.m_all_content_culled)
     {
@@ -1787,8 +2917,30 @@ clipInPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
     }
 
   vec2 pmin, pmax;
-  pmin = path.tessellation()->bounding_box_min();
-  pmax = path.tessellation()->bounding_box_max();
+  pmin = d->tessellation(path).bounding_box_min();
+  pmax = d->tessellation(path).bounding_box_max();
+
+  if(d->use_stencil_clip())
+    {
+      /* clipping to the bounding box only changes the clip
+         equations when the transformation is not tricky,
+         which helps culling; otherwise it would draw
+         occluders which the stencil clipping does not need.
+       */
+      if(!d->m_clip_rect_state.m_clip_rect.m_enabled
+         || !d->m_clip_rect_state.m_item_matrix_tricky)
+        {
+          clipInRect(pmin, pmax - pmin);
+          if(d->m_clip_rect_state.m_all_content_culled)
+            {
+              return;
+            }
+        }
+      path.tessellation();
+      d->stencil_clip_path(this, path, fill_rule, true);
+      return;
+    }
+
   clipInRect(pmin, pmax - pmin);
   clipOutPath(path, PainterEnums::complement_fill_rule(fill_rule));
 }
@@ -1799,6 +2951,7 @@ clipInPath(const Path &path, const CustomFillRuleBase &fill_rule)
 {
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
+  assert(!d->m_recording);
 
   if(d->m_clip_rect_state.m_all_content_culled)
     {
@@ -1808,8 +2961,30 @@ clipInPath(const Path &path, const CustomFillRuleBase &fill_rule)
     }
 
   vec2 pmin, pmax;
-  pmin = path.tessellation()->bounding_box_min();
-  pmax = path.tessellation()->bounding_box_max();
+  pmin = d->tessellation(path).bounding_box_min();
+  pmax = d->tessellation(path).bounding_box_max();
+
+  if(d->use_stencil_clip())
+    {
+      /* clipping to the bounding box only changes the clip
+         equations when the transformation is not tricky,
+         which helps culling; otherwise it would draw
+         occluders which the stencil clipping does not need.
+       */
+      if(!d->m_clip_rect_state.m_clip_rect.m_enabled
+         || !d->m_clip_rect_state.m_item_matrix_tricky)
+        {
+          clipInRect(pmin, pmax - pmin);
+          if(d->m_clip_rect_state.m_all_content_culled)
+            {
+              return;
+            }
+        }
+      path.tessellation();
+      d->stencil_clip_path(this, path, fill_rule, true);
+      return;
+    }
+
   clipInRect(pmin, pmax - pmin);
   clipOutPath(path, ComplementFillRule(&fill_rule));
 }
@@ -1820,6 +2995,7 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
 {
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
+  assert(!d->m_recording);
 
   d->m_clip_rect_state.m_all_content_culled =
     d->m_clip_rect_state.m_all_content_culled ||
@@ -1922,16 +3098,7 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
      We do this because round off error can have us
      miss a few pixels when drawing the occluder
    */
-  PainterClipEquations slightly_bigger(current_clip.value());
-  for(unsigned int i = 0; i < 4; ++i)
-    {
-      float f;
-      vec3 &eq(slightly_bigger.m_clip_equations[i]);
-
-      f = fastuidraw::t_abs(eq.x()) * d->m_one_pixel_width.x() + fastuidraw::t_abs(eq.y()) * d->m_one_pixel_width.y();
-      eq.z() += f;
-    }
-  d->set_current_clip(slightly_bigger);
+  d->set_current_clip(d->expanded_clip(current_clip.value()));
 
   /* draw the half plane occluders
    */
@@ -2006,7 +3173,7 @@ blend_shader(const fastuidraw::reference_counted_ptr<PainterBlendShader> &h,
 {
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
-  d->m_core->blend_shader(h, mode);
+  d->blend_shader(h, mode);
 }
 
 const fastuidraw::PainterShaderSet&
@@ -2018,6 +3185,78 @@ default_shaders(void) const
   return d->m_core->default_shaders();
 }
 
+void
+fastuidraw::Painter::
+curve_flatness(float v)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_curve_flatness = v;
+}
+
+float
+fastuidraw::Painter::
+curve_flatness(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_curve_flatness;
+}
+
+void
+fastuidraw::Painter::
+stroke_lod_distance(float v)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_stroke_lod_distance = v;
+}
+
+float
+fastuidraw::Painter::
+stroke_lod_distance(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_stroke_lod_distance;
+}
+
+void
+fastuidraw::Painter::
+stroke_lod_max_width(float v)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_stroke_lod_max_width = v;
+}
+
+float
+fastuidraw::Painter::
+stroke_lod_max_width(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_stroke_lod_max_width;
+}
+
+void
+fastuidraw::Painter::
+stroke_with_edge_segments(bool v)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_stroke_with_edge_segments = v;
+}
+
+bool
+fastuidraw::Painter::
+stroke_with_edge_segments(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_stroke_with_edge_segments;
+}
+
 unsigned int
 fastuidraw::Painter::
 current_z(void) const
@@ -2089,3 +3328,52 @@ register_shader(const PainterShaderSet &p)
   d = reinterpret_cast<PainterPrivate*>(m_d);
   d->m_core->register_shader(p);
 }
+
+///////////////////////////////////////
+// fastuidraw::PainterRecording methods
+fastuidraw::PainterRecording::
+PainterRecording(void)
+{
+  m_d = FASTUIDRAWnew PainterRecordingPrivate();
+}
+
+fastuidraw::PainterRecording::
+~PainterRecording()
+{
+  PainterRecordingPrivate *d;
+  d = reinterpret_cast<PainterRecordingPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+unsigned int
+fastuidraw::PainterRecording::
+number_draws(void) const
+{
+  PainterRecordingPrivate *d;
+  d = reinterpret_cast<PainterRecordingPrivate*>(m_d);
+  return (d->m_list) ? d->m_list->number_draws() : 0;
+}
+
+unsigned int
+fastuidraw::PainterRecording::
+z_range(void) const
+{
+  PainterRecordingPrivate *d;
+  d = reinterpret_cast<PainterRecordingPrivate*>(m_d);
+  return d->m_z_range;
+}
+
+void
+fastuidraw::PainterRecording::
+clear(void)
+{
+  PainterRecordingPrivate *d;
+  d = reinterpret_cast<PainterRecordingPrivate*>(m_d);
+  if(d->m_list)
+    {
+      d->m_list->clear();
+    }
+  d->m_matrices.clear();
+  d->m_z_range = 0;
+}
@@ -0,0 +1,525 @@
+/*!
+ * \file painter_analytic_fill_params.cpp
+ * \brief file painter_analytic_fill_params.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <cmath>
+#include <fastuidraw/painter/painter_analytic_fill_params.hpp>
+#include <fastuidraw/util/math.hpp>
+#include <fastuidraw/util/fastuidraw_memory.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  class segment
+  {
+  public:
+    segment(const fastuidraw::vec2 &s, const fastuidraw::vec2 &e):
+      m_start(s),
+      m_end(e)
+    {}
+
+    fastuidraw::vec2 m_start, m_end;
+  };
+
+  class PainterAnalyticFillParamsData:public fastuidraw::PainterShaderData::DataBase
+  {
+  public:
+    PainterAnalyticFillParamsData(void);
+
+    virtual
+    fastuidraw::PainterShaderData::DataBase*
+    copy(void) const;
+
+    virtual
+    unsigned int
+    data_size(unsigned int alignment) const;
+
+    virtual
+    void
+    pack_data(unsigned int alignment, fastuidraw::c_array<fastuidraw::generic_data> dst) const;
+
+    /* set m_number_bands, the band coordinates and
+       the lists of segments of the bands from m_segments.
+     */
+    void
+    compute_bands(void);
+
+    /* the horizontal band of a point, i.e. the band whose
+       segments may cross the ray in the x-direction
+     */
+    unsigned int
+    horizontal_band(const fastuidraw::vec2 &p) const;
+
+    /* the vertical band of a point, i.e. the band whose
+       segments may cross the ray in the y-direction
+     */
+    unsigned int
+    vertical_band(const fastuidraw::vec2 &p) const;
+
+    fastuidraw::const_c_array<unsigned int>
+    band_segments(unsigned int band) const;
+
+    enum fastuidraw::PainterEnums::fill_rule_t m_fill_rule;
+    std::vector<segment> m_segments;
+
+    /* the horizontal bands are the first m_number_bands
+       elements of m_bands, the vertical bands the next
+       m_number_bands; each is a range into m_band_segments
+       which holds indices into m_segments.
+     */
+    unsigned int m_number_bands;
+    float m_band_min_x, m_band_min_y;
+    float m_band_scale_x, m_band_scale_y;
+    std::vector<fastuidraw::range_type<unsigned int> > m_bands;
+    std::vector<unsigned int> m_band_segments;
+  };
+
+  /* Returns the band of a coordinate already mapped so that
+     each band has size 1, must match
+     fastuidraw_analytic_fill_band() of
+     fastuidraw_painter_analytic_fill.frag.glsl.resource_string
+   */
+  unsigned int
+  band_of(float f, unsigned int number_bands)
+  {
+    if(!(f > 0.0f))
+      {
+        return 0;
+      }
+    return static_cast<unsigned int>(fastuidraw::t_min(f, static_cast<float>(number_bands - 1)));
+  }
+
+  /* Adds the segment to the bands [band_of(f0), band_of(f1)];
+     the range is widened by a small fraction of a band so that
+     the rounding of the shader in computing the band of a pixel
+     does not lose a segment that crosses the pixel's ray. When
+     count_only is true, only the number of segments of each band
+     is incremented.
+   */
+  void
+  add_to_bands(float f0, float f1, unsigned int number_bands, unsigned int first_band,
+               unsigned int segment_id, bool count_only,
+               std::vector<fastuidraw::range_type<unsigned int> > &bands,
+               std::vector<unsigned int> &band_segments)
+  {
+    const float slack(1.0f / 256.0f);
+    unsigned int b0, b1;
+
+    b0 = band_of(fastuidraw::t_min(f0, f1) - slack, number_bands);
+    b1 = band_of(fastuidraw::t_max(f0, f1) + slack, number_bands);
+    for(unsigned int b = first_band + b0, endb = first_band + b1; b <= endb; ++b)
+      {
+        if(count_only)
+          {
+            ++bands[b].m_end;
+          }
+        else
+          {
+            band_segments[bands[b].m_end++] = segment_id;
+          }
+      }
+  }
+
+  /* Returns the contribution of a segment crossing a ray at
+     the given (signed) distance along the ray measured in
+     pixels, i.e. 1 if the crossing is at least half a pixel
+     ahead, 0 if it is at least half a pixel behind and a
+     linear ramp between.
+   */
+  float
+  crossing_coverage(float pixel_distance)
+  {
+    return fastuidraw::t_min(1.0f, fastuidraw::t_max(0.0f, 0.5f + pixel_distance));
+  }
+
+  /* Returns how much the coverage along a ray is to be
+     trusted from a crossing at the given distance in pixels,
+     i.e. 1 when the crossing is at the point going down to 0
+     when the crossing is half a pixel away.
+   */
+  float
+  crossing_weight(float pixel_distance)
+  {
+    return fastuidraw::t_max(0.0f, 1.0f - 2.0f * fastuidraw::t_abs(pixel_distance));
+  }
+
+  float
+  apply_fill_rule(float w, enum fastuidraw::PainterEnums::fill_rule_t fill_rule)
+  {
+    using namespace fastuidraw;
+
+    float c;
+
+    w = t_abs(w);
+    switch(fill_rule)
+      {
+      case PainterEnums::odd_even_fill_rule:
+      case PainterEnums::complement_odd_even_fill_rule:
+        c = 1.0f - t_abs(1.0f - std::fmod(w, 2.0f));
+        break;
+
+      default:
+        c = t_min(w, 1.0f);
+      }
+
+    if(fill_rule == PainterEnums::complement_odd_even_fill_rule
+       || fill_rule == PainterEnums::complement_nonzero_fill_rule)
+      {
+        c = 1.0f - c;
+      }
+    return c;
+  }
+}
+
+//////////////////////////////////////
+// PainterAnalyticFillParamsData methods
+PainterAnalyticFillParamsData::
+PainterAnalyticFillParamsData(void):
+  m_fill_rule(fastuidraw::PainterEnums::nonzero_fill_rule)
+{
+  compute_bands();
+}
+
+fastuidraw::PainterShaderData::DataBase*
+PainterAnalyticFillParamsData::
+copy(void) const
+{
+  return FASTUIDRAWnew PainterAnalyticFillParamsData(*this);
+}
+
+unsigned int
+PainterAnalyticFillParamsData::
+data_size(unsigned int alignment) const
+{
+  using namespace fastuidraw;
+  return round_up_to_multiple(PainterAnalyticFillParams::analytic_fill_static_data_size, alignment)
+    + m_bands.size() * round_up_to_multiple(PainterAnalyticFillParams::analytic_fill_band_size, alignment)
+    + m_band_segments.size() * round_up_to_multiple(PainterAnalyticFillParams::analytic_fill_segment_size, alignment);
+}
+
+void
+PainterAnalyticFillParamsData::
+pack_data(unsigned int alignment, fastuidraw::c_array<fastuidraw::generic_data> dst) const
+{
+  using namespace fastuidraw;
+
+  unsigned int header_size, band_stride, segment_stride, segments_offset;
+  c_array<generic_data> dst_bands, dst_segments;
+
+  dst[PainterAnalyticFillParams::analytic_fill_number_segments_offset].u = m_segments.size();
+  dst[PainterAnalyticFillParams::analytic_fill_fill_rule_offset].u = m_fill_rule;
+  dst[PainterAnalyticFillParams::analytic_fill_number_bands_offset].u = m_number_bands;
+  dst[PainterAnalyticFillParams::analytic_fill_band_min_x_offset].f = m_band_min_x;
+  dst[PainterAnalyticFillParams::analytic_fill_band_min_y_offset].f = m_band_min_y;
+  dst[PainterAnalyticFillParams::analytic_fill_band_scale_x_offset].f = m_band_scale_x;
+  dst[PainterAnalyticFillParams::analytic_fill_band_scale_y_offset].f = m_band_scale_y;
+
+  header_size = round_up_to_multiple(PainterAnalyticFillParams::analytic_fill_static_data_size, alignment);
+  band_stride = round_up_to_multiple(PainterAnalyticFillParams::analytic_fill_band_size, alignment);
+  segment_stride = round_up_to_multiple(PainterAnalyticFillParams::analytic_fill_segment_size, alignment);
+  segments_offset = header_size + m_bands.size() * band_stride;
+
+  /* the band table gives the location of the segments
+     of each band in blocks from the start of the data
+   */
+  dst_bands = dst.sub_array(header_size);
+  for(unsigned int b = 0, j = 0, endb = m_bands.size(); b < endb; ++b, j += band_stride)
+    {
+      dst_bands[j + 0].u = (segments_offset + m_bands[b].m_begin * segment_stride) / alignment;
+      dst_bands[j + 1].u = m_bands[b].difference();
+    }
+
+  dst_segments = dst.sub_array(segments_offset);
+  for(unsigned int i = 0, j = 0, endi = m_band_segments.size(); i < endi; ++i, j += segment_stride)
+    {
+      const segment &S(m_segments[m_band_segments[i]]);
+      dst_segments[j + 0].f = S.m_start.x();
+      dst_segments[j + 1].f = S.m_start.y();
+      dst_segments[j + 2].f = S.m_end.x();
+      dst_segments[j + 3].f = S.m_end.y();
+    }
+}
+
+void
+PainterAnalyticFillParamsData::
+compute_bands(void)
+{
+  using namespace fastuidraw;
+
+  float max_x, max_y;
+
+  /* the number of segments of a band goes as the square
+     root of the number of segments when the segments are
+     spread out evenly.
+   */
+  m_number_bands = static_cast<unsigned int>(std::sqrt(static_cast<float>(m_segments.size())));
+  m_number_bands = t_min(t_max(m_number_bands, 1u),
+                         static_cast<unsigned int>(PainterAnalyticFillParams::analytic_fill_max_number_bands));
+
+  m_band_min_x = m_band_min_y = 0.0f;
+  max_x = max_y = 0.0f;
+  for(unsigned int i = 0, endi = m_segments.size(); i < endi; ++i)
+    {
+      const segment &S(m_segments[i]);
+      if(i == 0)
+        {
+          m_band_min_x = max_x = S.m_start.x();
+          m_band_min_y = max_y = S.m_start.y();
+        }
+      m_band_min_x = t_min(m_band_min_x, t_min(S.m_start.x(), S.m_end.x()));
+      m_band_min_y = t_min(m_band_min_y, t_min(S.m_start.y(), S.m_end.y()));
+      max_x = t_max(max_x, t_max(S.m_start.x(), S.m_end.x()));
+      max_y = t_max(max_y, t_max(S.m_start.y(), S.m_end.y()));
+    }
+  m_band_scale_x = (max_x > m_band_min_x) ? static_cast<float>(m_number_bands) / (max_x - m_band_min_x) : 0.0f;
+  m_band_scale_y = (max_y > m_band_min_y) ? static_cast<float>(m_number_bands) / (max_y - m_band_min_y) : 0.0f;
+
+  /* first pass counts the segments of each band, second
+     pass fills the lists. A segment parallel to a ray never
+     crosses it and is not added to the bands of that ray.
+   */
+  m_bands.clear();
+  m_bands.resize(2 * m_number_bands, range_type<unsigned int>(0, 0));
+  m_band_segments.clear();
+  for(int pass = 0; pass < 2; ++pass)
+    {
+      for(unsigned int i = 0, endi = m_segments.size(); i < endi; ++i)
+        {
+          const segment &S(m_segments[i]);
+          if(S.m_start.y() != S.m_end.y())
+            {
+              add_to_bands((S.m_start.y() - m_band_min_y) * m_band_scale_y,
+                           (S.m_end.y() - m_band_min_y) * m_band_scale_y,
+                           m_number_bands, 0, i, pass == 0, m_bands, m_band_segments);
+            }
+          if(S.m_start.x() != S.m_end.x())
+            {
+              add_to_bands((S.m_start.x() - m_band_min_x) * m_band_scale_x,
+                           (S.m_end.x() - m_band_min_x) * m_band_scale_x,
+                           m_number_bands, m_number_bands, i, pass == 0, m_bands, m_band_segments);
+            }
+        }
+
+      if(pass == 0)
+        {
+          unsigned int total(0);
+          for(unsigned int b = 0, endb = m_bands.size(); b < endb; ++b)
+            {
+              unsigned int sz(m_bands[b].m_end);
+              m_bands[b].m_begin = m_bands[b].m_end = total;
+              total += sz;
+            }
+          m_band_segments.resize(total);
+        }
+    }
+}
+
+unsigned int
+PainterAnalyticFillParamsData::
+horizontal_band(const fastuidraw::vec2 &p) const
+{
+  return band_of((p.y() - m_band_min_y) * m_band_scale_y, m_number_bands);
+}
+
+unsigned int
+PainterAnalyticFillParamsData::
+vertical_band(const fastuidraw::vec2 &p) const
+{
+  return m_number_bands + band_of((p.x() - m_band_min_x) * m_band_scale_x, m_number_bands);
+}
+
+fastuidraw::const_c_array<unsigned int>
+PainterAnalyticFillParamsData::
+band_segments(unsigned int band) const
+{
+  fastuidraw::const_c_array<unsigned int> R;
+
+  R = fastuidraw::make_c_array(m_band_segments);
+  return R.sub_array(m_bands[band].m_begin, m_bands[band].difference());
+}
+
+///////////////////////////////////
+// fastuidraw::PainterAnalyticFillParams methods
+fastuidraw::PainterAnalyticFillParams::
+PainterAnalyticFillParams(void)
+{
+  m_data = FASTUIDRAWnew PainterAnalyticFillParamsData();
+}
+
+fastuidraw::PainterAnalyticFillParams&
+fastuidraw::PainterAnalyticFillParams::
+path(const TessellatedPath &P)
+{
+  PainterAnalyticFillParamsData *d;
+  assert(dynamic_cast<PainterAnalyticFillParamsData*>(m_data) != NULL);
+  d = static_cast<PainterAnalyticFillParamsData*>(m_data);
+
+  d->m_segments.clear();
+  d->m_segments.reserve(P.point_data().size());
+  for(unsigned int c = 0, endc = P.number_contours(); c < endc; ++c)
+    {
+      const_c_array<TessellatedPath::point> pts(P.contour_point_data(c));
+      if(pts.empty())
+        {
+          continue;
+        }
+
+      /* the points shared between edges are replicated,
+         so skip the segments of length zero.
+       */
+      for(unsigned int i = 1, endi = pts.size(); i < endi; ++i)
+        {
+          if(pts[i - 1].m_p != pts[i].m_p)
+            {
+              d->m_segments.push_back(segment(pts[i - 1].m_p, pts[i].m_p));
+            }
+        }
+
+      if(pts.back().m_p != pts.front().m_p)
+        {
+          d->m_segments.push_back(segment(pts.back().m_p, pts.front().m_p));
+        }
+    }
+  d->compute_bands();
+  return *this;
+}
+
+unsigned int
+fastuidraw::PainterAnalyticFillParams::
+number_segments(void) const
+{
+  PainterAnalyticFillParamsData *d;
+  assert(dynamic_cast<PainterAnalyticFillParamsData*>(m_data) != NULL);
+  d = static_cast<PainterAnalyticFillParamsData*>(m_data);
+  return d->m_segments.size();
+}
+
+unsigned int
+fastuidraw::PainterAnalyticFillParams::
+number_bands(void) const
+{
+  PainterAnalyticFillParamsData *d;
+  assert(dynamic_cast<PainterAnalyticFillParamsData*>(m_data) != NULL);
+  d = static_cast<PainterAnalyticFillParamsData*>(m_data);
+  return d->m_number_bands;
+}
+
+enum fastuidraw::PainterEnums::fill_rule_t
+fastuidraw::PainterAnalyticFillParams::
+fill_rule(void) const
+{
+  PainterAnalyticFillParamsData *d;
+  assert(dynamic_cast<PainterAnalyticFillParamsData*>(m_data) != NULL);
+  d = static_cast<PainterAnalyticFillParamsData*>(m_data);
+  return d->m_fill_rule;
+}
+
+fastuidraw::PainterAnalyticFillParams&
+fastuidraw::PainterAnalyticFillParams::
+fill_rule(enum PainterEnums::fill_rule_t f)
+{
+  PainterAnalyticFillParamsData *d;
+  assert(dynamic_cast<PainterAnalyticFillParamsData*>(m_data) != NULL);
+  d = static_cast<PainterAnalyticFillParamsData*>(m_data);
+  d->m_fill_rule = f;
+  return *this;
+}
+
+int
+fastuidraw::PainterAnalyticFillParams::
+winding_number(const vec2 &p) const
+{
+  PainterAnalyticFillParamsData *d;
+  const_c_array<unsigned int> band;
+  int w(0);
+
+  assert(dynamic_cast<PainterAnalyticFillParamsData*>(m_data) != NULL);
+  d = static_cast<PainterAnalyticFillParamsData*>(m_data);
+  band = d->band_segments(d->horizontal_band(p));
+  for(unsigned int i = 0; i < band.size(); ++i)
+    {
+      const vec2 &a(d->m_segments[band[i]].m_start), &b(d->m_segments[band[i]].m_end);
+      if(t_min(a.y(), b.y()) <= p.y() && p.y() < t_max(a.y(), b.y()))
+        {
+          float x;
+          x = a.x() + (p.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+          if(x > p.x())
+            {
+              w += (b.y() > a.y()) ? 1 : -1;
+            }
+        }
+    }
+  return w;
+}
+
+float
+fastuidraw::PainterAnalyticFillParams::
+compute_coverage(const vec2 &p, const vec2 &pixels_per_unit) const
+{
+  PainterAnalyticFillParamsData *d;
+  const_c_array<unsigned int> band;
+  float wx(0.0f), wy(0.0f), weight_x(0.0f), weight_y(0.0f);
+  float cx, cy;
+
+  assert(dynamic_cast<PainterAnalyticFillParamsData*>(m_data) != NULL);
+  d = static_cast<PainterAnalyticFillParamsData*>(m_data);
+
+  /* must match the computation in
+     fastuidraw_painter_analytic_fill.frag.glsl.resource_string
+   */
+  band = d->band_segments(d->horizontal_band(p));
+  for(unsigned int i = 0; i < band.size(); ++i)
+    {
+      const vec2 &a(d->m_segments[band[i]].m_start), &b(d->m_segments[band[i]].m_end);
+
+      if(t_min(a.y(), b.y()) <= p.y() && p.y() < t_max(a.y(), b.y()))
+        {
+          float x;
+          x = (a.x() + (p.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y()) - p.x()) * pixels_per_unit.x();
+          wx += ((b.y() > a.y()) ? 1.0f : -1.0f) * crossing_coverage(x);
+          weight_x = t_max(weight_x, crossing_weight(x));
+        }
+    }
+
+  band = d->band_segments(d->vertical_band(p));
+  for(unsigned int i = 0; i < band.size(); ++i)
+    {
+      const vec2 &a(d->m_segments[band[i]].m_start), &b(d->m_segments[band[i]].m_end);
+
+      if(t_min(a.x(), b.x()) <= p.x() && p.x() < t_max(a.x(), b.x()))
+        {
+          float y;
+          y = (a.y() + (p.x() - a.x()) * (b.y() - a.y()) / (b.x() - a.x()) - p.y()) * pixels_per_unit.y();
+          wy += ((b.x() < a.x()) ? 1.0f : -1.0f) * crossing_coverage(y);
+          weight_y = t_max(weight_y, crossing_weight(y));
+        }
+    }
+
+  cx = apply_fill_rule(wx, d->m_fill_rule);
+  cy = apply_fill_rule(wy, d->m_fill_rule);
+
+  /* a ray that has no crossing near the point gives a
+     coverage of 0 or 1 at the boundary, so the rays are
+     weighted by how near their nearest crossing is.
+   */
+  if(weight_x + weight_y > 0.0f)
+    {
+      return (cx * weight_x + cy * weight_y) / (weight_x + weight_y);
+    }
+  return 0.5f * (cx + cy);
+}
@@ -24,6 +24,42 @@
 
 namespace
 {
+  class BoundingBox
+  {
+  public:
+    BoundingBox(void):
+      m_empty(true),
+      m_min(0.0f, 0.0f),
+      m_max(0.0f, 0.0f)
+    {}
+
+    void
+    clear(void)
+    {
+      m_empty = true;
+    }
+
+    void
+    union_point(const fastuidraw::vec2 &p)
+    {
+      if(m_empty)
+        {
+          m_empty = false;
+          m_min = m_max = p;
+        }
+      else
+        {
+          m_min.x() = fastuidraw::t_min(m_min.x(), p.x());
+          m_min.y() = fastuidraw::t_min(m_min.y(), p.y());
+          m_max.x() = fastuidraw::t_max(m_max.x(), p.x());
+          m_max.y() = fastuidraw::t_max(m_max.y(), p.y());
+        }
+    }
+
+    bool m_empty;
+    fastuidraw::vec2 m_min, m_max;
+  };
+
   inline
   uint32_t
   filter_atlas_layer(int layer)
@@ -49,7 +85,8 @@ namespace
   void
   pack_glyph_attributes(enum fastuidraw::PainterEnums::glyph_orientation orientation,
                         fastuidraw::vec2 p, fastuidraw::Glyph glyph, float SCALE,
-                        fastuidraw::c_array<fastuidraw::PainterAttribute> dst)
+                        fastuidraw::c_array<fastuidraw::PainterAttribute> dst,
+                        BoundingBox &bbox)
   {
     assert(glyph.valid());
 
@@ -84,6 +121,8 @@ namespace
         p_bl = p + SCALE * glyph.layout().m_horizontal_layout_offset;
         p_tr = p_bl + glyph_size;
       }
+    bbox.union_point(p_bl);
+    bbox.union_point(p_tr);
 
     /* secondary_atlas.layer() can be -1 to indicate that
        the glyph does not have secondary atlas, when changed
@@ -176,39 +215,50 @@ namespace
     return dst;
   }
 
-  void
-  grab_attribute_index_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attrib_dst,
-                            unsigned int &attr_loc,
-                            fastuidraw::const_c_array<fastuidraw::StrokedPath::point> attr_src,
-                            fastuidraw::c_array<fastuidraw::PainterIndex> idx_dst, unsigned int &idx_loc,
-                            fastuidraw::const_c_array<unsigned int> idx_src,
-                            fastuidraw::const_c_array<fastuidraw::PainterAttribute> &attrib_chunks,
-                            fastuidraw::const_c_array<fastuidraw::PainterIndex> &index_chunks)
-  {
-    attrib_dst = attrib_dst.sub_array(attr_loc, attr_src.size());
-    idx_dst = idx_dst.sub_array(idx_loc, idx_src.size());
-
-    attrib_chunks = attrib_dst;
-    index_chunks = idx_dst;
-
-    std::copy(idx_src.begin(), idx_src.end(), idx_dst.begin());
-    std::transform(attr_src.begin(), attr_src.end(), attrib_dst.begin(), generate_attribute_stroke);
-
-    attr_loc += attr_src.size();
-    idx_loc += idx_src.size();
-  }
-
   class PainterAttributeDataPrivate
   {
   public:
     enum { number_join_types = 3 };
 
+    PainterAttributeDataPrivate(void):
+      m_stroked_path(NULL),
+      m_point_set_ready(false)
+    {}
+
     unsigned int
     prepare_arrays_for_text(fastuidraw::const_c_array<fastuidraw::Glyph> glyphs);
 
     void
     ready_non_empty_index_data_chunks(void);
 
+    void
+    set_stroked_path(const fastuidraw::StrokedPath *path);
+
+    void
+    release_stroked_path(void);
+
+    /* make the chunks of the point set of the
+       StrokedPath from which the named chunk comes.
+     */
+    void
+    ready_chunk(unsigned int chunk);
+
+    void
+    ready_all_chunks(void);
+
+    void
+    ready_point_set(enum fastuidraw::StrokedPath::point_set_t tp);
+
+    static
+    enum fastuidraw::StrokedPath::point_set_t
+    point_set_from_chunk(unsigned int chunk);
+
+    void
+    grab_join(enum fastuidraw::StrokedPath::point_set_t tp,
+              enum fastuidraw::PainterAttributeData::stroking_data_t closing_edge,
+              unsigned int C, unsigned int J, unsigned int gJ,
+              unsigned int &idx_loc);
+
     std::vector<fastuidraw::PainterAttribute> m_attribute_data;
     std::vector<fastuidraw::PainterIndex> m_index_data;
 
@@ -216,9 +266,29 @@ namespace
     std::vector<fastuidraw::const_c_array<fastuidraw::PainterIndex> > m_index_chunks;
     std::vector<unsigned int> m_increment_z;
     std::vector<unsigned int> m_non_empty_index_data_chunks;
+
+    /* bounding box of the positions of the attribute data
+     */
+    BoundingBox m_bounding_box;
+
+    /* non-NULL if the data is set from a StrokedPath, in which
+       case the chunks of each point set of the StrokedPath are
+       made on first request and are backed by the arrays of
+       that point set.
+     */
+    const fastuidraw::StrokedPath *m_stroked_path;
+    fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> m_stroked_path_handle;
+    fastuidraw::vecN<bool, fastuidraw::StrokedPath::number_point_set_types> m_point_set_ready;
+    fastuidraw::vecN<std::vector<fastuidraw::PainterAttribute>,
+                     fastuidraw::StrokedPath::number_point_set_types> m_point_set_attribute_data;
+    fastuidraw::vecN<std::vector<fastuidraw::PainterIndex>,
+                     fastuidraw::StrokedPath::number_point_set_types> m_point_set_index_data;
   };
 }
 
+//////////////////////////////////////////
+// PainterAttributeDataPrivate methods
+
 void
 PainterAttributeDataPrivate::
 ready_non_empty_index_data_chunks(void)
@@ -233,6 +303,321 @@ ready_non_empty_index_data_chunks(void)
     }
 }
 
+void
+PainterAttributeDataPrivate::
+set_stroked_path(const fastuidraw::StrokedPath *path)
+{
+  using namespace fastuidraw;
+
+  unsigned int num_chunks(PainterAttributeData::stroking_data_count + 1);
+
+  release_stroked_path();
+  m_stroked_path = path;
+  m_attribute_data.clear();
+  m_index_data.clear();
+
+  for(unsigned int C = 0, endC = path->number_contours(); C < endC; ++C)
+    {
+      num_chunks += number_join_types * path->number_joins(C);
+    }
+  m_attribute_chunks.clear();
+  m_index_chunks.clear();
+  m_attribute_chunks.resize(num_chunks);
+  m_index_chunks.resize(num_chunks);
+  m_increment_z.clear();
+  m_increment_z.resize(PainterAttributeData::stroking_data_count, 0);
+  m_non_empty_index_data_chunks.clear();
+
+  /* the bounding box is of the points of the path; the
+     offsets added by stroking are not known until the
+     stroking width is known.
+   */
+  m_bounding_box.clear();
+  if(path->number_contours() > 0)
+    {
+      m_bounding_box.union_point(path->bounding_box_min());
+      m_bounding_box.union_point(path->bounding_box_max());
+    }
+}
+
+void
+PainterAttributeDataPrivate::
+release_stroked_path(void)
+{
+  if(m_stroked_path == NULL)
+    {
+      return;
+    }
+
+  m_stroked_path = NULL;
+  m_stroked_path_handle = fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath>();
+  for(unsigned int i = 0; i < fastuidraw::StrokedPath::number_point_set_types; ++i)
+    {
+      m_point_set_ready[i] = false;
+      std::vector<fastuidraw::PainterAttribute>().swap(m_point_set_attribute_data[i]);
+      std::vector<fastuidraw::PainterIndex>().swap(m_point_set_index_data[i]);
+    }
+  m_attribute_chunks.clear();
+  m_index_chunks.clear();
+  m_increment_z.clear();
+  m_non_empty_index_data_chunks.clear();
+}
+
+enum fastuidraw::StrokedPath::point_set_t
+PainterAttributeDataPrivate::
+point_set_from_chunk(unsigned int chunk)
+{
+  using namespace fastuidraw;
+
+  switch(chunk)
+    {
+    case PainterAttributeData::rounded_joins_closing_edge:
+    case PainterAttributeData::rounded_joins_no_closing_edge:
+      return StrokedPath::rounded_join_point_set;
+
+    case PainterAttributeData::bevel_joins_closing_edge:
+    case PainterAttributeData::bevel_joins_no_closing_edge:
+      return StrokedPath::bevel_join_point_set;
+
+    case PainterAttributeData::miter_joins_closing_edge:
+    case PainterAttributeData::miter_joins_no_closing_edge:
+      return StrokedPath::miter_join_point_set;
+
+    case PainterAttributeData::edge_closing_edge:
+    case PainterAttributeData::edge_no_closing_edge:
+      return StrokedPath::edge_point_set;
+
+    case PainterAttributeData::edge_segment_closing_edge:
+    case PainterAttributeData::edge_segment_no_closing_edge:
+      return StrokedPath::edge_segment_point_set;
+
+    case PainterAttributeData::rounded_cap:
+      return StrokedPath::rounded_cap_point_set;
+
+    case PainterAttributeData::square_cap:
+      return StrokedPath::square_cap_point_set;
+
+    case PainterAttributeData::stroking_data_count:
+      return StrokedPath::number_point_set_types;
+
+    default:
+      /* a chunk of a single join, see
+         PainterAttributeData::chunk_from_join()
+       */
+      {
+        const enum StrokedPath::point_set_t join_point_sets[number_join_types] =
+          {
+            StrokedPath::rounded_join_point_set,
+            StrokedPath::bevel_join_point_set,
+            StrokedPath::miter_join_point_set,
+          };
+        return join_point_sets[(chunk - PainterAttributeData::stroking_data_count - 1) % number_join_types];
+      }
+    }
+}
+
+void
+PainterAttributeDataPrivate::
+ready_chunk(unsigned int chunk)
+{
+  if(m_stroked_path != NULL && chunk < m_index_chunks.size())
+    {
+      enum fastuidraw::StrokedPath::point_set_t tp;
+
+      tp = point_set_from_chunk(chunk);
+      if(tp < fastuidraw::StrokedPath::number_point_set_types)
+        {
+          ready_point_set(tp);
+        }
+    }
+}
+
+void
+PainterAttributeDataPrivate::
+ready_all_chunks(void)
+{
+  if(m_stroked_path != NULL)
+    {
+      for(unsigned int i = 0; i < fastuidraw::StrokedPath::number_point_set_types; ++i)
+        {
+          ready_point_set(static_cast<enum fastuidraw::StrokedPath::point_set_t>(i));
+        }
+    }
+}
+
+void
+PainterAttributeDataPrivate::
+ready_point_set(enum fastuidraw::StrokedPath::point_set_t tp)
+{
+  using namespace fastuidraw;
+
+  if(m_point_set_ready[tp])
+    {
+      return;
+    }
+  m_point_set_ready[tp] = true;
+
+  /* the cap join points are not made into chunks
+   */
+  if(tp == StrokedPath::cap_join_point_set)
+    {
+      return;
+    }
+
+  const StrokedPath *path(m_stroked_path);
+  std::vector<PainterAttribute> &attribs(m_point_set_attribute_data[tp]);
+  std::vector<PainterIndex> &indices(m_point_set_index_data[tp]);
+  const_c_array<StrokedPath::point> src_pts(path->points(tp, true));
+  const_c_array<unsigned int> src_indices(path->indices(tp, true));
+  enum PainterAttributeData::stroking_data_t closing_edge, no_closing_edge;
+  unsigned int num_indices(src_indices.size());
+  bool is_join;
+
+  switch(tp)
+    {
+    case StrokedPath::rounded_join_point_set:
+      closing_edge = PainterAttributeData::rounded_joins_closing_edge;
+      is_join = true;
+      break;
+
+    case StrokedPath::bevel_join_point_set:
+      closing_edge = PainterAttributeData::bevel_joins_closing_edge;
+      is_join = true;
+      break;
+
+    case StrokedPath::miter_join_point_set:
+      closing_edge = PainterAttributeData::miter_joins_closing_edge;
+      is_join = true;
+      break;
+
+    case StrokedPath::edge_point_set:
+      closing_edge = PainterAttributeData::edge_closing_edge;
+      is_join = false;
+      break;
+
+    case StrokedPath::edge_segment_point_set:
+      closing_edge = PainterAttributeData::edge_segment_closing_edge;
+      is_join = false;
+      break;
+
+    case StrokedPath::rounded_cap_point_set:
+      closing_edge = PainterAttributeData::rounded_cap;
+      is_join = false;
+      break;
+
+    case StrokedPath::square_cap_point_set:
+      closing_edge = PainterAttributeData::square_cap;
+      is_join = false;
+      break;
+
+    default:
+      assert(!"Point set has no chunks");
+      return;
+    }
+  no_closing_edge = PainterAttributeData::without_closing_edge(closing_edge);
+
+  if(is_join)
+    {
+      /* indices for joins appear twice, once all together
+         and then again as seperate chunks.
+       */
+      for(unsigned int C = 0, endC = path->number_contours(); C < endC; ++C)
+        {
+          for(unsigned int J = 0, endJ = path->number_joins(C); J < endJ; ++J)
+            {
+              num_indices += path->indices_range(tp, C, J).difference();
+            }
+        }
+    }
+
+  attribs.resize(src_pts.size());
+  std::transform(src_pts.begin(), src_pts.end(), attribs.begin(), generate_attribute_stroke);
+  indices.resize(num_indices);
+  std::copy(src_indices.begin(), src_indices.end(), indices.begin());
+
+  m_attribute_chunks[closing_edge] = make_c_array(attribs);
+  m_index_chunks[closing_edge] = make_c_array(indices).sub_array(0, src_indices.size());
+  m_increment_z[closing_edge] = path->number_depth(tp, true);
+  if(no_closing_edge != closing_edge)
+    {
+      unsigned int with, without;
+
+      /* the data without the closing edge shares the backing
+         store: the attributes of the closing edge are at the
+         end and its indices are at the start.
+       */
+      with = src_indices.size();
+      without = path->indices(tp, false).size();
+      assert(with >= without);
+
+      m_attribute_chunks[no_closing_edge] =
+        m_attribute_chunks[closing_edge].sub_array(0, path->points(tp, false).size());
+      m_index_chunks[no_closing_edge] = m_index_chunks[closing_edge].sub_array(with - without);
+      m_increment_z[no_closing_edge] = path->number_depth(tp, false);
+    }
+
+  if(is_join)
+    {
+      unsigned int idx_loc(src_indices.size()), gJ(0);
+
+      /* the last two joins of each contour are grabbed last,
+         this is to make sure that the joins for the closing
+         edge are always at the end of our join list.
+       */
+      for(unsigned int C = 0, endC = path->number_contours(); C < endC; ++C)
+        {
+          for(unsigned int J = 0, endJ = path->number_joins(C); J + 2 < endJ; ++J, ++gJ)
+            {
+              grab_join(tp, closing_edge, C, J, gJ, idx_loc);
+            }
+        }
+
+      for(unsigned int C = 0, endC = path->number_contours(); C < endC; ++C)
+        {
+          unsigned int endJ(path->number_joins(C));
+          if(endJ >= 2)
+            {
+              grab_join(tp, closing_edge, C, endJ - 1, gJ, idx_loc);
+              ++gJ;
+              grab_join(tp, closing_edge, C, endJ - 2, gJ, idx_loc);
+              ++gJ;
+            }
+        }
+      assert(idx_loc == indices.size());
+    }
+
+  ready_non_empty_index_data_chunks();
+}
+
+void
+PainterAttributeDataPrivate::
+grab_join(enum fastuidraw::StrokedPath::point_set_t tp,
+          enum fastuidraw::PainterAttributeData::stroking_data_t closing_edge,
+          unsigned int C, unsigned int J, unsigned int gJ,
+          unsigned int &idx_loc)
+{
+  using namespace fastuidraw;
+
+  unsigned int K;
+  range_type<unsigned int> Ri, Ra;
+  const_c_array<unsigned int> src;
+  c_array<PainterIndex> dst;
+
+  Ra = m_stroked_path->points_range(tp, C, J);
+  Ri = m_stroked_path->indices_range(tp, C, J);
+  src = m_stroked_path->indices(tp, true).sub_array(Ri);
+  dst = make_c_array(m_point_set_index_data[tp]).sub_array(idx_loc, src.size());
+
+  K = PainterAttributeData::chunk_from_join(closing_edge, gJ);
+  m_attribute_chunks[K] = m_attribute_chunks[closing_edge].sub_array(Ra);
+  m_index_chunks[K] = dst;
+  for(unsigned int I = 0; I < src.size(); ++I)
+    {
+      dst[I] = src[I] - Ra.m_begin;
+    }
+  idx_loc += src.size();
+}
+
 unsigned int
 PainterAttributeDataPrivate::
 prepare_arrays_for_text(fastuidraw::const_c_array<fastuidraw::Glyph> glyphs)
@@ -240,8 +625,10 @@ prepare_arrays_for_text(fastuidraw::const_c_array<fastuidraw::Glyph> glyphs)
   unsigned int cnt, num_glyph_types;
   std::vector<unsigned int> cnt_by_type;
 
+  release_stroked_path();
   cnt = number_uploadable(glyphs, cnt_by_type);
   num_glyph_types = cnt_by_type.size();
+  m_bounding_box.clear();
 
   m_attribute_data.resize(4 * cnt);
   m_index_data.resize(6 * cnt);
@@ -321,6 +708,8 @@ set_data(const reference_counted_ptr<const FilledPath> &path)
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
   const_c_array<int> winding_numbers(path->winding_numbers());
 
+  d->release_stroked_path();
+  d->m_bounding_box.clear();
   if(winding_numbers.empty())
     {
       d->m_attribute_data.clear();
@@ -333,6 +722,11 @@ set_data(const reference_counted_ptr<const FilledPath> &path)
 
   d->m_attribute_data.resize(path->points().size());
   std::transform(path->points().begin(), path->points().end(), d->m_attribute_data.begin(), generate_attribute_fill);
+  for(const_c_array<vec2>::iterator iter = path->points().begin(),
+        end = path->points().end(); iter != end; ++iter)
+    {
+      d->m_bounding_box.union_point(*iter);
+    }
 
   /* winding_numbers is already sorted, so largest and smallest
      winding numbers are at back and front
@@ -423,157 +817,17 @@ set_data(const reference_counted_ptr<const StrokedPath> &path)
   PainterAttributeDataPrivate *d;
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
 
-  unsigned int num_attributes(0), num_indices(0);
-  unsigned int attr_loc(0), idx_loc(0);
-  unsigned int numJoins(0);
-
-  for(unsigned int i = 0; i < StrokedPath::number_point_set_types; ++i)
-    {
-      enum StrokedPath::point_set_t tp;
-      tp = static_cast<enum StrokedPath::point_set_t>(i);
-      num_attributes += path->points(tp, true).size();
-      num_indices += path->indices(tp, true).size();
-    }
-
-  for(unsigned int C = 0, endC = path->number_contours(); C < endC; ++C)
-    {
-      unsigned int endJ;
-
-      endJ = path->number_joins(C);
-      numJoins += endJ;
-      for(unsigned int J = 0; J < endJ; ++J)
-        {
-          /* indices for joins appear twice, once all together
-             and then again as seperate chunks.
-           */
-          num_indices += path->indices_range(StrokedPath::bevel_join_point_set, C, J).difference();
-          num_indices += path->indices_range(StrokedPath::rounded_join_point_set, C, J).difference();
-          num_indices += path->indices_range(StrokedPath::miter_join_point_set, C, J).difference();
-        }
-    }
-
-  d->m_attribute_data.resize(num_attributes);
-  d->m_index_data.resize(num_indices);
-  d->m_attribute_chunks.resize(stroking_data_count + 1 + PainterAttributeDataPrivate::number_join_types * numJoins);
-  d->m_index_chunks.resize(stroking_data_count + 1 + PainterAttributeDataPrivate::number_join_types * numJoins);
-
-  d->m_increment_z.resize(stroking_data_count, 0);
-  d->m_increment_z[edge_closing_edge] = path->number_depth(StrokedPath::edge_point_set, true);
-  d->m_increment_z[bevel_joins_closing_edge] = path->number_depth(StrokedPath::bevel_join_point_set, true);
-  d->m_increment_z[rounded_joins_closing_edge] = path->number_depth(StrokedPath::rounded_join_point_set, true);
-  d->m_increment_z[miter_joins_closing_edge] = path->number_depth(StrokedPath::miter_join_point_set, true);
-
-  d->m_increment_z[edge_no_closing_edge] = path->number_depth(StrokedPath::edge_point_set, false);
-  d->m_increment_z[bevel_joins_no_closing_edge] = path->number_depth(StrokedPath::bevel_join_point_set, false);
-  d->m_increment_z[rounded_joins_no_closing_edge] = path->number_depth(StrokedPath::rounded_join_point_set, false);
-  d->m_increment_z[miter_joins_no_closing_edge] = path->number_depth(StrokedPath::miter_join_point_set, false);
-
-  d->m_increment_z[square_cap] = path->number_depth(StrokedPath::square_cap_point_set, false);
-  d->m_increment_z[rounded_cap] = path->number_depth(StrokedPath::rounded_cap_point_set, false);
-
-  grab_attribute_index_data(make_c_array(d->m_attribute_data), attr_loc,
-                            path->points(StrokedPath::square_cap_point_set, false),
-                            make_c_array(d->m_index_data), idx_loc,
-                            path->indices(StrokedPath::square_cap_point_set, false),
-                            d->m_attribute_chunks[square_cap], d->m_index_chunks[square_cap]);
-
-  grab_attribute_index_data(make_c_array(d->m_attribute_data), attr_loc,
-                            path->points(StrokedPath::rounded_cap_point_set, false),
-                            make_c_array(d->m_index_data), idx_loc,
-                            path->indices(StrokedPath::rounded_cap_point_set, false),
-                            d->m_attribute_chunks[rounded_cap], d->m_index_chunks[rounded_cap]);
-
-#define GRAB_MACRO(dst_root_name, src_name) do {                        \
-                                                                        \
-    enum stroking_data_t closing_edge = dst_root_name##_closing_edge;   \
-    enum stroking_data_t no_closing_edge = dst_root_name##_no_closing_edge; \
-                                                                        \
-    grab_attribute_index_data(make_c_array(d->m_attribute_data),        \
-                              attr_loc,                                 \
-                              path->points(src_name, true),             \
-                              make_c_array(d->m_index_data), idx_loc,   \
-                              path->indices(src_name, true),            \
-                              d->m_attribute_chunks[closing_edge],      \
-                              d->m_index_chunks[closing_edge]);         \
-    d->m_attribute_chunks[no_closing_edge] =                            \
-      d->m_attribute_chunks[closing_edge].sub_array(0, path->points(src_name, false).size()); \
-                                                                        \
-    unsigned int with, without;                                         \
-    with = path->indices(src_name, true).size();                        \
-    without = path->indices(src_name, false).size();                    \
-    assert(with >= without);                                            \
-                                                                        \
-    d->m_index_chunks[no_closing_edge] =                                \
-      d->m_index_chunks[closing_edge].sub_array(with - without);        \
-  } while(0)
-
-#define GRAB_JOIN_MACRO_HELPER(src_name, closing_edge, C, J, gJ) do {   \
-    unsigned int Kc;                                                    \
-    range_type<unsigned int> Ri, Ra;                                    \
-    const_c_array<unsigned int> srcI;                                   \
-    c_array<unsigned int> dst;                                          \
-                                                                        \
-    Ra = path->points_range(src_name, C, J);                            \
-    Ri = path->indices_range(src_name, C, J);                           \
-    srcI = path->indices(src_name, true).sub_array(Ri);                 \
-    Kc = chunk_from_join(closing_edge, gJ);                             \
-    d->m_attribute_chunks[Kc] = d->m_attribute_chunks[closing_edge].sub_array(Ra); \
-    dst = make_c_array(d->m_index_data).sub_array(idx_loc, srcI.size()); \
-    d->m_index_chunks[Kc] =  dst;                                       \
-    for(unsigned int I = 0; I < srcI.size(); ++I)                       \
-      {                                                                 \
-        dst[I] = srcI[I] - Ra.m_begin;                                  \
-      }                                                                 \
-    idx_loc += srcI.size();                                             \
-    ++gJ;                                                               \
-  } while(0)
-
-  /* note that the last two joins of each contour are grabbed last,
-     this is to make sure that the joins for the closing edge are
-     always at the end of our join list.
-   */
-#define GRAB_JOIN_MACRO(dst_root_name, src_name) do {                   \
-    enum stroking_data_t closing_edge = dst_root_name##_closing_edge;   \
-    unsigned int gJ = 0;                                                \
-    for(unsigned int C = 0, endC = path->number_contours();             \
-        C < endC; ++C)                                                  \
-      {                                                                 \
-        for(unsigned int J = 0, endJ = path->number_joins(C) - 2;       \
-            J < endJ; ++J)                                        \
-          {                                                             \
-            GRAB_JOIN_MACRO_HELPER(src_name, closing_edge, C, J, gJ);   \
-          }                                                             \
-      }                                                                 \
-    for(unsigned int C = 0, endC = path->number_contours();             \
-        C < endC; ++C)                                                  \
-      {                                                                 \
-        if(path->number_joins(C) >= 2)                                  \
-          {                                                             \
-            unsigned int J;                                             \
-            J = path->number_joins(C) - 1;                              \
-            GRAB_JOIN_MACRO_HELPER(src_name, closing_edge, C, J, gJ);   \
-            J = path->number_joins(C) - 2;                              \
-            GRAB_JOIN_MACRO_HELPER(src_name, closing_edge, C, J, gJ);   \
-          }                                                             \
-      }                                                                 \
-  } while(0)
-
-  //grab the data for edges and joint together
-  GRAB_MACRO(edge, StrokedPath::edge_point_set);
-  GRAB_MACRO(bevel_joins, StrokedPath::bevel_join_point_set);
-  GRAB_MACRO(rounded_joins, StrokedPath::rounded_join_point_set);
-  GRAB_MACRO(miter_joins, StrokedPath::miter_join_point_set);
-
-  // then grab individual joins, this must be done after
-  // all the blocks because although it does not generate new
-  // attribute data, it does generate new index data
-  GRAB_JOIN_MACRO(rounded_joins, StrokedPath::rounded_join_point_set);
-  GRAB_JOIN_MACRO(bevel_joins, StrokedPath::bevel_join_point_set);
-  GRAB_JOIN_MACRO(miter_joins, StrokedPath::miter_join_point_set);
-
-#undef GRAB_MACRO
+  d->set_stroked_path(path.get());
+  d->m_stroked_path_handle = path;
+}
 
-  d->ready_non_empty_index_data_chunks();
+void
+fastuidraw::PainterAttributeData::
+set_data_without_reference(const StrokedPath *path)
+{
+  PainterAttributeDataPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->set_stroked_path(path);
 }
 
 unsigned int
@@ -606,7 +860,8 @@ set_data(const_c_array<vec2> glyph_positions,
           t = glyphs[g].type();
           pack_glyph_attributes(orientation, glyph_positions[g],
                                 glyphs[g], SCALE,
-                                const_cast_c_array(d->m_attribute_chunks[t].sub_array(4 * current[t], 4)));
+                                const_cast_c_array(d->m_attribute_chunks[t].sub_array(4 * current[t], 4)),
+                                d->m_bounding_box);
           pack_glyph_indices(const_cast_c_array(d->m_index_chunks[t].sub_array(6 * current[t], 6)), 4 * current[t]);
           ++current[t];
         }
@@ -644,7 +899,8 @@ set_data(const_c_array<vec2> glyph_positions,
           t = glyphs[g].type();
           pack_glyph_attributes(orientation, glyph_positions[g],
                                 glyphs[g], SCALE,
-                                const_cast_c_array(d->m_attribute_chunks[t].sub_array(4 * current[t], 4)));
+                                const_cast_c_array(d->m_attribute_chunks[t].sub_array(4 * current[t], 4)),
+                                d->m_bounding_box);
           pack_glyph_indices(const_cast_c_array(d->m_index_chunks[t].sub_array(6 * current[t], 6)), 4 * current[t]);
           ++current[t];
         }
@@ -659,6 +915,7 @@ attribute_data_chunks(void) const
 {
   PainterAttributeDataPrivate *d;
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->ready_all_chunks();
   return make_c_array(d->m_attribute_chunks);
 }
 
@@ -668,6 +925,7 @@ attribute_data_chunk(unsigned int i) const
 {
   PainterAttributeDataPrivate *d;
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->ready_chunk(i);
   return (i < d->m_attribute_chunks.size()) ?
     d->m_attribute_chunks[i] :
     const_c_array<PainterAttribute>();
@@ -679,6 +937,7 @@ index_data_chunks(void) const
 {
   PainterAttributeDataPrivate *d;
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->ready_all_chunks();
   return make_c_array(d->m_index_chunks);
 }
 
@@ -688,6 +947,7 @@ index_data_chunk(unsigned int i) const
 {
   PainterAttributeDataPrivate *d;
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->ready_chunk(i);
   return (i < d->m_index_chunks.size()) ?
     d->m_index_chunks[i] :
     const_c_array<PainterIndex>();
@@ -699,6 +959,7 @@ increment_z_values(void) const
 {
   PainterAttributeDataPrivate *d;
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->ready_all_chunks();
   return make_c_array(d->m_increment_z);
 }
 
@@ -708,17 +969,34 @@ increment_z_value(unsigned int i) const
 {
   PainterAttributeDataPrivate *d;
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->ready_chunk(i);
   return (i < d->m_increment_z.size()) ?
     d->m_increment_z[i] :
     0;
 }
 
+bool
+fastuidraw::PainterAttributeData::
+bounding_box(vec2 &pmin, vec2 &pmax) const
+{
+  PainterAttributeDataPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  if(d->m_bounding_box.m_empty)
+    {
+      return false;
+    }
+  pmin = d->m_bounding_box.m_min;
+  pmax = d->m_bounding_box.m_max;
+  return true;
+}
+
 fastuidraw::const_c_array<unsigned int>
 fastuidraw::PainterAttributeData::
 non_empty_index_data_chunks(void) const
 {
   PainterAttributeDataPrivate *d;
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->ready_all_chunks();
   return make_c_array(d->m_non_empty_index_data_chunks);
 }
 
@@ -762,3 +1040,471 @@ chunk_from_join(enum stroking_data_t tp, unsigned int J)
   return stroking_data_count + t + 1
     + J * PainterAttributeDataPrivate::number_join_types;
 }
+
+namespace
+{
+  class HierarchyTriangle
+  {
+  public:
+    unsigned int m_chunk;
+    unsigned int m_index;
+    fastuidraw::vec2 m_center;
+    BoundingBox m_bounding_box;
+  };
+
+  class triangle_chunk_compare
+  {
+  public:
+    bool
+    operator()(const HierarchyTriangle &lhs, const HierarchyTriangle &rhs) const
+    {
+      return lhs.m_chunk < rhs.m_chunk
+        || (lhs.m_chunk == rhs.m_chunk && lhs.m_index < rhs.m_index);
+    }
+  };
+
+  class center_below
+  {
+  public:
+    center_below(int coord, float v):
+      m_coord(coord),
+      m_v(v)
+    {}
+
+    bool
+    operator()(const HierarchyTriangle &tri) const
+    {
+      return tri.m_center[m_coord] < m_v;
+    }
+
+    int m_coord;
+    float m_v;
+  };
+
+  class HierarchyNode
+  {
+  public:
+    HierarchyNode(void):
+      m_data(NULL),
+      m_owns_data(false)
+    {}
+
+    BoundingBox m_bounding_box;
+    std::vector<unsigned int> m_children;
+    const fastuidraw::PainterAttributeData *m_data;
+    bool m_owns_data;
+  };
+
+  class PainterAttributeDataHierarchyPrivate
+  {
+  public:
+    enum { max_depth = 8 };
+
+    PainterAttributeDataHierarchyPrivate(const fastuidraw::PainterAttributeData &data,
+                                         const PainterAttributeDataPrivate *data_d,
+                                         fastuidraw::const_c_array<unsigned int> chunks,
+                                         unsigned int max_triangles_per_leaf);
+
+    ~PainterAttributeDataHierarchyPrivate();
+
+    unsigned int
+    attribute_chunk(unsigned int chunk) const
+    {
+      return m_shared_attributes ? 0u : chunk;
+    }
+
+    void
+    build(unsigned int node,
+          std::vector<HierarchyTriangle>::iterator begin,
+          std::vector<HierarchyTriangle>::iterator end,
+          const fastuidraw::vec2 &region_min, const fastuidraw::vec2 &region_max,
+          unsigned int depth);
+
+    void
+    make_leaf(unsigned int leaf, PainterAttributeDataPrivate *d);
+
+    const fastuidraw::PainterAttributeData &m_source;
+    std::vector<unsigned int> m_chunks;
+    unsigned int m_number_chunks;
+    unsigned int m_max_triangles_per_leaf;
+    bool m_shared_attributes;
+    std::vector<HierarchyNode> m_nodes;
+
+    /* only used while building, the triangles of the
+       leaf m_leaves[i].first are the elements of
+       m_triangles in the range m_leaves[i].second.
+     */
+    std::vector<HierarchyTriangle> m_triangles;
+    std::vector<std::pair<unsigned int, fastuidraw::range_type<unsigned int> > > m_leaves;
+  };
+}
+
+////////////////////////////////////////////////
+// PainterAttributeDataHierarchyPrivate methods
+PainterAttributeDataHierarchyPrivate::
+PainterAttributeDataHierarchyPrivate(const fastuidraw::PainterAttributeData &data,
+                                     const PainterAttributeDataPrivate *data_d,
+                                     fastuidraw::const_c_array<unsigned int> chunks,
+                                     unsigned int max_triangles_per_leaf):
+  m_source(data),
+  m_number_chunks(0),
+  m_max_triangles_per_leaf(fastuidraw::t_max(max_triangles_per_leaf, 1u))
+{
+  using namespace fastuidraw;
+
+  /* only the named chunks are fetched from data so that a
+     PainterAttributeData set from a StrokedPath does not make
+     the chunks that are not partitioned. The sizes of the arrays
+     of chunks are read directly for the same reason.
+   */
+  for(unsigned int i = 0; i < chunks.size(); ++i)
+    {
+      if(chunks[i] < data_d->m_index_chunks.size())
+        {
+          m_chunks.push_back(chunks[i]);
+          m_number_chunks = t_max(m_number_chunks, chunks[i] + 1);
+        }
+    }
+
+  /* when all index chunks index into the same attribute
+     chunk (as for fill data), the leaves also have just
+     one attribute chunk.
+   */
+  m_shared_attributes = (data_d->m_attribute_chunks.size() == 1);
+
+  unsigned int number_triangles(0);
+  for(unsigned int i = 0; i < m_chunks.size(); ++i)
+    {
+      number_triangles += data.index_data_chunk(m_chunks[i]).size() / 3;
+    }
+
+  m_nodes.push_back(HierarchyNode());
+  if(number_triangles <= m_max_triangles_per_leaf)
+    {
+      /* small enough that the source data is the only leaf
+       */
+      vec2 pmin, pmax;
+      if(data.bounding_box(pmin, pmax))
+        {
+          m_nodes[0].m_bounding_box.union_point(pmin);
+          m_nodes[0].m_bounding_box.union_point(pmax);
+        }
+      m_nodes[0].m_data = &data;
+      return;
+    }
+
+  BoundingBox region;
+  m_triangles.reserve(number_triangles);
+  for(unsigned int i = 0; i < m_chunks.size(); ++i)
+    {
+      unsigned int c(m_chunks[i]);
+      const_c_array<PainterIndex> indices(data.index_data_chunk(c));
+      const_c_array<PainterAttribute> attribs(data.attribute_data_chunk(attribute_chunk(c)));
+
+      for(unsigned int i = 0; i + 2 < indices.size(); i += 3)
+        {
+          HierarchyTriangle tri;
+
+          tri.m_chunk = c;
+          tri.m_index = i;
+          tri.m_center = vec2(0.0f, 0.0f);
+          for(unsigned int k = 0; k < 3; ++k)
+            {
+              const PainterAttribute &a(attribs[indices[i + k]]);
+              vec2 p(unpack_float(a.m_attrib0.x()), unpack_float(a.m_attrib0.y()));
+
+              tri.m_bounding_box.union_point(p);
+              tri.m_center += p;
+            }
+          tri.m_center /= 3.0f;
+          region.union_point(tri.m_center);
+          m_triangles.push_back(tri);
+        }
+    }
+  build(0, m_triangles.begin(), m_triangles.end(), region.m_min, region.m_max, 0);
+}
+
+PainterAttributeDataHierarchyPrivate::
+~PainterAttributeDataHierarchyPrivate()
+{
+  for(unsigned int i = 0, endi = m_nodes.size(); i < endi; ++i)
+    {
+      if(m_nodes[i].m_owns_data)
+        {
+          FASTUIDRAWdelete(const_cast<fastuidraw::PainterAttributeData*>(m_nodes[i].m_data));
+        }
+    }
+}
+
+void
+PainterAttributeDataHierarchyPrivate::
+build(unsigned int node,
+      std::vector<HierarchyTriangle>::iterator begin,
+      std::vector<HierarchyTriangle>::iterator end,
+      const fastuidraw::vec2 &region_min, const fastuidraw::vec2 &region_max,
+      unsigned int depth)
+{
+  using namespace fastuidraw;
+
+  for(std::vector<HierarchyTriangle>::iterator iter = begin; iter != end; ++iter)
+    {
+      m_nodes[node].m_bounding_box.union_point(iter->m_bounding_box.m_min);
+      m_nodes[node].m_bounding_box.union_point(iter->m_bounding_box.m_max);
+    }
+
+  if(static_cast<unsigned int>(end - begin) <= m_max_triangles_per_leaf || depth >= max_depth)
+    {
+      range_type<unsigned int> R(begin - m_triangles.begin(), end - m_triangles.begin());
+      m_leaves.push_back(std::make_pair(node, R));
+      return;
+    }
+
+  /* split the region into 4 quadrants by the center of
+     each triangle.
+   */
+  vec2 mid(0.5f * (region_min + region_max));
+  vecN<std::vector<HierarchyTriangle>::iterator, 5> split;
+  vecN<vec2, 4> child_min, child_max;
+
+  split[0] = begin;
+  split[4] = end;
+  split[2] = std::partition(begin, end, center_below(0, mid.x()));
+  split[1] = std::partition(split[0], split[2], center_below(1, mid.y()));
+  split[3] = std::partition(split[2], split[4], center_below(1, mid.y()));
+
+  child_min[0] = region_min;
+  child_max[0] = mid;
+  child_min[1] = vec2(region_min.x(), mid.y());
+  child_max[1] = vec2(mid.x(), region_max.y());
+  child_min[2] = vec2(mid.x(), region_min.y());
+  child_max[2] = vec2(region_max.x(), mid.y());
+  child_min[3] = mid;
+  child_max[3] = region_max;
+
+  for(unsigned int c = 0; c < 4; ++c)
+    {
+      if(split[c] != split[c + 1])
+        {
+          unsigned int child;
+
+          child = m_nodes.size();
+          m_nodes.push_back(HierarchyNode());
+          m_nodes[node].m_children.push_back(child);
+          build(child, split[c], split[c + 1], child_min[c], child_max[c], depth + 1);
+        }
+    }
+}
+
+void
+PainterAttributeDataHierarchyPrivate::
+make_leaf(unsigned int leaf, PainterAttributeDataPrivate *d)
+{
+  using namespace fastuidraw;
+
+  unsigned int node, number_attribute_chunks;
+  std::vector<HierarchyTriangle>::iterator begin, end;
+  std::vector<range_type<unsigned int> > attribute_ranges, index_ranges;
+  std::vector<unsigned int> used;
+
+  node = m_leaves[leaf].first;
+  begin = m_triangles.begin() + m_leaves[leaf].second.m_begin;
+  end = m_triangles.begin() + m_leaves[leaf].second.m_end;
+  std::sort(begin, end, triangle_chunk_compare());
+
+  number_attribute_chunks = (m_shared_attributes) ? 1u : m_number_chunks;
+  attribute_ranges.resize(number_attribute_chunks, range_type<unsigned int>(0, 0));
+  index_ranges.resize(m_number_chunks, range_type<unsigned int>(0, 0));
+
+  /* the triangles are sorted by chunk, thus the triangles of an
+     attribute chunk are [a_begin, a_end).
+   */
+  for(std::vector<HierarchyTriangle>::iterator a_begin = begin; a_begin != end;)
+    {
+      std::vector<HierarchyTriangle>::iterator a_end;
+      unsigned int A, attr_start;
+
+      A = attribute_chunk(a_begin->m_chunk);
+      for(a_end = a_begin; a_end != end && attribute_chunk(a_end->m_chunk) == A; ++a_end)
+        {}
+
+      /* get the sorted list of the attributes used, these
+         become the attributes of the chunk of the leaf.
+       */
+      const_c_array<PainterAttribute> src_attribs(m_source.attribute_data_chunk(A));
+      used.clear();
+      for(std::vector<HierarchyTriangle>::iterator iter = a_begin; iter != a_end; ++iter)
+        {
+          const_c_array<PainterIndex> src_indices(m_source.index_data_chunk(iter->m_chunk));
+          used.push_back(src_indices[iter->m_index + 0]);
+          used.push_back(src_indices[iter->m_index + 1]);
+          used.push_back(src_indices[iter->m_index + 2]);
+        }
+      std::sort(used.begin(), used.end());
+      used.erase(std::unique(used.begin(), used.end()), used.end());
+
+      attr_start = d->m_attribute_data.size();
+      for(unsigned int i = 0, endi = used.size(); i < endi; ++i)
+        {
+          d->m_attribute_data.push_back(src_attribs[used[i]]);
+        }
+      attribute_ranges[A] = range_type<unsigned int>(attr_start, d->m_attribute_data.size());
+
+      for(std::vector<HierarchyTriangle>::iterator iter = a_begin; iter != a_end; ++iter)
+        {
+          const_c_array<PainterIndex> src_indices(m_source.index_data_chunk(iter->m_chunk));
+          unsigned int C(iter->m_chunk);
+
+          if(index_ranges[C].m_begin == index_ranges[C].m_end)
+            {
+              index_ranges[C] = range_type<unsigned int>(d->m_index_data.size(), d->m_index_data.size());
+            }
+          assert(index_ranges[C].m_end == d->m_index_data.size());
+
+          for(unsigned int k = 0; k < 3; ++k)
+            {
+              std::vector<unsigned int>::iterator loc;
+              loc = std::lower_bound(used.begin(), used.end(), src_indices[iter->m_index + k]);
+              assert(loc != used.end() && *loc == src_indices[iter->m_index + k]);
+              d->m_index_data.push_back(loc - used.begin());
+            }
+          index_ranges[C].m_end = d->m_index_data.size();
+        }
+      a_begin = a_end;
+    }
+
+  d->m_attribute_chunks.resize(number_attribute_chunks);
+  for(unsigned int A = 0; A < number_attribute_chunks; ++A)
+    {
+      d->m_attribute_chunks[A] = make_c_array(d->m_attribute_data).sub_array(attribute_ranges[A]);
+    }
+
+  d->m_index_chunks.resize(m_number_chunks);
+  for(unsigned int C = 0; C < m_number_chunks; ++C)
+    {
+      d->m_index_chunks[C] = make_c_array(d->m_index_data).sub_array(index_ranges[C]);
+    }
+
+  d->m_increment_z.resize(m_number_chunks, 0);
+  for(unsigned int i = 0; i < m_chunks.size(); ++i)
+    {
+      d->m_increment_z[m_chunks[i]] = m_source.increment_z_value(m_chunks[i]);
+    }
+  d->m_bounding_box = m_nodes[node].m_bounding_box;
+  d->ready_non_empty_index_data_chunks();
+}
+
+//////////////////////////////////////////////////////
+// fastuidraw::PainterAttributeDataHierarchy methods
+fastuidraw::PainterAttributeDataHierarchy::
+PainterAttributeDataHierarchy(const PainterAttributeData &data,
+                              unsigned int number_chunks,
+                              unsigned int max_triangles_per_leaf)
+{
+  PainterAttributeDataPrivate *data_d;
+  std::vector<unsigned int> chunks;
+
+  data_d = reinterpret_cast<PainterAttributeDataPrivate*>(data.m_d);
+  number_chunks = t_min(number_chunks, static_cast<unsigned int>(data_d->m_index_chunks.size()));
+  for(unsigned int c = 0; c < number_chunks; ++c)
+    {
+      chunks.push_back(c);
+    }
+  m_d = FASTUIDRAWnew PainterAttributeDataHierarchyPrivate(data, data_d, make_c_array(chunks),
+                                                           max_triangles_per_leaf);
+  create_leaves();
+}
+
+fastuidraw::PainterAttributeDataHierarchy::
+PainterAttributeDataHierarchy(const PainterAttributeData &data,
+                              const_c_array<unsigned int> chunks,
+                              unsigned int max_triangles_per_leaf)
+{
+  PainterAttributeDataPrivate *data_d;
+
+  data_d = reinterpret_cast<PainterAttributeDataPrivate*>(data.m_d);
+  m_d = FASTUIDRAWnew PainterAttributeDataHierarchyPrivate(data, data_d, chunks,
+                                                           max_triangles_per_leaf);
+  create_leaves();
+}
+
+void
+fastuidraw::PainterAttributeDataHierarchy::
+create_leaves(void)
+{
+  PainterAttributeDataHierarchyPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataHierarchyPrivate*>(m_d);
+
+  for(unsigned int i = 0, endi = d->m_leaves.size(); i < endi; ++i)
+    {
+      PainterAttributeData *leaf;
+      unsigned int node;
+
+      node = d->m_leaves[i].first;
+      leaf = FASTUIDRAWnew PainterAttributeData();
+      d->m_nodes[node].m_data = leaf;
+      d->m_nodes[node].m_owns_data = true;
+      d->make_leaf(i, reinterpret_cast<PainterAttributeDataPrivate*>(leaf->m_d));
+    }
+
+  /* release the storage used only for building
+   */
+  std::vector<HierarchyTriangle>().swap(d->m_triangles);
+  d->m_leaves.clear();
+}
+
+fastuidraw::PainterAttributeDataHierarchy::
+~PainterAttributeDataHierarchy()
+{
+  PainterAttributeDataHierarchyPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataHierarchyPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+unsigned int
+fastuidraw::PainterAttributeDataHierarchy::
+number_nodes(void) const
+{
+  PainterAttributeDataHierarchyPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataHierarchyPrivate*>(m_d);
+  return d->m_nodes.size();
+}
+
+bool
+fastuidraw::PainterAttributeDataHierarchy::
+bounding_box(unsigned int node, vec2 &pmin, vec2 &pmax) const
+{
+  PainterAttributeDataHierarchyPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataHierarchyPrivate*>(m_d);
+  assert(node < d->m_nodes.size());
+
+  const BoundingBox &bb(d->m_nodes[node].m_bounding_box);
+  if(bb.m_empty)
+    {
+      return false;
+    }
+  pmin = bb.m_min;
+  pmax = bb.m_max;
+  return true;
+}
+
+fastuidraw::const_c_array<unsigned int>
+fastuidraw::PainterAttributeDataHierarchy::
+children(unsigned int node) const
+{
+  PainterAttributeDataHierarchyPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataHierarchyPrivate*>(m_d);
+  assert(node < d->m_nodes.size());
+  return make_c_array(d->m_nodes[node].m_children);
+}
+
+const fastuidraw::PainterAttributeData&
+fastuidraw::PainterAttributeDataHierarchy::
+data(unsigned int node) const
+{
+  PainterAttributeDataHierarchyPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataHierarchyPrivate*>(m_d);
+  assert(node < d->m_nodes.size());
+  assert(d->m_nodes[node].m_data != NULL);
+  return *d->m_nodes[node].m_data;
+}
@@ -16,9 +16,12 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
 #include <fastuidraw/painter/painter_dashed_stroke_params.hpp>
 #include <fastuidraw/util/fastuidraw_memory.hpp>
 #include "../private/util_private.hpp"
+#include "private/stroking_distance.hpp"
 
 
 namespace
@@ -57,6 +60,63 @@ namespace
     compute_dash_interval(const fastuidraw::PainterShaderData::DataBase *data,
                           float distance,
                           fastuidraw::range_type<float> &out_interval) const;
+
+    virtual
+    unsigned int
+    compute_dash_ranges(const fastuidraw::PainterShaderData::DataBase *data,
+                        fastuidraw::const_c_array<float> sorted_distances,
+                        fastuidraw::c_array<fastuidraw::range_type<unsigned int> > out_ranges) const;
+
+  private:
+    /* Returns the element of the dash pattern containing the
+       named distance, writes to out_period which repeat of the
+       pattern contains the distance, to out_element_start where
+       the element starts within the pattern and to out_f how far
+       the distance is into the element. The dash offset is applied
+       in the same way as the shader applies it.
+     */
+    static
+    unsigned int
+    locate_element(const PainterDashedStrokeParamsData *d, float distance,
+                   float &out_period, float &out_element_start, float &out_f);
+
+    /* Returns where the named location of the pattern is
+       in the distances passed to the evaluator; computing it
+       from the period instead of accumulating the lengths of
+       the elements keeps round off from growing along the
+       path.
+     */
+    static
+    float
+    pattern_location(const PainterDashedStrokeParamsData *d,
+                     float period, float location)
+    {
+      return period * d->m_total_length + location - d->m_dash_offset;
+    }
+  };
+
+  class StrokingDataSelector:public fastuidraw::StrokingDataSelectorBase
+  {
+  public:
+    explicit
+    StrokingDataSelector(bool pixel_width):
+      m_pixel_width(pixel_width)
+    {}
+
+    virtual
+    bool
+    stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                       float &out_pixel_distance,
+                       float &out_item_space_distance) const;
+
+    virtual
+    bool
+    stroking_width(const fastuidraw::PainterShaderData::DataBase *data,
+                   float &out_pixel_width,
+                   float &out_item_space_width) const;
+
+  private:
+    bool m_pixel_width;
   };
 }
 //////////////////////////////////////
@@ -122,8 +182,78 @@ pack_data(unsigned int alignment, fastuidraw::c_array<fastuidraw::generic_data>
     }
 }
 
+///////////////////////////////
+// StrokingDataSelector methods
+bool
+StrokingDataSelector::
+stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                   float &out_pixel_distance,
+                   float &out_item_space_distance) const
+{
+  const PainterDashedStrokeParamsData *d;
+
+  assert(dynamic_cast<const PainterDashedStrokeParamsData*>(data) != NULL);
+  d = static_cast<const PainterDashedStrokeParamsData*>(data);
+  return fastuidraw::detail::stroking_distances(d->m_width, d->m_miter_limit, m_pixel_width,
+                                                out_pixel_distance, out_item_space_distance);
+}
+
+bool
+StrokingDataSelector::
+stroking_width(const fastuidraw::PainterShaderData::DataBase *data,
+               float &out_pixel_width,
+               float &out_item_space_width) const
+{
+  const PainterDashedStrokeParamsData *d;
+
+  assert(dynamic_cast<const PainterDashedStrokeParamsData*>(data) != NULL);
+  d = static_cast<const PainterDashedStrokeParamsData*>(data);
+  if(m_pixel_width)
+    {
+      out_pixel_width = d->m_width;
+      out_item_space_width = 0.0f;
+    }
+  else
+    {
+      out_pixel_width = 0.0f;
+      out_item_space_width = d->m_width;
+    }
+  return true;
+}
+
 ///////////////////////////////
 // DashEvaluator methods
+unsigned int
+DashEvaluator::
+locate_element(const PainterDashedStrokeParamsData *d, float distance,
+               float &out_period, float &out_element_start, float &out_f)
+{
+  float t;
+  unsigned int k, last_k;
+
+  t = distance + d->m_dash_offset;
+  out_period = std::floor(t / d->m_total_length);
+  out_f = fastuidraw::t_max(0.0f, t - out_period * d->m_total_length);
+  out_element_start = 0.0f;
+
+  /* round off can place out_f slightly past the end of the
+     pattern, the last element takes the remainder.
+   */
+  for(k = 0, last_k = d->m_dash_pattern.size() - 1; k < last_k; ++k)
+    {
+      float e;
+
+      e = d->m_dash_pattern[k].m_draw_length + d->m_dash_pattern[k].m_space_length;
+      if(out_f <= e)
+        {
+          return k;
+        }
+      out_f -= e;
+      out_element_start += e;
+    }
+  return last_k;
+}
+
 bool
 DashEvaluator::
 compute_dash_interval(const fastuidraw::PainterShaderData::DataBase *data,
@@ -140,40 +270,119 @@ compute_dash_interval(const fastuidraw::PainterShaderData::DataBase *data,
       return false;
     }
 
-  float q, r, iq;
-  q = distance / d->m_total_length;
-  r = std::modf(q, &iq);
+  unsigned int k;
+  float period, element_start, f, draw, skip;
+
+  k = locate_element(d, distance, period, element_start, f);
+  draw = d->m_dash_pattern[k].m_draw_length;
+  skip = d->m_dash_pattern[k].m_space_length;
+  if(f <= draw)
+    {
+      out_interval.m_begin = pattern_location(d, period, element_start);
+      out_interval.m_end = pattern_location(d, period, element_start + draw);
+      return true;
+    }
+
+  out_interval.m_begin = pattern_location(d, period, element_start + draw);
+  out_interval.m_end = pattern_location(d, period, element_start + draw + skip);
+  return false;
+}
+
+unsigned int
+DashEvaluator::
+compute_dash_ranges(const fastuidraw::PainterShaderData::DataBase *data,
+                    fastuidraw::const_c_array<float> sorted_distances,
+                    fastuidraw::c_array<fastuidraw::range_type<unsigned int> > out_ranges) const
+{
+  using namespace fastuidraw;
+
+  const PainterDashedStrokeParamsData *d;
+  unsigned int i(0), endi(sorted_distances.size()), count(0), k;
+  float period, element_start, f;
+
+  assert(dynamic_cast<const PainterDashedStrokeParamsData*>(data) != NULL);
+  d = static_cast<const PainterDashedStrokeParamsData*>(data);
+  assert(out_ranges.size() >= sorted_distances.size());
 
-  distance = r * d->m_total_length;
-  iq *= d->m_total_length;
+  if(d->m_total_length <= 0.0f || sorted_distances.empty())
+    {
+      return 0;
+    }
 
-  out_interval.m_begin = 0.0f;
-  for(unsigned int i = 0, endi = d->m_dash_pattern.size(); i < endi; ++i)
+  /* walk the elements of the dash pattern and the distances
+     together; the element is only located from scratch when
+     the next distance is at least a full period ahead, so the
+     work is proportional to the number of dashes that contain
+     a distance.
+   */
+  k = locate_element(d, sorted_distances[0], period, element_start, f);
+  while(i < endi)
     {
-      float f, draw, skip;
+      float draw_end, skip_end;
+
+      draw_end = element_start + d->m_dash_pattern[k].m_draw_length;
+      skip_end = draw_end + d->m_dash_pattern[k].m_space_length;
 
-      f = distance - out_interval.m_begin;
-      draw = d->m_dash_pattern[i].m_draw_length;
-      skip = d->m_dash_pattern[i].m_space_length;
-      if(f <= draw)
+      draw_end = pattern_location(d, period, draw_end);
+      if(sorted_distances[i] <= draw_end)
         {
-          out_interval.m_begin += iq;
-          out_interval.m_end = out_interval.m_begin + draw;
-          return true;
+          unsigned int j;
+
+          j = std::upper_bound(sorted_distances.begin() + i, sorted_distances.end(),
+                               draw_end) - sorted_distances.begin();
+          if(count > 0 && out_ranges[count - 1].m_end == i)
+            {
+              out_ranges[count - 1].m_end = j;
+            }
+          else
+            {
+              out_ranges[count] = range_type<unsigned int>(i, j);
+              ++count;
+            }
+          i = j;
         }
 
-      out_interval.m_begin += draw;
-      f -= draw;
-      if(f <= skip)
+      if(i < endi && sorted_distances[i] <= pattern_location(d, period, skip_end))
         {
-          out_interval.m_begin += iq;
-          out_interval.m_end = out_interval.m_begin + skip;
-          return false;
+          i = std::upper_bound(sorted_distances.begin() + i, sorted_distances.end(),
+                               pattern_location(d, period, skip_end)) - sorted_distances.begin();
         }
-    }
 
-  out_interval.m_end = out_interval.m_begin;
-  return false;
+      if(i == endi)
+        {
+          break;
+        }
+
+      if(sorted_distances[i] - pattern_location(d, period, skip_end) < d->m_total_length)
+        {
+          if(k + 1 == d->m_dash_pattern.size())
+            {
+              k = 0;
+              element_start = 0.0f;
+              period += 1.0f;
+            }
+          else
+            {
+              ++k;
+              element_start = skip_end;
+            }
+        }
+      else
+        {
+          float prev_period(period);
+
+          k = locate_element(d, sorted_distances[i], period, element_start, f);
+          if(period <= prev_period)
+            {
+              /* the round off of the distance is so large
+                 compared to the pattern that the walk cannot
+                 advance; give up on the distance.
+               */
+              ++i;
+            }
+        }
+    }
+  return count;
 }
 
 
@@ -202,7 +411,7 @@ width(void) const
   PainterDashedStrokeParamsData *d;
   assert(dynamic_cast<PainterDashedStrokeParamsData*>(m_data) != NULL);
   d = static_cast<PainterDashedStrokeParamsData*>(m_data);
-  return d->m_miter_limit;
+  return d->m_width;
 }
 
 fastuidraw::PainterDashedStrokeParams&
@@ -344,3 +553,10 @@ dash_evaluator(void)
 {
   return FASTUIDRAWnew DashEvaluator();
 }
+
+fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase>
+fastuidraw::PainterDashedStrokeParams::
+stroking_data_selector(bool pixel_width)
+{
+  return FASTUIDRAWnew StrokingDataSelector(pixel_width);
+}
@@ -16,6 +16,7 @@
  *
  */
 
+#include <algorithm>
 #include <fastuidraw/util/vecN.hpp>
 #include <fastuidraw/painter/painter_dashed_stroke_shader_set.hpp>
 
@@ -33,6 +34,49 @@ namespace
   };
 }
 
+///////////////////////////////////////////////////
+// fastuidraw::DashEvaluatorBase methods
+unsigned int
+fastuidraw::DashEvaluatorBase::
+compute_dash_ranges(const PainterShaderData::DataBase *data,
+                    const_c_array<float> sorted_distances,
+                    c_array<range_type<unsigned int> > out_ranges) const
+{
+  unsigned int i(0), endi(sorted_distances.size()), count(0);
+
+  assert(out_ranges.size() >= sorted_distances.size());
+  while(i < endi)
+    {
+      range_type<float> interval;
+      bool solid;
+      unsigned int j;
+
+      solid = compute_dash_interval(data, sorted_distances[i], interval);
+      j = std::upper_bound(sorted_distances.begin() + i, sorted_distances.end(),
+                           interval.m_end) - sorted_distances.begin();
+
+      /* always consume the distance at i, so that an interval
+         that does not contain it (from round off) does not
+         stall the walk.
+       */
+      j = t_max(j, i + 1);
+      if(solid)
+        {
+          if(count > 0 && out_ranges[count - 1].m_end == i)
+            {
+              out_ranges[count - 1].m_end = j;
+            }
+          else
+            {
+              out_ranges[count] = range_type<unsigned int>(i, j);
+              ++count;
+            }
+        }
+      i = j;
+    }
+  return count;
+}
+
 
 ///////////////////////////////////////////////////
 // fastuidraw::PainterDashedStrokeShaderSet methods
@@ -30,6 +30,7 @@ namespace
     fastuidraw::PainterDashedStrokeShaderSet m_dashed_stroke_shader;
     fastuidraw::PainterDashedStrokeShaderSet m_pixel_width_dashed_stroke_shader;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_fill_shader;
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_analytic_fill_shader;
     fastuidraw::PainterBlendShaderSet m_blend_shaders;
   };
 }
@@ -100,6 +101,7 @@ setget_implement(fastuidraw::PainterStrokeShader, pixel_width_stroke_shader)
 setget_implement(fastuidraw::PainterDashedStrokeShaderSet, dashed_stroke_shader)
 setget_implement(fastuidraw::PainterDashedStrokeShaderSet, pixel_width_dashed_stroke_shader)
 setget_implement(fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>, fill_shader)
+setget_implement(fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>, analytic_fill_shader)
 setget_implement(fastuidraw::PainterBlendShaderSet, blend_shaders)
 
 #undef setget_implement
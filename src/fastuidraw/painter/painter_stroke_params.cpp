@@ -19,6 +19,7 @@
 #include <fastuidraw/painter/painter_stroke_params.hpp>
 #include <fastuidraw/util/fastuidraw_memory.hpp>
 #include "../private/util_private.hpp"
+#include "private/stroking_distance.hpp"
 
 namespace
 {
@@ -56,6 +57,69 @@ namespace
     float m_miter_limit;
     float m_width;
   };
+
+  class StrokingDataSelector:public fastuidraw::StrokingDataSelectorBase
+  {
+  public:
+    explicit
+    StrokingDataSelector(bool pixel_width):
+      m_pixel_width(pixel_width)
+    {}
+
+    virtual
+    bool
+    stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                       float &out_pixel_distance,
+                       float &out_item_space_distance) const;
+
+    virtual
+    bool
+    stroking_width(const fastuidraw::PainterShaderData::DataBase *data,
+                   float &out_pixel_width,
+                   float &out_item_space_width) const;
+
+  private:
+    bool m_pixel_width;
+  };
+}
+
+///////////////////////////////
+// StrokingDataSelector methods
+bool
+StrokingDataSelector::
+stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                   float &out_pixel_distance,
+                   float &out_item_space_distance) const
+{
+  const PainterStrokeParamsData *d;
+
+  assert(dynamic_cast<const PainterStrokeParamsData*>(data) != NULL);
+  d = static_cast<const PainterStrokeParamsData*>(data);
+  return fastuidraw::detail::stroking_distances(d->m_width, d->m_miter_limit, m_pixel_width,
+                                                out_pixel_distance, out_item_space_distance);
+}
+
+bool
+StrokingDataSelector::
+stroking_width(const fastuidraw::PainterShaderData::DataBase *data,
+               float &out_pixel_width,
+               float &out_item_space_width) const
+{
+  const PainterStrokeParamsData *d;
+
+  assert(dynamic_cast<const PainterStrokeParamsData*>(data) != NULL);
+  d = static_cast<const PainterStrokeParamsData*>(data);
+  if(m_pixel_width)
+    {
+      out_pixel_width = d->m_width;
+      out_item_space_width = 0.0f;
+    }
+  else
+    {
+      out_pixel_width = 0.0f;
+      out_item_space_width = d->m_width;
+    }
+  return true;
 }
 
 ///////////////////////////////////
@@ -83,7 +147,7 @@ width(void) const
   PainterStrokeParamsData *d;
   assert(dynamic_cast<PainterStrokeParamsData*>(m_data) != NULL);
   d = static_cast<PainterStrokeParamsData*>(m_data);
-  return d->m_miter_limit;
+  return d->m_width;
 }
 
 fastuidraw::PainterStrokeParams&
@@ -107,3 +171,10 @@ width(float f)
   d->m_width = f;
   return *this;
 }
+
+fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase>
+fastuidraw::PainterStrokeParams::
+stroking_data_selector(bool pixel_width)
+{
+  return FASTUIDRAWnew StrokingDataSelector(pixel_width);
+}
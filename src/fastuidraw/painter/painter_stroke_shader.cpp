@@ -31,10 +31,25 @@ namespace
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_aa_shader_pass1;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_aa_shader_pass2;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_non_aa_shader;
+    fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase> m_stroking_data_selector;
     enum fastuidraw::PainterStrokeShader::type_t m_aa_type;
   };
 }
 
+//////////////////////////////////////////
+// fastuidraw::StrokingDataSelectorBase methods
+bool
+fastuidraw::StrokingDataSelectorBase::
+stroking_width(const PainterShaderData::DataBase *data,
+               float &out_pixel_width,
+               float &out_item_space_width) const
+{
+  FASTUIDRAWunused(data);
+  FASTUIDRAWunused(out_pixel_width);
+  FASTUIDRAWunused(out_item_space_width);
+  return false;
+}
+
 //////////////////////////////////////////
 // fastuidraw::PainterStrokeShader methods
 fastuidraw::PainterStrokeShader::
@@ -98,5 +113,6 @@ setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItem
 setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>&, aa_shader_pass2)
 setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>&, non_aa_shader)
 setget_implement(enum fastuidraw::PainterStrokeShader::type_t, aa_type);
+setget_implement(const fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase>&, stroking_data_selector)
 
 #undef setget_implement
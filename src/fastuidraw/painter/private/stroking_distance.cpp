@@ -0,0 +1,56 @@
+/*!
+ * \file stroking_distance.cpp
+ * \brief file stroking_distance.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <cmath>
+#include <fastuidraw/util/math.hpp>
+#include "stroking_distance.hpp"
+
+bool
+fastuidraw::detail::
+stroking_distances(float width, float miter_limit, bool pixel_width,
+                   float &out_pixel_distance,
+                   float &out_item_space_distance)
+{
+  float r;
+
+  /* a negative miter limit means miter-joins are not
+     limited, thus how far stroking extends is unbounded.
+   */
+  if(miter_limit < 0.0f)
+    {
+      return false;
+    }
+
+  /* square caps extend sqrt(2) times the stroking radius
+     and miter-joins extend miter-limit times the stroking
+     radius from the path. The anti-alias fuzz adds a couple
+     of pixels on top of that.
+   */
+  r = 0.5f * width * t_max(miter_limit, static_cast<float>(M_SQRT2));
+  if(pixel_width)
+    {
+      out_pixel_distance = r + 2.0f;
+      out_item_space_distance = 0.0f;
+    }
+  else
+    {
+      out_pixel_distance = 2.0f;
+      out_item_space_distance = r;
+    }
+  return true;
+}
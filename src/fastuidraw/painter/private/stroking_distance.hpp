@@ -0,0 +1,42 @@
+/*!
+ * \file stroking_distance.hpp
+ * \brief file stroking_distance.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+namespace fastuidraw
+{
+namespace detail
+{
+  /*!
+    Computes how far stroking extends from the path, for
+    the StrokingDataSelectorBase::stroking_distances()
+    implementations of the stroking parameter classes.
+    Returns false if the distance is unbounded.
+     \param width stroking width
+     \param miter_limit miter limit, negative means unlimited
+     \param pixel_width if true, the width is in pixels
+     \param out_pixel_distance location to which to write the distance in pixels
+     \param out_item_space_distance location to which to write the distance in item coordinates
+   */
+  bool
+  stroking_distances(float width, float miter_limit, bool pixel_width,
+                     float &out_pixel_distance,
+                     float &out_item_space_distance);
+}
+}
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
 #include <vector>
 #include <fastuidraw/path.hpp>
 #include "private/util_private.hpp"
@@ -37,6 +38,27 @@ namespace
     static
     fastuidraw::vec2
     compute_poly(float t, fastuidraw::const_c_array<fastuidraw::vec2> poly);
+
+    /* compute_quadratic() and compute_cubic() give the same
+       values as compute_poly() on the polynomial and its
+       derivatives of a quadratic or cubic curve, but without
+       the loop over the coefficients.
+     */
+    static
+    void
+    compute_quadratic(float t, const fastuidraw::vec2 *poly,
+                      const fastuidraw::vec2 *poly_prime,
+                      const fastuidraw::vec2 *poly_prime_prime,
+                      fastuidraw::vec2 &outp, fastuidraw::vec2 &outp_t,
+                      fastuidraw::vec2 &outp_tt);
+
+    static
+    void
+    compute_cubic(float t, const fastuidraw::vec2 *poly,
+                  const fastuidraw::vec2 *poly_prime,
+                  const fastuidraw::vec2 *poly_prime_prime,
+                  fastuidraw::vec2 &outp, fastuidraw::vec2 &outp_t,
+                  fastuidraw::vec2 &outp_tt);
   };
 
 
@@ -62,47 +84,124 @@ namespace
   class analytic_point_data:public fastuidraw::TessellatedPath::point
   {
   public:
-    analytic_point_data(float time, const fastuidraw::PathContour::interpolator_generic *h);
-
-    bool
-    operator<(const analytic_point_data &rhs) const
+    analytic_point_data(void):
+      m_time(0.0f),
+      m_K_times_speed(0.0f)
     {
-      return m_time < rhs.m_time;
+      m_p = fastuidraw::vec2(0.0f, 0.0f);
+      m_p_t = fastuidraw::vec2(0.0f, 0.0f);
+      m_distance_from_edge_start = 0.0f;
+      m_distance_from_contour_start = 0.0f;
+      m_edge_length = 0.0f;
+      m_open_contour_length = 0.0f;
+      m_closed_contour_length = 0.0f;
     }
 
+    void
+    set(float time, const fastuidraw::vec2 &p,
+        const fastuidraw::vec2 &p_t, const fastuidraw::vec2 &p_tt);
+
     float m_time;
     float m_K_times_speed;
   };
 
 
+  /* Tessellator emits the points of an interpolator_generic
+     in order of increasing time directly into the destination
+     array. An interval is refined by adding its midpoint and,
+     if the curvature integral over the interval is too large,
+     by refining its two halves. The intervals still to be
+     refined are kept in a fixed size stack; refining an
+     interval pops it and pushes its two halves, so the stack
+     never holds more than one interval per level of recursion.
+     Every interval that is pushed below the maximum recursion
+     level has its midpoint computed when it is popped, so the
+     midpoints of both halves are computed together with one
+     call to interpolator_generic::compute_batch() when they
+     are pushed.
+   */
   class Tessellator:fastuidraw::noncopyable
   {
   public:
     Tessellator(const fastuidraw::TessellatedPath::TessellationParams &tess_params,
                 const fastuidraw::PathContour::interpolator_generic *h);
 
+    /* writes the tessellation to out_data and, if
+       out_max_distance is non-NULL, the maximum distance
+       between the curve and the emitted segments to
+       out_max_distance.
+     */
     unsigned int
-    dump(fastuidraw::c_array<fastuidraw::TessellatedPath::point> out_data) const;
-
+    dump(fastuidraw::c_array<fastuidraw::TessellatedPath::point> out_data,
+         float *out_max_distance) const;
 
   private:
-    unsigned int m_max_recursion, m_max_size;
-    const fastuidraw::PathContour::interpolator_generic *m_h;
-    float m_thresh_times_six;
-    std::vector<analytic_point_data> m_data;
+    enum
+      {
+        /* uint32_log2() of an uint32_t is at most 31 */
+        max_stack_size = 33
+      };
 
-    void
-    tessellation_worker(unsigned int idx_p, unsigned int idx_q,
-                        unsigned int recursion_level);
+    class interval
+    {
+    public:
+      /* end of the interval, the start of the interval is
+         always the last point emitted.
+       */
+      analytic_point_data m_end;
+
+      /* midpoint of the interval, only valid if
+         m_recursion_level is less than m_max_recursion
+       */
+      analytic_point_data m_mid;
+      unsigned int m_recursion_level;
+    };
 
+    /* computes the points at the times of in_t
+     */
+    template<size_t N>
+    void
+    compute(const fastuidraw::vecN<float, N> &in_t,
+            fastuidraw::vecN<analytic_point_data, N> &out_pts) const;
 
     bool
     requires_recursion(float delta_t,
-                       unsigned int idx_p,
-                       unsigned int idx_mid,
-                       unsigned int idx_q);
+                       const analytic_point_data &p,
+                       const analytic_point_data &mid,
+                       const analytic_point_data &q) const;
+
+    /* maximum distance from the curve between p and q to
+       the segment [p, q], measured at the quarter times of
+       the interval; sampling the interior of the interval
+       (rather than comparing the tangents at p and q) also
+       catches the S-shaped pieces of the curve.
+     */
+    float
+    segment_deviation(const analytic_point_data &p,
+                      const analytic_point_data &q) const;
+
+    unsigned int m_max_recursion;
+    const fastuidraw::PathContour::interpolator_generic *m_h;
+    float m_thresh_times_six;
   };
 
+  /* distance from p to the segment [a, b]
+   */
+  inline
+  float
+  distance_to_segment(const fastuidraw::vec2 &p,
+                      const fastuidraw::vec2 &a,
+                      const fastuidraw::vec2 &b)
+  {
+    fastuidraw::vec2 ab(b - a), ap(p - a);
+    float len_sq, t;
+
+    len_sq = fastuidraw::dot(ab, ab);
+    t = (len_sq > 0.0f) ? fastuidraw::dot(ap, ab) / len_sq : 0.0f;
+    t = fastuidraw::t_min(1.0f, fastuidraw::t_max(0.0f, t));
+    return (ap - t * ab).magnitude();
+  }
+
   class InterpolatorBasePrivate
   {
   public:
@@ -152,22 +251,57 @@ namespace
     current_contour(void)
     {
       assert(!m_contours.empty());
-      m_tessellation.clear();
+      clear_tessellation();
       return m_contours.back();
     }
 
     void
-    move_common(const fastuidraw::vec2 &pt)
+    clear_tessellation(void)
     {
       m_tessellation.clear();
+      m_tessellation_levels.clear();
+      m_simplified_levels.clear();
+      m_tessellation_job.clear();
+    }
+
+    const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+    tessellation_level(const fastuidraw::Path &path, int level);
+
+    void
+    move_common(const fastuidraw::vec2 &pt)
+    {
+      clear_tessellation();
       m_contours.push_back(FASTUIDRAWnew fastuidraw::PathContour());
       m_contours.back()->start(pt);
     }
 
     fastuidraw::TessellatedPath::TessellationParams m_tessellation_params;
     fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> m_tessellation;
+
+    /* tessellations other than m_tessellation keyed by level,
+       level L uses m_tessellation_params with the curvature
+       threshhold scaled by 2^-L; for L > 0 the maximum number
+       of segments is also scaled by 2^L.
+     */
+    std::map<int, fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> > m_tessellation_levels;
+
+    /* simplified tessellations keyed by level, level L
+       is within 2^L of the curves of the Path.
+     */
+    std::map<int, fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> > m_simplified_levels;
+
+    /* non-NULL if m_tessellation is being constructed
+       by a PathTessellationPool
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::PathTessellationPool::Job> m_tessellation_job;
     std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > m_contours;
   };
+
+  /* range of levels for Path::tessellation(float); each level
+     roughly divides TessellatedPath::max_distance() by 4.
+   */
+  const int min_tessellation_level = -4;
+  const int max_tessellation_level = 6;
 }
 
 
@@ -272,6 +406,40 @@ compute_poly(float t, fastuidraw::const_c_array<fastuidraw::vec2> poly)
   return work;
 }
 
+inline
+void
+poly::
+compute_quadratic(float t, const fastuidraw::vec2 *poly,
+                  const fastuidraw::vec2 *poly_prime,
+                  const fastuidraw::vec2 *poly_prime_prime,
+                  fastuidraw::vec2 &outp, fastuidraw::vec2 &outp_t,
+                  fastuidraw::vec2 &outp_tt)
+{
+  float s(1.0f - t);
+  float st(s * t);
+
+  outp = (poly[2] * (t * t)) + (poly[0] * (s * s)) + (st * poly[1]);
+  outp_t = s * poly_prime[0] + t * poly_prime[1];
+  outp_tt = poly_prime_prime[0];
+}
+
+inline
+void
+poly::
+compute_cubic(float t, const fastuidraw::vec2 *poly,
+              const fastuidraw::vec2 *poly_prime,
+              const fastuidraw::vec2 *poly_prime_prime,
+              fastuidraw::vec2 &outp, fastuidraw::vec2 &outp_t,
+              fastuidraw::vec2 &outp_tt)
+{
+  float s(1.0f - t);
+  float st(s * t);
+  float s2(s * s), t2(t * t);
+
+  outp = (poly[3] * (t * t2)) + (poly[0] * (s * s2)) + (st * (s * poly[1] + t * poly[2]));
+  outp_t = (poly_prime[2] * t2) + (poly_prime[0] * s2) + (st * poly_prime[1]);
+  outp_tt = s * poly_prime_prime[0] + t * poly_prime_prime[1];
+}
 
 ///////////////////////////////////////////
 // binomial_coeff methods
@@ -317,12 +485,11 @@ prepare_bernstein(std::vector<fastuidraw::vec2> &victim) const
 
 ////////////////////////////////////
 // analytic_point_data methods
+void
 analytic_point_data::
-analytic_point_data(float time, const fastuidraw::PathContour::interpolator_generic *h)
+set(float time, const fastuidraw::vec2 &p,
+    const fastuidraw::vec2 &p_t, const fastuidraw::vec2 &p_tt)
 {
-  assert(h);
-
-  fastuidraw::vec2 p_tt;
   float cross_mag, speed_sq;
   const float epsilon(0.000001f);
   const float epsilon_sq(epsilon * epsilon);
@@ -333,7 +500,8 @@ analytic_point_data(float time, const fastuidraw::PathContour::interpolator_gene
      K ||p_t || = || p_t x p_tt || / ||p_t||^2
   */
   m_time = time;
-  h->compute(time, m_p, m_p_t, p_tt);
+  m_p = p;
+  m_p_t = p_t;
 
   cross_mag = std::abs(m_p_t.x() * p_tt.y() - p_tt.x() * m_p_t.y());
   speed_sq = std::max(dot(m_p_t, m_p_t), epsilon_sq);
@@ -346,98 +514,161 @@ Tessellator::
 Tessellator(const fastuidraw::TessellatedPath::TessellationParams &tess_params,
             const fastuidraw::PathContour::interpolator_generic *h):
   m_max_recursion(fastuidraw::uint32_log2(tess_params.m_max_segments)),
-  m_max_size(tess_params.m_max_segments + 1),
   m_h(h),
   m_thresh_times_six(tess_params.m_curve_tessellation * 6.0f)
 {
   assert(m_h);
-
-  m_data.push_back(analytic_point_data(0.0f, m_h));
-  m_data.push_back(analytic_point_data(1.0f, m_h));
-  tessellation_worker(0, 1, 0);
-  std::sort(m_data.begin(), m_data.end());
-
-  /*! enforce start and end point values
-   */
-  m_data.front().m_p = h->start_pt();
-  m_data.back().m_p = h->end_pt();
-
-  /* compute distance values along edge
-   */
-  m_data[0].m_distance_from_edge_start = 0.0f;
-  for(unsigned int i = 1, endi = m_data.size(); i < endi; ++i)
-    {
-      fastuidraw::vec2 delta;
-
-      delta = m_data[i].m_p - m_data[i-1].m_p;
-      m_data[i].m_distance_from_edge_start = delta.magnitude()
-        + m_data[i-1].m_distance_from_edge_start;
-    }
+  assert(m_max_recursion + 2 <= max_stack_size);
 }
 
 inline
 bool
 Tessellator::
 requires_recursion(float delta_t,
-                   unsigned int idx_p,
-                   unsigned int idx_mid,
-                   unsigned int idx_q)
-
+                   const analytic_point_data &p,
+                   const analytic_point_data &mid,
+                   const analytic_point_data &q) const
 {
   /* Use simpson's Rule on the integral:
        integral_[t, t + delta_t] K_times_speed(t) dt
   */
   float K0, K1, K;
 
-  K0 = m_data[idx_p].m_K_times_speed;
-  K = m_data[idx_mid].m_K_times_speed;
-  K1 = m_data[idx_q].m_K_times_speed;
+  K0 = p.m_K_times_speed;
+  K = mid.m_K_times_speed;
+  K1 = q.m_K_times_speed;
 
   return (K0 + K1 + 4.0f * K ) * delta_t > m_thresh_times_six;
 }
 
+template<size_t N>
 void
 Tessellator::
-tessellation_worker(unsigned int idx_start, unsigned int idx_end,
-                    unsigned int recurse_level)
+compute(const fastuidraw::vecN<float, N> &in_t,
+        fastuidraw::vecN<analytic_point_data, N> &out_pts) const
 {
+  fastuidraw::vecN<fastuidraw::vec2, N> p, p_t, p_tt;
 
-  if(recurse_level >= m_max_recursion)
+  m_h->compute_batch(fastuidraw::const_c_array<float>(in_t.c_ptr(), N),
+                     fastuidraw::c_array<fastuidraw::vec2>(p.c_ptr(), N),
+                     fastuidraw::c_array<fastuidraw::vec2>(p_t.c_ptr(), N),
+                     fastuidraw::c_array<fastuidraw::vec2>(p_tt.c_ptr(), N));
+  for(unsigned int i = 0; i < N; ++i)
     {
-      return;
+      out_pts[i].set(in_t[i], p[i], p_t[i], p_tt[i]);
     }
+}
 
-  float delta_t, start_t, end_t, mid_t;
-  unsigned int idx_mid(m_data.size());
-
-  start_t = m_data[idx_start].m_time;
-  end_t = m_data[idx_end].m_time;
-  mid_t = 0.5f * (end_t + start_t);
-  delta_t = (end_t - start_t);
-
-  m_data.push_back(analytic_point_data(mid_t, m_h));
+float
+Tessellator::
+segment_deviation(const analytic_point_data &p,
+                  const analytic_point_data &q) const
+{
+  fastuidraw::vecN<analytic_point_data, 3> samples;
+  float dt(q.m_time - p.m_time), return_value(0.0f);
 
+  compute(fastuidraw::vecN<float, 3>(p.m_time + 0.25f * dt,
+                                     p.m_time + 0.50f * dt,
+                                     p.m_time + 0.75f * dt),
+          samples);
+  for(unsigned int i = 0; i < 3; ++i)
+    {
+      return_value = fastuidraw::t_max(return_value,
+                                       distance_to_segment(samples[i].m_p, p.m_p, q.m_p));
+    }
+  return return_value;
+}
 
-  if(requires_recursion(delta_t, idx_start, idx_mid, idx_end))
+unsigned int
+Tessellator::
+dump(fastuidraw::c_array<fastuidraw::TessellatedPath::point> out_data,
+     float *out_max_distance) const
+{
+  interval stack[max_stack_size];
+  unsigned int stack_size(0), n(0);
+  fastuidraw::vecN<analytic_point_data, 3> start_pts;
+  analytic_point_data current;
+  float max_distance(0.0f);
+
+  assert(out_data.size() >= (1u << m_max_recursion) + 1u);
+
+  compute(fastuidraw::vecN<float, 3>(0.0f, 0.5f, 1.0f), start_pts);
+  current = start_pts[0];
+  out_data[n++] = current;
+  stack[stack_size].m_end = start_pts[2];
+  stack[stack_size].m_mid = start_pts[1];
+  stack[stack_size].m_recursion_level = 0;
+  ++stack_size;
+
+  while(stack_size > 0)
     {
-      tessellation_worker(idx_start, idx_mid,
-                          recurse_level + 1);
+      interval I(stack[--stack_size]);
 
-      tessellation_worker(idx_mid, idx_end,
-                          recurse_level + 1);
+      if(I.m_recursion_level < m_max_recursion)
+        {
+          const analytic_point_data &mid(I.m_mid);
+
+          if(requires_recursion(I.m_end.m_time - current.m_time, current, mid, I.m_end))
+            {
+              unsigned int level(I.m_recursion_level + 1);
+
+              /* push the second half first so that the
+                 first half is refined first.
+               */
+              assert(stack_size + 2 <= max_stack_size);
+              stack[stack_size].m_end = I.m_end;
+              stack[stack_size].m_recursion_level = level;
+              stack[stack_size + 1].m_end = mid;
+              stack[stack_size + 1].m_recursion_level = level;
+              if(level < m_max_recursion)
+                {
+                  fastuidraw::vecN<analytic_point_data, 2> mids;
+                  fastuidraw::vecN<float, 2> times(0.5f * (I.m_end.m_time + mid.m_time),
+                                                   0.5f * (mid.m_time + current.m_time));
+                  compute(times, mids);
+                  stack[stack_size].m_mid = mids[0];
+                  stack[stack_size + 1].m_mid = mids[1];
+                }
+              stack_size += 2;
+              continue;
+            }
+          if(out_max_distance)
+            {
+              max_distance = fastuidraw::t_max(max_distance, segment_deviation(current, mid));
+            }
+          out_data[n++] = mid;
+          current = mid;
+        }
+      if(out_max_distance)
+        {
+          max_distance = fastuidraw::t_max(max_distance, segment_deviation(current, I.m_end));
+        }
+      out_data[n++] = I.m_end;
+      current = I.m_end;
+    }
 
+  if(out_max_distance)
+    {
+      *out_max_distance = max_distance;
     }
 
-}
+  /* enforce start and end point values
+   */
+  out_data[0].m_p = m_h->start_pt();
+  out_data[n - 1].m_p = m_h->end_pt();
 
+  /* compute distance values along edge
+   */
+  out_data[0].m_distance_from_edge_start = 0.0f;
+  for(unsigned int i = 1; i < n; ++i)
+    {
+      fastuidraw::vec2 delta;
 
-unsigned int
-Tessellator::
-dump(fastuidraw::c_array<fastuidraw::TessellatedPath::point> out_data) const
-{
-  assert(out_data.size() >= m_data.size());
-  std::copy(m_data.begin(), m_data.end(), out_data.begin());
-  return m_data.size();
+      delta = out_data[i].m_p - out_data[i-1].m_p;
+      out_data[i].m_distance_from_edge_start = delta.magnitude()
+        + out_data[i-1].m_distance_from_edge_start;
+    }
+  return n;
 }
 
 ////////////////////////////////////////
@@ -515,10 +746,25 @@ end_pt(void) const
 unsigned int
 fastuidraw::PathContour::interpolator_generic::
 produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
-                     c_array<TessellatedPath::point> out_data) const
+                     c_array<TessellatedPath::point> out_data,
+                     float *out_max_distance) const
 {
   Tessellator tesser(tess_params, this);
-  return tesser.dump(out_data);
+  return tesser.dump(out_data, out_max_distance);
+}
+
+void
+fastuidraw::PathContour::interpolator_generic::
+compute_batch(const_c_array<float> in_t, c_array<vec2> outp,
+              c_array<vec2> outp_t, c_array<vec2> outp_tt) const
+{
+  assert(in_t.size() == outp.size());
+  assert(in_t.size() == outp_t.size());
+  assert(in_t.size() == outp_tt.size());
+  for(unsigned int i = 0, endi = in_t.size(); i < endi; ++i)
+    {
+      compute(in_t[i], outp[i], outp_t[i], outp_tt[i]);
+    }
 }
 
 
@@ -595,9 +841,76 @@ compute(float t, vec2 &outp, vec2 &outp_t, vec2 &outp_tt) const
 {
   BezierPrivate *d;
   d = reinterpret_cast<BezierPrivate*>(m_d);
-  outp = poly::compute_poly(t, make_c_array(d->m_poly));
-  outp_t = poly::compute_poly(t, make_c_array(d->m_poly_prime));
-  outp_tt = poly::compute_poly(t, make_c_array(d->m_poly_prime_prime));
+  switch(d->m_poly.size())
+    {
+    case 3:
+      poly::compute_quadratic(t, &d->m_poly[0], &d->m_poly_prime[0], &d->m_poly_prime_prime[0],
+                              outp, outp_t, outp_tt);
+      break;
+
+    case 4:
+      poly::compute_cubic(t, &d->m_poly[0], &d->m_poly_prime[0], &d->m_poly_prime_prime[0],
+                          outp, outp_t, outp_tt);
+      break;
+
+    default:
+      outp = poly::compute_poly(t, make_c_array(d->m_poly));
+      outp_t = poly::compute_poly(t, make_c_array(d->m_poly_prime));
+      outp_tt = poly::compute_poly(t, make_c_array(d->m_poly_prime_prime));
+    }
+}
+
+void
+fastuidraw::PathContour::bezier::
+compute_batch(const_c_array<float> in_t, c_array<vec2> outp,
+              c_array<vec2> outp_t, c_array<vec2> outp_tt) const
+{
+  BezierPrivate *d;
+  unsigned int cnt(in_t.size());
+
+  d = reinterpret_cast<BezierPrivate*>(m_d);
+  assert(cnt == outp.size());
+  assert(cnt == outp_t.size());
+  assert(cnt == outp_tt.size());
+
+  /* the degree is checked once for the entire batch,
+     and the loops over the times have no branching
+   */
+  switch(d->m_poly.size())
+    {
+    case 3:
+      {
+        const vec2 *p(&d->m_poly[0]), *p_t(&d->m_poly_prime[0]), *p_tt(&d->m_poly_prime_prime[0]);
+        for(unsigned int i = 0; i < cnt; ++i)
+          {
+            poly::compute_quadratic(in_t[i], p, p_t, p_tt, outp[i], outp_t[i], outp_tt[i]);
+          }
+      }
+      break;
+
+    case 4:
+      {
+        const vec2 *p(&d->m_poly[0]), *p_t(&d->m_poly_prime[0]), *p_tt(&d->m_poly_prime_prime[0]);
+        for(unsigned int i = 0; i < cnt; ++i)
+          {
+            poly::compute_cubic(in_t[i], p, p_t, p_tt, outp[i], outp_t[i], outp_tt[i]);
+          }
+      }
+      break;
+
+    default:
+      {
+        const_c_array<vec2> p(make_c_array(d->m_poly));
+        const_c_array<vec2> p_t(make_c_array(d->m_poly_prime));
+        const_c_array<vec2> p_tt(make_c_array(d->m_poly_prime_prime));
+        for(unsigned int i = 0; i < cnt; ++i)
+          {
+            outp[i] = poly::compute_poly(in_t[i], p);
+            outp_t[i] = poly::compute_poly(in_t[i], p_t);
+            outp_tt[i] = poly::compute_poly(in_t[i], p_tt);
+          }
+      }
+    }
 }
 
 fastuidraw::PathContour::interpolator_base*
@@ -612,7 +925,8 @@ deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
 unsigned int
 fastuidraw::PathContour::flat::
 produce_tessellation(const TessellatedPath::TessellationParams&,
-                     c_array<TessellatedPath::point> out_data) const
+                     c_array<TessellatedPath::point> out_data,
+                     float *out_max_distance) const
 {
   vec2 delta(end_pt() - start_pt());
   float mag(delta.magnitude());
@@ -624,6 +938,11 @@ produce_tessellation(const TessellatedPath::TessellationParams&,
   out_data[1].m_p = end_pt();
   out_data[1].m_p_t = delta;
   out_data[1].m_distance_from_edge_start = mag;
+
+  if(out_max_distance)
+    {
+      *out_max_distance = 0.0f;
+    }
   return 2;
 }
 
@@ -701,7 +1020,8 @@ fastuidraw::PathContour::arc::
 unsigned int
 fastuidraw::PathContour::arc::
 produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
-                     c_array<TessellatedPath::point> out_data) const
+                     c_array<TessellatedPath::point> out_data,
+                     float *out_max_distance) const
 {
   ArcPrivate *d;
   d = reinterpret_cast<ArcPrivate*>(m_d);
@@ -713,6 +1033,7 @@ produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
   needed_sizef = std::abs(d->m_angle_speed) / tess_params.m_curve_tessellation;
   needed_size = static_cast<unsigned int>(needed_sizef);
   needed_size = std::min(needed_size, tess_params.m_max_segments);
+  needed_size = std::max(needed_size, 1u);
   delta_angle = d->m_angle_speed / static_cast<float>(needed_size);
   sgn = d->m_angle_speed > 0.0 ? 1.0 : -1.0;
   sgn_radius = sgn * d->m_radius;
@@ -729,6 +1050,14 @@ produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
     }
   out_data[0].m_p = start_pt();
   out_data[needed_size].m_p = end_pt();
+
+  /* the distance from an arc of angle A of a circle of
+     radius R to its chord is R * (1 - cos(A / 2))
+   */
+  if(out_max_distance)
+    {
+      *out_max_distance = d->m_radius * (1.0f - std::cos(0.5f * std::abs(delta_angle)));
+    }
   return needed_size + 1;
 }
 
@@ -1012,16 +1341,43 @@ deep_copy(void)
 
 /////////////////////////////////
 // PathPrivate methods
+const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+PathPrivate::
+tessellation_level(const fastuidraw::Path &path, int level)
+{
+  if(level == 0)
+    {
+      return path.tessellation();
+    }
+
+  fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> &r(m_tessellation_levels[level]);
+  if(!r)
+    {
+      fastuidraw::TessellatedPath::TessellationParams params(m_tessellation_params);
+
+      params.m_curve_tessellation = std::ldexp(params.m_curve_tessellation, -level);
+      if(level > 0)
+        {
+          params.m_max_segments <<= level;
+        }
+      r = FASTUIDRAWnew fastuidraw::TessellatedPath(path, params);
+    }
+  return r;
+}
+
 PathPrivate::
 PathPrivate(const PathPrivate &obj):
   m_tessellation_params(obj.m_tessellation_params),
   m_tessellation(obj.m_tessellation),
+  m_tessellation_levels(obj.m_tessellation_levels),
+  m_simplified_levels(obj.m_simplified_levels),
+  m_tessellation_job(obj.m_tessellation_job),
   m_contours(obj.m_contours)
 {
   /* if the last contour is not ended, we need to do a
      deep copy on it.
    */
-  if(!m_contours.back()->ended())
+  if(!m_contours.empty() && !m_contours.back()->ended())
     {
       m_contours.back() = m_contours.back()->deep_copy();
     }
@@ -1083,7 +1439,7 @@ clear(void)
 {
   PathPrivate *d;
   d = reinterpret_cast<PathPrivate*>(m_d);
-  d->m_tessellation.clear();
+  d->clear_tessellation();
   d->m_contours.clear();
 }
 
@@ -1102,7 +1458,7 @@ add_contour(const reference_counted_ptr<const PathContour> &pcontour)
   reference_counted_ptr<PathContour> contour;
   contour = pcontour.const_cast_ptr<PathContour>();
 
-  d->m_tessellation.clear();
+  d->clear_tessellation();
   if(d->m_contours.empty() || d->m_contours.back()->ended())
     {
       d->m_contours.push_back(contour);
@@ -1128,7 +1484,7 @@ add_contours(const Path &path)
 
   if(d != pd && !pd->m_contours.empty())
     {
-      d->m_tessellation.clear();
+      d->clear_tessellation();
       d->m_contours.reserve(d->m_contours.size() + pd->m_contours.size());
 
       reference_counted_ptr<PathContour> r;
@@ -1209,7 +1565,7 @@ tessellation_params(const fastuidraw::TessellatedPath::TessellationParams &p)
    */
   if(p != d->m_tessellation_params)
     {
-      d->m_tessellation = reference_counted_ptr<const TessellatedPath>();
+      d->clear_tessellation();
     }
   d->m_tessellation_params = p;
 }
@@ -1222,12 +1578,135 @@ tessellation(void) const
   d = reinterpret_cast<PathPrivate*>(m_d);
   if(!d->m_tessellation)
     {
-      d->m_tessellation = FASTUIDRAWnew TessellatedPath(*this,
-                                                        d->m_tessellation_params);
+      if(d->m_tessellation_job)
+        {
+          d->m_tessellation = d->m_tessellation_job->tessellation();
+          d->m_tessellation_job.clear();
+        }
+      else
+        {
+          d->m_tessellation = FASTUIDRAWnew TessellatedPath(*this,
+                                                            d->m_tessellation_params);
+        }
     }
   return d->m_tessellation;
 }
 
+fastuidraw::reference_counted_ptr<const fastuidraw::PathTessellationPool::Job>
+fastuidraw::Path::
+tessellate_async(const reference_counted_ptr<PathTessellationPool> &pool) const
+{
+  PathPrivate *d;
+  d = reinterpret_cast<PathPrivate*>(m_d);
+
+  assert(pool);
+  if(!d->m_tessellation && !d->m_tessellation_job)
+    {
+      d->m_tessellation_job = pool->add_job(*this);
+    }
+  return d->m_tessellation_job;
+}
+
+bool
+fastuidraw::Path::
+tessellation_pending(void) const
+{
+  PathPrivate *d;
+  d = reinterpret_cast<PathPrivate*>(m_d);
+  return d->m_tessellation_job && !d->m_tessellation_job->ready();
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+fastuidraw::Path::
+tessellation(float max_distance) const
+{
+  PathPrivate *d;
+  d = reinterpret_cast<PathPrivate*>(m_d);
+
+  const reference_counted_ptr<const TessellatedPath> &base(tessellation());
+  float base_distance(base->max_distance());
+
+  if(max_distance <= 0.0f || base_distance <= 0.0f)
+    {
+      return base;
+    }
+
+  /* Each level scales the curvature threshhold by 1/2 which
+     (because the distance from an arc to its chord varies
+     as the square of the angle of the arc) scales the error
+     by roughly 1/4; use that to guess the level, then walk
+     to coarser levels while the bound is still met, or to
+     finer levels until it is met. The guess is usually
+     right or off by one, so only a few levels are made.
+   */
+  int level;
+  float ratio(base_distance / max_distance);
+
+  if(ratio <= 1.0f)
+    {
+      level = -static_cast<int>(std::floor(0.5f * std::log2(1.0f / ratio)));
+      level = t_max(level, min_tessellation_level);
+    }
+  else
+    {
+      level = static_cast<int>(std::ceil(0.5f * std::log2(ratio)));
+      level = t_min(level, max_tessellation_level);
+    }
+
+  if(d->tessellation_level(*this, level)->max_distance() <= max_distance)
+    {
+      while(level > min_tessellation_level
+            && d->tessellation_level(*this, level - 1)->max_distance() <= max_distance)
+        {
+          --level;
+        }
+    }
+  else
+    {
+      while(level < max_tessellation_level
+            && d->tessellation_level(*this, level)->max_distance() > max_distance)
+        {
+          ++level;
+        }
+    }
+  return d->tessellation_level(*this, level);
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+fastuidraw::Path::
+simplified_tessellation(float max_distance) const
+{
+  PathPrivate *d;
+  d = reinterpret_cast<PathPrivate*>(m_d);
+
+  if(max_distance <= 0.0f)
+    {
+      return tessellation();
+    }
+
+  /* round the distance down to a power of 2 so that the
+     cache holds only a few levels; the tessellation of the
+     curves is given up to half of the distance and the
+     simplification of the segments whatever that tessellation
+     leaves, so that the TessellatedPath::max_distance() of
+     the result is no more than the distance.
+   */
+  int level;
+  float distance;
+
+  level = static_cast<int>(std::floor(std::log2(max_distance)));
+  reference_counted_ptr<const TessellatedPath> &r(d->m_simplified_levels[level]);
+  if(!r)
+    {
+      const TessellatedPath *tess;
+
+      distance = std::ldexp(1.0f, level);
+      tess = tessellation(0.5f * distance).get();
+      r = FASTUIDRAWnew TessellatedPath(*tess, t_max(0.0f, distance - tess->max_distance()));
+    }
+  return r;
+}
+
 fastuidraw::Path&
 fastuidraw::Path::
 operator<<(const control_point &pt)
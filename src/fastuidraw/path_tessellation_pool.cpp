@@ -0,0 +1,472 @@
+/*!
+ * \file path_tessellation_pool.cpp
+ * \brief file path_tessellation_pool.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <deque>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/path_tessellation_pool.hpp>
+
+#include "private/util_private.hpp"
+#include "private/path_tessellation_pool_private.hpp"
+
+namespace
+{
+  /* A Task is an entry of the queue of a PathTessellationPool.
+   */
+  class Task:public fastuidraw::reference_counted<Task>::atomic
+  {
+  public:
+    virtual
+    ~Task()
+    {}
+
+    virtual
+    void
+    execute(void) = 0;
+  };
+
+  class JobPrivate:fastuidraw::noncopyable
+  {
+  public:
+    JobPrivate(const fastuidraw::Path &path,
+               const fastuidraw::PathTessellationPool *pool):
+      m_path(path),
+      m_pool(pool),
+      m_ready(false)
+    {}
+
+    void
+    execute(void);
+
+    /* m_path is a copy of the Path made when the job was
+       added, it is cleared when the job completes.
+     */
+    fastuidraw::Path m_path;
+
+    /* the pool that executes the job, it is alive while
+       the job executes because the dtor of the pool waits
+       for all jobs.
+     */
+    const fastuidraw::PathTessellationPool *m_pool;
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> m_tessellation;
+    bool m_ready;
+    mutable boost::mutex m_mutex;
+    mutable boost::condition_variable m_cond;
+  };
+
+  class JobTask:public Task
+  {
+  public:
+    typedef fastuidraw::reference_counted_ptr<fastuidraw::PathTessellationPool::Job> job_handle;
+
+    JobTask(const job_handle &job, JobPrivate *d):
+      m_job(job),
+      m_d(d)
+    {}
+
+    virtual
+    void
+    execute(void)
+    {
+      m_d->execute();
+    }
+
+  private:
+    /* the job handle is held so that the Job is alive until
+       it has been executed, the JobPrivate is the m_d of the
+       Job.
+     */
+    job_handle m_job;
+    JobPrivate *m_d;
+  };
+
+  /* A ParallelFor is shared by the thread that calls
+     PathTessellationPoolAccess::parallel_for() and the
+     ParallelForTask objects it adds to the pool. The ranges
+     are handed out with an atomic counter, so a task that
+     is executed after all ranges have been handed out does
+     nothing; in particular it does not touch m_f, which
+     may be gone by then.
+   */
+  class ParallelFor:public fastuidraw::reference_counted<ParallelFor>::atomic
+  {
+  public:
+    typedef boost::function<void (fastuidraw::range_type<unsigned int>)> function;
+
+    ParallelFor(unsigned int count, unsigned int number_ranges,
+                const function &f):
+      m_count(count),
+      m_number_ranges(number_ranges),
+      m_f(f),
+      m_next_range(0),
+      m_ranges_done(0)
+    {}
+
+    /* process ranges until all have been handed out,
+       returns the number of ranges processed.
+     */
+    unsigned int
+    run(void);
+
+    /* mark ranges as done and wake the waiting thread
+       if all ranges are done
+     */
+    void
+    mark_done(unsigned int number);
+
+    void
+    wait(void);
+
+  private:
+    unsigned int m_count, m_number_ranges;
+    const function &m_f;
+    boost::atomic<unsigned int> m_next_range;
+    unsigned int m_ranges_done;
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+  };
+
+  class ParallelForTask:public Task
+  {
+  public:
+    explicit
+    ParallelForTask(const fastuidraw::reference_counted_ptr<ParallelFor> &p):
+      m_p(p)
+    {}
+
+    virtual
+    void
+    execute(void)
+    {
+      unsigned int n;
+
+      n = m_p->run();
+      if(n > 0)
+        {
+          m_p->mark_done(n);
+        }
+    }
+
+  private:
+    fastuidraw::reference_counted_ptr<ParallelFor> m_p;
+  };
+
+  class PathTessellationPoolPrivate:fastuidraw::noncopyable
+  {
+  public:
+    explicit
+    PathTessellationPoolPrivate(unsigned int number_threads);
+
+    ~PathTessellationPoolPrivate();
+
+    void
+    worker(void);
+
+    void
+    add_task(const fastuidraw::reference_counted_ptr<Task> &task);
+
+    unsigned int m_number_threads;
+    std::deque<fastuidraw::reference_counted_ptr<Task> > m_queue;
+    bool m_stop;
+    boost::mutex m_mutex;
+    boost::condition_variable m_cond;
+    boost::thread_group m_threads;
+  };
+}
+
+/////////////////////////////////////
+// JobPrivate methods
+void
+JobPrivate::
+execute(void)
+{
+  fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> tess;
+
+  /* construct the parts of the path that any drawing of it
+     needs: the tessellation, the triangulation of the fill
+     and the edges of the stroke. The PainterAttributeData
+     and the hierarchies of those depend on how the path is
+     drawn; they stay lazy and are made by the thread drawing
+     the path for only the styles it uses.
+   */
+  tess = FASTUIDRAWnew fastuidraw::TessellatedPath(m_path, m_path.tessellation_params(), m_pool);
+  tess->filled();
+  tess->stroked();
+  m_path.clear();
+
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+  m_tessellation = tess;
+  m_ready = true;
+  m_cond.notify_all();
+}
+
+/////////////////////////////////////////////
+// ParallelFor methods
+unsigned int
+ParallelFor::
+run(void)
+{
+  unsigned int number_done(0);
+
+  for(;;)
+    {
+      unsigned int r;
+
+      r = m_next_range.fetch_add(1);
+      if(r >= m_number_ranges)
+        {
+          return number_done;
+        }
+
+      /* range r is [r * count / N, (r + 1) * count / N) */
+      uint64_t b, e;
+      b = (static_cast<uint64_t>(r) * m_count) / m_number_ranges;
+      e = (static_cast<uint64_t>(r + 1) * m_count) / m_number_ranges;
+      m_f(fastuidraw::range_type<unsigned int>(b, e));
+      ++number_done;
+    }
+}
+
+void
+ParallelFor::
+mark_done(unsigned int number)
+{
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+  m_ranges_done += number;
+  if(m_ranges_done == m_number_ranges)
+    {
+      m_cond.notify_all();
+    }
+}
+
+void
+ParallelFor::
+wait(void)
+{
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  while(m_ranges_done != m_number_ranges)
+    {
+      m_cond.wait(lock);
+    }
+}
+
+/////////////////////////////////////////////
+// PathTessellationPoolPrivate methods
+PathTessellationPoolPrivate::
+PathTessellationPoolPrivate(unsigned int number_threads):
+  m_number_threads(fastuidraw::t_max(number_threads, 1u)),
+  m_stop(false)
+{
+  for(unsigned int i = 0; i < m_number_threads; ++i)
+    {
+      m_threads.create_thread(boost::bind(&PathTessellationPoolPrivate::worker, this));
+    }
+}
+
+PathTessellationPoolPrivate::
+~PathTessellationPoolPrivate()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  m_threads.join_all();
+  assert(m_queue.empty());
+}
+
+void
+PathTessellationPoolPrivate::
+worker(void)
+{
+  for(;;)
+    {
+      fastuidraw::reference_counted_ptr<Task> task;
+
+      {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        while(m_queue.empty() && !m_stop)
+          {
+            m_cond.wait(lock);
+          }
+
+        /* only stop once all jobs are taken so that no
+           Job is left waiting forever.
+         */
+        if(m_queue.empty())
+          {
+            return;
+          }
+        task = m_queue.front();
+        m_queue.pop_front();
+      }
+
+      task->execute();
+    }
+}
+
+void
+PathTessellationPoolPrivate::
+add_task(const fastuidraw::reference_counted_ptr<Task> &task)
+{
+  {
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    m_queue.push_back(task);
+  }
+  m_cond.notify_one();
+}
+
+/////////////////////////////////////////////
+// fastuidraw::PathTessellationPool::Job methods
+fastuidraw::PathTessellationPool::Job::
+Job(const Path &path, const PathTessellationPool *pool)
+{
+  m_d = FASTUIDRAWnew JobPrivate(path, pool);
+}
+
+fastuidraw::PathTessellationPool::Job::
+~Job()
+{
+  JobPrivate *d;
+  d = reinterpret_cast<JobPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+bool
+fastuidraw::PathTessellationPool::Job::
+ready(void) const
+{
+  JobPrivate *d;
+  d = reinterpret_cast<JobPrivate*>(m_d);
+
+  boost::lock_guard<boost::mutex> lock(d->m_mutex);
+  return d->m_ready;
+}
+
+void
+fastuidraw::PathTessellationPool::Job::
+wait(void) const
+{
+  JobPrivate *d;
+  d = reinterpret_cast<JobPrivate*>(m_d);
+
+  boost::unique_lock<boost::mutex> lock(d->m_mutex);
+  while(!d->m_ready)
+    {
+      d->m_cond.wait(lock);
+    }
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+fastuidraw::PathTessellationPool::Job::
+tessellation(void) const
+{
+  JobPrivate *d;
+  d = reinterpret_cast<JobPrivate*>(m_d);
+
+  wait();
+  /* once m_ready is true, m_tessellation is never written
+     again, so it can be returned without holding the lock.
+   */
+  return d->m_tessellation;
+}
+
+/////////////////////////////////////////////
+// fastuidraw::PathTessellationPool methods
+fastuidraw::PathTessellationPool::
+PathTessellationPool(unsigned int number_threads)
+{
+  m_d = FASTUIDRAWnew PathTessellationPoolPrivate(number_threads);
+}
+
+fastuidraw::PathTessellationPool::
+~PathTessellationPool()
+{
+  PathTessellationPoolPrivate *d;
+  d = reinterpret_cast<PathTessellationPoolPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+unsigned int
+fastuidraw::PathTessellationPool::
+number_threads(void) const
+{
+  PathTessellationPoolPrivate *d;
+  d = reinterpret_cast<PathTessellationPoolPrivate*>(m_d);
+  return d->m_number_threads;
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PathTessellationPool::Job>
+fastuidraw::PathTessellationPool::
+add_job(const Path &path)
+{
+  PathTessellationPoolPrivate *d;
+  reference_counted_ptr<Job> job;
+
+  d = reinterpret_cast<PathTessellationPoolPrivate*>(m_d);
+  job = FASTUIDRAWnew Job(path, this);
+  d->add_task(FASTUIDRAWnew JobTask(job, reinterpret_cast<JobPrivate*>(job->m_d)));
+  return job;
+}
+
+/////////////////////////////////////////////
+// fastuidraw::detail::PathTessellationPoolAccess methods
+void
+fastuidraw::detail::PathTessellationPoolAccess::
+parallel_for(const PathTessellationPool &pool, unsigned int count,
+             const boost::function<void (range_type<unsigned int>)> &f)
+{
+  PathTessellationPoolPrivate *d;
+  unsigned int number_ranges, n;
+
+  d = reinterpret_cast<PathTessellationPoolPrivate*>(pool.m_d);
+  if(count == 0)
+    {
+      return;
+    }
+
+  /* use a few ranges per thread so that threads finishing
+     early can help with the remaining ranges; the calling
+     thread works on the ranges as well.
+   */
+  number_ranges = t_min(count, 4u * (d->m_number_threads + 1u));
+  if(number_ranges == 1)
+    {
+      f(range_type<unsigned int>(0, count));
+      return;
+    }
+
+  reference_counted_ptr<ParallelFor> p;
+  p = FASTUIDRAWnew ParallelFor(count, number_ranges, f);
+  for(unsigned int i = 0; i < d->m_number_threads; ++i)
+    {
+      d->add_task(FASTUIDRAWnew ParallelForTask(p));
+    }
+
+  n = p->run();
+  if(n > 0)
+    {
+      p->mark_done(n);
+    }
+  p->wait();
+}
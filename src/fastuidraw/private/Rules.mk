@@ -4,7 +4,7 @@ dirstack_$(sp)	:= $(d)
 d		:= $(dir)
 # End standard header
 
-LIBRARY_PRIVATE_SOURCES += $(call filelist, interval_allocator.cpp)
+LIBRARY_PRIVATE_SOURCES += $(call filelist, interval_allocator.cpp sweep_triangulator.cpp)
 
 # Begin standard footer
 d		:= $(dirstack_$(sp))
@@ -0,0 +1,55 @@
+/*!
+ * \file path_tessellation_pool_private.hpp
+ * \brief file path_tessellation_pool_private.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <boost/function.hpp>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/path_tessellation_pool.hpp>
+
+namespace fastuidraw
+{
+namespace detail
+{
+  /*!\class PathTessellationPoolAccess
+    Gives the implementation of fastuidraw access to
+    the worker threads of a PathTessellationPool.
+   */
+  class PathTessellationPoolAccess
+  {
+  public:
+    /*!
+      Partitions [0, count) into consecutive ranges and calls
+      f on each of them, from the worker threads of a
+      PathTessellationPool and from the calling thread. Returns
+      once f has returned for every range. The calling thread
+      takes ranges as well and only waits for the ranges that
+      other threads have started, so it is safe to call from a
+      worker thread of the pool, e.g. from a Job.
+      \param pool PathTessellationPool whose workers to use
+      \param count number of elements to process
+      \param f function to process a range of elements
+     */
+    static
+    void
+    parallel_for(const PathTessellationPool &pool, unsigned int count,
+                 const boost::function<void (range_type<unsigned int>)> &f);
+  };
+}
+}
@@ -0,0 +1,780 @@
+/*!
+ * \file sweep_triangulator.cpp
+ * \brief file sweep_triangulator.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <assert.h>
+#include <algorithm>
+#include <limits>
+#include <fastuidraw/util/fastuidraw_memory.hpp>
+#include "sweep_triangulator.hpp"
+
+namespace
+{
+  /* Sets a + b = x + y exactly, with x the rounded sum */
+  void
+  two_sum(double a, double b, double &x, double &y)
+  {
+    double bv, av;
+
+    x = a + b;
+    bv = x - a;
+    av = x - bv;
+    y = (a - av) + (b - bv);
+  }
+
+  /* Returns the sign of the exact sum of the n <= 8 values v,
+     accumulated as a non-overlapping expansion (Shewchuk); the
+     sign of the sum is the sign of the largest component.
+   */
+  int
+  exact_sign(const double *v, unsigned int n)
+  {
+    double e[8];
+    unsigned int m(0);
+
+    assert(n <= 8);
+    for(unsigned int i = 0; i < n; ++i)
+      {
+        double q(v[i]);
+        unsigned int k(0);
+
+        for(unsigned int j = 0; j < m; ++j)
+          {
+            double h;
+
+            two_sum(q, e[j], q, h);
+            if(h != 0.0)
+              {
+                e[k++] = h;
+              }
+          }
+        if(q != 0.0)
+          {
+            e[k++] = q;
+          }
+        m = k;
+      }
+    return (m == 0) ? 0 : (e[m - 1] > 0.0) ? 1 : -1;
+  }
+
+  /* Returns the sign of the cross product of b - a with p - a,
+     i.e. for a.y() < b.y(), positive if p is to the left of the
+     line through a and b. The products of two floats are exact
+     as doubles, so the only rounding is in their sum.
+   */
+  int
+  orientation(const fastuidraw::vec2 &a, const fastuidraw::vec2 &b,
+              const fastuidraw::vec2 &p)
+  {
+    double v[6] =
+      {
+        double(b.x()) * double(p.y()),
+        -double(b.x()) * double(a.y()),
+        -double(a.x()) * double(p.y()),
+        -double(b.y()) * double(p.x()),
+        double(b.y()) * double(a.x()),
+        double(a.y()) * double(p.x())
+      };
+    return exact_sign(v, 6);
+  }
+
+  /* Returns the sign of the cross product of the direction
+     of the edge e with the direction of the edge n.
+   */
+  template<typename T>
+  int
+  direction_orientation(const T *e, const T *n)
+  {
+    const fastuidraw::vec2 &a1(e->m_start), &b1(e->m_end);
+    const fastuidraw::vec2 &a2(n->m_start), &b2(n->m_end);
+    double v[8] =
+      {
+        double(b1.x()) * double(b2.y()),
+        -double(b1.x()) * double(a2.y()),
+        -double(a1.x()) * double(b2.y()),
+        double(a1.x()) * double(a2.y()),
+        -double(b1.y()) * double(b2.x()),
+        double(b1.y()) * double(a2.x()),
+        double(a1.y()) * double(b2.x()),
+        -double(a1.y()) * double(a2.x())
+      };
+    return exact_sign(v, 8);
+  }
+
+  /* Returns -1 if the edge n, which starts at a point that
+     the edge e crosses or starts at, is to the left of e just
+     below that point and 1 if it is to the right. Edges that
+     overlap are ordered by address so that both are in the set.
+   */
+  template<typename T>
+  int
+  compare_at_start(const T *n, const T *e)
+  {
+    int s;
+
+    s = orientation(e->m_start, e->m_end, n->m_start);
+    if(s == 0)
+      {
+        s = direction_orientation(e, n);
+      }
+
+    if(s != 0)
+      {
+        return (s > 0) ? -1 : 1;
+      }
+    return (n < e) ? -1 : 1;
+  }
+
+  /* Returns true if the edges lhs and rhs, with lhs to the left
+     of rhs at y, are in the other order at y_next. If so, gives
+     the y-coordinate at which they cross, clamped to be no less
+     than y. Since the order at y_next is the order at the end of
+     the first of the two edges to end, a pair of edges crosses at
+     most once.
+   */
+  template<typename T>
+  bool
+  compute_crossing(const T *lhs, const T *rhs,
+                   float y, float y_next, float &y_crossing)
+  {
+    float lhs_next, rhs_next, num, den;
+
+    if(lhs->m_side != 0 || rhs->m_side != 0)
+      {
+        return false;
+      }
+
+    lhs_next = lhs->x_at(y_next);
+    rhs_next = rhs->x_at(y_next);
+    if(!(lhs_next > rhs_next))
+      {
+        return false;
+      }
+
+    num = rhs->x_at(y) - lhs->x_at(y);
+    den = num + (lhs_next - rhs_next);
+    if(num <= 0.0f)
+      {
+        /* the edges already touch at y */
+        y_crossing = y;
+      }
+    else
+      {
+        y_crossing = std::max(y, y + (num / den) * (y_next - y));
+      }
+
+    /* a crossing that rounds to y_next is handled by the
+       removal of the edge that ends at y_next
+     */
+    return y_crossing < y_next;
+  }
+}
+
+/////////////////////////////////////
+// fastuidraw::sweep_triangulator::active_edge_sorter methods
+bool
+fastuidraw::sweep_triangulator::active_edge_sorter::
+operator()(const active_edge &lhs, const active_edge &rhs) const
+{
+  const edge *l(lhs.m_edge), *r(rhs.m_edge);
+
+  if(l->m_side != r->m_side)
+    {
+      return l->m_side < r->m_side;
+    }
+
+  if(l == r)
+    {
+      return false;
+    }
+
+  /* one of the two is the edge being inserted, it starts at
+     the event point and the other edge crosses the sweep line
+     there; comparing exactly at that point gives an order that
+     does not change while the set is searched.
+   */
+  if(l->m_start == *m_event_point)
+    {
+      return compare_at_start(l, r) < 0;
+    }
+  assert(r->m_start == *m_event_point);
+  return compare_at_start(r, l) > 0;
+}
+
+/////////////////////////////////////
+// fastuidraw::sweep_triangulator::arena methods
+fastuidraw::sweep_triangulator::arena::
+arena(void):
+  m_block_used(0),
+  m_block_size(0)
+{}
+
+fastuidraw::sweep_triangulator::arena::
+~arena()
+{
+  for(std::vector<char*>::iterator iter = m_blocks.begin(),
+        end = m_blocks.end(); iter != end; ++iter)
+    {
+      FASTUIDRAWfree(*iter);
+    }
+}
+
+void*
+fastuidraw::sweep_triangulator::arena::
+allocate(size_t bytes)
+{
+  /* keep every allocation aligned as malloc aligns */
+  const size_t alignment(16), min_block_size(4096);
+  char *p;
+
+  bytes = (bytes + alignment - 1) & ~(alignment - 1);
+  if(m_blocks.empty() || m_block_used + bytes > m_block_size)
+    {
+      m_block_size = std::max(bytes, std::max(min_block_size, 2 * m_block_size));
+      m_blocks.push_back(static_cast<char*>(FASTUIDRAWmalloc(m_block_size)));
+      m_block_used = 0;
+    }
+  p = m_blocks.back() + m_block_used;
+  m_block_used += bytes;
+  return p;
+}
+
+/////////////////////////////////////////
+// fastuidraw::sweep_triangulator::compare_edge_start methods
+bool
+fastuidraw::sweep_triangulator::compare_edge_start::
+operator()(const edge *lhs, const edge *rhs) const
+{
+  if(lhs->m_start.y() != rhs->m_start.y())
+    {
+      return lhs->m_start.y() < rhs->m_start.y();
+    }
+  return lhs->m_start.x() < rhs->m_start.x();
+}
+
+///////////////////////////////////////
+// fastuidraw::sweep_triangulator methods
+fastuidraw::sweep_triangulator::
+sweep_triangulator(std::vector<vec2> &points):
+  m_points(points),
+  m_event_point(0.0f, 0.0f),
+  m_sweep_edges(active_edge_sorter(&m_event_point),
+                arena_allocator<active_edge>(&m_arena)),
+  m_events(arena_allocator<event>(&m_arena))
+{}
+
+fastuidraw::sweep_triangulator::
+~sweep_triangulator()
+{}
+
+void
+fastuidraw::sweep_triangulator::
+add_edge(unsigned int from, unsigned int to)
+{
+  add_edge(from, to, 0);
+}
+
+void
+fastuidraw::sweep_triangulator::
+set_boundary(unsigned int min_min, unsigned int min_max,
+             unsigned int max_max, unsigned int max_min)
+{
+  FASTUIDRAWunused(max_max);
+  FASTUIDRAWunused(max_min);
+  add_edge(min_min, min_max, -1);
+  add_edge(max_min, max_max, 1);
+}
+
+void
+fastuidraw::sweep_triangulator::
+add_edge(unsigned int from, unsigned int to, int side)
+{
+  const vec2 &p(m_points[from]);
+  const vec2 &q(m_points[to]);
+  edge e;
+
+  /* horizontal edges do not cross the sweep line, the
+     comparison is written so that a NaN is also skipped
+   */
+  if(!(p.y() < q.y()) && !(q.y() < p.y()))
+    {
+      return;
+    }
+
+  if(p.y() < q.y())
+    {
+      e.m_start = p;
+      e.m_end = q;
+      e.m_start_point = from;
+      e.m_end_point = to;
+      e.m_winding_delta = -1;
+    }
+  else
+    {
+      e.m_start = q;
+      e.m_end = p;
+      e.m_start_point = to;
+      e.m_end_point = from;
+      e.m_winding_delta = 1;
+    }
+
+  if(side != 0)
+    {
+      e.m_winding_delta = 0;
+    }
+
+  e.m_slope = (e.m_end.x() - e.m_start.x()) / (e.m_end.y() - e.m_start.y());
+  e.m_side = side;
+  e.m_active = false;
+  e.m_dirty = false;
+  e.m_winding = 0;
+  e.m_right = NULL;
+  e.m_last_node = invalid_node;
+  e.m_last_y = 0.0f;
+  e.m_region_left_node = invalid_node;
+  e.m_region_right_node = invalid_node;
+  e.m_region_winding = 0;
+  m_edges.push_back(e);
+}
+
+void
+fastuidraw::sweep_triangulator::
+add_node(edge *e, float y, unsigned int point)
+{
+  node N;
+
+  N.m_point = point;
+  N.m_next = invalid_node;
+  if(e->m_last_node != invalid_node)
+    {
+      m_nodes[e->m_last_node].m_next = m_nodes.size();
+    }
+  e->m_last_node = m_nodes.size();
+  e->m_last_y = y;
+  m_nodes.push_back(N);
+}
+
+unsigned int
+fastuidraw::sweep_triangulator::
+node_at(edge *e, float y)
+{
+  unsigned int point;
+
+  if(e->m_last_node != invalid_node && e->m_last_y == y)
+    {
+      return e->m_last_node;
+    }
+
+  if(y == e->m_start.y())
+    {
+      point = e->m_start_point;
+    }
+  else if(y == e->m_end.y())
+    {
+      point = e->m_end_point;
+    }
+  else
+    {
+      point = m_points.size();
+      m_points.push_back(vec2(e->x_at(y), y));
+    }
+  add_node(e, y, point);
+  return e->m_last_node;
+}
+
+fastuidraw::sweep_triangulator::edge*
+fastuidraw::sweep_triangulator::
+left_of(edge *e) const
+{
+  active_set::iterator iter(e->m_location);
+
+  assert(e->m_active);
+  if(iter == m_sweep_edges.begin())
+    {
+      return NULL;
+    }
+  --iter;
+  return iter->m_edge;
+}
+
+fastuidraw::sweep_triangulator::edge*
+fastuidraw::sweep_triangulator::
+right_of(edge *e) const
+{
+  active_set::iterator iter(e->m_location);
+
+  assert(e->m_active);
+  ++iter;
+  return (iter == m_sweep_edges.end()) ? NULL : iter->m_edge;
+}
+
+void
+fastuidraw::sweep_triangulator::
+mark_dirty(edge *e)
+{
+  if(!e->m_dirty)
+    {
+      e->m_dirty = true;
+      m_dirty.push_back(e);
+    }
+}
+
+void
+fastuidraw::sweep_triangulator::
+add_crossing(edge *lhs, edge *rhs, float y)
+{
+  float y_crossing;
+
+  if(compute_crossing(lhs, rhs, y, std::min(lhs->m_end.y(), rhs->m_end.y()), y_crossing))
+    {
+      push_event(event(y_crossing, lhs, rhs));
+    }
+}
+
+void
+fastuidraw::sweep_triangulator::
+push_event(const event &ev)
+{
+  m_events.push_back(ev);
+  std::push_heap(m_events.begin(), m_events.end());
+}
+
+fastuidraw::sweep_triangulator::event
+fastuidraw::sweep_triangulator::
+pop_event(void)
+{
+  event ev(m_events.front());
+
+  std::pop_heap(m_events.begin(), m_events.end());
+  m_events.pop_back();
+  return ev;
+}
+
+void
+fastuidraw::sweep_triangulator::
+insert_edge(edge *e, float y)
+{
+  edge *left;
+
+  FASTUIDRAWunused(y);
+  assert(e->m_start.y() == y);
+  m_event_point = e->m_start;
+  e->m_location = m_sweep_edges.insert(active_edge(e)).first;
+  e->m_active = true;
+  mark_dirty(e);
+
+  left = left_of(e);
+  if(left != NULL)
+    {
+      mark_dirty(left);
+    }
+  push_event(event(e->m_end.y(), e, NULL));
+}
+
+void
+fastuidraw::sweep_triangulator::
+remove_edge(edge *e, float y)
+{
+  edge *left;
+
+  /* the region to the left of e is closed by update_regions()
+     since the edge to the left of e gets a new neighbor.
+   */
+  if(e->m_right != NULL)
+    {
+      close_region(e, y);
+      e->m_right = NULL;
+    }
+
+  left = left_of(e);
+  if(left != NULL)
+    {
+      mark_dirty(left);
+    }
+  m_sweep_edges.erase(e->m_location);
+  e->m_active = false;
+}
+
+void
+fastuidraw::sweep_triangulator::
+swap_edges(edge *lhs, edge *rhs, float y)
+{
+  edge *left;
+  bool lhs_has, rhs_has;
+
+  /* both edges get the same point at the crossing */
+  lhs_has = (lhs->m_last_node != invalid_node && lhs->m_last_y == y);
+  rhs_has = (rhs->m_last_node != invalid_node && rhs->m_last_y == y);
+  if(lhs_has && !rhs_has)
+    {
+      add_node(rhs, y, m_nodes[lhs->m_last_node].m_point);
+    }
+  else if(!lhs_has && rhs_has)
+    {
+      add_node(lhs, y, m_nodes[rhs->m_last_node].m_point);
+    }
+  else if(!lhs_has && !rhs_has)
+    {
+      unsigned int point(m_points.size());
+      m_points.push_back(vec2(0.5f * (lhs->x_at(y) + rhs->x_at(y)), y));
+      add_node(lhs, y, point);
+      add_node(rhs, y, point);
+    }
+
+  /* the edges are neighbors, so exchanging them in their
+     locations keeps the set ordered
+   */
+  lhs->m_location->m_edge = rhs;
+  rhs->m_location->m_edge = lhs;
+  std::swap(lhs->m_location, rhs->m_location);
+
+  mark_dirty(lhs);
+  mark_dirty(rhs);
+  left = left_of(rhs);
+  if(left != NULL)
+    {
+      mark_dirty(left);
+    }
+}
+
+void
+fastuidraw::sweep_triangulator::
+update_regions(float y)
+{
+  /* Walk to the right from each edge marked dirty whose left
+     neighbor is not, recomputing the winding number of the
+     regions. The walk continues past the dirty edges and past
+     the edges whose winding number changes, which happens
+     between the end points of a horizontal edge at y; once an
+     edge that is not dirty keeps its winding number, the
+     regions to its right are unchanged.
+   */
+  for(unsigned int i = 0; i < m_dirty.size(); ++i)
+    {
+      edge *e(m_dirty[i]), *left;
+
+      if(!e->m_dirty || !e->m_active)
+        {
+          continue;
+        }
+
+      left = left_of(e);
+      if(left != NULL && left->m_dirty)
+        {
+          continue;
+        }
+
+      while(e != NULL)
+        {
+          edge *right(right_of(e));
+          int winding((left != NULL) ? left->m_winding : 0);
+          bool new_neighbor(e->m_right != right);
+
+          winding += e->m_winding_delta;
+
+          /* a region is closed when the edges that bound it are
+             no longer neighbors or when a horizontal edge at y
+             cuts it
+           */
+          if(e->m_right != NULL && (new_neighbor || e->m_region_winding != winding))
+            {
+              close_region(e, y);
+              e->m_right = NULL;
+            }
+
+          if(e->m_right == NULL && right != NULL)
+            {
+              e->m_region_left_node = node_at(e, y);
+              e->m_region_right_node = node_at(right, y);
+              e->m_region_winding = winding;
+              e->m_right = right;
+            }
+
+          if(new_neighbor && right != NULL)
+            {
+              add_crossing(e, right, y);
+            }
+
+          e->m_winding = winding;
+          e->m_dirty = false;
+          if(right == NULL
+             || (!right->m_dirty && right->m_winding == winding + right->m_winding_delta))
+            {
+              break;
+            }
+          left = e;
+          e = right;
+        }
+    }
+
+  for(std::vector<edge*>::const_iterator iter = m_dirty.begin(),
+        end = m_dirty.end(); iter != end; ++iter)
+    {
+      (*iter)->m_dirty = false;
+    }
+  m_dirty.clear();
+}
+
+void
+fastuidraw::sweep_triangulator::
+close_region(edge *e, float y)
+{
+  unsigned int left, right, left_end, right_end;
+  int winding(e->m_region_winding);
+
+  left = e->m_region_left_node;
+  right = e->m_region_right_node;
+  left_end = node_at(e, y);
+  right_end = node_at(e->m_right, y);
+
+  /* the region is a trapezoid whose sides carry the points
+     added to them while the region was open; walk up both
+     sides, always advancing the side whose next point
+     is lower.
+   */
+  while(left != left_end || right != right_end)
+    {
+      bool advance_left;
+
+      if(left == left_end)
+        {
+          advance_left = false;
+        }
+      else if(right == right_end)
+        {
+          advance_left = true;
+        }
+      else
+        {
+          advance_left = m_points[m_nodes[m_nodes[left].m_next].m_point].y()
+            <= m_points[m_nodes[m_nodes[right].m_next].m_point].y();
+        }
+
+      if(advance_left)
+        {
+          unsigned int next(m_nodes[left].m_next);
+          emit_triangle(winding, m_nodes[left].m_point,
+                        m_nodes[next].m_point, m_nodes[right].m_point);
+          left = next;
+        }
+      else
+        {
+          unsigned int next(m_nodes[right].m_next);
+          emit_triangle(winding, m_nodes[left].m_point,
+                        m_nodes[right].m_point, m_nodes[next].m_point);
+          right = next;
+        }
+    }
+}
+
+void
+fastuidraw::sweep_triangulator::
+emit_triangle(int winding_number, unsigned int a,
+              unsigned int b, unsigned int c)
+{
+  vec2 ab, ac;
+
+  if(a == b || a == c || b == c)
+    {
+      return;
+    }
+
+  ab = m_points[b] - m_points[a];
+  ac = m_points[c] - m_points[a];
+  if(ab.x() * ac.y() - ab.y() * ac.x() == 0.0f)
+    {
+      return;
+    }
+  add_triangle(winding_number, a, b, c);
+}
+
+void
+fastuidraw::sweep_triangulator::
+triangulate(void)
+{
+  unsigned int p(0);
+
+  m_pending.clear();
+  m_pending.reserve(m_edges.size());
+  for(std::vector<edge>::iterator iter = m_edges.begin(),
+        end = m_edges.end(); iter != end; ++iter)
+    {
+      m_pending.push_back(&*iter);
+    }
+  std::sort(m_pending.begin(), m_pending.end(), compare_edge_start());
+
+  /* each edge gets at least two points */
+  m_nodes.reserve(3 * m_edges.size());
+
+  /* each edge has an end event and usually at most one
+     pending crossing with its right neighbor
+   */
+  m_events.reserve(2 * m_edges.size());
+
+  while(p < m_pending.size() || !m_events.empty())
+    {
+      float y;
+
+      /* the next event is the lowest of the start of an edge
+         not yet reached, the end of an edge crossing the sweep
+         line and the crossing of two neighboring edges
+       */
+      y = (p < m_pending.size()) ?
+        m_pending[p]->m_start.y() :
+        std::numeric_limits<float>::max();
+
+      if(!m_events.empty() && m_events.front().m_y <= y)
+        {
+          y = m_events.front().m_y;
+          if(m_events.front().is_crossing())
+            {
+              /* a crossing is stale if the edges are no longer
+                 neighbors, e.g. because an edge started between
+                 them or because they already crossed
+               */
+              while(!m_events.empty() && m_events.front().m_y == y
+                    && m_events.front().is_crossing())
+                {
+                  event ev(pop_event());
+
+                  if(ev.m_lhs->m_active && ev.m_rhs->m_active
+                     && right_of(ev.m_lhs) == ev.m_rhs)
+                    {
+                      swap_edges(ev.m_lhs, ev.m_rhs, y);
+                    }
+                }
+              update_regions(y);
+              continue;
+            }
+        }
+
+      while(!m_events.empty() && m_events.front().m_y == y)
+        {
+          event ev(pop_event());
+
+          assert(!ev.is_crossing());
+          remove_edge(ev.m_lhs, y);
+        }
+
+      for(; p < m_pending.size() && m_pending[p]->m_start.y() == y; ++p)
+        {
+          insert_edge(m_pending[p], y);
+        }
+      update_regions(y);
+    }
+}
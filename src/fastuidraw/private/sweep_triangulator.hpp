@@ -0,0 +1,429 @@
+/*!
+ * \file sweep_triangulator.hpp
+ * \brief file sweep_triangulator.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <set>
+#include <new>
+#include <cstddef>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+
+namespace fastuidraw
+{
+  /*!\class sweep_triangulator
+    A sweep_triangulator triangulates the regions of the plane cut
+    by a set of closed contours, giving for each triangle the
+    winding number of the region it covers. The region outside of
+    the contours but within a bounding box is also triangulated
+    and reported with winding number 0.
+
+    The implementation sweeps a horizontal line upwards through the
+    plane. Between two consecutive events (a vertex of a contour or
+    the crossing of two edges) the edges crossing the sweep line are
+    kept sorted by x in a balanced tree and the region between two
+    neighboring edges is a trapezoid. As in the Bentley-Ottmann
+    algorithm, the ends of the edges and the crossings of neighboring
+    edges are kept in a priority queue and an event only visits the
+    edges whose neighbors change, so the cost is O((n + k) log n)
+    for n edges that cross k times. A trapezoid is emitted as triangles only when
+    one of its two edges changes or when a horizontal edge cuts it;
+    the points that were added on its edges in the meantime (by the
+    trapezoids on the other side of those edges) are used, so the
+    triangles do not have T-junctions along the edges. All edges
+    are allocated in one array before the sweep starts and the
+    points added on the edges are kept in a single array as well;
+    the nodes of the tree and the events come from an arena that
+    is released with the sweep_triangulator.
+
+    An edge is placed in the tree with exact orientation tests
+    against its start point, so the order of the tree does not
+    depend on rounding x-coordinates at the sweep line.
+   */
+  class sweep_triangulator:fastuidraw::noncopyable
+  {
+  public:
+    /*!\fn
+      Ctor.
+      \param points points of the contours; the points created by
+                    the triangulation are appended to it
+     */
+    explicit
+    sweep_triangulator(std::vector<vec2> &points);
+
+    virtual
+    ~sweep_triangulator();
+
+    /*!\fn
+      Add an edge of a contour, all edges must be added before
+      triangulate() is called. The edges of a contour must be
+      added with the same orientation as the contour.
+      \param from index into the points of the start of the edge
+      \param to index into the points of the end of the edge
+     */
+    void
+    add_edge(unsigned int from, unsigned int to);
+
+    /*!\fn
+      Set the bounding box within which the region of winding
+      number 0 is triangulated. The box must strictly contain
+      all the points of the edges.
+      \param min_min index of the point (xmin, ymin)
+      \param min_max index of the point (xmin, ymax)
+      \param max_max index of the point (xmax, ymax)
+      \param max_min index of the point (xmax, ymin)
+     */
+    void
+    set_boundary(unsigned int min_min, unsigned int min_max,
+                 unsigned int max_max, unsigned int max_min);
+
+    /*!\fn
+      Perform the triangulation, calling add_triangle()
+      for each triangle.
+     */
+    void
+    triangulate(void);
+
+  protected:
+    /*!\fn
+      To be implemented by a derived class to receive
+      the triangles of the triangulation.
+      \param winding_number winding number of the triangle
+      \param a index into the points of a corner of the triangle
+      \param b index into the points of a corner of the triangle
+      \param c index into the points of a corner of the triangle
+     */
+    virtual
+    void
+    add_triangle(int winding_number, unsigned int a,
+                 unsigned int b, unsigned int c) = 0;
+
+  private:
+    enum
+      {
+        invalid_node = ~0u
+      };
+
+    class edge;
+
+    /* memory handed out in blocks that are only released
+       when the arena is destroyed; deallocating is a no-op.
+     */
+    class arena:fastuidraw::noncopyable
+    {
+    public:
+      arena(void);
+
+      ~arena();
+
+      void*
+      allocate(size_t bytes);
+
+    private:
+      std::vector<char*> m_blocks;
+      size_t m_block_used, m_block_size;
+    };
+
+    /* allocator of the containers of the sweep, from an arena */
+    template<typename T>
+    class arena_allocator
+    {
+    public:
+      typedef T value_type;
+      typedef T *pointer;
+      typedef const T *const_pointer;
+      typedef T &reference;
+      typedef const T &const_reference;
+      typedef size_t size_type;
+      typedef ptrdiff_t difference_type;
+
+      template<typename U>
+      class rebind
+      {
+      public:
+        typedef arena_allocator<U> other;
+      };
+
+      explicit
+      arena_allocator(arena *a):
+        m_arena(a)
+      {}
+
+      template<typename U>
+      arena_allocator(const arena_allocator<U> &obj):
+        m_arena(obj.m_arena)
+      {}
+
+      pointer
+      address(reference v) const
+      {
+        return &v;
+      }
+
+      const_pointer
+      address(const_reference v) const
+      {
+        return &v;
+      }
+
+      pointer
+      allocate(size_type n, const void *hint = NULL)
+      {
+        FASTUIDRAWunused(hint);
+        return static_cast<pointer>(m_arena->allocate(n * sizeof(T)));
+      }
+
+      void
+      deallocate(pointer p, size_type n)
+      {
+        FASTUIDRAWunused(p);
+        FASTUIDRAWunused(n);
+      }
+
+      size_type
+      max_size(void) const
+      {
+        return ~size_type(0) / sizeof(T);
+      }
+
+      void
+      construct(pointer p, const_reference v)
+      {
+        new(p) T(v);
+      }
+
+      void
+      destroy(pointer p)
+      {
+        p->~T();
+      }
+
+      bool
+      operator==(const arena_allocator &rhs) const
+      {
+        return m_arena == rhs.m_arena;
+      }
+
+      bool
+      operator!=(const arena_allocator &rhs) const
+      {
+        return m_arena != rhs.m_arena;
+      }
+
+      arena *m_arena;
+    };
+
+    /* an element of the set of edges crossing the sweep line, the
+       edge is mutable so that two neighbors can be swapped at their
+       crossing without changing the structure of the set
+     */
+    class active_edge
+    {
+    public:
+      explicit
+      active_edge(edge *e):
+        m_edge(e)
+      {}
+
+      mutable edge *m_edge;
+    };
+
+    /* orders the edges by where they cross the sweep line; the
+       set only compares the edge being inserted, which starts
+       at the event point, against the edges already in it.
+     */
+    class active_edge_sorter
+    {
+    public:
+      explicit
+      active_edge_sorter(const vec2 *event_point):
+        m_event_point(event_point)
+      {}
+
+      bool
+      operator()(const active_edge &lhs, const active_edge &rhs) const;
+
+      const vec2 *m_event_point;
+    };
+
+    typedef std::set<active_edge, active_edge_sorter, arena_allocator<active_edge> > active_set;
+
+    /* a node in the list of points on an edge, the
+       points on an edge are listed in increasing y
+     */
+    class node
+    {
+    public:
+      unsigned int m_point;
+      unsigned int m_next;
+    };
+
+    /* an edge is oriented so that m_start.y() < m_end.y() */
+    class edge
+    {
+    public:
+      float
+      x_at(float y) const
+      {
+        return (y <= m_start.y()) ? m_start.x() :
+          (y >= m_end.y()) ? m_end.x() :
+          m_start.x() + (y - m_start.y()) * m_slope;
+      }
+
+      vec2 m_start, m_end;
+      unsigned int m_start_point, m_end_point;
+      float m_slope;
+
+      /* change in winding number when crossing the
+         edge from left to right */
+      int m_winding_delta;
+
+      /* -1 for the left side of the bounding box, 1 for
+         the right side and 0 for edges of the contours */
+      int m_side;
+
+      /* location in the set of edges crossing the sweep line,
+         only valid while m_active is true */
+      active_set::iterator m_location;
+      bool m_active;
+
+      /* true if the edge is in the list of edges whose neighbor
+         on the right or winding number may have changed */
+      bool m_dirty;
+
+      /* winding number of the region to the right of the edge */
+      int m_winding;
+
+      /* neighbor on the right with which the region to the
+         right of the edge is open, NULL if there is none */
+      edge *m_right;
+
+      /* last node added to the list of points of the
+         edge and the y-coordinate of its point */
+      unsigned int m_last_node;
+      float m_last_y;
+
+      /* the region to the right of the edge is open since
+         the points at the given nodes of this edge and of
+         m_right. */
+      unsigned int m_region_left_node, m_region_right_node;
+      int m_region_winding;
+    };
+
+    /* an event of the priority queue: the end of an edge
+       or the crossing of two neighboring edges; for events
+       at the same y, crossings come first. The queue is a
+       heap in m_events.
+     */
+    class event
+    {
+    public:
+      event(float y, edge *lhs, edge *rhs):
+        m_y(y),
+        m_lhs(lhs),
+        m_rhs(rhs)
+      {}
+
+      bool
+      is_crossing(void) const
+      {
+        return m_rhs != NULL;
+      }
+
+      bool
+      operator<(const event &rhs) const
+      {
+        /* std::pop_heap gives the largest element,
+           so the order is reversed
+         */
+        if(m_y != rhs.m_y)
+          {
+            return m_y > rhs.m_y;
+          }
+        return !is_crossing() && rhs.is_crossing();
+      }
+
+      float m_y;
+      edge *m_lhs, *m_rhs;
+    };
+
+    class compare_edge_start
+    {
+    public:
+      bool
+      operator()(const edge *lhs, const edge *rhs) const;
+    };
+
+    void
+    add_edge(unsigned int from, unsigned int to, int side);
+
+    unsigned int
+    node_at(edge *e, float y);
+
+    void
+    add_node(edge *e, float y, unsigned int point);
+
+    edge*
+    left_of(edge *e) const;
+
+    edge*
+    right_of(edge *e) const;
+
+    void
+    mark_dirty(edge *e);
+
+    void
+    add_crossing(edge *lhs, edge *rhs, float y);
+
+    void
+    push_event(const event &ev);
+
+    event
+    pop_event(void);
+
+    void
+    insert_edge(edge *e, float y);
+
+    void
+    remove_edge(edge *e, float y);
+
+    void
+    swap_edges(edge *lhs, edge *rhs, float y);
+
+    void
+    update_regions(float y);
+
+    void
+    close_region(edge *e, float y);
+
+    void
+    emit_triangle(int winding_number, unsigned int a,
+                  unsigned int b, unsigned int c);
+
+    std::vector<vec2> &m_points;
+    std::vector<edge> m_edges;
+    std::vector<node> m_nodes;
+    std::vector<edge*> m_pending, m_dirty;
+    arena m_arena;
+    vec2 m_event_point;
+    active_set m_sweep_edges;
+    std::vector<event, arena_allocator<event> > m_events;
+  };
+}
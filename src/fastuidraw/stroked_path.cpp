@@ -19,6 +19,7 @@
 
 #include <vector>
 #include <complex>
+#include <algorithm>
 
 #include <fastuidraw/stroked_path.hpp>
 #include <fastuidraw/tessellated_path.hpp>
@@ -51,7 +52,9 @@ namespace
             uint32_t depth = 0u)
   {
     assert(on_boundary == 0 || on_boundary == 1 || on_boundary == -1);
-    assert(on_boundary == 1 || pt == fastuidraw::StrokedPath::offset_edge);
+    assert(on_boundary == 1
+           || pt == fastuidraw::StrokedPath::offset_edge
+           || pt == fastuidraw::StrokedPath::offset_edge_segment);
 
     uint32_t bb(on_boundary + 1), pp(pt);
     return fastuidraw::pack_bits(fastuidraw::StrokedPath::offset_type_bit0, fastuidraw::StrokedPath::offset_type_num_bits, pp)
@@ -167,11 +170,78 @@ namespace
     fastuidraw::uvec2 m_data;
   };
 
-  class PerContourData
+  /* The data from the TessellatedPath needed to create the
+     edges, edge segments, joins and caps. It is extracted when
+     the StrokedPath is constructed so that the data of each
+     point set is created on first request without needing
+     the TessellatedPath.
+   */
+  class JoinSource
+  {
+  public:
+    /* m_p0 is the point at the end of the edge into
+       the join and m_p1 the point at the start of the
+       edge out of the join.
+     */
+    fastuidraw::TessellatedPath::point m_p0;
+    fastuidraw::vec2 m_p1, m_n0, m_n1;
+  };
+
+  class CapSource
   {
   public:
-    std::vector<fastuidraw::vec2> m_edge_begin_normal, m_edge_end_normal;
-    fastuidraw::vec2 m_begin_cap_normal, m_end_cap_normal;
+    fastuidraw::TessellatedPath::point m_p;
+    fastuidraw::vec2 m_n;
+  };
+
+  class ContourSource
+  {
+  public:
+    /* m_joins[J] is the join that connects edge J to
+       edge J + 1, i.e. the last two joins are the joins
+       of the closing edge. m_caps[0] is the cap at the
+       start of the contour and m_caps[1] is the cap at
+       the end of the contour.
+     */
+    std::vector<JoinSource> m_joins;
+    fastuidraw::vecN<CapSource, 2> m_caps;
+  };
+
+  class PathSource
+  {
+  public:
+    PathSource(void):
+      m_box_min(0.0f, 0.0f),
+      m_box_max(0.0f, 0.0f),
+      m_curve_tessellation(0.0f),
+      m_number_joins(0)
+    {}
+
+    void
+    set(const fastuidraw::TessellatedPath &P);
+
+    unsigned int
+    number_contours(void) const
+    {
+      return m_edge_ranges.size();
+    }
+
+    unsigned int
+    number_edges(unsigned int contour) const
+    {
+      return m_edge_ranges[contour].size();
+    }
+
+    /* copies of TessellatedPath::point_data() and of
+       TessellatedPath::edge_range() of each edge
+     */
+    std::vector<fastuidraw::TessellatedPath::point> m_points;
+    std::vector<std::vector<fastuidraw::range_type<unsigned int> > > m_edge_ranges;
+
+    std::vector<ContourSource> m_contours;
+    fastuidraw::vec2 m_box_min, m_box_max;
+    float m_curve_tessellation;
+    unsigned int m_number_joins;
   };
 
   class EdgeDataCreator
@@ -179,9 +249,9 @@ namespace
   public:
     static const float sm_mag_tol;
 
-    EdgeDataCreator(const fastuidraw::TessellatedPath &P):
-      m_P(P),
-      m_per_contour_data(m_P.number_contours())
+    explicit
+    EdgeDataCreator(const PathSource &S):
+      m_S(S)
     {
       compute_size();
     }
@@ -197,20 +267,31 @@ namespace
               fastuidraw::c_array<unsigned int> indices,
               unsigned int &pre_close_depth, unsigned int &close_depth);
 
-    const PerContourData&
-    per_contour_data(unsigned int contour) const
-    {
-      return m_per_contour_data[contour];
-    }
+    /* updates normal to the normal of the segment from p to q;
+       if the segment is degenerate, the normal is from the
+       derivative at p and if that is degenerate too, normal
+       is left unchanged.
+     */
+    static
+    void
+    update_normal(const fastuidraw::TessellatedPath::point &p,
+                  const fastuidraw::TessellatedPath::point &q,
+                  fastuidraw::vec2 &normal);
+
+    /* the normals used by the points of an edge at its
+       start and at its end
+     */
+    static
+    void
+    edge_normals(fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src_pts,
+                 fastuidraw::range_type<unsigned int> R,
+                 fastuidraw::vec2 &begin_normal, fastuidraw::vec2 &end_normal);
 
   private:
 
     void
     compute_size(void);
 
-    void
-    init_prev_normal(unsigned int contour);
-
     void
     add_edge(unsigned int contour, unsigned int edge,
              fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
@@ -219,19 +300,65 @@ namespace
              unsigned int &vert_offset, unsigned int &index_offset);
 
     PointIndexSize m_size;
-    const fastuidraw::TessellatedPath &m_P;
-    fastuidraw::vec2 m_prev_normal;
-    std::vector<PerContourData> m_per_contour_data;
+    const PathSource &m_S;
   };
 
-  class JoinCount
+  /* Creates the points of StrokedPath::edge_segment_point_set
+     directly from the points of the tessellation, one quad for
+     each segment of non-zero length. The depth of a segment is
+     the depth the segment has in StrokedPath::edge_point_set.
+   */
+  class EdgeSegmentCreator
   {
   public:
     explicit
-    JoinCount(const fastuidraw::TessellatedPath &P);
+    EdgeSegmentCreator(const PathSource &S);
 
-    unsigned int m_number_close_joins;
-    unsigned int m_number_non_close_joins;
+    fastuidraw::uvec4
+    sizes(void) const
+    {
+      return m_size.m_data;
+    }
+
+    void
+    fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
+              fastuidraw::c_array<unsigned int> indices,
+              unsigned int &pre_close_depth, unsigned int &close_depth) const;
+
+  private:
+    static
+    bool
+    keep_segment(const fastuidraw::vec2 &delta);
+
+    /* counts the segments of the closing edges of the contours
+       if closing_edges is true and of the other edges otherwise
+     */
+    void
+    count_segments(bool closing_edges,
+                   unsigned int &number_verts, unsigned int &number_indices,
+                   unsigned int &number_segments) const;
+
+    /* adds the segments of the closing edges of the contours if
+       closing_edges is true and of the other edges otherwise; the
+       n'th segment, including the segments of zero length, gets
+       the depth depth_start - n.
+     */
+    void
+    add_segments(bool closing_edges, unsigned int depth_start,
+                 fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
+                 fastuidraw::c_array<unsigned int> indices,
+                 unsigned int &vert_offset, unsigned int &index_offset) const;
+
+    static
+    void
+    set_point(const fastuidraw::TessellatedPath::point &src,
+              const fastuidraw::vec2 &to_other_end,
+              int side, float normal_sign, unsigned int depth,
+              fastuidraw::StrokedPath::point &dst);
+
+    const PathSource &m_S;
+    PointIndexSize m_size;
+    unsigned int m_pre_close_segments, m_close_segments;
   };
 
   class CommonJoinData
@@ -264,11 +391,9 @@ namespace
   {
   public:
     explicit
-    JoinCreatorBase(const fastuidraw::TessellatedPath &P,
-                    const EdgeDataCreator &e,
+    JoinCreatorBase(const PathSource &S,
                     bool set_skip_dash_computation = true):
-      m_P(P),
-      m_e(e),
+      m_S(S),
       m_set_skip_dash_computation(set_skip_dash_computation),
       m_size_ready(false)
     {}
@@ -290,21 +415,19 @@ namespace
               std::vector<LocationsOfCapsAndJoins> &locations,
               enum joint_type_t Jtype);
 
+  protected:
+    const PathSource &m_S;
+
   private:
 
     virtual
     void
-    add_join(unsigned int join_id,
-             const fastuidraw::TessellatedPath &path,
-             const fastuidraw::vec2 &n0_from_stroking,
-             const fastuidraw::vec2 &n1_from_stroking,
-             unsigned int contour, unsigned int edge,
+    add_join(unsigned int join_id, const JoinSource &join,
              unsigned int &vert_count, unsigned int &index_count) = 0;
 
 
     void
-    fill_join(unsigned int join_id,
-              unsigned int contour, unsigned int edge,
+    fill_join(unsigned int join_id, const JoinSource &join,
               fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
               unsigned int &depth,
               fastuidraw::c_array<unsigned int> indices,
@@ -313,9 +436,7 @@ namespace
 
     virtual
     void
-    fill_join_implement(unsigned int join_id,
-                        const fastuidraw::TessellatedPath &path,
-                        unsigned int contour, unsigned int edge,
+    fill_join_implement(unsigned int join_id, const JoinSource &join,
                         fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
                         fastuidraw::c_array<unsigned int> indices,
                         unsigned int &vertex_offset, unsigned int &index_offset) = 0;
@@ -323,8 +444,6 @@ namespace
     void
     compute_size(void);
 
-    const fastuidraw::TessellatedPath &m_P;
-    const EdgeDataCreator &m_e;
     bool m_set_skip_dash_computation;
     PointIndexSize m_size;
     bool m_size_ready;
@@ -334,8 +453,7 @@ namespace
   class RoundedJoinCreator:public JoinCreatorBase
   {
   public:
-    RoundedJoinCreator(const fastuidraw::TessellatedPath &P,
-                       const EdgeDataCreator &e);
+    RoundedJoinCreator(const PathSource &S);
 
   private:
 
@@ -343,7 +461,7 @@ namespace
     {
     public:
       PerJoinData(const fastuidraw::TessellatedPath::point &p0,
-                  const fastuidraw::TessellatedPath::point &p1,
+                  const fastuidraw::vec2 &p1,
                   const fastuidraw::vec2 &n0_from_stroking,
                   const fastuidraw::vec2 &n1_from_stroking,
                   float curve_tessellation);
@@ -361,18 +479,12 @@ namespace
 
     virtual
     void
-    add_join(unsigned int join_id,
-             const fastuidraw::TessellatedPath &path,
-             const fastuidraw::vec2 &n0_from_stroking,
-             const fastuidraw::vec2 &n1_from_stroking,
-             unsigned int contour, unsigned int edge,
+    add_join(unsigned int join_id, const JoinSource &join,
              unsigned int &vert_count, unsigned int &index_count);
 
     virtual
     void
-    fill_join_implement(unsigned int join_id,
-                        const fastuidraw::TessellatedPath &path,
-                        unsigned int contour, unsigned int edge,
+    fill_join_implement(unsigned int join_id, const JoinSource &join,
                         fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
                         fastuidraw::c_array<unsigned int> indices,
                         unsigned int &vertex_offset, unsigned int &index_offset);
@@ -384,31 +496,22 @@ namespace
   {
   public:
     explicit
-    BevelJoinCreator(const fastuidraw::TessellatedPath &P,
-                     const EdgeDataCreator &e);
+    BevelJoinCreator(const PathSource &S);
 
   private:
 
     virtual
     void
-    add_join(unsigned int join_id,
-             const fastuidraw::TessellatedPath &path,
-             const fastuidraw::vec2 &n0_from_stroking,
-             const fastuidraw::vec2 &n1_from_stroking,
-             unsigned int contour, unsigned int edge,
+    add_join(unsigned int join_id, const JoinSource &join,
              unsigned int &vert_count, unsigned int &index_count);
 
     virtual
     void
-    fill_join_implement(unsigned int join_id,
-                        const fastuidraw::TessellatedPath &path,
-                        unsigned int contour, unsigned int edge,
+    fill_join_implement(unsigned int join_id, const JoinSource &join,
                         fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
                         fastuidraw::c_array<unsigned int> indices,
                         unsigned int &vertex_offset, unsigned int &index_offset);
 
-    std::vector<fastuidraw::vec2> m_n0, m_n1;
-
   };
 
   class CommonCapData
@@ -436,9 +539,9 @@ namespace
   class CapCreatorBase
   {
   public:
-    CapCreatorBase(const fastuidraw::TessellatedPath &P,
+    CapCreatorBase(const PathSource &S,
                    PointIndexCapSize sz):
-      m_P(P),
+      m_S(S),
       m_size(sz)
     {}
 
@@ -453,8 +556,7 @@ namespace
     }
 
     unsigned int
-    fill_data(const EdgeDataCreator &edge_creator,
-              fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
+    fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
               fastuidraw::c_array<unsigned int> indices,
               std::vector<LocationsOfCapsAndJoins> &locations,
               enum cap_type_t cp) const;
@@ -481,7 +583,7 @@ namespace
             unsigned int &vertex_offset,
             unsigned int &index_offset) const = 0;
 
-    const fastuidraw::TessellatedPath &m_P;
+    const PathSource &m_S;
     PointIndexCapSize m_size;
 
   };
@@ -489,15 +591,16 @@ namespace
   class RoundedCapCreator:public CapCreatorBase
   {
   public:
-    RoundedCapCreator(const fastuidraw::TessellatedPath &P):
-      CapCreatorBase(P, compute_size(P))
+    explicit
+    RoundedCapCreator(const PathSource &S):
+      CapCreatorBase(S, compute_size(S))
     {
     }
 
   private:
 
     PointIndexCapSize
-    compute_size(const fastuidraw::TessellatedPath &P);
+    compute_size(const PathSource &S);
 
     void
     add_cap(const fastuidraw::vec2 &normal_from_stroking,
@@ -515,15 +618,16 @@ namespace
   class SquareCapCreator:public CapCreatorBase
   {
   public:
-    SquareCapCreator(const fastuidraw::TessellatedPath &P):
-      CapCreatorBase(P, compute_size(P))
+    explicit
+    SquareCapCreator(const PathSource &S):
+      CapCreatorBase(S, compute_size(S))
     {
     }
 
   private:
 
     PointIndexCapSize
-    compute_size(const fastuidraw::TessellatedPath &P);
+    compute_size(const PathSource &S);
 
     void
     add_cap(const fastuidraw::vec2 &normal_from_stroking,
@@ -539,29 +643,21 @@ namespace
   {
   public:
     explicit
-    MiterJoinCreator(const fastuidraw::TessellatedPath &P,
-                     const EdgeDataCreator &e);
+    MiterJoinCreator(const PathSource &S);
 
   private:
     virtual
     void
-    add_join(unsigned int join_id,
-             const fastuidraw::TessellatedPath &path,
-             const fastuidraw::vec2 &n0_from_stroking,
-             const fastuidraw::vec2 &n1_from_stroking,
-             unsigned int contour, unsigned int edge,
+    add_join(unsigned int join_id, const JoinSource &join,
              unsigned int &vert_count, unsigned int &index_count);
 
     virtual
     void
-    fill_join_implement(unsigned int join_id,
-                        const fastuidraw::TessellatedPath &path,
-                        unsigned int contour, unsigned int edge,
+    fill_join_implement(unsigned int join_id, const JoinSource &join,
                         fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
                         fastuidraw::c_array<unsigned int> indices,
                         unsigned int &vertex_offset, unsigned int &index_offset);
 
-    std::vector<fastuidraw::vec2> m_n0, m_n1;
   };
 
   template<typename T>
@@ -612,6 +708,10 @@ namespace
   class DataAsCArrays
   {
   public:
+    DataAsCArrays(void):
+      m_number_depth(0)
+    {}
+
     fastuidraw::const_c_array<fastuidraw::StrokedPath::point> m_points;
     fastuidraw::const_c_array<unsigned int> m_indices;
     unsigned int m_number_depth;
@@ -687,7 +787,29 @@ namespace
     StrokedPathPrivate(const fastuidraw::TessellatedPath &P);
     ~StrokedPathPrivate();
 
+    /* the points of each point set are created
+       on the first request for them.
+     */
+    void
+    ready_point_set(enum fastuidraw::StrokedPath::point_set_t tp);
+
+    void
+    create_joins(JoinCreatorBase &creator, enum joint_type_t tp,
+                 Data<fastuidraw::StrokedPath::point> &dst,
+                 DataAsCArraysPair &out_value);
+
+    void
+    create_caps(const CapCreatorBase &creator, enum cap_type_t tp,
+                CapData &dst, DataAsCArraysPair &out_value);
+
+    void
+    create_join_distance_table(void);
+
+    PathSource m_source;
+    fastuidraw::vecN<bool, fastuidraw::StrokedPath::number_point_set_types> m_point_set_ready;
+
     Data<fastuidraw::StrokedPath::point> m_edges;
+    Data<fastuidraw::StrokedPath::point> m_edge_segments;
     Data<fastuidraw::StrokedPath::point> m_rounded_joins;
     Data<fastuidraw::StrokedPath::point> m_bevel_joins;
     Data<fastuidraw::StrokedPath::point> m_miter_joins;
@@ -697,7 +819,16 @@ namespace
     std::vector<LocationsOfCapsAndJoins> m_locations;
 
     fastuidraw::vecN<DataAsCArraysPair, fastuidraw::StrokedPath::number_point_set_types> m_return_values;
+
+    /* indexed by including_closing_edge, the join ids
+       sorted by their distance from the contour start
+     */
+    fastuidraw::vecN<std::vector<float>, 2> m_sorted_join_distances;
+    fastuidraw::vecN<std::vector<unsigned int>, 2> m_sorted_join_ids;
+
     fastuidraw::PainterAttributeData *m_attribute_data;
+    fastuidraw::vecN<fastuidraw::PainterAttributeDataHierarchy*,
+                     fastuidraw::PainterAttributeData::stroking_data_count> m_attribute_data_hierarchy;
   };
 
 }
@@ -771,18 +902,61 @@ fetch(enum fastuidraw::StrokedPath::point_set_t tp, unsigned int N)
 }
 
 //////////////////////////////////////////////
-// JoinCount methods
-JoinCount::
-JoinCount(const fastuidraw::TessellatedPath &P):
-  m_number_close_joins(0),
-  m_number_non_close_joins(0)
+// PathSource methods
+void
+PathSource::
+set(const fastuidraw::TessellatedPath &P)
 {
-  for(unsigned int o = 0; o < P.number_contours(); ++o)
+  fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src_pts(P.point_data());
+
+  m_points.assign(src_pts.begin(), src_pts.end());
+  m_box_min = P.bounding_box_min();
+  m_box_max = P.bounding_box_max();
+  m_curve_tessellation = P.tessellation_parameters().m_curve_tessellation;
+  m_edge_ranges.resize(P.number_contours());
+  m_contours.resize(P.number_contours());
+  for(unsigned int o = 0, endo = P.number_contours(); o < endo; ++o)
     {
-      if(P.number_edges(o) >= 2)
+      unsigned int num_edges(P.number_edges(o));
+      std::vector<fastuidraw::vec2> begin_normals(num_edges), end_normals(num_edges);
+
+      m_edge_ranges[o].resize(num_edges);
+      for(unsigned int e = 0; e < num_edges; ++e)
+        {
+          m_edge_ranges[o][e] = P.edge_range(o, e);
+          EdgeDataCreator::edge_normals(src_pts, m_edge_ranges[o][e],
+                                        begin_normals[e], end_normals[e]);
+        }
+
+      if(num_edges >= 2)
+        {
+          m_contours[o].m_joins.resize(num_edges);
+          m_number_joins += num_edges;
+          for(unsigned int J = 0; J < num_edges; ++J)
+            {
+              fastuidraw::range_type<unsigned int> R0, R1;
+              unsigned int next_edge;
+
+              next_edge = (J + 1 != num_edges) ? J + 1 : 0;
+              R0 = m_edge_ranges[o][J]; //end of edge into join
+              R1 = m_edge_ranges[o][next_edge]; //start of edge out of join
+
+              m_contours[o].m_joins[J].m_p0 = src_pts[R0.m_end - 1];
+              m_contours[o].m_joins[J].m_p1 = src_pts[R1.m_begin].m_p;
+              m_contours[o].m_joins[J].m_n0 = end_normals[J];
+              m_contours[o].m_joins[J].m_n1 = begin_normals[next_edge];
+            }
+        }
+
+      /* the last edge is the closing edge, so the cap at the
+         end of the contour is at the end of the edge before it.
+       */
+      m_contours[o].m_caps[0].m_p = P.unclosed_contour_point_data(o).front();
+      m_contours[o].m_caps[1].m_p = P.unclosed_contour_point_data(o).back();
+      if(num_edges > 0)
         {
-          m_number_non_close_joins += P.number_edges(o) - 2;
-          m_number_close_joins += 2;
+          m_contours[o].m_caps[0].m_n = begin_normals[0];
+          m_contours[o].m_caps[1].m_n = end_normals[(num_edges >= 2) ? num_edges - 2 : 0];
         }
     }
 }
@@ -916,19 +1090,65 @@ compute_lambda(const fastuidraw::vec2 &n0, const fastuidraw::vec2 &n1)
 // EdgeDataCreator methods
 const float EdgeDataCreator::sm_mag_tol = 0.000001f;
 
+void
+EdgeDataCreator::
+update_normal(const fastuidraw::TessellatedPath::point &p,
+              const fastuidraw::TessellatedPath::point &q,
+              fastuidraw::vec2 &normal)
+{
+  fastuidraw::vec2 delta;
+
+  delta = q.m_p - p.m_p;
+  if(delta.magnitudeSq() >= sm_mag_tol * sm_mag_tol)
+    {
+      normal = fastuidraw::vec2(-delta.y(), delta.x());
+    }
+  else if(p.m_p_t.magnitudeSq() >= sm_mag_tol * sm_mag_tol)
+    {
+      normal = fastuidraw::vec2(-p.m_p_t.y(), p.m_p_t.x());
+    }
+  normal.normalize();
+}
+
+void
+EdgeDataCreator::
+edge_normals(fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src_pts,
+             fastuidraw::range_type<unsigned int> R,
+             fastuidraw::vec2 &begin_normal, fastuidraw::vec2 &end_normal)
+{
+  fastuidraw::vec2 normal(1.0f, 0.0f);
+
+  assert(R.m_end > R.m_begin);
+  if(R.m_begin + 1 >= R.m_end)
+    {
+      normal = fastuidraw::vec2(-src_pts[R.m_begin].m_p_t.y(), src_pts[R.m_begin].m_p_t.x());
+      normal.normalize();
+      begin_normal = end_normal = normal;
+      return;
+    }
+
+  for(unsigned int i = R.m_begin; i + 1 < R.m_end; ++i)
+    {
+      update_normal(src_pts[i], src_pts[i + 1], normal);
+      if(i == R.m_begin)
+        {
+          begin_normal = normal;
+        }
+    }
+  end_normal = normal;
+}
+
 void
 EdgeDataCreator::
 compute_size(void)
 {
-  for(unsigned int o = 0; o < m_P.number_contours(); ++o)
+  for(unsigned int o = 0; o < m_S.number_contours(); ++o)
     {
-      m_per_contour_data[o].m_edge_begin_normal.resize(m_P.number_edges(o), fastuidraw::vec2(999,999));
-      m_per_contour_data[o].m_edge_end_normal.resize(m_P.number_edges(o), fastuidraw::vec2(111,111));
-      for(unsigned int e = 0; e < m_P.number_edges(o); ++e)
+      for(unsigned int e = 0; e < m_S.number_edges(o); ++e)
         {
           fastuidraw::range_type<unsigned int> R;
 
-          R = m_P.edge_range(o, e);
+          R = m_S.m_edge_ranges[o][e];
           assert(R.m_end > R.m_begin);
 
           /* Each sub-edge of the tessellation produces -6- points:
@@ -943,7 +1163,7 @@ compute_size(void)
                However, the last triangle is not present on the last
                edge segment.
           */
-          if(e + 1 == m_P.number_edges(o))
+          if(e + 1 == m_S.number_edges(o))
             {
               m_size.close_verts() += 6 * ((R.m_end - R.m_begin) - 1);
               m_size.close_indices() += 15 * ((R.m_end - R.m_begin) - 1) - 3;
@@ -966,10 +1186,10 @@ add_edge(unsigned int o, unsigned int e,
          unsigned int &vert_offset, unsigned int &index_offset)
 {
   fastuidraw::range_type<unsigned int> R;
-  fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src_pts(m_P.point_data());
+  fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src_pts(fastuidraw::make_c_array(m_S.m_points));
   fastuidraw::vec2 normal(1.0f, 0.0f);
 
-  R = m_P.edge_range(o, e);
+  R = m_S.m_edge_ranges[o][e];
   assert(R.m_end > R.m_begin);
 
   for(unsigned int i = R.m_begin; i + 1 < R.m_end; ++i, ++depth)
@@ -979,27 +1199,7 @@ add_edge(unsigned int o, unsigned int e,
       fastuidraw::vec2 delta;
 
       delta = src_pts[i+1].m_p - src_pts[i].m_p;
-      if(delta.magnitudeSq() >= sm_mag_tol * sm_mag_tol)
-        {
-          normal = fastuidraw::vec2(-delta.y(), delta.x());
-        }
-      else
-        {
-          if(src_pts[i].m_p_t.magnitudeSq() >= sm_mag_tol * sm_mag_tol)
-            {
-              normal = fastuidraw::vec2(-src_pts[i].m_p_t.y(), src_pts[i].m_p_t.x());
-            }
-        }
-      normal.normalize();
-
-      if(i == R.m_begin)
-        {
-          m_per_contour_data[o].m_edge_begin_normal[e] = normal;
-          if(e == 0)
-            {
-              m_per_contour_data[o].m_begin_cap_normal = normal;
-            }
-        }
+      update_normal(src_pts[i], src_pts[i + 1], normal);
 
       int boundary_values[3] =
         {
@@ -1091,23 +1291,6 @@ add_edge(unsigned int o, unsigned int e,
         }
       vert_offset += 6;
     }
-
-  if(R.m_begin + 1 >= R.m_end)
-    {
-      normal = fastuidraw::vec2(-src_pts[R.m_begin].m_p_t.y(), src_pts[R.m_begin].m_p_t.x());
-      normal.normalize();
-      m_per_contour_data[o].m_edge_begin_normal[e] = normal;
-      if(e == 0)
-        {
-          m_per_contour_data[o].m_begin_cap_normal = normal;
-        }
-    }
-
-  m_per_contour_data[o].m_edge_end_normal[e] = normal;
-  if(e + 2 == m_P.number_edges(o))
-    {
-      m_per_contour_data[o].m_end_cap_normal = normal;
-    }
 }
 
 
@@ -1124,11 +1307,11 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
   pre_close_depth = 0;
   close_depth = 0;
 
-  for(unsigned int o = 0; o < m_P.number_contours(); ++o)
+  for(unsigned int o = 0; o < m_S.number_contours(); ++o)
     {
-      for(unsigned int e = 0; e < m_P.number_edges(o); ++e)
+      for(unsigned int e = 0; e < m_S.number_edges(o); ++e)
         {
-          if(e + 1 == m_P.number_edges(o))
+          if(e + 1 == m_S.number_edges(o))
             {
               add_edge(o, e, pts, close_depth, indices,
                        close_vertex, close_index);
@@ -1164,6 +1347,185 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
   close_depth = total;
 }
 
+/////////////////////////////////////////////////
+// EdgeSegmentCreator methods
+EdgeSegmentCreator::
+EdgeSegmentCreator(const PathSource &S):
+  m_S(S)
+{
+  count_segments(false, m_size.pre_close_verts(), m_size.pre_close_indices(), m_pre_close_segments);
+  count_segments(true, m_size.close_verts(), m_size.close_indices(), m_close_segments);
+}
+
+bool
+EdgeSegmentCreator::
+keep_segment(const fastuidraw::vec2 &delta)
+{
+  /* segments of zero length have no direction from
+     which the shader can compute a normal.
+   */
+  return delta.magnitudeSq() >= EdgeDataCreator::sm_mag_tol * EdgeDataCreator::sm_mag_tol;
+}
+
+void
+EdgeSegmentCreator::
+count_segments(bool closing_edges,
+               unsigned int &number_verts, unsigned int &number_indices,
+               unsigned int &number_segments) const
+{
+  const std::vector<fastuidraw::TessellatedPath::point> &src(m_S.m_points);
+
+  number_verts = 0;
+  number_indices = 0;
+  number_segments = 0;
+  for(unsigned int o = 0, endo = m_S.number_contours(); o < endo; ++o)
+    {
+      for(unsigned int e = 0, ende = m_S.number_edges(o); e < ende; ++e)
+        {
+          fastuidraw::range_type<unsigned int> R(m_S.m_edge_ranges[o][e]);
+          bool have_prev(false);
+
+          if((e + 1 == ende) != closing_edges)
+            {
+              continue;
+            }
+
+          for(unsigned int i = R.m_begin; i + 1 < R.m_end; ++i, ++number_segments)
+            {
+              if(keep_segment(src[i + 1].m_p - src[i].m_p))
+                {
+                  number_verts += 4;
+                  number_indices += have_prev ? 9 : 6;
+                  have_prev = true;
+                }
+            }
+        }
+    }
+}
+
+void
+EdgeSegmentCreator::
+set_point(const fastuidraw::TessellatedPath::point &src,
+          const fastuidraw::vec2 &to_other_end,
+          int side, float normal_sign, unsigned int depth,
+          fastuidraw::StrokedPath::point &dst)
+{
+  dst.m_position = src.m_p;
+  dst.m_pre_offset = fastuidraw::vec2(normal_sign, 0.0f);
+  dst.m_auxilary_offset = to_other_end;
+  dst.m_distance_from_edge_start = src.m_distance_from_edge_start;
+  dst.m_distance_from_contour_start = src.m_distance_from_contour_start;
+  dst.m_edge_length = src.m_edge_length;
+  dst.m_open_contour_length = src.m_open_contour_length;
+  dst.m_closed_contour_length = src.m_closed_contour_length;
+  dst.m_packed_data = pack_data(side, fastuidraw::StrokedPath::offset_edge_segment, depth);
+}
+
+void
+EdgeSegmentCreator::
+add_segments(bool closing_edges, unsigned int depth_start,
+             fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
+             fastuidraw::c_array<unsigned int> indices,
+             unsigned int &vert_offset, unsigned int &index_offset) const
+{
+  const std::vector<fastuidraw::TessellatedPath::point> &src(m_S.m_points);
+  unsigned int depth(depth_start);
+
+  for(unsigned int o = 0, endo = m_S.number_contours(); o < endo; ++o)
+    {
+      for(unsigned int e = 0, ende = m_S.number_edges(o); e < ende; ++e)
+        {
+          fastuidraw::range_type<unsigned int> R(m_S.m_edge_ranges[o][e]);
+          unsigned int prev_vert(0);
+          bool have_prev(false);
+          fastuidraw::vec2 prev_delta;
+
+          if((e + 1 == ende) != closing_edges)
+            {
+              continue;
+            }
+
+          for(unsigned int i = R.m_begin; i + 1 < R.m_end; ++i, --depth)
+            {
+              fastuidraw::vec2 delta(src[i + 1].m_p - src[i].m_p);
+
+              if(!keep_segment(delta))
+                {
+                  continue;
+                }
+
+              /* The quad is:
+                   (p, delta, +1), (p, delta, -1),
+                   (p_next, -delta, +1), (p_next, -delta, -1)
+                 the normal computed from the vector to the other
+                 end flips at p_next, so the sign to apply to it
+                 flips as well.
+               */
+              set_point(src[i], delta, 1, 1.0f, depth, pts[vert_offset + 0]);
+              set_point(src[i], delta, -1, -1.0f, depth, pts[vert_offset + 1]);
+              set_point(src[i + 1], -delta, 1, -1.0f, depth, pts[vert_offset + 2]);
+              set_point(src[i + 1], -delta, -1, 1.0f, depth, pts[vert_offset + 3]);
+
+              indices[index_offset + 0] = vert_offset + 0;
+              indices[index_offset + 1] = vert_offset + 1;
+              indices[index_offset + 2] = vert_offset + 3;
+              indices[index_offset + 3] = vert_offset + 0;
+              indices[index_offset + 4] = vert_offset + 3;
+              indices[index_offset + 5] = vert_offset + 2;
+              index_offset += 6;
+
+              /* bevel-like join to the previous segment of the same
+                 edge; the end points of the previous segment are on
+                 opposite sides of the path, so the triangle they make
+                 with the outer point of this segment covers the gap.
+               */
+              if(have_prev)
+                {
+                  unsigned int offset;
+                  float lambda;
+
+                  lambda = CommonJoinData::compute_lambda(prev_delta, delta);
+                  offset = (lambda > 0.0f) ? 0 : 1;
+                  indices[index_offset + 0] = prev_vert + 2;
+                  indices[index_offset + 1] = prev_vert + 3;
+                  indices[index_offset + 2] = vert_offset + offset;
+                  index_offset += 3;
+                }
+
+              have_prev = true;
+              prev_vert = vert_offset;
+              prev_delta = delta;
+              vert_offset += 4;
+            }
+        }
+    }
+}
+
+void
+EdgeSegmentCreator::
+fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
+          fastuidraw::c_array<unsigned int> indices,
+          unsigned int &pre_close_depth, unsigned int &close_depth) const
+{
+  unsigned int pre_close_vertex(0), pre_close_index(m_size.close_indices());
+  unsigned int close_vertex(m_size.pre_close_verts()), close_index(0);
+
+  /* the depth of each segment is the depth of the
+     sub-edge in StrokedPath::edge_point_set, i.e. the
+     segments of the closing edges are drawn first and
+     get the largest depth values.
+   */
+  pre_close_depth = m_pre_close_segments;
+  close_depth = m_pre_close_segments + m_close_segments;
+  add_segments(false, pre_close_depth - 1, pts, indices, pre_close_vertex, pre_close_index);
+  add_segments(true, close_depth - 1, pts, indices, close_vertex, close_index);
+
+  assert(pre_close_vertex == m_size.pre_close_verts());
+  assert(pre_close_index == m_size.close_indices() + m_size.pre_close_indices());
+  assert(close_vertex == pre_close_vertex + m_size.close_verts());
+  assert(close_index == m_size.close_indices());
+}
+
 /////////////////////////////////////////////////
 // JoinCreatorBase methods
 void
@@ -1173,28 +1535,23 @@ compute_size(void)
   if(!m_size_ready)
     {
       m_size_ready = true;
-      for(unsigned int o = 0, join_id = 0; o < m_P.number_contours(); ++o)
+      for(unsigned int o = 0, join_id = 0; o < m_S.m_contours.size(); ++o)
         {
-          for(unsigned int e = 1; e + 1 < m_P.number_edges(o); ++e, ++join_id)
+          const std::vector<JoinSource> &joins(m_S.m_contours[o].m_joins);
+          unsigned int num_joins(joins.size());
+
+          for(unsigned int J = 0; J + 2 < num_joins; ++J, ++join_id)
             {
-              add_join(join_id, m_P,
-                       m_e.per_contour_data(o).m_edge_end_normal[e - 1],
-                       m_e.per_contour_data(o).m_edge_begin_normal[e],
-                       o, e, m_size.pre_close_verts(), m_size.pre_close_indices());
+              add_join(join_id, joins[J],
+                       m_size.pre_close_verts(), m_size.pre_close_indices());
             }
 
-          if(m_P.number_edges(o) >= 2)
+          if(num_joins >= 2)
             {
-              add_join(join_id, m_P,
-                       m_e.per_contour_data(o).m_edge_end_normal[m_P.number_edges(o) - 2],
-                       m_e.per_contour_data(o).m_edge_begin_normal[m_P.number_edges(o) - 1],
-                       o, m_P.number_edges(o) - 1,
+              add_join(join_id, joins[num_joins - 2],
                        m_size.close_verts(), m_size.close_indices());
 
-              add_join(join_id + 1, m_P,
-                       m_e.per_contour_data(o).m_edge_end_normal.back(),
-                       m_e.per_contour_data(o).m_edge_begin_normal.front(),
-                       o, m_P.number_edges(o),
+              add_join(join_id + 1, joins[num_joins - 1],
                        m_size.close_verts(), m_size.close_indices());
 
               join_id += 2;
@@ -1205,8 +1562,7 @@ compute_size(void)
 
 void
 JoinCreatorBase::
-fill_join(unsigned int join_id,
-          unsigned int contour, unsigned int edge,
+fill_join(unsigned int join_id, const JoinSource &join,
           fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
           unsigned int &depth,
           fastuidraw::c_array<unsigned int> indices,
@@ -1217,7 +1573,7 @@ fill_join(unsigned int join_id,
 
   loc.m_attribs.m_begin = vertex_offset;
   loc.m_indices.m_begin = index_offset;
-  fill_join_implement(join_id, m_P, contour, edge, pts, indices, vertex_offset, index_offset);
+  fill_join_implement(join_id, join, pts, indices, vertex_offset, index_offset);
   loc.m_attribs.m_end = vertex_offset;
   loc.m_indices.m_end = index_offset;
 
@@ -1249,24 +1605,27 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
   pre_close_depth = 0;
   close_depth = 0;
 
-  for(unsigned int o = 0, join_id = 0; o < m_P.number_contours(); ++o)
+  for(unsigned int o = 0, join_id = 0; o < m_S.m_contours.size(); ++o)
     {
-      for(unsigned int e = 1; e + 1 < m_P.number_edges(o); ++e, ++join_id)
+      const std::vector<JoinSource> &joins(m_S.m_contours[o].m_joins);
+      unsigned int num_joins(joins.size());
+
+      for(unsigned int J = 0; J + 2 < num_joins; ++J, ++join_id)
         {
-          fill_join(join_id, o, e, pts, pre_close_depth, indices,
+          fill_join(join_id, joins[J], pts, pre_close_depth, indices,
                     pre_close_vertex, pre_close_index,
-                    locations[o].m_joins[e - 1].m_values[Jtype]);
+                    locations[o].m_joins[J].m_values[Jtype]);
         }
 
-      if(m_P.number_edges(o) >= 2)
+      if(num_joins >= 2)
         {
-          fill_join(join_id, o, m_P.number_edges(o) - 1, pts, close_depth, indices,
+          fill_join(join_id, joins[num_joins - 2], pts, close_depth, indices,
                     close_vertex, close_index,
-                    locations[o].m_joins[m_P.number_edges(o) - 2].m_values[Jtype]);
+                    locations[o].m_joins[num_joins - 2].m_values[Jtype]);
 
-          fill_join(join_id + 1, o, m_P.number_edges(o), pts, close_depth, indices,
+          fill_join(join_id + 1, joins[num_joins - 1], pts, close_depth, indices,
                     close_vertex, close_index,
-                    locations[o].m_joins[m_P.number_edges(o) - 1].m_values[Jtype]);
+                    locations[o].m_joins[num_joins - 1].m_values[Jtype]);
 
           join_id += 2;
         }
@@ -1301,11 +1660,11 @@ fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
 // RoundedJoinCreator::PerJoinData methods
 RoundedJoinCreator::PerJoinData::
 PerJoinData(const fastuidraw::TessellatedPath::point &p0,
-            const fastuidraw::TessellatedPath::point &p1,
+            const fastuidraw::vec2 &p1,
             const fastuidraw::vec2 &n0_from_stroking,
             const fastuidraw::vec2 &n1_from_stroking,
             float curve_tessellation):
-  CommonJoinData(p0.m_p, n0_from_stroking, p1.m_p, n1_from_stroking,
+  CommonJoinData(p0.m_p, n0_from_stroking, p1, n1_from_stroking,
                  p0.m_distance_from_edge_start, p0.m_distance_from_contour_start,
                  p0.m_edge_length, p0.m_open_contour_length, p0.m_closed_contour_length)
 {
@@ -1412,43 +1771,21 @@ add_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
 ///////////////////////////////////////////////////
 // RoundedJoinCreator methods
 RoundedJoinCreator::
-RoundedJoinCreator(const fastuidraw::TessellatedPath &P,
-                   const EdgeDataCreator &e):
-  JoinCreatorBase(P, e)
+RoundedJoinCreator(const PathSource &S):
+  JoinCreatorBase(S)
 {
-  JoinCount J(P);
-  m_per_join_data.reserve(J.m_number_close_joins + J.m_number_non_close_joins);
+  m_per_join_data.reserve(S.m_number_joins);
 }
 
 void
 RoundedJoinCreator::
-add_join(unsigned int join_id,
-         const fastuidraw::TessellatedPath &path,
-         const fastuidraw::vec2 &n0_from_stroking,
-         const fastuidraw::vec2 &n1_from_stroking,
-         unsigned int contour, unsigned int edge,
+add_join(unsigned int join_id, const JoinSource &join,
          unsigned int &vert_count, unsigned int &index_count)
 {
-  fastuidraw::range_type<unsigned int> R0, R1;
-  fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src_pts(path.point_data());
-
   (void)join_id;
 
-  assert(edge >= 1);
-
-  R0 = path.edge_range(contour, edge - 1); //end of previous edge
-  if(edge != path.number_edges(contour))
-    {
-      R1 = path.edge_range(contour, edge);
-    }
-  else
-    {
-      R1 = path.edge_range(contour, 0);
-    }
-
-  PerJoinData J(src_pts[R0.m_end - 1], src_pts[R1.m_begin],
-        n0_from_stroking, n1_from_stroking,
-        path.tessellation_parameters().m_curve_tessellation);
+  PerJoinData J(join.m_p0, join.m_p1, join.m_n0, join.m_n1,
+                m_S.m_curve_tessellation);
 
   m_per_join_data.push_back(J);
 
@@ -1462,16 +1799,12 @@ add_join(unsigned int join_id,
 
 void
 RoundedJoinCreator::
-fill_join_implement(unsigned int join_id,
-                    const fastuidraw::TessellatedPath &path,
-                    unsigned int contour, unsigned int edge,
+fill_join_implement(unsigned int join_id, const JoinSource &join,
                     fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
                     fastuidraw::c_array<unsigned int> indices,
                     unsigned int &vertex_offset, unsigned int &index_offset)
 {
-  (void)contour;
-  (void)edge;
-  (void)path;
+  (void)join;
 
   assert(join_id < m_per_join_data.size());
   m_per_join_data[join_id].add_data(pts, vertex_offset, indices, index_offset);
@@ -1482,71 +1815,42 @@ fill_join_implement(unsigned int join_id,
 ///////////////////////////////////////////////////
 // BevelJoinCreator methods
 BevelJoinCreator::
-BevelJoinCreator(const fastuidraw::TessellatedPath &P,
-                 const EdgeDataCreator &e):
-  JoinCreatorBase(P, e)
+BevelJoinCreator(const PathSource &S):
+  JoinCreatorBase(S)
 {}
 
 void
 BevelJoinCreator::
-add_join(unsigned int join_id,
-         const fastuidraw::TessellatedPath &path,
-         const fastuidraw::vec2 &n0_from_stroking,
-         const fastuidraw::vec2 &n1_from_stroking,
-         unsigned int contour, unsigned int edge,
+add_join(unsigned int join_id, const JoinSource &join,
          unsigned int &vert_count, unsigned int &index_count)
 {
   (void)join_id;
-  (void)path;
-  (void)contour;
-  (void)edge;
+  (void)join;
 
   /* one triangle per bevel join
    */
   vert_count += 3;
   index_count += 3;
-
-  m_n0.push_back(n0_from_stroking);
-  m_n1.push_back(n1_from_stroking);
 }
 
 void
 BevelJoinCreator::
-fill_join_implement(unsigned int join_id,
-                    const fastuidraw::TessellatedPath &path,
-                    unsigned int contour, unsigned int edge,
+fill_join_implement(unsigned int join_id, const JoinSource &join,
                     fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
                     fastuidraw::c_array<unsigned int> indices,
                     unsigned int &vertex_offset, unsigned int &index_offset)
 {
-  fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src_pts(path.point_data());
-  unsigned int i0, i1;
-  fastuidraw::range_type<unsigned int> R0, R1;
-
   (void)join_id;
 
-  R0 = path.edge_range(contour, edge - 1);
-  if(edge != path.number_edges(contour))
-    {
-      R1 = path.edge_range(contour, edge); //start of current edge
-    }
-  else
-    {
-      R1 = path.edge_range(contour, 0);
-    }
-
-  i0 = R0.m_end - 1;
-  i1 = R1.m_begin;
-
-  CommonJoinData J(src_pts[i0].m_p, m_n0[join_id],
-                   src_pts[i1].m_p, m_n1[join_id],
-                   src_pts[i0].m_distance_from_edge_start,
-                   src_pts[i0].m_distance_from_contour_start,
+  CommonJoinData J(join.m_p0.m_p, join.m_n0,
+                   join.m_p1, join.m_n1,
+                   join.m_p0.m_distance_from_edge_start,
+                   join.m_p0.m_distance_from_contour_start,
                    //using p0 to decide the edge length, as
                    //we think of the join as ending an edge.
-                   src_pts[i0].m_edge_length,
-                   src_pts[i0].m_open_contour_length,
-                   src_pts[i0].m_closed_contour_length);
+                   join.m_p0.m_edge_length,
+                   join.m_p0.m_open_contour_length,
+                   join.m_p0.m_closed_contour_length);
 
   pts[vertex_offset + 0].m_position = J.m_p0;
   pts[vertex_offset + 0].m_pre_offset = J.m_lambda * J.m_n0;
@@ -1603,18 +1907,19 @@ add_cap_and_set_location(const fastuidraw::vec2 &normal_from_stroking,
 
 unsigned int
 CapCreatorBase::
-fill_data(const EdgeDataCreator &edge_creator,
-          fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
+fill_data(fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
           fastuidraw::c_array<unsigned int> indices,
           std::vector<LocationsOfCapsAndJoins> &locations,
           enum cap_type_t cp) const
 {
   unsigned int vertex_offset(0), index_offset(0), v(0), depth(0);
 
-  for(unsigned int o = 0; o < m_P.number_contours(); ++o)
+  for(unsigned int o = 0; o < m_S.m_contours.size(); ++o)
     {
-      add_cap_and_set_location(edge_creator.per_contour_data(o).m_begin_cap_normal,
-                               true, m_P.unclosed_contour_point_data(o).front(),
+      const ContourSource &C(m_S.m_contours[o]);
+
+      add_cap_and_set_location(C.m_caps[0].m_n,
+                               true, C.m_caps[0].m_p,
                                pts, indices,
                                vertex_offset, index_offset,
                                locations[o].m_caps[cp].m_values[0]);
@@ -1625,8 +1930,8 @@ fill_data(const EdgeDataCreator &edge_creator,
           ++depth;
         }
 
-      add_cap_and_set_location(edge_creator.per_contour_data(o).m_end_cap_normal,
-                               false, m_P.unclosed_contour_point_data(o).back(),
+      add_cap_and_set_location(C.m_caps[1].m_n,
+                               false, C.m_caps[1].m_p,
                                pts, indices,
                                vertex_offset, index_offset,
                                locations[o].m_caps[cp].m_values[1]);
@@ -1655,9 +1960,9 @@ fill_data(const EdgeDataCreator &edge_creator,
 // RoundedCapCreator methods
 PointIndexCapSize
 RoundedCapCreator::
-compute_size(const fastuidraw::TessellatedPath &P)
+compute_size(const PathSource &S)
 {
-  float tc(P.tessellation_parameters().m_curve_tessellation);
+  float tc(S.m_curve_tessellation);
   unsigned int num_caps;
   PointIndexCapSize return_value;
 
@@ -1668,7 +1973,7 @@ compute_size(const fastuidraw::TessellatedPath &P)
 
   /* each cap is a triangle fan centered at the cap point.
    */
-  num_caps = 2 * P.number_contours();
+  num_caps = 2 * S.m_contours.size();
   return_value.verts() = (1 + m_num_arc_points_per_cap) * num_caps;
   return_value.indices() = 3 * (m_num_arc_points_per_cap - 1) * num_caps;
 
@@ -1754,7 +2059,7 @@ add_cap(const fastuidraw::vec2 &normal_from_stroking,
 // SquareCapCreator methods
 PointIndexCapSize
 SquareCapCreator::
-compute_size(const fastuidraw::TessellatedPath &P)
+compute_size(const PathSource &S)
 {
   PointIndexCapSize return_value;
   unsigned int num_caps;
@@ -1762,7 +2067,7 @@ compute_size(const fastuidraw::TessellatedPath &P)
   /* each square cap generates 5 new points
      and 3 triangles (= 9 indices)
    */
-  num_caps = 2 * P.number_contours();
+  num_caps = 2 * S.m_contours.size();
   return_value.verts() = 5 * num_caps;
   return_value.indices() = 9 * num_caps;
 
@@ -1851,74 +2156,47 @@ add_cap(const fastuidraw::vec2 &normal_from_stroking,
 ///////////////////////////////////////////////////
 // MiterJoinCreator methods
 MiterJoinCreator::
-MiterJoinCreator(const fastuidraw::TessellatedPath &P,
-                 const EdgeDataCreator &e):
-  JoinCreatorBase(P, e)
+MiterJoinCreator(const PathSource &S):
+  JoinCreatorBase(S)
 {
 }
 
 void
 MiterJoinCreator::
-add_join(unsigned int join_id,
-         const fastuidraw::TessellatedPath &path,
-         const fastuidraw::vec2 &n0_from_stroking,
-         const fastuidraw::vec2 &n1_from_stroking,
-         unsigned int contour, unsigned int edge,
+add_join(unsigned int join_id, const JoinSource &join,
          unsigned int &vert_count, unsigned int &index_count)
 {
   /* Each join is a triangle fan from 5 points
      (thus 3 triangles, which is 9 indices)
    */
   (void)join_id;
-  (void)path;
-  (void)contour;
-  (void)edge;
+  (void)join;
 
   vert_count += 5;
   index_count += 9;
-
-  m_n0.push_back(n0_from_stroking);
-  m_n1.push_back(n1_from_stroking);
 }
 
 
 void
 MiterJoinCreator::
-fill_join_implement(unsigned int join_id,
-                    const fastuidraw::TessellatedPath &path,
-                    unsigned int contour, unsigned int edge,
+fill_join_implement(unsigned int join_id, const JoinSource &join,
                     fastuidraw::c_array<fastuidraw::StrokedPath::point> pts,
                     fastuidraw::c_array<unsigned int> indices,
                     unsigned int &vertex_offset, unsigned int &index_offset)
 {
-  fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> src_pts(path.point_data());
-  unsigned int i, i0, i1, first;
-  fastuidraw::range_type<unsigned int> R0, R1;
+  unsigned int i, first;
 
   (void)join_id;
 
-  R0 = path.edge_range(contour, edge - 1);
-  if(edge != path.number_edges(contour))
-    {
-      R1 = path.edge_range(contour, edge); //start of current edge
-    }
-  else
-    {
-      R1 = path.edge_range(contour, 0);
-    }
-
-  i0 = R0.m_end - 1;
-  i1 = R1.m_begin;
-
-  CommonJoinData J(src_pts[i0].m_p, m_n0[join_id],
-                   src_pts[i1].m_p, m_n1[join_id],
-                   src_pts[i0].m_distance_from_edge_start,
-                   src_pts[i0].m_distance_from_contour_start,
+  CommonJoinData J(join.m_p0.m_p, join.m_n0,
+                   join.m_p1, join.m_n1,
+                   join.m_p0.m_distance_from_edge_start,
+                   join.m_p0.m_distance_from_contour_start,
                    //using p0 to decide the edge length, as
                    //we think of the join as ending an edge.
-                   src_pts[i0].m_edge_length,
-                   src_pts[i0].m_open_contour_length,
-                   src_pts[i0].m_closed_contour_length);
+                   join.m_p0.m_edge_length,
+                   join.m_p0.m_open_contour_length,
+                   join.m_p0.m_closed_contour_length);
 
   /* The miter point is given by where the two boundary
      curves intersect. The two curves are given by:
@@ -2004,7 +2282,9 @@ fill_join_implement(unsigned int join_id,
 // StrokedPathPrivate methods
 StrokedPathPrivate::
 StrokedPathPrivate(const fastuidraw::TessellatedPath &P):
-  m_attribute_data(NULL)
+  m_point_set_ready(false),
+  m_attribute_data(NULL),
+  m_attribute_data_hierarchy(static_cast<fastuidraw::PainterAttributeDataHierarchy*>(NULL))
 {
   if(P.number_contours() == 0)
     {
@@ -2017,73 +2297,191 @@ StrokedPathPrivate(const fastuidraw::TessellatedPath &P):
       m_locations[C].m_joins.resize(P.number_edges(C));
     }
 
-  EdgeDataCreator e(P);
-  m_edges.resize(e.sizes());
-  e.fill_data(m_edges.m_points.data(true),
-              m_edges.m_indices.data(true),
-              m_edges.m_number_depth[false],
-              m_edges.m_number_depth[true]);
-
-  RoundedJoinCreator r(P, e);
-  m_rounded_joins.resize(r.sizes());
-  r.fill_data(m_rounded_joins.m_points.data(true),
-              m_rounded_joins.m_indices.data(true),
-              m_rounded_joins.m_number_depth[false],
-              m_rounded_joins.m_number_depth[true],
-              m_locations, rounded_join);
-
-  BevelJoinCreator b(P, e);
-  m_bevel_joins.resize(b.sizes());
-  b.fill_data(m_bevel_joins.m_points.data(true),
-              m_bevel_joins.m_indices.data(true),
-              m_bevel_joins.m_number_depth[false],
-              m_bevel_joins.m_number_depth[true],
-              m_locations, bevel_join);
-
-  MiterJoinCreator m(P, e);
-  m_miter_joins.resize(m.sizes());
-  m.fill_data(m_miter_joins.m_points.data(true),
-              m_miter_joins.m_indices.data(true),
-              m_miter_joins.m_number_depth[false],
-              m_miter_joins.m_number_depth[true],
-              m_locations, miter_join);
-
-  RoundedCapCreator rc(P);
-  m_rounded_cap.resize(rc.sizes());
-  m_rounded_cap.m_number_depth = rc.fill_data(e,
-                                              fastuidraw::make_c_array(m_rounded_cap.m_points),
-                                              fastuidraw::make_c_array(m_rounded_cap.m_indices),
-                                              m_locations, rounded_cap);
-
-  SquareCapCreator sc(P);
-  m_square_cap.resize(sc.sizes());
-  m_square_cap.m_number_depth = sc.fill_data(e,
-                                             fastuidraw::make_c_array(m_square_cap.m_points),
-                                             fastuidraw::make_c_array(m_square_cap.m_indices),
-                                             m_locations, square_cap);
-
-  m_bevel_joins.compute_conveniance(m_return_values[fastuidraw::StrokedPath::bevel_join_point_set]);
-  m_rounded_joins.compute_conveniance(m_return_values[fastuidraw::StrokedPath::rounded_join_point_set]);
-  m_miter_joins.compute_conveniance(m_return_values[fastuidraw::StrokedPath::miter_join_point_set]);
-  m_rounded_cap.compute_conveniance(m_return_values[fastuidraw::StrokedPath::square_cap_point_set]);
-  m_square_cap.compute_conveniance(m_return_values[fastuidraw::StrokedPath::rounded_cap_point_set]);
-  m_edges.compute_conveniance(m_return_values[fastuidraw::StrokedPath::edge_point_set]);
+  m_source.set(P);
+  create_join_distance_table();
 }
 
 StrokedPathPrivate::
 ~StrokedPathPrivate()
 {
+  for(unsigned int i = 0; i < m_attribute_data_hierarchy.size(); ++i)
+    {
+      if(m_attribute_data_hierarchy[i] != NULL)
+        {
+          FASTUIDRAWdelete(m_attribute_data_hierarchy[i]);
+        }
+    }
+
   if(m_attribute_data != NULL)
     {
       FASTUIDRAWdelete(m_attribute_data);
     }
 }
 
+void
+StrokedPathPrivate::
+create_joins(JoinCreatorBase &creator, enum joint_type_t tp,
+             Data<fastuidraw::StrokedPath::point> &dst,
+             DataAsCArraysPair &out_value)
+{
+  dst.resize(creator.sizes());
+  creator.fill_data(dst.m_points.data(true),
+                    dst.m_indices.data(true),
+                    dst.m_number_depth[false],
+                    dst.m_number_depth[true],
+                    m_locations, tp);
+  dst.compute_conveniance(out_value);
+}
+
+void
+StrokedPathPrivate::
+create_caps(const CapCreatorBase &creator, enum cap_type_t tp,
+            CapData &dst, DataAsCArraysPair &out_value)
+{
+  dst.resize(creator.sizes());
+  dst.m_number_depth = creator.fill_data(fastuidraw::make_c_array(dst.m_points),
+                                         fastuidraw::make_c_array(dst.m_indices),
+                                         m_locations, tp);
+  dst.compute_conveniance(out_value);
+}
+
+void
+StrokedPathPrivate::
+create_join_distance_table(void)
+{
+  std::vector<std::pair<float, unsigned int> > joins;
+  unsigned int gJ(0), num_non_closing;
+
+  /* the join ids are the order in which PainterAttributeData
+     makes the join chunks: first the joins of each contour
+     that are not of the closing edge and then, contour by
+     contour, the joins number_joins(C) - 1 and number_joins(C) - 2.
+   */
+  joins.reserve(m_source.m_number_joins);
+  for(unsigned int C = 0, endC = m_source.m_contours.size(); C < endC; ++C)
+    {
+      const std::vector<JoinSource> &src(m_source.m_contours[C].m_joins);
+      for(unsigned int J = 0, endJ = src.size(); J + 2 < endJ; ++J, ++gJ)
+        {
+          joins.push_back(std::make_pair(src[J].m_p0.m_distance_from_contour_start, gJ));
+        }
+    }
+
+  num_non_closing = gJ;
+  for(unsigned int C = 0, endC = m_source.m_contours.size(); C < endC; ++C)
+    {
+      const std::vector<JoinSource> &src(m_source.m_contours[C].m_joins);
+      unsigned int endJ(src.size());
+      if(endJ >= 2)
+        {
+          joins.push_back(std::make_pair(src[endJ - 1].m_p0.m_distance_from_contour_start, gJ++));
+          joins.push_back(std::make_pair(src[endJ - 2].m_p0.m_distance_from_contour_start, gJ++));
+        }
+    }
+  assert(gJ == m_source.m_number_joins);
+
+  std::sort(joins.begin(), joins.end());
+  for(unsigned int i = 0, endi = joins.size(); i < endi; ++i)
+    {
+      m_sorted_join_distances[true].push_back(joins[i].first);
+      m_sorted_join_ids[true].push_back(joins[i].second);
+      if(joins[i].second < num_non_closing)
+        {
+          m_sorted_join_distances[false].push_back(joins[i].first);
+          m_sorted_join_ids[false].push_back(joins[i].second);
+        }
+    }
+}
+
+void
+StrokedPathPrivate::
+ready_point_set(enum fastuidraw::StrokedPath::point_set_t tp)
+{
+  using namespace fastuidraw;
+
+  assert(tp < StrokedPath::number_point_set_types);
+  if(m_point_set_ready[tp])
+    {
+      return;
+    }
+
+  m_point_set_ready[tp] = true;
+  switch(tp)
+    {
+    case StrokedPath::rounded_join_point_set:
+      {
+        RoundedJoinCreator r(m_source);
+        create_joins(r, rounded_join, m_rounded_joins, m_return_values[tp]);
+      }
+      break;
+
+    case StrokedPath::bevel_join_point_set:
+      {
+        BevelJoinCreator b(m_source);
+        create_joins(b, bevel_join, m_bevel_joins, m_return_values[tp]);
+      }
+      break;
+
+    case StrokedPath::miter_join_point_set:
+      {
+        MiterJoinCreator m(m_source);
+        create_joins(m, miter_join, m_miter_joins, m_return_values[tp]);
+      }
+      break;
+
+    case StrokedPath::rounded_cap_point_set:
+      {
+        RoundedCapCreator rc(m_source);
+        create_caps(rc, rounded_cap, m_rounded_cap, m_return_values[tp]);
+      }
+      break;
+
+    case StrokedPath::square_cap_point_set:
+      {
+        SquareCapCreator sc(m_source);
+        create_caps(sc, square_cap, m_square_cap, m_return_values[tp]);
+      }
+      break;
+
+    case StrokedPath::edge_point_set:
+      {
+        EdgeDataCreator e(m_source);
+        m_edges.resize(e.sizes());
+        e.fill_data(m_edges.m_points.data(true),
+                    m_edges.m_indices.data(true),
+                    m_edges.m_number_depth[false],
+                    m_edges.m_number_depth[true]);
+        m_edges.compute_conveniance(m_return_values[tp]);
+      }
+      break;
+
+    case StrokedPath::edge_segment_point_set:
+      {
+        EdgeSegmentCreator es(m_source);
+        m_edge_segments.resize(es.sizes());
+        es.fill_data(m_edge_segments.m_points.data(true),
+                     m_edge_segments.m_indices.data(true),
+                     m_edge_segments.m_number_depth[false],
+                     m_edge_segments.m_number_depth[true]);
+        m_edge_segments.compute_conveniance(m_return_values[tp]);
+      }
+      break;
+
+    case StrokedPath::cap_join_point_set:
+      /* cap join points are not made, their data is empty
+       */
+      break;
+
+    default:
+      assert(!"Invalid point_set_t value");
+    }
+}
+
 //////////////////////////////////////
 // fastuidraw::StrokedPath::point methods
 fastuidraw::vec2
 fastuidraw::StrokedPath::point::
-offset_vector(void)
+offset_vector(void) const
 {
   switch(offset_type())
     {
@@ -2129,6 +2527,13 @@ offset_vector(void)
         return cs;
       }
 
+    case offset_edge_segment:
+      {
+        vec2 t(m_auxilary_offset);
+        t.normalize();
+        return m_pre_offset.x() * vec2(-t.y(), t.x());
+      }
+
     default:
       return vec2(0.0f, 0.0f);
     }
@@ -2191,11 +2596,32 @@ painter_data(void) const
   if(d->m_attribute_data == NULL)
     {
       d->m_attribute_data = FASTUIDRAWnew PainterAttributeData();
-      d->m_attribute_data->set_data(this);
+      d->m_attribute_data->set_data_without_reference(this);
     }
   return *d->m_attribute_data;
 }
 
+const fastuidraw::PainterAttributeDataHierarchy&
+fastuidraw::StrokedPath::
+painter_data_hierarchy(unsigned int chunk) const
+{
+  StrokedPathPrivate *d;
+  d = reinterpret_cast<StrokedPathPrivate*>(m_d);
+
+  /* only the chunks named by PainterAttributeData::stroking_data_t
+     are partitioned; the chunks of the individual joins are only
+     used by dashed stroking which takes them from painter_data().
+   */
+  assert(chunk < PainterAttributeData::stroking_data_count);
+  if(d->m_attribute_data_hierarchy[chunk] == NULL)
+    {
+      unsigned int chunks[1] = { chunk };
+      d->m_attribute_data_hierarchy[chunk] =
+        FASTUIDRAWnew PainterAttributeDataHierarchy(painter_data(), const_c_array<unsigned int>(chunks, 1));
+    }
+  return *d->m_attribute_data_hierarchy[chunk];
+}
+
 fastuidraw::const_c_array<fastuidraw::StrokedPath::point>
 fastuidraw::StrokedPath::
 points(enum point_set_t tp, bool including_closing_edge) const
@@ -2203,6 +2629,7 @@ points(enum point_set_t tp, bool including_closing_edge) const
   StrokedPathPrivate *d;
   d = reinterpret_cast<StrokedPathPrivate*>(m_d);
   assert(tp < number_point_set_types);
+  d->ready_point_set(tp);
   return d->m_return_values[tp][including_closing_edge].m_points;
 }
 
@@ -2213,6 +2640,7 @@ indices(enum point_set_t tp, bool including_closing_edge) const
   StrokedPathPrivate *d;
   d = reinterpret_cast<StrokedPathPrivate*>(m_d);
   assert(tp < number_point_set_types);
+  d->ready_point_set(tp);
   return d->m_return_values[tp][including_closing_edge].m_indices;
 }
 
@@ -2223,6 +2651,7 @@ number_depth(enum point_set_t tp, bool including_closing_edge) const
   StrokedPathPrivate *d;
   d = reinterpret_cast<StrokedPathPrivate*>(m_d);
   assert(tp < number_point_set_types);
+  d->ready_point_set(tp);
   return d->m_return_values[tp][including_closing_edge].m_number_depth;
 }
 
@@ -2235,6 +2664,24 @@ number_contours(void) const
   return d->m_locations.size();
 }
 
+fastuidraw::vec2
+fastuidraw::StrokedPath::
+bounding_box_min(void) const
+{
+  StrokedPathPrivate *d;
+  d = reinterpret_cast<StrokedPathPrivate*>(m_d);
+  return d->m_source.m_box_min;
+}
+
+fastuidraw::vec2
+fastuidraw::StrokedPath::
+bounding_box_max(void) const
+{
+  StrokedPathPrivate *d;
+  d = reinterpret_cast<StrokedPathPrivate*>(m_d);
+  return d->m_source.m_box_max;
+}
+
 unsigned int
 fastuidraw::StrokedPath::
 number_joins(unsigned int contour) const
@@ -2252,6 +2699,7 @@ points_range(enum point_set_t tp, unsigned int contour, unsigned int N) const
   StrokedPathPrivate *d;
   d = reinterpret_cast<StrokedPathPrivate*>(m_d);
   assert(contour < d->m_locations.size());
+  d->ready_point_set(tp);
   return d->m_locations[contour].fetch(tp, N).m_attribs;
 }
 
@@ -2262,5 +2710,24 @@ indices_range(enum point_set_t tp, unsigned int contour, unsigned int N) const
   StrokedPathPrivate *d;
   d = reinterpret_cast<StrokedPathPrivate*>(m_d);
   assert(contour < d->m_locations.size());
+  d->ready_point_set(tp);
   return d->m_locations[contour].fetch(tp, N).m_indices;
 }
+
+fastuidraw::const_c_array<float>
+fastuidraw::StrokedPath::
+sorted_join_distances(bool including_closing_edge) const
+{
+  StrokedPathPrivate *d;
+  d = reinterpret_cast<StrokedPathPrivate*>(m_d);
+  return make_c_array(d->m_sorted_join_distances[including_closing_edge]);
+}
+
+fastuidraw::const_c_array<unsigned int>
+fastuidraw::StrokedPath::
+sorted_join_ids(bool including_closing_edge) const
+{
+  StrokedPathPrivate *d;
+  d = reinterpret_cast<StrokedPathPrivate*>(m_d);
+  return make_c_array(d->m_sorted_join_ids[including_closing_edge]);
+}
@@ -17,11 +17,13 @@
  */
 
 
-#include <list>
+#include <cmath>
 #include <vector>
+#include <boost/ref.hpp>
 #include <fastuidraw/tessellated_path.hpp>
 #include <fastuidraw/path.hpp>
 #include "private/util_private.hpp"
+#include "private/path_tessellation_pool_private.hpp"
 
 namespace
 {
@@ -29,128 +31,482 @@ namespace
   {
   public:
     TessellatedPathPrivate(const fastuidraw::Path &input,
-                           fastuidraw::TessellatedPath::TessellationParams TP);
+                           fastuidraw::TessellatedPath::TessellationParams TP,
+                           const fastuidraw::PathTessellationPool *pool);
+
+    TessellatedPathPrivate(const fastuidraw::TessellatedPath &input,
+                           float max_deviation);
+
+    /* Set the point data from the points of each edge, where
+       edge_points holds the edges of all contours in order and
+       number_edges[o] is the number of edges of contour o. The
+       m_distance_from_edge_start of the points must be set, the
+       values that depend on the preceding edges are computed.
+     */
+    void
+    set_point_data(const std::vector<unsigned int> &number_edges,
+                   std::vector<std::vector<fastuidraw::TessellatedPath::point> > &edge_points);
 
     std::vector<std::vector<fastuidraw::range_type<unsigned int> > > m_edge_ranges;
     std::vector<fastuidraw::TessellatedPath::point> m_point_data;
     fastuidraw::vec2 m_box_min, m_box_max;
+    float m_max_distance;
     fastuidraw::TessellatedPath::TessellationParams m_params;
     fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> m_stroked;
     fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath> m_filled;
   };
+
+  /* Tessellates a range of the edges of m_edges into m_out,
+     writing the distance between each edge and its segments
+     to m_out_distances.
+   */
+  class EdgeTessellator
+  {
+  public:
+    EdgeTessellator(const fastuidraw::TessellatedPath::TessellationParams &params,
+                    const std::vector<const fastuidraw::PathContour::interpolator_base*> &edges,
+                    std::vector<std::vector<fastuidraw::TessellatedPath::point> > &out,
+                    std::vector<float> &out_distances):
+      m_params(params),
+      m_edges(edges),
+      m_out(out),
+      m_out_distances(out_distances)
+    {}
+
+    void
+    operator()(fastuidraw::range_type<unsigned int> R) const;
+
+  private:
+    fastuidraw::TessellatedPath::TessellationParams m_params;
+    const std::vector<const fastuidraw::PathContour::interpolator_base*> &m_edges;
+    std::vector<std::vector<fastuidraw::TessellatedPath::point> > &m_out;
+    std::vector<float> &m_out_distances;
+  };
+
+  /* Simplifies a polyline with the Douglas-Peucker algorithm,
+     the end points of the polyline are always kept. The
+     recursion is done with an explicit stack so that long
+     polylines do not overflow the call stack.
+   */
+  class PolylineSimplifier
+  {
+  public:
+    explicit
+    PolylineSimplifier(float max_deviation):
+      m_max_deviation_sq(max_deviation * max_deviation)
+    {}
+
+    /* sets keep[i] to true exactly for those pts[i]
+       that are kept; returns the maximum distance from
+       the removed points to the simplified polyline.
+     */
+    float
+    simplify(const std::vector<fastuidraw::vec2> &pts,
+             std::vector<bool> &keep);
+
+  private:
+    static
+    float
+    distance_sq_to_segment(const fastuidraw::vec2 &p,
+                           const fastuidraw::vec2 &a,
+                           const fastuidraw::vec2 &b);
+
+    float m_max_deviation_sq;
+    std::vector<fastuidraw::range_type<unsigned int> > m_stack;
+  };
+
+  /* A point of a contour of the input to the simplification
+     together with if it is the point shared by two edges.
+   */
+  class SimplifyPoint
+  {
+  public:
+    SimplifyPoint(const fastuidraw::TessellatedPath::point &pt, bool is_edge_end):
+      m_pt(pt),
+      m_is_edge_end(is_edge_end)
+    {}
+
+    fastuidraw::TessellatedPath::point m_pt;
+    bool m_is_edge_end;
+  };
+}
+
+/////////////////////////////////////////////
+// PolylineSimplifier methods
+float
+PolylineSimplifier::
+distance_sq_to_segment(const fastuidraw::vec2 &p,
+                       const fastuidraw::vec2 &a,
+                       const fastuidraw::vec2 &b)
+{
+  fastuidraw::vec2 v(b - a), w(p - a);
+  float vv, t;
+
+  vv = fastuidraw::dot(v, v);
+  t = (vv > 0.0f) ?
+    fastuidraw::t_min(1.0f, fastuidraw::t_max(0.0f, fastuidraw::dot(w, v) / vv)) :
+    0.0f;
+  w -= t * v;
+  return fastuidraw::dot(w, w);
+}
+
+float
+PolylineSimplifier::
+simplify(const std::vector<fastuidraw::vec2> &pts,
+         std::vector<bool> &keep)
+{
+  float removed_distance_sq(0.0f);
+
+  keep.assign(pts.size(), false);
+  if(pts.empty())
+    {
+      return 0.0f;
+    }
+
+  keep.front() = true;
+  keep.back() = true;
+
+  m_stack.clear();
+  m_stack.push_back(fastuidraw::range_type<unsigned int>(0, pts.size() - 1));
+  while(!m_stack.empty())
+    {
+      fastuidraw::range_type<unsigned int> R(m_stack.back());
+      unsigned int far_point(R.m_begin);
+      float far_distance_sq(0.0f);
+
+      m_stack.pop_back();
+      for(unsigned int i = R.m_begin + 1; i < R.m_end; ++i)
+        {
+          float d;
+
+          d = distance_sq_to_segment(pts[i], pts[R.m_begin], pts[R.m_end]);
+          if(d > far_distance_sq)
+            {
+              far_distance_sq = d;
+              far_point = i;
+            }
+        }
+
+      if(far_distance_sq > m_max_deviation_sq)
+        {
+          keep[far_point] = true;
+          m_stack.push_back(fastuidraw::range_type<unsigned int>(R.m_begin, far_point));
+          m_stack.push_back(fastuidraw::range_type<unsigned int>(far_point, R.m_end));
+        }
+      else
+        {
+          /* the points of R are replaced by the segment
+             [pts[R.m_begin], pts[R.m_end]]
+           */
+          removed_distance_sq = fastuidraw::t_max(removed_distance_sq, far_distance_sq);
+        }
+    }
+  return std::sqrt(removed_distance_sq);
+}
+
+//////////////////////////////////////////////
+// EdgeTessellator methods
+void
+EdgeTessellator::
+operator()(fastuidraw::range_type<unsigned int> R) const
+{
+  std::vector<fastuidraw::TessellatedPath::point> work_room(m_params.m_max_segments + 1);
+
+  for(unsigned int i = R.m_begin; i < R.m_end; ++i)
+    {
+      unsigned int needed;
+
+      needed = m_edges[i]->produce_tessellation(m_params, fastuidraw::make_c_array(work_room),
+                                                &m_out_distances[i]);
+      m_out[i].assign(work_room.begin(), work_room.begin() + needed);
+    }
 }
 
 //////////////////////////////////////////////
 // TessellatedPathPrivate methods
 TessellatedPathPrivate::
 TessellatedPathPrivate(const fastuidraw::Path &input,
-                       fastuidraw::TessellatedPath::TessellationParams TP):
+                       fastuidraw::TessellatedPath::TessellationParams TP,
+                       const fastuidraw::PathTessellationPool *pool):
   m_edge_ranges(input.number_contours()),
   m_box_min(0.0f, 0.0f),
   m_box_max(0.0f, 0.0f),
+  m_max_distance(0.0f),
   m_params(TP)
 {
-  if(input.number_contours() > 0)
+  if(input.number_contours() == 0)
     {
-      std::list<std::vector<fastuidraw::TessellatedPath::point> > temp;
-      std::vector<fastuidraw::TessellatedPath::point> work_room(m_params.m_max_segments + 1);
-      std::list<std::vector<fastuidraw::TessellatedPath::point> >::const_iterator iter, end_iter;
+      return;
+    }
 
-      for(unsigned int loc = 0, o = 0, endo = input.number_contours(); o < endo; ++o)
+  /* The edges are tessellated independently of each other,
+     possibly by the threads of a PathTessellationPool, each
+     into its own buffer.
+     Afterwards the values that depend on the preceding edges
+     (distance along the contour, contour lengths) are
+     computed serially; thus the result does not depend on
+     the number of threads used.
+   */
+  std::vector<const fastuidraw::PathContour::interpolator_base*> edges;
+  std::vector<std::vector<fastuidraw::TessellatedPath::point> > edge_points;
+  std::vector<float> edge_distances;
+
+  for(unsigned int o = 0, endo = input.number_contours(); o < endo; ++o)
+    {
+      fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> contour(input.contour(o));
+      for(unsigned int e = 0, ende = contour->number_points(); e < ende; ++e)
         {
-          fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> contour(input.contour(o));
-          float contour_length(0.0f), open_contour_length, closed_contour_length;
-          std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator start_contour;
+          edges.push_back(contour->interpolator(e).get());
+        }
+    }
+  edge_points.resize(edges.size());
+  edge_distances.resize(edges.size(), 0.0f);
 
-          m_edge_ranges[o].resize(contour->number_points());
-          for(unsigned int e = 0, ende = contour->number_points(); e < ende; ++e)
-            {
-              unsigned int needed;
+  EdgeTessellator tessellator(m_params, edges, edge_points, edge_distances);
+  if(pool)
+    {
+      fastuidraw::detail::PathTessellationPoolAccess::parallel_for(*pool, edges.size(),
+                                                                   boost::cref(tessellator));
+    }
+  else
+    {
+      tessellator(fastuidraw::range_type<unsigned int>(0, edges.size()));
+    }
 
-              temp.push_back(std::vector<fastuidraw::TessellatedPath::point>());
-              needed = contour->interpolator(e)->produce_tessellation(m_params, fastuidraw::make_c_array(work_room));
-              m_edge_ranges[o][e] = fastuidraw::range_type<unsigned int>(loc, loc + needed);
-              loc += needed;
+  std::vector<unsigned int> number_edges(input.number_contours());
+  for(unsigned int o = 0, endo = input.number_contours(); o < endo; ++o)
+    {
+      number_edges[o] = input.contour(o)->number_points();
+    }
+  set_point_data(number_edges, edge_points);
 
-              for(unsigned int n = 0; n < needed; ++n)
-                {
-                  const fastuidraw::vec2 &pt(work_room[n].m_p);
+  for(unsigned int i = 0, endi = edge_distances.size(); i < endi; ++i)
+    {
+      m_max_distance = std::max(m_max_distance, edge_distances[i]);
+    }
+}
 
-                  work_room[n].m_distance_from_contour_start = contour_length + work_room[n].m_distance_from_edge_start;
+TessellatedPathPrivate::
+TessellatedPathPrivate(const fastuidraw::TessellatedPath &input,
+                       float max_deviation):
+  m_edge_ranges(input.number_contours()),
+  m_box_min(0.0f, 0.0f),
+  m_box_max(0.0f, 0.0f),
+  m_max_distance(0.0f),
+  m_params(input.tessellation_parameters())
+{
+  using namespace fastuidraw;
 
-                  if(o == 0 and e == 0 and n == 0)
-                    {
-                      m_box_min = pt;
-                      m_box_max = pt;
-                    }
-                  else
+  if(input.number_contours() == 0)
+    {
+      return;
+    }
+
+  /* The open portion of each contour (i.e. all edges but
+     the closing edge) and the closing edge are simplified
+     as separate polylines so that the end points of the
+     open contour, where the caps are, are kept. The point
+     shared by two edges is kept only if the simplification
+     keeps it, thus edges are merged when the point between
+     them is removed; a new edge starts at each kept point
+     shared by two edges of the input.
+   */
+  PolylineSimplifier simplifier(max_deviation);
+  std::vector<SimplifyPoint> group;
+  std::vector<vec2> group_pts;
+  std::vector<bool> keep;
+  std::vector<unsigned int> number_edges(input.number_contours(), 0);
+  std::vector<std::vector<TessellatedPath::point> > edge_points;
+  float removed_distance(0.0f);
+
+  for(unsigned int o = 0, endo = input.number_contours(); o < endo; ++o)
+    {
+      unsigned int ende(input.number_edges(o));
+      vecN<range_type<unsigned int>, 2> groups;
+
+      groups[0] = range_type<unsigned int>(0, (ende > 1) ? ende - 1 : ende);
+      groups[1] = range_type<unsigned int>(groups[0].m_end, ende);
+      for(unsigned int g = 0; g < 2; ++g)
+        {
+          if(groups[g].m_begin == groups[g].m_end)
+            {
+              continue;
+            }
+
+          group.clear();
+          for(unsigned int e = groups[g].m_begin; e < groups[g].m_end; ++e)
+            {
+              const_c_array<TessellatedPath::point> pts(input.edge_point_data(o, e));
+              for(unsigned int i = 0, endi = pts.size(); i < endi; ++i)
+                {
+                  /* the point shared with the previous edge is
+                     replicated, drop the replica.
+                   */
+                  if(i == 0 && !group.empty() && group.back().m_pt.m_p == pts[i].m_p)
                     {
-                      m_box_min.x() = std::min(m_box_min.x(), pt.x());
-                      m_box_min.y() = std::min(m_box_min.y(), pt.y());
-                      m_box_max.x() = std::max(m_box_max.x(), pt.x());
-                      m_box_max.y() = std::max(m_box_max.y(), pt.y());
+                      continue;
                     }
+                  group.push_back(SimplifyPoint(pts[i], i + 1 == endi && e + 1 != groups[g].m_end));
                 }
-              std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator t;
-              t = temp.insert(temp.end(),
-                              std::vector<fastuidraw::TessellatedPath::point>(work_room.begin(), work_room.begin() + needed));
-              if(e == 0)
-                {
-                  start_contour = t;
-                }
+            }
 
-              contour_length = temp.back().back().m_distance_from_contour_start;
+          group_pts.resize(group.size());
+          for(unsigned int i = 0, endi = group.size(); i < endi; ++i)
+            {
+              group_pts[i] = group[i].m_pt.m_p;
+            }
+          removed_distance = t_max(removed_distance, simplifier.simplify(group_pts, keep));
 
-              if(e + 2 == ende)
-                {
-                  open_contour_length = contour_length;
-                }
-              else if(e + 1 == ende)
+          edge_points.push_back(std::vector<TessellatedPath::point>());
+          ++number_edges[o];
+          for(unsigned int i = 0, endi = group.size(); i < endi; ++i)
+            {
+              if(!keep[i])
                 {
-                  closed_contour_length = contour_length;
+                  continue;
                 }
 
-              for(unsigned int n = 0; n < needed; ++n)
+              edge_points.back().push_back(group[i].m_pt);
+              if(group[i].m_is_edge_end)
                 {
-                  (*t)[n].m_edge_length = (*t)[needed - 1].m_distance_from_edge_start;
+                  edge_points.push_back(std::vector<TessellatedPath::point>(1, group[i].m_pt));
+                  ++number_edges[o];
                 }
             }
+        }
+    }
+
+  /* the derivative of a kept point is replaced by the
+     direction of the segment leaving it (the segment coming
+     into it for the last point of an edge) so that the
+     stroking of the bends within an edge is on the correct
+     side; the distances are recomputed along the segments.
+   */
+  for(unsigned int t = 0, endt = edge_points.size(); t < endt; ++t)
+    {
+      std::vector<TessellatedPath::point> &pts(edge_points[t]);
+      float d(0.0f);
 
-          for(std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator
-                t = start_contour, endt = temp.end(); t != endt; ++t)
+      for(unsigned int i = 0, endi = pts.size(); i < endi; ++i)
+        {
+          vec2 delta;
+
+          if(i > 0)
             {
-              for(unsigned int e = 0, ende = t->size(); e < ende; ++e)
+              d += (pts[i].m_p - pts[i - 1].m_p).magnitude();
+            }
+          pts[i].m_distance_from_edge_start = d;
+
+          delta = (i + 1 < endi) ?
+            pts[i + 1].m_p - pts[i].m_p :
+            (i > 0) ? pts[i].m_p - pts[i - 1].m_p : vec2(0.0f, 0.0f);
+          if(delta.magnitudeSq() > 0.0f)
+            {
+              pts[i].m_p_t = delta;
+            }
+        }
+    }
+  set_point_data(number_edges, edge_points);
+
+  /* each segment of input is within removed_distance of the
+     simplified segment that replaces it (the distance to a
+     segment is convex and the end points of the segment of
+     input are within removed_distance), so each point of the
+     curves is within the sum of the distances.
+   */
+  m_max_distance = input.max_distance() + removed_distance;
+}
+
+void
+TessellatedPathPrivate::
+set_point_data(const std::vector<unsigned int> &number_edges,
+               std::vector<std::vector<fastuidraw::TessellatedPath::point> > &edge_points)
+{
+  unsigned int loc(0), edge(0);
+  for(unsigned int o = 0, endo = number_edges.size(); o < endo; ++o)
+    {
+      unsigned int ende(number_edges[o]);
+      unsigned int start_contour(edge);
+      float contour_length(0.0f), open_contour_length(0.0f), closed_contour_length(0.0f);
+
+      m_edge_ranges[o].resize(ende);
+      for(unsigned int e = 0; e < ende; ++e, ++edge)
+        {
+          std::vector<fastuidraw::TessellatedPath::point> &pts(edge_points[edge]);
+          unsigned int needed(pts.size());
+
+          m_edge_ranges[o][e] = fastuidraw::range_type<unsigned int>(loc, loc + needed);
+          loc += needed;
+
+          for(unsigned int n = 0; n < needed; ++n)
+            {
+              const fastuidraw::vec2 &pt(pts[n].m_p);
+
+              pts[n].m_distance_from_contour_start = contour_length + pts[n].m_distance_from_edge_start;
+
+              if(o == 0 and e == 0 and n == 0)
                 {
-                  (*t)[e].m_open_contour_length = open_contour_length;
-                  (*t)[e].m_closed_contour_length = closed_contour_length;
+                  m_box_min = pt;
+                  m_box_max = pt;
+                }
+              else
+                {
+                  m_box_min.x() = std::min(m_box_min.x(), pt.x());
+                  m_box_min.y() = std::min(m_box_min.y(), pt.y());
+                  m_box_max.x() = std::max(m_box_max.x(), pt.x());
+                  m_box_max.y() = std::max(m_box_max.y(), pt.y());
                 }
             }
-        }
 
-      unsigned int total_needed;
+          contour_length = pts.back().m_distance_from_contour_start;
+
+          if(e + 2 == ende)
+            {
+              open_contour_length = contour_length;
+            }
+          else if(e + 1 == ende)
+            {
+              closed_contour_length = contour_length;
+            }
+
+          for(unsigned int n = 0; n < needed; ++n)
+            {
+              pts[n].m_edge_length = pts[needed - 1].m_distance_from_edge_start;
+            }
+        }
 
-      total_needed = m_edge_ranges.back().back().m_end;
-      m_point_data.reserve(total_needed);
-      for(iter = temp.begin(), end_iter = temp.end(); iter != end_iter; ++iter)
+      for(unsigned int t = start_contour; t < edge; ++t)
         {
-          std::copy(iter->begin(), iter->end(),
-                    std::back_insert_iterator<std::vector<fastuidraw::TessellatedPath::point> >(m_point_data));
+          for(unsigned int n = 0, endn = edge_points[t].size(); n < endn; ++n)
+            {
+              edge_points[t][n].m_open_contour_length = open_contour_length;
+              edge_points[t][n].m_closed_contour_length = closed_contour_length;
+            }
         }
-      assert(total_needed == m_point_data.size());
     }
-  else
+
+  m_point_data.reserve(loc);
+  for(unsigned int t = 0, endt = edge_points.size(); t < endt; ++t)
     {
-      m_box_min = m_box_max = fastuidraw::vec2(0.0f, 0.0f);
+      m_point_data.insert(m_point_data.end(), edge_points[t].begin(), edge_points[t].end());
     }
+  assert(loc == m_point_data.size());
 }
 
 //////////////////////////////////////
 // fastuidraw::TessellatedPath methods
 fastuidraw::TessellatedPath::
 TessellatedPath(const Path &input,
-                fastuidraw::TessellatedPath::TessellationParams TP)
+                fastuidraw::TessellatedPath::TessellationParams TP,
+                const PathTessellationPool *pool)
 {
-  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP);
+  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP, pool);
+}
+
+fastuidraw::TessellatedPath::
+TessellatedPath(const TessellatedPath &input, float max_deviation)
+{
+  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, max_deviation);
 }
 
 fastuidraw::TessellatedPath::
@@ -162,6 +518,15 @@ fastuidraw::TessellatedPath::
   m_d = NULL;
 }
 
+float
+fastuidraw::TessellatedPath::
+max_distance(void) const
+{
+  TessellatedPathPrivate *d;
+  d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
+  return d->m_max_distance;
+}
+
 const fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath>&
 fastuidraw::TessellatedPath::
 stroked(void) const
@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+10,10,47,42,10,32,32,77,117,115,116,32,104,97,118,101,32,100,101,102,105,110,101,100,58,10,32,32,32,45,32,70,65,83,84,85,73,68,82,65,87,95,73,78,68,69,88,95,84,73,76,69,95,83,73,90,69,58,32,115,105,122,101,32,111,102,32,105,110,100,101,120,32,116,105,108,101,115,10,32,32,32,45,32,70,65,83,84,85,73,68,82,65,87,95,67,79,76,79,82,95,84,73,76,69,95,83,73,90,69,58,32,115,105,122,101,32,111,102,32,99,111,108,111,114,32,116,105,108,101,115,10,10,32,32,32,45,32,70,65,83,84,85,73,68,82,65,87,95,73,78,68,69,88,95,65,84,76,65,83,58,32,117,115,97,109,112,108,101,114,50,68,65,114,114,97,121,32,115,97,109,112,108,101,114,32,102,111,114,32,116,104,101,32,105,110,100,101,120,32,97,116,108,97,115,10,32,32,32,45,32,70,65,83,84,85,73,68,82,65,87,95,65,84,76,65,83,95,67,79,77,80,85,84,69,95,67,79,79,82,68,58,32,110,97,109,101,32,111,102,32,116,104,101,32,102,117,110,99,116,105,111,110,10,32,42,47,10,10,10,118,111,105,100,10,70,65,83,84,85,73,68,82,65,87,95,65,84,76,65,83,95,67,79,77,80,85,84,69,95,67,79,79,82,68,40,105,110,32,118,101,99,50,32,112,117,110,110,111,114,109,97,108,105,122,101,100,95,105,110,100,101,120,95,116,101,120,95,99,111,111,114,100,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,105,110,116,32,112,105,110,100,101,120,95,108,97,121,101,114,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,105,110,116,32,112,110,117,109,95,108,101,118,101,108,115,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,105,110,116,32,115,108,97,99,107,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,111,117,116,32,118,101,99,50,32,114,101,116,117,114,110,95,118,97,108,117,101,95,117,110,110,111,114,109,97,108,105,122,101,100,95,116,101,120,99,111,111,114,100,95,120,121,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,111,117,116,32,105,110,116,32,114,101,116,117,114,110,95,118,97,108,117,101,95,108,97,121,101,114,41,10,123,10,32,32,105,110,116,32,105,110,100,101,120,95,108,97,121,101,114,32,61,32,112,105,110,100,101,120,95,108,97,121,101,114,59,10,32,32,118,101,99,50,32,117,110,110,111,114,109,97,108,105,122,101,100,95,105,110,100,101,120,95,116,101,120,95,99,111,111,114,100,32,61,32,112,117,110,110,111,114,109,97,108,105,122,101,100,95,105,110,100,101,120,95,116,101,120,95,99,111,111,114,100,59,10,32,32,105,118,101,99,52,32,116,105,108,101,95,105,100,59,10,32,32,118,101,99,50,32,99,111,108,111,114,95,97,116,108,97,115,95,116,101,120,99,111,111,114,100,95,120,121,59,10,32,32,105,118,101,99,50,32,105,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,59,10,10,10,32,32,105,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,32,61,32,105,118,101,99,50,40,117,110,110,111,114,109,97,108,105,122,101,100,95,105,110,100,101,120,95,116,101,120,95,99,111,111,114,100,41,59,10,32,32,116,105,108,101,95,105,100,32,61,32,105,118,101,99,52,40,116,101,120,101,108,70,101,116,99,104,40,70,65,83,84,85,73,68,82,65,87,95,73,78,68,69,88,95,65,84,76,65,83,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,118,101,99,51,40,105,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,44,32,105,110,100,101,120,95,108,97,121,101,114,41,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,48,41,41,59,10,32,32,105,110,100,101,120,95,108,97,121,101,114,32,61,32,116,105,108,101,95,105,100,46,122,32,43,32,50,53,54,32,42,32,116,105,108,101,95,105,100,46,119,59,10,10,32,32,102,111,114,40,105,110,116,32,105,32,61,32,49,59,32,105,32,60,32,112,110,117,109,95,108,101,118,101,108,115,59,32,43,43,105,41,10,32,32,32,32,123,10,32,32,32,32,32,32,118,101,99,50,32,105,110,100,101,120,95,116,105,108,101,95,111,102,102,115,101,116,59,10,32,32,32,32,32,32,118,101,99,50,32,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,59,10,10,32,32,32,32,32,32,117,110,110,111,114,109,97,108,105,122,101,100,95,105,110,100,101,120,95,116,101,120,95,99,111,111,114,100,32,45,61,32,118,101,99,50,40,105,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,41,59,10,32,32,32,32,32,32,105,110,100,101,120,95,116,105,108,101,95,111,102,102,115,101,116,32,61,32,117,110,110,111,114,109,97,108,105,122,101,100,95,105,110,100,101,120,95,116,101,120,95,99,111,111,114,100,32,42,32,102,108,111,97,116,40,70,65,83,84,85,73,68,82,65,87,95,73,78,68,69,88,95,84,73,76,69,95,83,73,90,69,41,59,10,32,32,32,32,32,32,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,32,61,32,105,110,100,101,120,95,116,105,108,101,95,111,102,102,115,101,116,10,32,32,32,32,32,32,32,32,43,32,118,101,99,50,40,116,105,108,101,95,105,100,46,120,121,41,32,42,32,102,108,111,97,116,40,70,65,83,84,85,73,68,82,65,87,95,73,78,68,69,88,95,84,73,76,69,95,83,73,90,69,41,59,10,10,32,32,32,32,32,32,105,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,32,61,32,105,118,101,99,50,40,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,41,59,10,32,32,32,32,32,32,116,105,108,101,95,105,100,32,61,32,105,118,101,99,52,40,116,101,120,101,108,70,101,116,99,104,40,70,65,83,84,85,73,68,82,65,87,95,73,78,68,69,88,95,65,84,76,65,83,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,118,101,99,51,40,105,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,44,32,105,110,100,101,120,95,108,97,121,101,114,41,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,48,41,41,59,10,32,32,32,32,32,32,105,110,100,101,120,95,108,97,121,101,114,32,61,32,116,105,108,101,95,105,100,46,122,32,43,32,50,53,54,32,42,32,116,105,108,101,95,105,100,46,119,59,10,10,32,32,32,32,32,32,117,110,110,111,114,109,97,108,105,122,101,100,95,105,110,100,101,120,95,116,101,120,95,99,111,111,114,100,32,61,32,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,59,10,10,32,32,32,32,125,10,10,32,32,47,42,32,97,116,32,116,104,105,115,32,112,111,105,110,116,32,105,110,100,101,120,95,108,97,121,101,114,32,103,105,118,101,115,10,32,32,32,32,32,116,104,101,32,108,97,121,101,114,32,105,110,116,111,32,99,111,108,111,114,65,116,108,97,115,32,97,110,100,10,32,32,32,32,32,116,105,108,101,95,105,100,32,103,105,118,101,115,32,119,104,105,99,104,32,116,105,108,101,32,105,110,10,32,32,32,32,32,116,104,101,32,99,111,108,111,114,32,97,116,108,97,115,10,32,32,42,47,10,32,32,118,101,99,50,32,116,105,108,101,95,111,102,102,115,101,116,59,10,32,32,105,110,116,32,115,117,98,116,105,108,101,95,105,109,97,103,101,95,115,105,122,101,59,10,10,32,32,115,117,98,116,105,108,101,95,105,109,97,103,101,95,115,105,122,101,32,61,32,70,65,83,84,85,73,68,82,65,87,95,67,79,76,79,82,95,84,73,76,69,95,83,73,90,69,32,45,32,50,32,42,32,115,108,97,99,107,59,10,32,32,116,105,108,101,95,111,102,102,115,101,116,32,61,32,40,117,110,110,111,114,109,97,108,105,122,101,100,95,105,110,100,101,120,95,116,101,120,95,99,111,111,114,100,32,45,32,118,101,99,50,40,105,116,101,120,101,108,95,99,111,111,114,100,105,110,97,116,101,41,41,32,42,32,102,108,111,97,116,40,115,117,98,116,105,108,101,95,105,109,97,103,101,95,115,105,122,101,41,59,10,10,32,32,114,101,116,117,114,110,95,118,97,108,117,101,95,117,110,110,111,114,109,97,108,105,122,101,100,95,116,101,120,99,111,111,114,100,95,120,121,32,61,32,116,105,108,101,95,111,102,102,115,101,116,32,47,47,111,102,102,115,101,116,32,105,110,116,111,32,116,105,108,101,10,32,32,32,32,43,32,118,101,99,50,40,102,108,111,97,116,40,115,108,97,99,107,41,41,32,47,47,115,108,97,99,107,32,97,100,100,101,100,10,32,32,32,32,43,32,118,101,99,50,40,116,105,108,101,95,105,100,46,120,121,41,32,42,32,102,108,111,97,116,40,70,65,83,84,85,73,68,82,65,87,95,67,79,76,79,82,95,84,73,76,69,95,83,73,90,69,41,59,32,47,47,108,111,99,97,116,105,111,110,32,111,102,32,116,105,108,101,10,10,32,32,114,101,116,117,114,110,95,118,97,108,117,101,95,108,97,121,101,114,32,61,32,105,110,100,101,120,95,108,97,121,101,114,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_atlas_image_fetch.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
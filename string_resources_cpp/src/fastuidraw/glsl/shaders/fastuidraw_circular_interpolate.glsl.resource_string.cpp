@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+118,101,99,50,10,102,97,115,116,117,105,100,114,97,119,95,99,105,114,99,117,108,97,114,95,105,110,116,101,114,112,111,108,97,116,101,40,105,110,32,118,101,99,50,32,118,48,44,32,105,110,32,118,101,99,50,32,118,49,44,32,105,110,32,102,108,111,97,116,32,100,44,32,105,110,32,102,108,111,97,116,32,105,110,116,101,114,112,111,108,97,116,101,41,10,123,10,32,32,102,108,111,97,116,32,97,110,103,108,101,44,32,99,44,32,115,59,10,32,32,97,110,103,108,101,32,61,32,97,99,111,115,40,100,41,59,10,32,32,47,42,32,119,101,32,109,117,108,116,105,112,108,101,32,98,121,32,116,104,101,32,99,114,111,115,115,32,111,102,32,118,48,32,97,110,100,32,118,49,10,32,32,32,32,32,116,111,32,109,97,107,101,32,115,117,114,101,32,119,101,32,97,114,101,32,105,110,116,101,114,112,111,108,97,116,105,110,103,32,102,114,111,109,32,118,48,10,32,32,32,32,32,116,111,32,118,49,32,98,101,99,97,117,115,101,32,97,99,111,115,32,97,108,119,97,121,115,32,103,105,118,101,115,32,97,32,112,111,115,105,116,105,118,101,10,32,32,32,32,32,97,110,103,108,101,10,32,32,32,42,47,10,32,32,99,32,61,32,99,111,115,40,97,110,103,108,101,32,42,32,105,110,116,101,114,112,111,108,97,116,101,41,59,10,32,32,115,32,61,32,115,105,110,40,97,110,103,108,101,32,42,32,105,110,116,101,114,112,111,108,97,116,101,41,32,42,32,115,105,103,110,40,118,48,46,120,32,42,32,118,49,46,121,32,45,32,118,49,46,120,32,42,32,118,48,46,121,41,59,10,32,32,114,101,116,117,114,110,32,118,101,99,50,40,99,32,42,32,118,48,46,120,32,45,32,115,32,42,32,118,48,46,121,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,115,32,42,32,118,48,46,120,32,43,32,99,32,42,32,118,48,46,121,41,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_circular_interpolate.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
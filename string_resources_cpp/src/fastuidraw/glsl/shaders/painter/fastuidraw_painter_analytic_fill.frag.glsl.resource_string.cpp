@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+47,42,32,69,97,99,104,32,115,101,103,109,101,110,116,32,115,116,97,114,116,115,32,111,110,32,97,32,98,108,111,99,107,32,111,102,32,116,104,101,32,100,97,116,97,32,115,116,111,114,101,32,97,110,100,32,105,115,10,32,32,32,112,97,99,107,101,100,32,97,115,32,40,115,116,97,114,116,46,120,44,32,115,116,97,114,116,46,121,44,32,101,110,100,46,120,44,32,101,110,100,46,121,41,46,10,32,42,47,10,118,101,99,52,10,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,102,101,116,99,104,95,115,101,103,109,101,110,116,40,105,110,32,117,105,110,116,32,108,111,99,41,10,123,10,32,32,35,105,102,32,102,97,115,116,117,105,100,114,97,119,95,100,97,116,97,95,115,116,111,114,101,95,97,108,105,103,110,109,101,110,116,32,61,61,32,52,10,32,32,114,101,116,117,114,110,32,117,105,110,116,66,105,116,115,84,111,70,108,111,97,116,40,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,41,41,59,10,32,32,35,101,108,105,102,32,102,97,115,116,117,105,100,114,97,119,95,100,97,116,97,95,115,116,111,114,101,95,97,108,105,103,110,109,101,110,116,32,61,61,32,51,10,32,32,114,101,116,117,114,110,32,117,105,110,116,66,105,116,115,84,111,70,108,111,97,116,40,117,118,101,99,52,40,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,41,46,120,121,122,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,32,43,32,49,117,41,46,120,41,41,59,10,32,32,35,101,108,105,102,32,102,97,115,116,117,105,100,114,97,119,95,100,97,116,97,95,115,116,111,114,101,95,97,108,105,103,110,109,101,110,116,32,61,61,32,50,10,32,32,114,101,116,117,114,110,32,117,105,110,116,66,105,116,115,84,111,70,108,111,97,116,40,117,118,101,99,52,40,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,41,46,120,121,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,32,43,32,49,117,41,46,120,121,41,41,59,10,32,32,35,101,108,115,101,10,32,32,114,101,116,117,114,110,32,117,105,110,116,66,105,116,115,84,111,70,108,111,97,116,40,117,118,101,99,52,40,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,41,46,120,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,32,43,32,49,117,41,46,120,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,32,43,32,50,117,41,46,120,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,32,43,32,51,117,41,46,120,41,41,59,10,32,32,35,101,110,100,105,102,10,125,10,10,47,42,32,69,97,99,104,32,101,110,116,114,121,32,111,102,32,116,104,101,32,98,97,110,100,32,116,97,98,108,101,32,115,116,97,114,116,115,32,111,110,32,97,32,98,108,111,99,107,32,111,102,32,116,104,101,32,100,97,116,97,10,32,32,32,115,116,111,114,101,32,97,110,100,32,105,115,32,112,97,99,107,101,100,32,97,115,32,40,108,111,99,97,116,105,111,110,32,111,102,32,116,104,101,32,102,105,114,115,116,32,115,101,103,109,101,110,116,32,105,110,32,98,108,111,99,107,115,10,32,32,32,102,114,111,109,32,116,104,101,32,115,116,97,114,116,32,111,102,32,116,104,101,32,100,97,116,97,44,32,110,117,109,98,101,114,32,111,102,32,115,101,103,109,101,110,116,115,41,46,10,32,42,47,10,117,118,101,99,50,10,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,102,101,116,99,104,95,98,97,110,100,40,105,110,32,117,105,110,116,32,108,111,99,41,10,123,10,32,32,35,105,102,32,102,97,115,116,117,105,100,114,97,119,95,100,97,116,97,95,115,116,111,114,101,95,97,108,105,103,110,109,101,110,116,32,61,61,32,49,10,32,32,114,101,116,117,114,110,32,117,118,101,99,50,40,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,41,46,120,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,32,43,32,49,117,41,46,120,41,59,10,32,32,35,101,108,115,101,10,32,32,114,101,116,117,114,110,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,100,97,116,97,40,108,111,99,41,46,120,121,59,10,32,32,35,101,110,100,105,102,10,125,10,10,47,42,32,77,117,115,116,32,109,97,116,99,104,32,98,97,110,100,95,111,102,40,41,32,111,102,32,112,97,105,110,116,101,114,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,112,97,114,97,109,115,46,99,112,112,44,10,32,32,32,102,32,105,115,32,116,104,101,32,99,111,111,114,100,105,110,97,116,101,32,109,97,112,112,101,100,32,115,111,32,116,104,97,116,32,101,97,99,104,32,98,97,110,100,32,104,97,115,32,115,105,122,101,32,49,46,10,32,42,47,10,117,105,110,116,10,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,98,97,110,100,40,105,110,32,102,108,111,97,116,32,102,44,32,105,110,32,117,105,110,116,32,110,117,109,98,101,114,95,98,97,110,100,115,41,10,123,10,32,32,114,101,116,117,114,110,32,117,105,110,116,40,99,108,97,109,112,40,102,44,32,48,46,48,44,32,102,108,111,97,116,40,110,117,109,98,101,114,95,98,97,110,100,115,32,45,32,49,117,41,41,41,59,10,125,10,10,102,108,111,97,116,10,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,97,112,112,108,121,95,102,105,108,108,95,114,117,108,101,40,105,110,32,102,108,111,97,116,32,119,44,32,105,110,32,117,105,110,116,32,102,105,108,108,95,114,117,108,101,41,10,123,10,32,32,102,108,111,97,116,32,99,59,10,10,32,32,119,32,61,32,97,98,115,40,119,41,59,10,32,32,105,102,40,102,105,108,108,95,114,117,108,101,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,111,100,100,95,101,118,101,110,95,102,105,108,108,95,114,117,108,101,41,10,32,32,32,32,32,124,124,32,102,105,108,108,95,114,117,108,101,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,99,111,109,112,108,101,109,101,110,116,95,111,100,100,95,101,118,101,110,95,102,105,108,108,95,114,117,108,101,41,41,10,32,32,32,32,123,10,32,32,32,32,32,32,99,32,61,32,49,46,48,32,45,32,97,98,115,40,49,46,48,32,45,32,109,111,100,40,119,44,32,50,46,48,41,41,59,10,32,32,32,32,125,10,32,32,101,108,115,101,10,32,32,32,32,123,10,32,32,32,32,32,32,99,32,61,32,109,105,110,40,119,44,32,49,46,48,41,59,10,32,32,32,32,125,10,10,32,32,105,102,40,102,105,108,108,95,114,117,108,101,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,99,111,109,112,108,101,109,101,110,116,95,111,100,100,95,101,118,101,110,95,102,105,108,108,95,114,117,108,101,41,10,32,32,32,32,32,124,124,32,102,105,108,108,95,114,117,108,101,32,61,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,99,111,109,112,108,101,109,101,110,116,95,110,111,110,122,101,114,111,95,102,105,108,108,95,114,117,108,101,41,41,10,32,32,32,32,123,10,32,32,32,32,32,32,99,32,61,32,49,46,48,32,45,32,99,59,10,32,32,32,32,125,10,32,32,114,101,116,117,114,110,32,99,59,10,125,10,10,47,42,32,77,117,115,116,32,109,97,116,99,104,32,80,97,105,110,116,101,114,65,110,97,108,121,116,105,99,70,105,108,108,80,97,114,97,109,115,58,58,99,111,109,112,117,116,101,95,99,111,118,101,114,97,103,101,40,41,58,10,32,32,32,116,104,101,32,119,105,110,100,105,110,103,32,110,117,109,98,101,114,32,105,115,32,99,111,109,112,117,116,101,100,32,97,108,111,110,103,32,116,104,101,32,114,97,121,32,105,110,32,116,104,101,32,100,105,114,101,99,116,105,111,110,10,32,32,32,111,102,32,105,110,99,114,101,97,115,105,110,103,32,120,32,97,110,100,32,97,108,111,110,103,32,116,104,101,32,114,97,121,32,105,110,32,116,104,101,32,100,105,114,101,99,116,105,111,110,32,111,102,32,105,110,99,114,101,97,115,105,110,103,10,32,32,32,121,59,32,97,32,115,101,103,109,101,110,116,32,99,114,111,115,115,105,110,103,32,97,32,114,97,121,32,119,105,116,104,105,110,32,104,97,108,102,32,97,32,112,105,120,101,108,32,111,102,32,116,104,101,32,102,114,97,103,109,101,110,116,10,32,32,32,99,111,110,116,114,105,98,117,116,101,115,32,102,114,97,99,116,105,111,110,97,108,108,121,32,115,111,32,116,104,97,116,32,116,104,101,32,101,100,103,101,115,32,97,114,101,32,97,110,116,105,45,97,108,105,97,115,101,100,46,32,84,104,101,10,32,32,32,116,119,111,32,114,97,121,115,32,97,114,101,32,119,101,105,103,104,116,101,100,32,98,121,32,104,111,119,32,110,101,97,114,32,116,104,101,105,114,32,110,101,97,114,101,115,116,32,99,114,111,115,115,105,110,103,32,105,115,46,32,79,110,108,121,10,32,32,32,116,104,101,32,115,101,103,109,101,110,116,115,32,111,102,32,116,104,101,32,104,111,114,105,122,111,110,116,97,108,32,98,97,110,100,32,97,110,100,32,111,102,32,116,104,101,32,118,101,114,116,105,99,97,108,32,98,97,110,100,32,111,102,10,32,32,32,116,104,101,32,102,114,97,103,109,101,110,116,32,97,114,101,32,119,97,108,107,101,100,46,10,32,42,47,10,118,101,99,52,10,102,97,115,116,117,105,100,114,97,119,95,103,108,95,102,114,97,103,95,109,97,105,110,40,105,110,32,117,105,110,116,32,115,117,98,95,115,104,97,100,101,114,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,117,105,110,116,32,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,41,10,123,10,32,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,104,101,97,100,101,114,32,104,101,97,100,101,114,59,10,32,32,118,101,99,50,32,112,44,32,112,105,120,101,108,115,95,112,101,114,95,117,110,105,116,59,10,32,32,102,108,111,97,116,32,119,120,44,32,119,121,44,32,119,101,105,103,104,116,95,120,44,32,119,101,105,103,104,116,95,121,44,32,99,120,44,32,99,121,44,32,99,111,118,101,114,97,103,101,59,10,32,32,117,105,110,116,32,108,111,99,44,32,105,44,32,104,98,97,110,100,44,32,118,98,97,110,100,59,10,32,32,117,118,101,99,50,32,98,97,110,100,59,10,10,32,32,102,97,115,116,117,105,100,114,97,119,95,114,101,97,100,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,104,101,97,100,101,114,40,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,44,32,104,101,97,100,101,114,41,59,10,10,32,32,112,32,61,32,118,101,99,50,40,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,120,44,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,121,41,59,10,32,32,112,105,120,101,108,115,95,112,101,114,95,117,110,105,116,46,120,32,61,32,49,46,48,32,47,32,109,97,120,40,108,101,110,103,116,104,40,118,101,99,50,40,100,70,100,120,40,112,46,120,41,44,32,100,70,100,121,40,112,46,120,41,41,41,44,32,49,101,45,54,41,59,10,32,32,112,105,120,101,108,115,95,112,101,114,95,117,110,105,116,46,121,32,61,32,49,46,48,32,47,32,109,97,120,40,108,101,110,103,116,104,40,118,101,99,50,40,100,70,100,120,40,112,46,121,41,44,32,100,70,100,121,40,112,46,121,41,41,41,44,32,49,101,45,54,41,59,10,10,32,32,119,120,32,61,32,48,46,48,59,10,32,32,119,121,32,61,32,48,46,48,59,10,32,32,119,101,105,103,104,116,95,120,32,61,32,48,46,48,59,10,32,32,119,101,105,103,104,116,95,121,32,61,32,48,46,48,59,10,32,32,104,98,97,110,100,32,61,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,98,97,110,100,40,40,112,46,121,32,45,32,104,101,97,100,101,114,46,98,97,110,100,95,109,105,110,95,121,41,32,42,32,104,101,97,100,101,114,46,98,97,110,100,95,115,99,97,108,101,95,121,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,104,101,97,100,101,114,46,110,117,109,98,101,114,95,98,97,110,100,115,41,59,10,32,32,118,98,97,110,100,32,61,32,104,101,97,100,101,114,46,110,117,109,98,101,114,95,98,97,110,100,115,10,32,32,32,32,43,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,98,97,110,100,40,40,112,46,120,32,45,32,104,101,97,100,101,114,46,98,97,110,100,95,109,105,110,95,120,41,32,42,32,104,101,97,100,101,114,46,98,97,110,100,95,115,99,97,108,101,95,120,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,104,101,97,100,101,114,46,110,117,109,98,101,114,95,98,97,110,100,115,41,59,10,10,32,32,98,97,110,100,32,61,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,102,101,116,99,104,95,98,97,110,100,40,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,43,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,104,101,97,100,101,114,95,110,117,109,95,98,108,111,99,107,115,41,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,43,32,104,98,97,110,100,32,42,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,98,97,110,100,95,110,117,109,95,98,108,111,99,107,115,41,41,59,10,32,32,108,111,99,32,61,32,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,32,43,32,98,97,110,100,46,120,59,10,32,32,102,111,114,40,105,32,61,32,48,117,59,32,105,32,60,32,98,97,110,100,46,121,59,32,43,43,105,44,32,108,111,99,32,43,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,115,101,103,109,101,110,116,95,110,117,109,95,98,108,111,99,107,115,41,41,10,32,32,32,32,123,10,32,32,32,32,32,32,118,101,99,52,32,83,59,10,32,32,32,32,32,32,118,101,99,50,32,97,44,32,98,59,10,10,32,32,32,32,32,32,83,32,61,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,102,101,116,99,104,95,115,101,103,109,101,110,116,40,108,111,99,41,59,10,32,32,32,32,32,32,97,32,61,32,83,46,120,121,59,10,32,32,32,32,32,32,98,32,61,32,83,46,122,119,59,10,10,32,32,32,32,32,32,105,102,40,109,105,110,40,97,46,121,44,32,98,46,121,41,32,60,61,32,112,46,121,32,38,38,32,112,46,121,32,60,32,109,97,120,40,97,46,121,44,32,98,46,121,41,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,120,59,10,32,32,32,32,32,32,32,32,32,32,120,32,61,32,40,97,46,120,32,43,32,40,112,46,121,32,45,32,97,46,121,41,32,42,32,40,98,46,120,32,45,32,97,46,120,41,32,47,32,40,98,46,121,32,45,32,97,46,121,41,32,45,32,112,46,120,41,32,42,32,112,105,120,101,108,115,95,112,101,114,95,117,110,105,116,46,120,59,10,32,32,32,32,32,32,32,32,32,32,119,120,32,43,61,32,40,40,98,46,121,32,62,32,97,46,121,41,32,63,32,49,46,48,32,58,32,45,49,46,48,41,32,42,32,99,108,97,109,112,40,48,46,53,32,43,32,120,44,32,48,46,48,44,32,49,46,48,41,59,10,32,32,32,32,32,32,32,32,32,32,119,101,105,103,104,116,95,120,32,61,32,109,97,120,40,119,101,105,103,104,116,95,120,44,32,49,46,48,32,45,32,50,46,48,32,42,32,97,98,115,40,120,41,41,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,125,10,10,32,32,98,97,110,100,32,61,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,102,101,116,99,104,95,98,97,110,100,40,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,43,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,104,101,97,100,101,114,95,110,117,109,95,98,108,111,99,107,115,41,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,43,32,118,98,97,110,100,32,42,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,98,97,110,100,95,110,117,109,95,98,108,111,99,107,115,41,41,59,10,32,32,108,111,99,32,61,32,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,32,43,32,98,97,110,100,46,120,59,10,32,32,102,111,114,40,105,32,61,32,48,117,59,32,105,32,60,32,98,97,110,100,46,121,59,32,43,43,105,44,32,108,111,99,32,43,61,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,115,101,103,109,101,110,116,95,110,117,109,95,98,108,111,99,107,115,41,41,10,32,32,32,32,123,10,32,32,32,32,32,32,118,101,99,52,32,83,59,10,32,32,32,32,32,32,118,101,99,50,32,97,44,32,98,59,10,10,32,32,32,32,32,32,83,32,61,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,102,101,116,99,104,95,115,101,103,109,101,110,116,40,108,111,99,41,59,10,32,32,32,32,32,32,97,32,61,32,83,46,120,121,59,10,32,32,32,32,32,32,98,32,61,32,83,46,122,119,59,10,10,32,32,32,32,32,32,105,102,40,109,105,110,40,97,46,120,44,32,98,46,120,41,32,60,61,32,112,46,120,32,38,38,32,112,46,120,32,60,32,109,97,120,40,97,46,120,44,32,98,46,120,41,41,10,32,32,32,32,32,32,32,32,123,10,32,32,32,32,32,32,32,32,32,32,102,108,111,97,116,32,121,59,10,32,32,32,32,32,32,32,32,32,32,121,32,61,32,40,97,46,121,32,43,32,40,112,46,120,32,45,32,97,46,120,41,32,42,32,40,98,46,121,32,45,32,97,46,121,41,32,47,32,40,98,46,120,32,45,32,97,46,120,41,32,45,32,112,46,121,41,32,42,32,112,105,120,101,108,115,95,112,101,114,95,117,110,105,116,46,121,59,10,32,32,32,32,32,32,32,32,32,32,119,121,32,43,61,32,40,40,98,46,120,32,60,32,97,46,120,41,32,63,32,49,46,48,32,58,32,45,49,46,48,41,32,42,32,99,108,97,109,112,40,48,46,53,32,43,32,121,44,32,48,46,48,44,32,49,46,48,41,59,10,32,32,32,32,32,32,32,32,32,32,119,101,105,103,104,116,95,121,32,61,32,109,97,120,40,119,101,105,103,104,116,95,121,44,32,49,46,48,32,45,32,50,46,48,32,42,32,97,98,115,40,121,41,41,59,10,32,32,32,32,32,32,32,32,125,10,32,32,32,32,125,10,10,32,32,99,120,32,61,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,97,112,112,108,121,95,102,105,108,108,95,114,117,108,101,40,119,120,44,32,104,101,97,100,101,114,46,102,105,108,108,95,114,117,108,101,41,59,10,32,32,99,121,32,61,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,97,112,112,108,121,95,102,105,108,108,95,114,117,108,101,40,119,121,44,32,104,101,97,100,101,114,46,102,105,108,108,95,114,117,108,101,41,59,10,32,32,105,102,40,119,101,105,103,104,116,95,120,32,43,32,119,101,105,103,104,116,95,121,32,62,32,48,46,48,41,10,32,32,32,32,123,10,32,32,32,32,32,32,99,111,118,101,114,97,103,101,32,61,32,40,99,120,32,42,32,119,101,105,103,104,116,95,120,32,43,32,99,121,32,42,32,119,101,105,103,104,116,95,121,41,32,47,32,40,119,101,105,103,104,116,95,120,32,43,32,119,101,105,103,104,116,95,121,41,59,10,32,32,32,32,125,10,32,32,101,108,115,101,10,32,32,32,32,123,10,32,32,32,32,32,32,99,111,118,101,114,97,103,101,32,61,32,48,46,53,32,42,32,40,99,120,32,43,32,99,121,41,59,10,32,32,32,32,125,10,10,32,32,114,101,116,117,114,110,32,118,101,99,52,40,49,46,48,44,32,49,46,48,44,32,49,46,48,44,32,99,111,118,101,114,97,103,101,41,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_analytic_fill.frag.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
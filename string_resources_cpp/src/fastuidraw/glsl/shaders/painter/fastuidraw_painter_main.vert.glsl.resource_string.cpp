@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+47,42,32,83,107,101,108,101,116,111,110,32,102,111,114,32,85,98,101,114,45,118,101,114,116,101,120,32,115,104,97,100,101,114,44,32,111,117,116,39,115,32,111,102,32,116,104,101,32,115,104,97,100,101,114,32,119,105,108,108,10,32,32,32,98,101,32,112,108,97,99,101,100,32,45,98,101,102,111,114,101,45,32,116,104,105,115,32,99,111,100,101,46,10,32,42,47,10,10,35,105,102,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,80,65,73,78,84,69,82,95,78,79,82,77,65,76,73,90,69,68,95,90,95,77,73,78,85,83,95,49,95,84,79,95,49,10,32,32,35,100,101,102,105,110,101,32,70,65,83,84,85,73,68,82,65,87,95,68,69,80,84,72,95,67,79,69,70,70,32,40,49,46,48,32,47,32,102,108,111,97,116,40,102,97,115,116,117,105,100,114,97,119,95,104,97,108,102,95,109,97,120,95,122,41,32,41,10,35,101,108,115,101,10,32,32,35,100,101,102,105,110,101,32,70,65,83,84,85,73,68,82,65,87,95,68,69,80,84,72,95,67,79,69,70,70,32,40,49,46,48,32,47,32,102,108,111,97,116,40,102,97,115,116,117,105,100,114,97,119,95,109,97,120,95,122,41,32,41,10,35,101,110,100,105,102,10,10,35,105,102,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,80,65,73,78,84,69,82,95,85,83,69,95,72,87,95,67,76,73,80,95,80,76,65,78,69,83,10,32,32,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,48,32,103,108,95,67,108,105,112,68,105,115,116,97,110,99,101,91,48,93,10,32,32,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,49,32,103,108,95,67,108,105,112,68,105,115,116,97,110,99,101,91,49,93,10,32,32,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,50,32,103,108,95,67,108,105,112,68,105,115,116,97,110,99,101,91,50,93,10,32,32,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,51,32,103,108,95,67,108,105,112,68,105,115,116,97,110,99,101,91,51,93,10,35,101,108,115,101,10,32,32,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,48,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,95,112,108,97,110,101,48,10,32,32,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,49,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,95,112,108,97,110,101,49,10,32,32,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,50,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,95,112,108,97,110,101,50,10,32,32,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,51,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,95,112,108,97,110,101,51,10,35,101,110,100,105,102,10,10,118,111,105,100,10,102,97,115,116,117,105,100,114,97,119,95,97,112,112,108,121,95,99,108,105,112,112,105,110,103,40,105,110,32,118,101,99,51,32,112,44,32,105,110,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,112,105,110,103,95,100,97,116,97,32,99,41,10,123,10,32,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,48,32,61,32,100,111,116,40,99,46,99,108,105,112,48,44,32,112,41,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,49,32,61,32,100,111,116,40,99,46,99,108,105,112,49,44,32,112,41,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,50,32,61,32,100,111,116,40,99,46,99,108,105,112,50,44,32,112,41,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,51,32,61,32,100,111,116,40,99,46,99,108,105,112,51,44,32,112,41,59,10,125,10,10,10,47,42,32,109,97,107,101,32,116,104,101,32,116,114,97,110,115,102,111,114,109,97,116,105,111,110,32,109,97,116,114,105,120,32,97,118,97,105,108,97,98,108,101,32,116,111,10,32,32,32,118,101,114,116,101,120,32,115,104,97,100,101,114,32,98,121,32,109,97,107,105,110,103,32,105,116,32,103,108,111,98,97,108,32,104,101,114,101,46,10,32,42,47,10,109,97,116,51,32,102,97,115,116,117,105,100,114,97,119,95,105,116,101,109,95,109,97,116,114,105,120,59,10,10,118,111,105,100,10,109,97,105,110,40,118,111,105,100,41,10,123,10,32,32,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,104,101,97,100,101,114,32,104,59,10,32,32,118,101,99,52,32,105,116,101,109,95,112,95,98,114,117,115,104,95,112,59,10,32,32,118,101,99,51,32,99,108,105,112,95,112,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,112,105,110,103,95,100,97,116,97,32,99,108,105,112,112,105,110,103,59,10,32,32,102,108,111,97,116,32,110,111,114,109,97,108,105,122,101,100,95,100,101,112,116,104,44,32,114,97,119,95,100,101,112,116,104,59,10,32,32,117,105,110,116,32,97,100,100,95,122,59,10,10,32,32,102,97,115,116,117,105,100,114,97,119,95,114,101,97,100,95,104,101,97,100,101,114,40,102,97,115,116,117,105,100,114,97,119,95,104,101,97,100,101,114,95,97,116,116,114,105,98,117,116,101,44,32,104,41,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,114,101,97,100,95,99,108,105,112,112,105,110,103,40,104,46,99,108,105,112,112,105,110,103,95,108,111,99,97,116,105,111,110,44,32,99,108,105,112,112,105,110,103,41,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,114,101,97,100,95,105,116,101,109,95,109,97,116,114,105,120,40,104,46,105,116,101,109,95,109,97,116,114,105,120,95,108,111,99,97,116,105,111,110,44,32,102,97,115,116,117,105,100,114,97,119,95,105,116,101,109,95,109,97,116,114,105,120,41,59,10,10,32,32,104,46,105,116,101,109,95,115,104,97,100,101,114,32,61,32,70,65,83,84,85,73,68,82,65,87,95,69,88,84,82,65,67,84,95,66,73,84,83,40,102,97,115,116,117,105,100,114,97,119,95,105,116,101,109,95,115,104,97,100,101,114,95,98,105,116,48,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,105,116,101,109,95,115,104,97,100,101,114,95,110,117,109,95,98,105,116,115,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,104,46,105,116,101,109,95,98,108,101,110,100,95,115,104,97,100,101,114,95,112,97,99,107,101,100,41,59,10,10,32,32,104,46,98,108,101,110,100,95,115,104,97,100,101,114,32,61,32,70,65,83,84,85,73,68,82,65,87,95,69,88,84,82,65,67,84,95,66,73,84,83,40,102,97,115,116,117,105,100,114,97,119,95,98,108,101,110,100,95,115,104,97,100,101,114,95,98,105,116,48,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,98,108,101,110,100,95,115,104,97,100,101,114,95,110,117,109,95,98,105,116,115,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,104,46,105,116,101,109,95,98,108,101,110,100,95,115,104,97,100,101,114,95,112,97,99,107,101,100,41,59,10,10,32,32,35,105,102,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,80,65,73,78,84,69,82,95,85,78,80,65,67,75,95,65,84,95,70,82,65,71,77,69,78,84,95,83,72,65,68,69,82,10,32,32,32,32,123,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,104,101,97,100,101,114,95,118,97,114,121,105,110,103,32,61,32,102,97,115,116,117,105,100,114,97,119,95,104,101,97,100,101,114,95,97,116,116,114,105,98,117,116,101,59,10,32,32,32,32,125,10,32,32,35,101,108,115,101,10,32,32,32,32,123,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,114,97,103,95,115,104,97,100,101,114,32,61,32,104,46,105,116,101,109,95,115,104,97,100,101,114,59,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,114,97,103,95,115,104,97,100,101,114,95,100,97,116,97,95,108,111,99,97,116,105,111,110,32,61,32,104,46,105,116,101,109,95,115,104,97,100,101,114,95,100,97,116,97,95,108,111,99,97,116,105,111,110,59,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,98,108,101,110,100,95,115,104,97,100,101,114,32,61,32,104,46,98,108,101,110,100,95,115,104,97,100,101,114,59,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,98,108,101,110,100,95,115,104,97,100,101,114,95,100,97,116,97,95,108,111,99,97,116,105,111,110,32,61,32,104,46,98,108,101,110,100,95,115,104,97,100,101,114,95,100,97,116,97,95,108,111,99,97,116,105,111,110,59,10,32,32,32,32,125,10,32,32,35,101,110,100,105,102,10,10,32,32,105,116,101,109,95,112,95,98,114,117,115,104,95,112,32,61,32,102,97,115,116,117,105,100,114,97,119,95,114,117,110,95,118,101,114,116,95,115,104,97,100,101,114,40,104,44,32,97,100,100,95,122,41,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,118,101,114,116,95,98,114,117,115,104,95,112,114,111,99,101,115,115,105,110,103,40,105,116,101,109,95,112,95,98,114,117,115,104,95,112,46,122,119,44,32,104,41,59,10,10,32,32,99,108,105,112,95,112,32,61,32,102,97,115,116,117,105,100,114,97,119,95,105,116,101,109,95,109,97,116,114,105,120,32,42,32,118,101,99,51,40,105,116,101,109,95,112,95,98,114,117,115,104,95,112,46,120,121,44,32,49,46,48,41,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,97,112,112,108,121,95,99,108,105,112,112,105,110,103,40,99,108,105,112,95,112,44,32,99,108,105,112,112,105,110,103,41,59,10,10,32,32,47,42,32,97,110,100,32,102,105,110,97,108,108,121,32,101,109,105,116,32,103,108,95,80,111,115,105,116,105,111,110,59,32,116,104,101,32,118,97,108,117,101,32,110,101,101,100,101,100,32,105,110,32,116,104,101,10,32,32,32,32,32,100,101,112,116,104,32,98,117,102,102,101,114,32,105,115,32,115,116,111,114,101,100,32,105,110,32,104,46,122,44,32,98,117,116,32,105,116,32,105,115,32,97,110,32,105,110,116,101,103,101,114,32,116,104,97,116,10,32,32,32,32,32,115,116,97,114,116,115,32,97,116,32,48,32,97,110,100,32,105,115,32,105,110,99,114,101,109,101,110,116,101,100,32,98,121,32,111,110,101,44,32,119,101,32,110,101,101,100,32,116,111,32,99,111,110,118,101,114,116,32,105,116,10,32,32,32,32,32,116,111,32,110,111,114,109,97,108,105,122,101,100,32,99,111,111,114,100,115,46,10,32,32,32,42,47,10,32,32,114,97,119,95,100,101,112,116,104,32,61,32,102,108,111,97,116,40,97,100,100,95,122,32,43,32,104,46,122,41,59,10,10,32,32,35,105,102,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,80,65,73,78,84,69,82,95,78,79,82,77,65,76,73,90,69,68,95,90,95,77,73,78,85,83,95,49,95,84,79,95,49,10,32,32,32,32,123,10,32,32,32,32,32,32,110,111,114,109,97,108,105,122,101,100,95,100,101,112,116,104,32,61,32,40,70,65,83,84,85,73,68,82,65,87,95,68,69,80,84,72,95,67,79,69,70,70,32,42,32,114,97,119,95,100,101,112,116,104,41,32,45,32,49,46,48,59,10,32,32,32,32,125,10,32,32,35,101,108,115,101,10,32,32,32,32,123,10,32,32,32,32,32,32,110,111,114,109,97,108,105,122,101,100,95,100,101,112,116,104,32,61,32,40,70,65,83,84,85,73,68,82,65,87,95,68,69,80,84,72,95,67,79,69,70,70,32,42,32,114,97,119,95,100,101,112,116,104,41,59,10,32,32,32,32,125,10,32,32,35,101,110,100,105,102,10,10,32,32,35,105,102,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,80,65,73,78,84,69,82,95,78,69,71,65,84,69,95,80,79,83,73,84,73,79,78,95,89,95,67,79,79,82,68,73,78,65,84,69,10,32,32,32,32,123,10,32,32,32,32,32,32,99,108,105,112,95,112,46,121,32,61,32,45,99,108,105,112,95,112,46,121,59,10,32,32,32,32,125,10,32,32,35,101,110,100,105,102,10,10,32,32,103,108,95,80,111,115,105,116,105,111,110,32,61,32,118,101,99,52,40,99,108,105,112,95,112,46,120,121,44,32,110,111,114,109,97,108,105,122,101,100,95,100,101,112,116,104,32,42,32,99,108,105,112,95,112,46,122,44,32,99,108,105,112,95,112,46,122,41,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_main.vert.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+115,116,114,117,99,116,32,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,104,101,97,100,101,114,10,123,10,32,32,47,42,32,114,101,97,100,32,100,105,114,101,99,116,108,121,32,102,114,111,109,32,100,97,116,97,32,115,116,111,114,101,32,98,117,102,102,101,114,10,32,32,32,42,47,10,32,32,117,105,110,116,32,99,108,105,112,112,105,110,103,95,108,111,99,97,116,105,111,110,59,10,32,32,117,105,110,116,32,105,116,101,109,95,109,97,116,114,105,120,95,108,111,99,97,116,105,111,110,59,10,32,32,117,105,110,116,32,98,114,117,115,104,95,115,104,97,100,101,114,95,100,97,116,97,95,108,111,99,97,116,105,111,110,59,10,32,32,117,105,110,116,32,105,116,101,109,95,115,104,97,100,101,114,95,100,97,116,97,95,108,111,99,97,116,105,111,110,59,10,32,32,117,105,110,116,32,98,108,101,110,100,95,115,104,97,100,101,114,95,100,97,116,97,95,108,111,99,97,116,105,111,110,59,10,32,32,117,105,110,116,32,98,114,117,115,104,95,115,104,97,100,101,114,59,10,32,32,117,105,110,116,32,122,59,10,32,32,117,105,110,116,32,105,116,101,109,95,98,108,101,110,100,95,115,104,97,100,101,114,95,112,97,99,107,101,100,59,10,10,32,32,47,42,32,100,101,114,105,118,101,100,32,118,97,108,117,101,115,10,32,32,32,42,47,10,32,32,117,105,110,116,32,105,116,101,109,95,115,104,97,100,101,114,59,10,32,32,117,105,110,116,32,98,108,101,110,100,95,115,104,97,100,101,114,59,10,125,59,10,10,115,116,114,117,99,116,32,102,97,115,116,117,105,100,114,97,119,95,99,108,105,112,112,105,110,103,95,100,97,116,97,10,123,10,32,32,118,101,99,51,32,99,108,105,112,48,44,32,99,108,105,112,49,44,32,99,108,105,112,50,44,32,99,108,105,112,51,59,10,125,59,10,10,115,116,114,117,99,116,32,102,97,115,116,117,105,100,114,97,119,95,115,116,114,111,107,105,110,103,95,112,97,114,97,109,115,10,123,10,32,32,102,108,111,97,116,32,119,105,100,116,104,59,10,32,32,102,108,111,97,116,32,109,105,116,101,114,95,108,105,109,105,116,59,10,125,59,10,10,115,116,114,117,99,116,32,102,97,115,116,117,105,100,114,97,119,95,100,97,115,104,101,100,95,115,116,114,111,107,105,110,103,95,112,97,114,97,109,115,95,104,101,97,100,101,114,10,123,10,32,32,102,108,111,97,116,32,119,105,100,116,104,59,10,32,32,102,108,111,97,116,32,109,105,116,101,114,95,108,105,109,105,116,59,10,32,32,102,108,111,97,116,32,100,97,115,104,95,111,102,102,115,101,116,59,10,32,32,102,108,111,97,116,32,116,111,116,97,108,95,108,101,110,103,116,104,59,10,32,32,102,108,111,97,116,32,102,105,114,115,116,95,105,110,116,101,114,118,97,108,95,115,116,97,114,116,59,10,125,59,10,10,115,116,114,117,99,116,32,102,97,115,116,117,105,100,114,97,119,95,97,110,97,108,121,116,105,99,95,102,105,108,108,95,104,101,97,100,101,114,10,123,10,32,32,117,105,110,116,32,110,117,109,98,101,114,95,115,101,103,109,101,110,116,115,59,10,32,32,117,105,110,116,32,102,105,108,108,95,114,117,108,101,59,10,32,32,117,105,110,116,32,110,117,109,98,101,114,95,98,97,110,100,115,59,10,32,32,102,108,111,97,116,32,98,97,110,100,95,109,105,110,95,120,59,10,32,32,102,108,111,97,116,32,98,97,110,100,95,109,105,110,95,121,59,10,32,32,102,108,111,97,116,32,98,97,110,100,95,115,99,97,108,101,95,120,59,10,32,32,102,108,111,97,116,32,98,97,110,100,95,115,99,97,108,101,95,121,59,10,125,59,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_types.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+